@@ -27,6 +27,7 @@
 #include <QHostAddress>
 #include <QStatusBar>
 #include <QTextStream>
+#include <functional>
 #include <rl/math/Rotation.h>
 #include <rl/sg/Body.h>
 #include <rl/sg/Shape.h>
@@ -36,7 +37,8 @@
 #include "Socket.h"
 
 Socket::Socket(QObject* parent) :
-	QTcpSocket(parent)
+	QTcpSocket(parent),
+	binary(false)
 {
 	QObject::connect(this, SIGNAL(disconnected()), this, SLOT(deleteLater()));
 	QObject::connect(this, SIGNAL(readyRead()), this, SLOT(readClient()));
@@ -51,6 +53,125 @@ Socket::readClient()
 {
 	MainWindow::instance()->statusBar()->showMessage("Received data from " + this->peerAddress().toString() + ":" + QString::number(this->peerPort()), 1000);
 	
+	if (this->binary)
+	{
+		this->readBinary();
+	}
+	else
+	{
+		this->readText();
+	}
+}
+
+void
+Socket::handle(const rl::hal::CoachFrame::Message& message, std::vector<rl::hal::CoachFrame::Message>& replies)
+{
+	std::size_t i = message.i;
+	const rl::math::Vector& values = message.values;
+	
+	switch (message.cmd)
+	{
+	case 0:
+		{
+			if (7 != values.size())
+			{
+				return;
+			}
+			
+			std::size_t j = static_cast<std::size_t>(values(0));
+			
+			rl::math::Transform t;
+			t = rl::math::AngleAxis(values(6), rl::math::Vector3::UnitZ()) *
+				rl::math::AngleAxis(values(5), rl::math::Vector3::UnitY()) *
+				rl::math::AngleAxis(values(4), rl::math::Vector3::UnitX());
+			t.translation() = values.segment<3>(1);
+			
+			if (MainWindow::instance()->scene->getNumModels() > i)
+			{
+				if (MainWindow::instance()->scene->getModel(i)->getNumBodies() > j)
+				{
+					MainWindow::instance()->scene->getModel(i)->getBody(j)->setFrame(t);
+				}
+			}
+		}
+		break;
+	case 1:
+		{
+			if (8 != values.size())
+			{
+				return;
+			}
+			
+			std::size_t j = static_cast<std::size_t>(values(0));
+			std::size_t k = static_cast<std::size_t>(values(1));
+			
+			rl::math::Transform t;
+			t = rl::math::AngleAxis(values(7), rl::math::Vector3::UnitZ()) *
+				rl::math::AngleAxis(values(6), rl::math::Vector3::UnitY()) *
+				rl::math::AngleAxis(values(5), rl::math::Vector3::UnitX());
+			t.translation() = values.segment<3>(2);
+			
+			if (MainWindow::instance()->scene->getNumModels() > i)
+			{
+				if (MainWindow::instance()->scene->getModel(i)->getNumBodies() > j)
+				{
+					if (MainWindow::instance()->scene->getModel(i)->getBody(j)->getNumShapes() > k)
+					{
+						MainWindow::instance()->scene->getModel(i)->getBody(j)->getShape(k)->setTransform(t);
+					}
+				}
+			}
+		}
+		break;
+	case 2:
+		{
+			if (i < MainWindow::instance()->kinematicModels.size())
+			{
+				if (MainWindow::instance()->kinematicModels[i]->getDofPosition() == static_cast<std::size_t>(values.size()))
+				{
+					MainWindow::instance()->configurationModels[i]->setData(values);
+				}
+			}
+		}
+		break;
+	case 6:
+		{
+			rl::math::Vector q;
+			
+			if (i < MainWindow::instance()->kinematicModels.size())
+			{
+				q = MainWindow::instance()->kinematicModels[i]->getPosition();
+			}
+			
+			rl::hal::CoachFrame::Message reply = {message.cmd, message.i, q};
+			replies.push_back(reply);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void
+Socket::readBinary()
+{
+	QByteArray buffer = this->peek(this->bytesAvailable());
+	std::vector<std::uint8_t> replies;
+	
+	std::size_t count = rl::hal::CoachFrame::process(
+		reinterpret_cast<const std::uint8_t*>(buffer.constData()),
+		buffer.size(),
+		std::bind(&Socket::handle, this, std::placeholders::_1, std::placeholders::_2),
+		replies
+	);
+	
+	this->read(count);
+	this->write(reinterpret_cast<const char*>(replies.data()), replies.size());
+}
+
+void
+Socket::readText()
+{
 	QTextStream textStream(this);
 	
 	for (QString line = textStream.readLine(); QString() != line; line = textStream.readLine())
@@ -198,6 +319,17 @@ Socket::readClient()
 #endif // QT_VERSION
 			}
 			break;
+		case 7:
+			{
+				textStream << cmd << " " << 1;
+#if QT_VERSION >= 0x050E00
+				textStream << Qt::endl;
+#else // QT_VERSION
+				textStream << endl;
+#endif // QT_VERSION
+				this->binary = true;
+			}
+			return;
 		default:
 			break;
 		}
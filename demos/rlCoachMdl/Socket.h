@@ -28,6 +28,8 @@
 #define SOCKET_H
 
 #include <QTcpSocket>
+#include <vector>
+#include <rl/hal/CoachFrame.h>
 
 class Socket : public QTcpSocket
 {
@@ -41,7 +43,14 @@ public:
 protected:
 	
 private:
-
+	void handle(const rl::hal::CoachFrame::Message& message, std::vector<rl::hal::CoachFrame::Message>& replies);
+	
+	void readBinary();
+	
+	void readText();
+	
+	bool binary;
+	
 private slots:
 	void readClient();
 };
@@ -0,0 +1,219 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <boost/lexical_cast.hpp>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/DormandPrinceIntegrator.h>
+#include <rl/mdl/EulerCauchyIntegrator.h>
+#include <rl/mdl/RungeKuttaNystromIntegrator.h>
+#include <rl/mdl/UrdfFactory.h>
+#include <rl/mdl/XmlFactory.h>
+
+std::string
+format(const rl::math::Real& value)
+{
+	std::ostringstream stream;
+	stream << value;
+	return stream.str();
+}
+
+void
+report(const std::string& name, const std::string& parameter, const std::size_t& evaluations, const double& duration, const rl::mdl::Dynamic* dynamic, const rl::math::Vector& q, const rl::math::Vector& qd)
+{
+	rl::math::Real error = std::max((dynamic->getPosition() - q).cwiseAbs().maxCoeff(), (dynamic->getVelocity() - qd).cwiseAbs().maxCoeff());
+	
+	std::cout << std::left << std::setw(20) << name;
+	std::cout << std::left << std::setw(16) << parameter;
+	std::cout << std::right << std::setw(12) << evaluations;
+	std::cout << std::right << std::setw(14) << std::fixed << std::setprecision(3) << duration;
+	std::cout << std::right << std::setw(14) << std::scientific << std::setprecision(3) << error;
+	std::cout << std::defaultfloat << std::endl;
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: rlIntegratorBenchmark MODELFILE [DURATION] [PERIOD]" << std::endl;
+		std::cout << "Example: rlIntegratorBenchmark unimation-puma560.xml 1 0.001" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::string filename(argv[1]);
+		std::shared_ptr<rl::mdl::Dynamic> dynamic;
+		
+		if ("urdf" == filename.substr(filename.length() - 4, 4))
+		{
+			rl::mdl::UrdfFactory factory;
+			dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(filename));
+		}
+		else
+		{
+			rl::mdl::XmlFactory factory;
+			dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(filename));
+		}
+		
+		if (nullptr == dynamic || dynamic->getDofPosition() != dynamic->getDof())
+		{
+			std::cerr << "Expected dynamic model with equal position and velocity degrees of freedom" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		rl::math::Real duration = argc > 2 ? boost::lexical_cast<rl::math::Real>(argv[2]) : 1;
+		rl::math::Real period = argc > 3 ? boost::lexical_cast<rl::math::Real>(argv[3]) : static_cast<rl::math::Real>(0.001);
+		
+		// passive motion under gravity from home position with unit joint velocities
+		
+		rl::math::Vector q0 = dynamic->getHomePosition();
+		rl::math::Vector qd0 = rl::math::Vector::Ones(dynamic->getDof());
+		rl::math::Vector tau = rl::math::Vector::Zero(dynamic->getDof());
+		
+		dynamic->setPosition(q0);
+		dynamic->setVelocity(qd0);
+		dynamic->setTorque(tau);
+		
+		rl::mdl::DormandPrinceIntegrator reference(dynamic.get());
+		reference.setAbsoluteTolerance(static_cast<rl::math::Real>(1.0e-13));
+		reference.setRelativeTolerance(static_cast<rl::math::Real>(1.0e-13));
+		reference.setMinimumStepSize(0);
+		reference.integrate(duration);
+		
+		rl::math::Vector q = dynamic->getPosition();
+		rl::math::Vector qd = dynamic->getVelocity();
+		
+		std::cout << "Model: " << filename << "  Duration: " << duration << " s  Period: " << period << " s" << std::endl;
+		std::cout << "Reference: Dormand-Prince tolerance 1e-13, " << reference.getEvaluations() << " evaluations" << std::endl;
+		std::cout << std::left << std::setw(20) << "Integrator";
+		std::cout << std::left << std::setw(16) << "Parameter";
+		std::cout << std::right << std::setw(12) << "Evaluations";
+		std::cout << std::right << std::setw(14) << "Time [ms]";
+		std::cout << std::right << std::setw(14) << "Error";
+		std::cout << std::endl;
+		
+		rl::math::Real fixed[] = {1.0e-2, 1.0e-3, 1.0e-4};
+		
+		for (std::size_t i = 0; i < sizeof(fixed) / sizeof(fixed[0]); ++i)
+		{
+			std::size_t steps = static_cast<std::size_t>(std::round(duration / fixed[i]));
+			
+			dynamic->setPosition(q0);
+			dynamic->setVelocity(qd0);
+			
+			rl::mdl::EulerCauchyIntegrator integrator(dynamic.get());
+			
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			
+			for (std::size_t j = 0; j < steps; ++j)
+			{
+				integrator.integrate(fixed[i]);
+			}
+			
+			std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+			
+			report("Euler-Cauchy", "dt " + format(fixed[i]), steps, std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000, dynamic.get(), q, qd);
+		}
+		
+		for (std::size_t i = 0; i < sizeof(fixed) / sizeof(fixed[0]); ++i)
+		{
+			std::size_t steps = static_cast<std::size_t>(std::round(duration / fixed[i]));
+			
+			dynamic->setPosition(q0);
+			dynamic->setVelocity(qd0);
+			
+			rl::mdl::RungeKuttaNystromIntegrator integrator(dynamic.get());
+			
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			
+			for (std::size_t j = 0; j < steps; ++j)
+			{
+				integrator.integrate(fixed[i]);
+			}
+			
+			std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+			
+			report("Runge-Kutta-Nystrom", "dt " + format(fixed[i]), 4 * steps, std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000, dynamic.get(), q, qd);
+		}
+		
+		rl::math::Real tolerances[] = {1.0e-3, 1.0e-6, 1.0e-9};
+		
+		for (std::size_t i = 0; i < sizeof(tolerances) / sizeof(tolerances[0]); ++i)
+		{
+			// one call per control period
+			
+			std::size_t periods = static_cast<std::size_t>(std::round(duration / period));
+			
+			dynamic->setPosition(q0);
+			dynamic->setVelocity(qd0);
+			
+			rl::mdl::DormandPrinceIntegrator integrator(dynamic.get());
+			integrator.setAbsoluteTolerance(tolerances[i]);
+			integrator.setRelativeTolerance(tolerances[i]);
+			
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			
+			for (std::size_t j = 0; j < periods; ++j)
+			{
+				integrator.integrate(period);
+			}
+			
+			std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+			
+			report("Dormand-Prince", "tol " + format(tolerances[i]), integrator.getEvaluations(), std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000, dynamic.get(), q, qd);
+			
+			// one call for the whole duration
+			
+			dynamic->setPosition(q0);
+			dynamic->setVelocity(qd0);
+			
+			rl::mdl::DormandPrinceIntegrator integrator2(dynamic.get());
+			integrator2.setAbsoluteTolerance(tolerances[i]);
+			integrator2.setRelativeTolerance(tolerances[i]);
+			
+			start = std::chrono::steady_clock::now();
+			integrator2.integrate(duration);
+			stop = std::chrono::steady_clock::now();
+			
+			report("Dormand-Prince", "tol " + format(tolerances[i]) + " once", integrator2.getEvaluations(), std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000, dynamic.get(), q, qd);
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
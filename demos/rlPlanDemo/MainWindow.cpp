@@ -49,6 +49,7 @@
 #include <rl/plan/AddRrtConCon.h>
 #include <rl/plan/AdvancedOptimizer.h>
 #include <rl/plan/BridgeSampler.h>
+#include <rl/plan/ConservativeAdvancementVerifier.h>
 #include <rl/plan/DistanceModel.h>
 #include <rl/plan/Eet.h>
 #include <rl/plan/GaussianSampler.h>
@@ -107,6 +108,9 @@
 #ifdef RL_SG_SOLID
 #include <rl/sg/solid/Scene.h>
 #endif // RL_SG_SOLID
+#ifdef RL_SG_SSV
+#include <rl/sg/ssv/Scene.h>
+#endif // RL_SG_SSV
 
 #include "ConfigurationDelegate.h"
 #include "ConfigurationModel.h"
@@ -856,6 +860,12 @@ MainWindow::load(const QString& filename)
 		this->scene = std::make_shared<rl::sg::solid::Scene>();
 	}
 #endif // RL_SG_SOLID
+#ifdef RL_SG_SSV
+	if ("ssv" == this->engine)
+	{
+		this->scene = std::make_shared<rl::sg::ssv::Scene>();
+	}
+#endif // RL_SG_SSV
 	
 	rl::xml::NodeSet modelScene = path.eval("(/rl/plan|/rlplan)//model/scene").getValue<rl::xml::NodeSet>();
 	std::string modelSceneFilename = modelScene[0].getLocalPath(modelScene[0].getProperty("href"));
@@ -870,8 +880,11 @@ MainWindow::load(const QString& filename)
 	}
 	else
 	{
+		// conservative advancement bounds body motion by bounding boxes
+		bool doBoundingBoxPoints = path.eval("count((/rl/plan|/rlplan)//conservativeAdvancementVerifier) > 0").getValue<bool>();
+		
 		rl::sg::XmlFactory sceneFactory;
-		sceneFactory.load(modelSceneFilename, this->scene.get());
+		sceneFactory.load(modelSceneFilename, this->scene.get(), doBoundingBoxPoints, false);
 		this->sceneModel = this->scene->getModel(
 			path.eval("number((/rl/plan|/rlplan)//model/model)").getValue<std::size_t>()
 		);
@@ -1306,7 +1319,13 @@ MainWindow::load(const QString& filename)
 	this->sampler2 = std::make_shared<rl::plan::UniformSampler>();
 	this->sampler2->setModel(this->model.get());
 	
-	if (path.eval("count((/rl/plan|/rlplan)//recursiveVerifier) > 0").getValue<bool>())
+	if (path.eval("count((/rl/plan|/rlplan)//conservativeAdvancementVerifier) > 0").getValue<bool>())
+	{
+		std::shared_ptr<rl::plan::ConservativeAdvancementVerifier> conservativeAdvancementVerifier = std::make_shared<rl::plan::ConservativeAdvancementVerifier>();
+		conservativeAdvancementVerifier->setEpsilon(path.eval("number((/rl/plan|/rlplan)//conservativeAdvancementVerifier/epsilon)").getValue<rl::math::Real>(static_cast<rl::math::Real>(1.0e-3)));
+		this->verifier = conservativeAdvancementVerifier;
+	}
+	else if (path.eval("count((/rl/plan|/rlplan)//recursiveVerifier) > 0").getValue<bool>())
 	{
 		this->verifier = std::make_shared<rl::plan::RecursiveVerifier>();
 		rl::math::Real delta = path.eval("number((/rl/plan|/rlplan)//recursiveVerifier/delta)").getValue<rl::math::Real>(1);
@@ -2114,6 +2133,10 @@ void
 MainWindow::parseCommandLine()
 {
 	QStringList engines;
+#ifdef RL_SG_SSV
+	engines.push_back("ssv");
+	this->engine = "ssv";
+#endif // RL_SG_SSV
 #ifdef RL_SG_FCL
 	engines.push_back("fcl");
 	this->engine = "fcl";
@@ -0,0 +1,271 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <rl/math/AlignedBox.h>
+#include <rl/sg/Body.h>
+#include <rl/sg/DistanceScene.h>
+#include <rl/sg/Model.h>
+#include <rl/sg/XmlFactory.h>
+
+#ifdef RL_SG_BULLET
+#include <rl/sg/bullet/Scene.h>
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+#include <rl/sg/fcl/Scene.h>
+#endif // RL_SG_FCL
+#ifdef RL_SG_PQP
+#include <rl/sg/pqp/Scene.h>
+#include <rl/sg/pqp/Shape.h>
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+#include <rl/sg/solid/Scene.h>
+#endif // RL_SG_SOLID
+#ifdef RL_SG_SSV
+#include <rl/sg/ssv/Scene.h>
+#endif // RL_SG_SSV
+
+#ifdef RL_SG_PQP
+// point query as implemented before, with a new PQP model for every call
+rl::math::Real
+legacyDistance(rl::sg::Body* body, const rl::math::Vector3& point)
+{
+	rl::math::Real distance = std::numeric_limits<rl::math::Real>::max();
+	
+	for (rl::sg::Body::Iterator i = body->begin(); i != body->end(); ++i)
+	{
+		rl::sg::pqp::Shape* shape = static_cast<rl::sg::pqp::Shape*>(*i);
+		
+		PQP_REAL p[3] = {0, 0, 0};
+		
+		PQP_Model model;
+		model.BeginModel(1);
+		model.AddTri(p, p, p, 0);
+		model.EndModel();
+		
+		PQP_REAL rotation[3][3] = {
+			{1, 0, 0},
+			{0, 1, 0},
+			{0, 0, 1}
+		};
+		
+		PQP_REAL translation[3] = {point(0), point(1), point(2)};
+		
+		PQP_DistanceResult result;
+		
+		PQP_Distance(
+			&result,
+			shape->rotation,
+			shape->translation,
+			&shape->model,
+			rotation,
+			translation,
+			&model,
+			std::numeric_limits<rl::math::Real>::epsilon(),
+			std::numeric_limits<rl::math::Real>::epsilon()
+		);
+		
+		distance = std::min(distance, static_cast<rl::math::Real>(result.Distance()));
+	}
+	
+	return distance;
+}
+#endif // RL_SG_PQP
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 4)
+	{
+		std::cout << "Usage: rlPointDistanceBenchmark ENGINE SCENEFILE POINTS [RUNS]" << std::endl;
+		std::cout << "Example: rlPointDistanceBenchmark pqp unimation-puma560_boxes.xml 10000 10" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::shared_ptr<rl::sg::Scene> scene;
+		
+#ifdef RL_SG_BULLET
+		if ("bullet" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::bullet::Scene>();
+		}
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+		if ("fcl" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::fcl::Scene>();
+		}
+#endif // RL_SG_FCL
+#ifdef RL_SG_PQP
+		if ("pqp" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::pqp::Scene>();
+		}
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+		if ("solid" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::solid::Scene>();
+		}
+#endif // RL_SG_SOLID
+#ifdef RL_SG_SSV
+		if ("ssv" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::ssv::Scene>();
+		}
+#endif // RL_SG_SSV
+		
+		rl::sg::DistanceScene* distanceScene = dynamic_cast<rl::sg::DistanceScene*>(scene.get());
+		
+		if (nullptr == distanceScene)
+		{
+			std::cerr << "Unsupported engine " << argv[1] << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		rl::sg::XmlFactory factory;
+		factory.load(argv[2], scene.get(), true, false);
+		
+		std::size_t numPoints = boost::lexical_cast<std::size_t>(argv[3]);
+		std::size_t runs = argc > 4 ? boost::lexical_cast<std::size_t>(argv[4]) : 1;
+		
+		std::vector<rl::sg::Body*> bodies;
+		rl::math::AlignedBox3 box;
+		
+		for (rl::sg::Scene::Iterator i = scene->begin(); i != scene->end(); ++i)
+		{
+			for (rl::sg::Model::Iterator j = (*i)->begin(); j != (*i)->end(); ++j)
+			{
+				bodies.push_back(*j);
+				
+				rl::math::Transform frame = (*j)->getFrame();
+				rl::math::AlignedBox3 bodyBox((*j)->min, (*j)->max);
+				
+				for (int k = 0; k < 8; ++k)
+				{
+					box.extend(frame * bodyBox.corner(static_cast<rl::math::AlignedBox3::CornerType>(k)));
+				}
+			}
+		}
+		
+		box.extend(box.min() - static_cast<rl::math::Real>(0.1) * box.sizes());
+		box.extend(box.max() + static_cast<rl::math::Real>(0.1) * box.sizes());
+		
+		std::mt19937 generator(0);
+		std::uniform_real_distribution<rl::math::Real> distribution(0, 1);
+		
+		std::vector<rl::math::Vector3> points(numPoints);
+		
+		for (std::size_t i = 0; i < points.size(); ++i)
+		{
+			for (std::ptrdiff_t j = 0; j < 3; ++j)
+			{
+				points[i](j) = box.min()(j) + distribution(generator) * box.sizes()(j);
+			}
+		}
+		
+		std::cout << "Bodies: " << bodies.size() << "  Points: " << points.size() << std::endl;
+		
+		std::vector<rl::math::Real> distances(points.size());
+		
+		double singleTotal = 0;
+#ifdef RL_SG_PQP
+		std::vector<rl::math::Real> legacyDistances(points.size());
+		rl::math::Real error = 0;
+		double legacyTotal = 0;
+#endif // RL_SG_PQP
+		
+		for (std::size_t i = 0; i < runs; ++i)
+		{
+			for (std::size_t j = 0; j < bodies.size(); ++j)
+			{
+				rl::math::Vector3 point1;
+				rl::math::Vector3 point2;
+				
+				std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+				
+				for (std::size_t k = 0; k < points.size(); ++k)
+				{
+					distances[k] = distanceScene->distance(bodies[j], points[k], point1, point2);
+				}
+				
+				std::chrono::steady_clock::time_point stopTime = std::chrono::steady_clock::now();
+				singleTotal += std::chrono::duration_cast<std::chrono::duration<double>>(stopTime - startTime).count() * 1000;
+				
+#ifdef RL_SG_PQP
+				if ("pqp" == std::string(argv[1]))
+				{
+					startTime = std::chrono::steady_clock::now();
+					
+					for (std::size_t k = 0; k < points.size(); ++k)
+					{
+						legacyDistances[k] = legacyDistance(bodies[j], points[k]);
+					}
+					
+					stopTime = std::chrono::steady_clock::now();
+					legacyTotal += std::chrono::duration_cast<std::chrono::duration<double>>(stopTime - startTime).count() * 1000;
+					
+					for (std::size_t k = 0; k < points.size(); ++k)
+					{
+						error = std::max(error, std::abs(distances[k] - legacyDistances[k]));
+					}
+				}
+#endif // RL_SG_PQP
+			}
+		}
+		
+		std::size_t queries = runs * bodies.size() * points.size();
+		
+		std::cout << "Single: " << singleTotal / runs << " ms  " << (queries > 0 ? singleTotal * 1.0e6 / queries : 0) << " ns/query" << std::endl;
+		
+#ifdef RL_SG_PQP
+		if ("pqp" == std::string(argv[1]))
+		{
+			std::cout << "Legacy: " << legacyTotal / runs << " ms  " << (queries > 0 ? legacyTotal * 1.0e6 / queries : 0) << " ns/query" << std::endl;
+			std::cout << "Speedup: " << legacyTotal / singleTotal << std::endl;
+			std::cout << "Maximum difference: " << error << std::endl;
+		}
+#endif // RL_SG_PQP
+		
+		return EXIT_SUCCESS;
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+}
@@ -27,6 +27,7 @@
 #include <QHostAddress>
 #include <QStatusBar>
 #include <QTextStream>
+#include <functional>
 #include <rl/math/Rotation.h>
 #include <rl/sg/Body.h>
 #include <rl/sg/Shape.h>
@@ -36,7 +37,8 @@
 #include "Socket.h"
 
 Socket::Socket(QObject* parent) :
-	QTcpSocket(parent)
+	QTcpSocket(parent),
+	binary(false)
 {
 	QObject::connect(this, SIGNAL(disconnected()), this, SLOT(deleteLater()));
 	QObject::connect(this, SIGNAL(readyRead()), this, SLOT(readClient()));
@@ -52,6 +54,117 @@ Socket::readClient()
 {
 	MainWindow::instance()->statusBar()->showMessage("Received data from " + this->peerAddress().toString() + ":" + QString::number(this->peerPort()), 1000);
 	
+	if (this->binary)
+	{
+		this->readBinary();
+	}
+	else
+	{
+		this->readText();
+	}
+}
+
+void
+Socket::handle(const rl::hal::CoachFrame::Message& message, std::vector<rl::hal::CoachFrame::Message>& replies)
+{
+	std::size_t i = message.i;
+	const rl::math::Vector& values = message.values;
+	
+	switch (message.cmd)
+	{
+	case 0:
+		{
+			if (7 != values.size())
+			{
+				return;
+			}
+			
+			std::size_t j = static_cast<std::size_t>(values(0));
+			
+			rl::math::Transform t;
+			t = rl::math::AngleAxis(values(4), rl::math::Vector3::UnitZ()) *
+				rl::math::AngleAxis(values(5), rl::math::Vector3::UnitY()) *
+				rl::math::AngleAxis(values(6), rl::math::Vector3::UnitX());
+			t.translation() = values.segment<3>(1);
+			
+			if (MainWindow::instance()->scene->getNumModels() > i)
+			{
+				if (MainWindow::instance()->scene->getModel(i)->getNumBodies() > j)
+				{
+					MainWindow::instance()->scene->getModel(i)->getBody(j)->setFrame(t);
+				}
+			}
+		}
+		break;
+	case 1:
+		{
+			if (8 != values.size())
+			{
+				return;
+			}
+			
+			std::size_t j = static_cast<std::size_t>(values(0));
+			std::size_t k = static_cast<std::size_t>(values(1));
+			
+			rl::math::Transform t;
+			t = rl::math::AngleAxis(values(5), rl::math::Vector3::UnitZ()) *
+				rl::math::AngleAxis(values(6), rl::math::Vector3::UnitY()) *
+				rl::math::AngleAxis(values(7), rl::math::Vector3::UnitX());
+			t.translation() = values.segment<3>(2);
+			
+			if (MainWindow::instance()->scene->getNumModels() > i)
+			{
+				if (MainWindow::instance()->scene->getModel(i)->getNumBodies() > j)
+				{
+					if (MainWindow::instance()->scene->getModel(i)->getBody(j)->getNumShapes() > k)
+					{
+						MainWindow::instance()->scene->getModel(i)->getBody(j)->getShape(k)->setTransform(t);
+					}
+				}
+			}
+		}
+		break;
+	case 2:
+		{
+			if (i < 1 && MainWindow::instance()->dynamicModel->getDof() == static_cast<std::size_t>(values.size()))
+			{
+				MainWindow::instance()->positionModel->setData(values);
+			}
+		}
+		break;
+	case 5:
+		{
+			if (i < 1 && MainWindow::instance()->dynamicModel->getDof() == static_cast<std::size_t>(values.size()))
+			{
+				MainWindow::instance()->torqueModel->setData(values);
+			}
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void
+Socket::readBinary()
+{
+	QByteArray buffer = this->peek(this->bytesAvailable());
+	std::vector<std::uint8_t> replies;
+	
+	std::size_t count = rl::hal::CoachFrame::process(
+		reinterpret_cast<const std::uint8_t*>(buffer.constData()),
+		buffer.size(),
+		std::bind(&Socket::handle, this, std::placeholders::_1, std::placeholders::_2),
+		replies
+	);
+	
+	this->read(count);
+	this->write(reinterpret_cast<const char*>(replies.data()), replies.size());
+}
+
+void
+Socket::readText()
+{
 	QTextStream textStream(this);
 	
 	while (this->canReadLine())
@@ -191,6 +304,17 @@ Socket::readClient()
 				}
 			}
 			break;
+		case 7:
+			{
+				textStream << cmd << " " << 1;
+#if QT_VERSION >= 0x050E00
+				textStream << Qt::endl;
+#else // QT_VERSION
+				textStream << endl;
+#endif // QT_VERSION
+				this->binary = true;
+			}
+			return;
 		default:
 			break;
 		}
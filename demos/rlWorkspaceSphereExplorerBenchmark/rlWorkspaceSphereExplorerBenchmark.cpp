@@ -0,0 +1,197 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <boost/lexical_cast.hpp>
+#include <rl/math/Constants.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/XmlFactory.h>
+#include <rl/plan/DistanceModel.h>
+#include <rl/plan/WorkspaceSphereExplorer.h>
+#include <rl/sg/Model.h>
+#include <rl/sg/XmlFactory.h>
+
+#ifdef RL_SG_BULLET
+#include <rl/sg/bullet/Scene.h>
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+#include <rl/sg/fcl/Scene.h>
+#endif // RL_SG_FCL
+#ifdef RL_SG_PQP
+#include <rl/sg/pqp/Scene.h>
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+#include <rl/sg/solid/Scene.h>
+#endif // RL_SG_SOLID
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 5)
+	{
+		std::cout << "Usage: rlWorkspaceSphereExplorerBenchmark ENGINE SCENEFILE KINEMATICSFILE RUNS START1 ... STARTn GOAL1 ... GOALn" << std::endl;
+		std::cout << "Example: rlWorkspaceSphereExplorerBenchmark pqp box-6d-300505_maze.mdl.xml box-6d-300505.sixDof.xml 10 2 1 1 0 0 0 1 9 11 1 0 0 -0.70710678 0.70710678" << std::endl;
+		std::cout << "Example: rlWorkspaceSphereExplorerBenchmark pqp unimation-puma560_boxes.convex.xml unimation-puma560.xml 10 0 0 0 0 0 90 -20 0 90 -40 0 0" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::shared_ptr<rl::sg::Scene> scene;
+		
+#ifdef RL_SG_BULLET
+		if ("bullet" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::bullet::Scene>();
+		}
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+		if ("fcl" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::fcl::Scene>();
+		}
+#endif // RL_SG_FCL
+#ifdef RL_SG_PQP
+		if ("pqp" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::pqp::Scene>();
+		}
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+		if ("solid" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::solid::Scene>();
+		}
+#endif // RL_SG_SOLID
+		
+		if (nullptr == scene)
+		{
+			std::cerr << "Unsupported engine " << argv[1] << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		rl::sg::XmlFactory factory1;
+		factory1.load(argv[2], scene.get());
+		
+		rl::mdl::XmlFactory factory2;
+		std::shared_ptr<rl::mdl::Kinematic> kinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory2.create(argv[3]));
+		
+		std::size_t runs = boost::lexical_cast<std::size_t>(argv[4]);
+		
+		Eigen::Matrix<rl::math::Units, Eigen::Dynamic, 1> qUnits = kinematic->getPositionUnits();
+		
+		if (argc < 5 + 2 * static_cast<int>(kinematic->getDofPosition()))
+		{
+			std::cerr << "Expected " << kinematic->getDofPosition() << " values for start and goal" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		rl::math::Vector start(kinematic->getDofPosition());
+		
+		for (std::ptrdiff_t i = 0; i < start.size(); ++i)
+		{
+			start(i) = boost::lexical_cast<rl::math::Real>(argv[i + 5]);
+			
+			if (rl::math::Units::radian == qUnits(i))
+			{
+				start(i) *= rl::math::constants::deg2rad;
+			}
+		}
+		
+		rl::math::Vector goal(kinematic->getDofPosition());
+		
+		for (std::ptrdiff_t i = 0; i < goal.size(); ++i)
+		{
+			goal(i) = boost::lexical_cast<rl::math::Real>(argv[start.size() + i + 5]);
+			
+			if (rl::math::Units::radian == qUnits(i))
+			{
+				goal(i) *= rl::math::constants::deg2rad;
+			}
+		}
+		
+		rl::plan::DistanceModel model;
+		model.mdl = kinematic.get();
+		model.model = scene->getModel(0);
+		model.scene = scene.get();
+		
+		rl::math::Vector3 explorerStart;
+		model.setPosition(start);
+		model.updateFrames(false);
+		explorerStart = model.forwardPosition().translation();
+		
+		rl::math::Vector3 explorerGoal;
+		model.setPosition(goal);
+		model.updateFrames(false);
+		explorerGoal = model.forwardPosition().translation();
+		
+		double total = 0;
+		std::size_t solved = 0;
+		
+		for (std::size_t i = 0; i < runs; ++i)
+		{
+			rl::plan::WorkspaceSphereExplorer explorer;
+			explorer.seed(i);
+			explorer.setGoal(&explorerGoal);
+			explorer.setGreedy(rl::plan::WorkspaceSphereExplorer::Greedy::space);
+			explorer.setModel(&model);
+			explorer.setRadius(0.025);
+			explorer.setRange(45);
+			explorer.setSamples(100);
+			explorer.setStart(&explorerStart);
+			
+			std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+			bool explored = explorer.explore();
+			std::chrono::steady_clock::time_point stopTime = std::chrono::steady_clock::now();
+			
+			double duration = std::chrono::duration_cast<std::chrono::duration<double>>(stopTime - startTime).count() * 1000;
+			total += duration;
+			
+			std::cout << "explore() " << (explored ? "true" : "false") << " " << duration << " ms";
+			
+			if (explored)
+			{
+				std::cout << "  PathSpheres: " << explorer.getPath().size();
+				++solved;
+			}
+			
+			std::cout << std::endl;
+		}
+		
+		std::cout << "Runs: " << runs << "  Explored: " << solved << "  Mean: " << (runs > 0 ? total / runs : 0) << " ms" << std::endl;
+		
+		return EXIT_SUCCESS;
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+}
@@ -24,12 +24,16 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <string>
 #include <thread>
 #include <boost/iostreams/stream.hpp>
 
 #include "Coach.h"
+#include "ComException.h"
+#include "TimeoutException.h"
 
 namespace rl
 {
@@ -48,9 +52,14 @@ namespace rl
 			JointPositionSensor(dof),
 			JointTorqueActuator(dof),
 			JointVelocityActuator(dof),
+			ReactiveDevice(),
+			binary(false),
 			i(i),
 			in(),
 			out(),
+			protocol(Protocol::text),
+			request(),
+			response(),
 			socket(Socket::Tcp(Socket::Address::Ipv4(address, port)))
 		{
 		}
@@ -63,14 +72,90 @@ namespace rl
 		Coach::close()
 		{
 			this->socket.close();
+			this->binary = false;
 			this->setConnected(false);
 		}
 		
+		::std::size_t
+		Coach::frame(const ::std::uint8_t* buf, const ::std::size_t& count) const
+		{
+			if (this->binary)
+			{
+				if (count < 4)
+				{
+					return 0;
+				}
+				
+				const ::std::uint8_t* ptr = buf;
+				::std::uint32_t size;
+				this->unserialize(ptr, size);
+				
+				return count < 4 + size ? 0 : 4 + size;
+			}
+			
+			const ::std::uint8_t* newline = static_cast<const ::std::uint8_t*>(::std::memchr(buf, '\n', count));
+			
+			return nullptr == newline ? 0 : newline - buf + 1;
+		}
+		
+		int
+		Coach::getDescriptor() const
+		{
+#ifdef WIN32
+			return -1;
+#else // WIN32
+			return this->socket.getDescriptor();
+#endif // WIN32
+		}
+		
 		::rl::math::Vector
 		Coach::getJointPosition() const
 		{
 			::rl::math::Vector q(this->getDof());
 			
+			if (this->binary)
+			{
+				q.setZero();
+				
+				const ::std::uint8_t* ptr = this->response.data();
+				const ::std::uint8_t* end = this->response.data() + this->response.size();
+				
+				while (end - ptr >= 8)
+				{
+					::std::uint16_t cmd;
+					this->unserialize(ptr, cmd);
+					::std::uint16_t id;
+					this->unserialize(ptr, id);
+					::std::uint32_t count;
+					this->unserialize(ptr, count);
+					
+					if (static_cast<::std::size_t>(end - ptr) < count * sizeof(double))
+					{
+						break;
+					}
+					
+					if (6 == cmd && this->i == id)
+					{
+						for (::std::size_t i = 0; i < count; ++i)
+						{
+							double value;
+							this->unserialize(ptr, value);
+							
+							if (i < this->getDof())
+							{
+								q(i) = value;
+							}
+						}
+						
+						break;
+					}
+					
+					ptr += count * sizeof(double);
+				}
+				
+				return q;
+			}
+			
 			::boost::iostreams::stream<::boost::iostreams::basic_array_source<char>> stream(this->in.data(), this->in.size());
 			
 			::std::size_t cmd;
@@ -86,19 +171,100 @@ namespace rl
 			return q;
 		}
 		
+		const Coach::Protocol&
+		Coach::getProtocol() const
+		{
+			return this->protocol;
+		}
+		
 		void
 		Coach::open()
 		{
 			this->socket.open();
 			this->socket.connect();
+			this->binary = false;
+			
+			if (Protocol::binary == this->protocol)
+			{
+				// servers without binary support either ignore the request or reply with an empty line
+				
+				this->socket.send("7\n", 2);
+				
+				try
+				{
+					this->socket.select(true, false, ::std::chrono::seconds(1));
+					this->in.fill(0);
+					this->socket.recv(this->in.data(), this->in.size());
+					this->binary = 0 == ::std::strncmp(this->in.data(), "7 1", 3);
+				}
+				catch (const TimeoutException&)
+				{
+				}
+				
+				this->in.fill(0);
+				this->request.assign(4, 0);
+			}
+			
 			this->setConnected(true);
 		}
 		
+		void
+		Coach::push(const ::std::uint16_t& cmd, const ::rl::math::Vector& values)
+		{
+			this->serialize(cmd);
+			this->serialize(static_cast<::std::uint16_t>(this->i));
+			this->serialize(static_cast<::std::uint32_t>(this->getDof()));
+			
+			for (::std::size_t i = 0; i < this->getDof(); ++i)
+			{
+				this->serialize(static_cast<double>(values(i)));
+			}
+		}
+		
+		void
+		Coach::receive(const ::std::uint8_t* buf, const ::std::size_t& count)
+		{
+			if (this->binary)
+			{
+				this->response.assign(buf + 4, buf + count);
+			}
+			else if (count > 1)
+			{
+				this->in.fill(0);
+				::std::memcpy(this->in.data(), buf, ::std::min(count, this->in.size() - 1));
+			}
+		}
+		
+		void
+		Coach::recv(void* buf, const ::std::size_t& count)
+		{
+			::std::uint8_t* ptr = static_cast<::std::uint8_t*>(buf);
+			::std::size_t sumbytes = 0;
+			
+			while (sumbytes < count)
+			{
+				::std::size_t numbytes = this->socket.recv(ptr + sumbytes, count - sumbytes);
+				
+				if (0 == numbytes)
+				{
+					throw ComException("Connection closed by server");
+				}
+				
+				sumbytes += numbytes;
+			}
+		}
+		
 		void
 		Coach::setJointPosition(const ::rl::math::Vector& q)
 		{
 			assert(this->getDof() >= q.size());
 			
+			if (this->binary)
+			{
+				this->push(2, q);
+				return;
+			}
+			
 			this->out << 2 << " " << this->i;
 			
 			for (::std::size_t i = 0; i < this->getDof(); ++i)
@@ -114,6 +280,12 @@ namespace rl
 		{
 			assert(this->getDof() >= tau.size());
 			
+			if (this->binary)
+			{
+				this->push(5, tau);
+				return;
+			}
+			
 			this->out << 5 << " " << this->i;
 			
 			for (::std::size_t i = 0; i < this->getDof(); ++i)
@@ -129,6 +301,12 @@ namespace rl
 		{
 			assert(this->getDof() >= qd.size());
 			
+			if (this->binary)
+			{
+				this->push(3, qd);
+				return;
+			}
+			
 			this->out << 3 << " " << this->i;
 			
 			for (::std::size_t i = 0; i < this->getDof(); ++i)
@@ -145,11 +323,47 @@ namespace rl
 			this->setRunning(true);
 		}
 		
+		void
+		Coach::setProtocol(const Protocol& protocol)
+		{
+			this->protocol = protocol;
+		}
+		
 		void
 		Coach::step()
 		{
 			::std::chrono::steady_clock::time_point start = ::std::chrono::steady_clock::now();
 			
+			if (this->binary)
+			{
+				this->serialize(static_cast<::std::uint16_t>(6));
+				this->serialize(static_cast<::std::uint16_t>(this->i));
+				this->serialize(static_cast<::std::uint32_t>(0));
+				
+				::std::uint32_t size = this->request.size() - 4;
+				Endian::hostToLittle(size);
+				::std::memcpy(this->request.data(), &size, sizeof(size));
+				
+				this->socket.send(this->request.data(), this->request.size());
+				this->request.resize(4);
+				
+				if (this->isReactive())
+				{
+					::std::this_thread::sleep_until(start + this->getUpdateRate());
+					return;
+				}
+				
+				::std::uint32_t responseSize;
+				this->recv(&responseSize, sizeof(responseSize));
+				Endian::littleToHost(responseSize);
+				
+				this->response.resize(responseSize);
+				this->recv(this->response.data(), this->response.size());
+				
+				::std::this_thread::sleep_until(start + this->getUpdateRate());
+				return;
+			}
+			
 			this->out << 6 << " " << this->i << ::std::endl;
 			
 			this->socket.send(this->out.str().c_str(), this->out.str().length());
@@ -157,8 +371,11 @@ namespace rl
 			this->out.clear();
 			this->out.str("");
 			
-			this->in.fill(0);
-			this->socket.recv(this->in.data(), this->in.size());
+			if (!this->isReactive())
+			{
+				this->in.fill(0);
+				this->socket.recv(this->in.data(), this->in.size());
+			}
 			
 			::std::this_thread::sleep_until(start + this->getUpdateRate());
 		}
@@ -168,6 +385,7 @@ namespace rl
 		{
 			this->out.clear();
 			this->out.str("");
+			this->request.resize(this->binary ? 4 : 0);
 			this->setRunning(false);
 		}
 	}
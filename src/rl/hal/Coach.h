@@ -28,23 +28,52 @@
 #define RL_HAL_COACH_H
 
 #include <array>
+#include <cstdint>
+#include <cstring>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "CyclicDevice.h"
+#include "Endian.h"
 #include "JointPositionActuator.h"
 #include "JointPositionSensor.h"
 #include "JointTorqueActuator.h"
 #include "JointVelocityActuator.h"
+#include "ReactiveDevice.h"
 #include "Socket.h"
 
 namespace rl
 {
 	namespace hal
 	{
-		class RL_HAL_EXPORT Coach : public CyclicDevice, public JointPositionActuator, public JointPositionSensor, public JointTorqueActuator, public JointVelocityActuator
+		/**
+		 * Client for the rlCoachKin, rlCoachMdl, and rlSimulator servers.
+		 * 
+		 * By default, commands are sent as text lines. With Protocol::binary,
+		 * the client asks the server for binary framing when opening the connection
+		 * and falls back to text if the server does not reply in time.
+		 * 
+		 * In binary mode, all commands of a cycle are batched into one frame,
+		 * consisting of a 32-bit little-endian payload size followed by the messages.
+		 * Each message has a 16-bit command, a 16-bit index, a 32-bit value count,
+		 * and the values as little-endian IEEE 754 doubles.
+		 * The server replies to each frame with exactly one frame.
+		 * 
+		 * When added to a Reactor, step() only sends the commands and the replies
+		 * are received by the reactor.
+		 */
+		class RL_HAL_EXPORT Coach : public CyclicDevice, public JointPositionActuator, public JointPositionSensor, public JointTorqueActuator, public JointVelocityActuator, public ReactiveDevice
 		{
 		public:
+			enum class Protocol
+			{
+				/** Length-prefixed little-endian frames, negotiated on open. */
+				binary,
+				/** Newline-terminated text commands. */
+				text
+			};
+			
 			Coach(
 				const ::std::size_t& dof,
 				const ::std::chrono::nanoseconds& updateRate,
@@ -57,8 +86,12 @@ namespace rl
 			
 			void close();
 			
+			int getDescriptor() const;
+			
 			::rl::math::Vector getJointPosition() const;
 			
+			const Protocol& getProtocol() const;
+			
 			void open();
 			
 			void setJointPosition(const ::rl::math::Vector& q);
@@ -67,6 +100,11 @@ namespace rl
 			
 			void setJointVelocity(const ::rl::math::Vector& qd);
 			
+			/**
+			 * Select the protocol requested on the next call to open().
+			 */
+			void setProtocol(const Protocol& protocol);
+			
 			void start();
 			
 			void step();
@@ -74,14 +112,45 @@ namespace rl
 			void stop();
 			
 		protected:
+			::std::size_t frame(const ::std::uint8_t* buf, const ::std::size_t& count) const;
+			
+			void receive(const ::std::uint8_t* buf, const ::std::size_t& count);
 			
 		private:
+			void push(const ::std::uint16_t& cmd, const ::rl::math::Vector& values);
+			
+			void recv(void* buf, const ::std::size_t& count);
+			
+			template<typename T>
+			void serialize(T t)
+			{
+				Endian::hostToLittle(t);
+				const ::std::uint8_t* ptr = reinterpret_cast<const ::std::uint8_t*>(&t);
+				this->request.insert(this->request.end(), ptr, ptr + sizeof(t));
+			}
+			
+			template<typename T>
+			void unserialize(const ::std::uint8_t*& ptr, T& t) const
+			{
+				::std::memcpy(&t, ptr, sizeof(t));
+				Endian::littleToHost(t);
+				ptr += sizeof(t);
+			}
+			
+			bool binary;
+			
 			::std::size_t i;
 			
 			::std::array<char, 1024> in;
 			
 			::std::stringstream out;
 			
+			Protocol protocol;
+			
+			::std::vector<::std::uint8_t> request;
+			
+			::std::vector<::std::uint8_t> response;
+			
 			Socket socket;
 		};
 	}
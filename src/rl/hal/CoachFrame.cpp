@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cstring>
+
+#include "CoachFrame.h"
+#include "Endian.h"
+
+namespace rl
+{
+	namespace hal
+	{
+		::std::size_t
+		CoachFrame::decode(const ::std::uint8_t* buf, const ::std::size_t& count, ::std::vector<Message>& messages)
+		{
+			messages.clear();
+			
+			if (count < 4)
+			{
+				return 0;
+			}
+			
+			::std::uint32_t size;
+			::std::memcpy(&size, buf, sizeof(size));
+			Endian::littleToHost(size);
+			
+			if (count - 4 < size)
+			{
+				return 0;
+			}
+			
+			const ::std::uint8_t* ptr = buf + 4;
+			const ::std::uint8_t* end = ptr + size;
+			
+			while (end - ptr >= 8)
+			{
+				Message message;
+				::std::memcpy(&message.cmd, ptr, sizeof(message.cmd));
+				Endian::littleToHost(message.cmd);
+				::std::memcpy(&message.i, ptr + 2, sizeof(message.i));
+				Endian::littleToHost(message.i);
+				::std::uint32_t values;
+				::std::memcpy(&values, ptr + 4, sizeof(values));
+				Endian::littleToHost(values);
+				ptr += 8;
+				
+				if (static_cast<::std::size_t>(end - ptr) / sizeof(double) < values)
+				{
+					break;
+				}
+				
+				message.values.resize(values);
+				
+				for (::std::ptrdiff_t i = 0; i < message.values.size(); ++i)
+				{
+					double value;
+					::std::memcpy(&value, ptr, sizeof(value));
+					Endian::littleToHost(value);
+					message.values(i) = value;
+					ptr += sizeof(value);
+				}
+				
+				messages.push_back(message);
+			}
+			
+			return 4 + size;
+		}
+		
+		void
+		CoachFrame::encode(const ::std::vector<Message>& messages, ::std::vector<::std::uint8_t>& buf)
+		{
+			::std::size_t start = buf.size();
+			buf.resize(start + 4);
+			
+			for (::std::size_t i = 0; i < messages.size(); ++i)
+			{
+				::std::size_t offset = buf.size();
+				buf.resize(offset + 8 + messages[i].values.size() * sizeof(double));
+				
+				::std::uint16_t cmd = messages[i].cmd;
+				Endian::hostToLittle(cmd);
+				::std::memcpy(&buf[offset], &cmd, sizeof(cmd));
+				::std::uint16_t index = messages[i].i;
+				Endian::hostToLittle(index);
+				::std::memcpy(&buf[offset + 2], &index, sizeof(index));
+				::std::uint32_t values = messages[i].values.size();
+				Endian::hostToLittle(values);
+				::std::memcpy(&buf[offset + 4], &values, sizeof(values));
+				offset += 8;
+				
+				for (::std::ptrdiff_t j = 0; j < messages[i].values.size(); ++j)
+				{
+					double value = messages[i].values(j);
+					Endian::hostToLittle(value);
+					::std::memcpy(&buf[offset], &value, sizeof(value));
+					offset += sizeof(value);
+				}
+			}
+			
+			::std::uint32_t size = buf.size() - start - 4;
+			Endian::hostToLittle(size);
+			::std::memcpy(&buf[start], &size, sizeof(size));
+		}
+		
+		::std::size_t
+		CoachFrame::process(const ::std::uint8_t* buf, const ::std::size_t& count, const Handler& handler, ::std::vector<::std::uint8_t>& replies)
+		{
+			::std::size_t consumed = 0;
+			::std::vector<Message> messages;
+			::std::vector<Message> answers;
+			
+			for (::std::size_t size = decode(buf, count, messages); size > 0; size = decode(buf + consumed, count - consumed, messages))
+			{
+				answers.clear();
+				
+				for (::std::size_t i = 0; i < messages.size(); ++i)
+				{
+					handler(messages[i], answers);
+				}
+				
+				encode(answers, replies);
+				consumed += size;
+			}
+			
+			return consumed;
+		}
+	}
+}
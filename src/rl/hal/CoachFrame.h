@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_HAL_COACHFRAME_H
+#define RL_HAL_COACHFRAME_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <rl/hal/export.h>
+#include <rl/math/Vector.h>
+
+namespace rl
+{
+	namespace hal
+	{
+		/**
+		 * Binary frames of the protocol between Coach and its servers.
+		 * 
+		 * A frame consists of a 32-bit little-endian payload size followed by
+		 * messages. Each message has a 16-bit command, a 16-bit index, a 32-bit
+		 * value count, and the values as little-endian IEEE 754 doubles.
+		 * A server switches a connection to binary frames after answering the
+		 * text request "7" with "7 1" and replies to each frame with exactly
+		 * one frame.
+		 */
+		class RL_HAL_EXPORT CoachFrame
+		{
+		public:
+			struct Message
+			{
+				::std::uint16_t cmd;
+				
+				::std::uint16_t i;
+				
+				::rl::math::Vector values;
+			};
+			
+			/**
+			 * Handles one message of a request frame and appends any answers to
+			 * the messages of the reply frame.
+			 */
+			typedef ::std::function<void(const Message&, ::std::vector<Message>&)> Handler;
+			
+			/**
+			 * Reads the messages of the frame at the start of a buffer.
+			 * 
+			 * A message with fewer values than announced ends the frame.
+			 * 
+			 * @return Size of the frame including its size field, or zero if the
+			 * buffer does not contain the complete frame
+			 */
+			static ::std::size_t decode(const ::std::uint8_t* buf, const ::std::size_t& count, ::std::vector<Message>& messages);
+			
+			/**
+			 * Appends a frame containing the given messages.
+			 */
+			static void encode(const ::std::vector<Message>& messages, ::std::vector<::std::uint8_t>& buf);
+			
+			/**
+			 * Handles all complete frames at the start of a buffer and appends
+			 * one reply frame for each of them.
+			 * 
+			 * @return Number of bytes consumed, an incomplete frame remains in
+			 * the buffer
+			 */
+			static ::std::size_t process(const ::std::uint8_t* buf, const ::std::size_t& count, const Handler& handler, ::std::vector<::std::uint8_t>& replies);
+			
+		protected:
+			
+		private:
+			
+		};
+	}
+}
+
+#endif // RL_HAL_COACHFRAME_H
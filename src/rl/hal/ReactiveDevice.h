@@ -0,0 +1,113 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_HAL_REACTIVEDEVICE_H
+#define RL_HAL_REACTIVEDEVICE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+#include "Device.h"
+
+namespace rl
+{
+	namespace hal
+	{
+		class Reactor;
+		
+		/**
+		 * Device that can receive its data through a Reactor.
+		 * 
+		 * Instead of blocking in step(), a reactive device splits its input into
+		 * frames and parses each complete frame as soon as it arrives.
+		 * While a device is added to a reactor, step() only sends its commands.
+		 */
+		class RL_HAL_EXPORT ReactiveDevice : public virtual Device
+		{
+		public:
+			ReactiveDevice();
+			
+			virtual ~ReactiveDevice();
+			
+			/**
+			 * File descriptor watched for incoming data.
+			 * 
+			 * @pre open()
+			 */
+			virtual int getDescriptor() const = 0;
+			
+			/**
+			 * Error that made the reactor remove this device.
+			 * 
+			 * Reading from the descriptor, end of file, and exceptions thrown
+			 * while parsing a frame remove the device from its reactor instead of
+			 * stopping the reactor for all devices.
+			 * 
+			 * @return Null if the device was not removed because of an error.
+			 */
+			::std::exception_ptr getException() const;
+			
+			/**
+			 * Arrival time of the last complete frame.
+			 */
+			const ::std::chrono::steady_clock::time_point& getTimestamp() const;
+			
+			/**
+			 * Device input is handled by a reactor.
+			 */
+			bool isReactive() const;
+			
+		protected:
+			/**
+			 * Size of the complete frame at the start of the buffer.
+			 * 
+			 * @return Zero if more data is required.
+			 */
+			virtual ::std::size_t frame(const ::std::uint8_t* buf, const ::std::size_t& count) const = 0;
+			
+			/**
+			 * Parse a complete frame.
+			 */
+			virtual void receive(const ::std::uint8_t* buf, const ::std::size_t& count) = 0;
+			
+		private:
+			friend class Reactor;
+			
+			::std::vector<::std::uint8_t> buffer;
+			
+			::std::exception_ptr exception;
+			
+			::std::atomic<bool> reactive;
+			
+			::std::chrono::steady_clock::time_point timestamp;
+		};
+	}
+}
+
+#endif // RL_HAL_REACTIVEDEVICE_H
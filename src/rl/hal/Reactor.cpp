@@ -0,0 +1,278 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "ComException.h"
+#include "Reactor.h"
+
+namespace rl
+{
+	namespace hal
+	{
+		Reactor::Reactor() :
+			devices(),
+			epfd(::epoll_create1(EPOLL_CLOEXEC)),
+			evfd(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)),
+			mutex(),
+			stopped(false)
+		{
+			if (-1 == this->epfd || -1 == this->evfd)
+			{
+				int errnum = errno;
+				
+				if (-1 != this->epfd)
+				{
+					::close(this->epfd);
+				}
+				
+				if (-1 != this->evfd)
+				{
+					::close(this->evfd);
+				}
+				
+				throw ComException(errnum);
+			}
+			
+			::epoll_event event = {};
+			event.events = EPOLLIN;
+			event.data.ptr = nullptr;
+			
+			if (-1 == ::epoll_ctl(this->epfd, EPOLL_CTL_ADD, this->evfd, &event))
+			{
+				int errnum = errno;
+				::close(this->epfd);
+				::close(this->evfd);
+				throw ComException(errnum);
+			}
+		}
+		
+		Reactor::~Reactor()
+		{
+			for (::std::size_t i = 0; i < this->devices.size(); ++i)
+			{
+				this->devices[i]->reactive = false;
+			}
+			
+			::close(this->evfd);
+			::close(this->epfd);
+		}
+		
+		void
+		Reactor::add(ReactiveDevice* device)
+		{
+			::epoll_event event = {};
+			event.events = EPOLLIN;
+			event.data.ptr = device;
+			
+			if (-1 == ::epoll_ctl(this->epfd, EPOLL_CTL_ADD, device->getDescriptor(), &event))
+			{
+				throw ComException(errno);
+			}
+			
+			::std::lock_guard<::std::mutex> lock(this->mutex);
+			device->buffer.clear();
+			device->exception = nullptr;
+			device->reactive = true;
+			this->devices.push_back(device);
+		}
+		
+		::std::size_t
+		Reactor::dispatch(ReactiveDevice* device, const ::std::chrono::steady_clock::time_point& timestamp)
+		{
+			::std::array<::std::uint8_t, 4096> chunk;
+			::ssize_t numbytes = ::read(device->getDescriptor(), chunk.data(), chunk.size());
+			
+			if (-1 == numbytes)
+			{
+				if (EAGAIN == errno || EINTR == errno || EWOULDBLOCK == errno)
+				{
+					return 0;
+				}
+				
+				throw ComException(errno);
+			}
+			else if (0 == numbytes)
+			{
+				throw ComException("Connection closed by device");
+			}
+			
+			::std::lock_guard<::std::mutex> lock(this->mutex);
+			
+			device->buffer.insert(device->buffer.end(), chunk.data(), chunk.data() + numbytes);
+			
+			::std::size_t frames = 0;
+			::std::size_t offset = 0;
+			
+			for (::std::size_t size = device->frame(device->buffer.data(), device->buffer.size()); size > 0; size = device->frame(device->buffer.data() + offset, device->buffer.size() - offset))
+			{
+				device->timestamp = timestamp;
+				device->receive(device->buffer.data() + offset, size);
+				offset += size;
+				++frames;
+			}
+			
+			device->buffer.erase(device->buffer.begin(), device->buffer.begin() + offset);
+			
+			return frames;
+		}
+		
+		::std::unique_lock<::std::mutex>
+		Reactor::lock()
+		{
+			return ::std::unique_lock<::std::mutex>(this->mutex);
+		}
+		
+		::std::size_t
+		Reactor::poll(const ::std::chrono::nanoseconds& timeout)
+		{
+			int milliseconds = timeout.count() < 0 ? -1 : ::std::chrono::duration_cast<::std::chrono::milliseconds>(timeout + ::std::chrono::milliseconds(1) - ::std::chrono::nanoseconds(1)).count();
+			
+			::std::array<::epoll_event, 16> events;
+			::std::size_t frames = 0;
+			
+			// after the first wakeup, drain everything that is already available
+			
+			for (int numevents = ::epoll_wait(this->epfd, events.data(), events.size(), milliseconds); numevents != 0; numevents = ::epoll_wait(this->epfd, events.data(), events.size(), 0))
+			{
+				if (-1 == numevents)
+				{
+					if (EINTR == errno)
+					{
+						break;
+					}
+					
+					throw ComException(errno);
+				}
+				
+				::std::chrono::steady_clock::time_point timestamp = ::std::chrono::steady_clock::now();
+				
+				for (int i = 0; i < numevents; ++i)
+				{
+					if (nullptr == events[i].data.ptr)
+					{
+						::std::uint64_t value;
+						
+						if (-1 == ::read(this->evfd, &value, sizeof(value)) && EAGAIN != errno)
+						{
+							throw ComException(errno);
+						}
+						
+						return frames;
+					}
+					
+					ReactiveDevice* device = static_cast<ReactiveDevice*>(events[i].data.ptr);
+					
+					try
+					{
+						frames += this->dispatch(device, timestamp);
+					}
+					catch (...)
+					{
+						this->remove(device, ::std::current_exception());
+					}
+				}
+			}
+			
+			return frames;
+		}
+		
+		void
+		Reactor::remove(ReactiveDevice* device)
+		{
+			this->remove(device, nullptr);
+		}
+		
+		void
+		Reactor::remove(ReactiveDevice* device, const ::std::exception_ptr& exception)
+		{
+			::std::lock_guard<::std::mutex> lock(this->mutex);
+			
+			::std::vector<ReactiveDevice*>::iterator i = ::std::find(this->devices.begin(), this->devices.end(), device);
+			
+			if (this->devices.end() == i)
+			{
+				return;
+			}
+			
+			::epoll_ctl(this->epfd, EPOLL_CTL_DEL, device->getDescriptor(), nullptr);
+			device->buffer.clear();
+			device->exception = exception;
+			device->reactive = false;
+			this->devices.erase(i);
+		}
+		
+		void
+		Reactor::run()
+		{
+			while (!this->stopped)
+			{
+				try
+				{
+					this->poll(::std::chrono::nanoseconds(-1));
+				}
+				catch (...)
+				{
+					::std::exception_ptr exception = ::std::current_exception();
+					
+					::std::vector<ReactiveDevice*> devices;
+					
+					{
+						::std::lock_guard<::std::mutex> lock(this->mutex);
+						devices = this->devices;
+					}
+					
+					for (::std::size_t i = 0; i < devices.size(); ++i)
+					{
+						this->remove(devices[i], exception);
+					}
+					
+					break;
+				}
+			}
+			
+			this->stopped = false;
+		}
+		
+		void
+		Reactor::stop()
+		{
+			this->stopped = true;
+			
+			::std::uint64_t value = 1;
+			
+			if (-1 == ::write(this->evfd, &value, sizeof(value)) && EAGAIN != errno)
+			{
+				throw ComException(errno);
+			}
+		}
+	}
+}
@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_HAL_REACTOR_H
+#define RL_HAL_REACTOR_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <vector>
+#include <rl/hal/export.h>
+
+#include "ReactiveDevice.h"
+
+namespace rl
+{
+	namespace hal
+	{
+		/**
+		 * Event-driven input for many devices using epoll.
+		 * 
+		 * A single thread calling poll() or run() receives the data of all added
+		 * devices without blocking on any of them, splits it into frames, stamps
+		 * the arrival time, and hands each complete frame to the device's parser.
+		 * 
+		 * Device states are only updated while the reactor holds its mutex.
+		 * A control loop running in another thread reads a consistent snapshot
+		 * of all devices while holding lock().
+		 * 
+		 * A device that fails to read or parse its input is removed, and the
+		 * error is kept in ReactiveDevice::getException(). The remaining devices
+		 * continue to be served.
+		 * 
+		 * @code
+		 * ::std::thread thread(&::rl::hal::Reactor::run, &reactor);
+		 * 
+		 * while (running)
+		 * {
+		 *     {
+		 *         ::std::unique_lock<::std::mutex> lock = reactor.lock();
+		 *         q = robot.getJointPosition();
+		 *         f = sensor.getForceTorque();
+		 *     }
+		 *     
+		 *     robot.setJointPosition(controller(q, f));
+		 *     robot.step();
+		 * }
+		 * 
+		 * reactor.stop();
+		 * thread.join();
+		 * @endcode
+		 */
+		class RL_HAL_EXPORT Reactor
+		{
+		public:
+			Reactor();
+			
+			virtual ~Reactor();
+			
+			/**
+			 * @pre device->open()
+			 */
+			void add(ReactiveDevice* device);
+			
+			/**
+			 * Keep the reactor from updating device states.
+			 */
+			::std::unique_lock<::std::mutex> lock();
+			
+			/**
+			 * Wait for data, then dispatch all complete frames available.
+			 * 
+			 * @param[in] timeout Maximum time to wait for data, negative values wait indefinitely
+			 * @return Number of dispatched frames
+			 */
+			::std::size_t poll(const ::std::chrono::nanoseconds& timeout);
+			
+			void remove(ReactiveDevice* device);
+			
+			/**
+			 * Call poll() until stop() is called from another thread.
+			 * 
+			 * If waiting for data fails, all devices are removed with this error
+			 * and run() returns.
+			 */
+			void run();
+			
+			void stop();
+			
+		protected:
+			
+		private:
+			::std::size_t dispatch(ReactiveDevice* device, const ::std::chrono::steady_clock::time_point& timestamp);
+			
+			void remove(ReactiveDevice* device, const ::std::exception_ptr& exception);
+			
+			::std::vector<ReactiveDevice*> devices;
+			
+			int epfd;
+			
+			int evfd;
+			
+			::std::mutex mutex;
+			
+			::std::atomic<bool> stopped;
+		};
+	}
+}
+
+#endif // RL_HAL_REACTOR_H
@@ -393,6 +393,14 @@ namespace rl
 			return this->dataBits;
 		}
 		
+#ifndef WIN32
+		int
+		Serial::getDescriptor() const
+		{
+			return this->impl->fd;
+		}
+		
+#endif // WIN32
 		const ::std::string&
 		Serial::getFilename() const
 		{
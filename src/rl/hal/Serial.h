@@ -252,6 +252,10 @@ namespace rl
 			
 			const DataBits& getDataBits() const;
 			
+#ifndef WIN32
+			int getDescriptor() const;
+			
+#endif // WIN32
 			const ::std::string& getFilename() const;
 			
 			const FlowControl& getFlowControl() const;
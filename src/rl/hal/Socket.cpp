@@ -241,6 +241,14 @@ namespace rl
 			return this->address;
 		}
 		
+#ifndef WIN32
+		int
+		Socket::getDescriptor() const
+		{
+			return this->fd;
+		}
+		
+#endif // WIN32
 		int
 		Socket::getOption(const Option& option) const
 		{
@@ -124,6 +124,10 @@ namespace rl
 			
 			const Address& getAddress() const;
 			
+#ifndef WIN32
+			int getDescriptor() const;
+			
+#endif // WIN32
 			int getOption(const Option& option) const;
 			
 			const int& getProtocol() const;
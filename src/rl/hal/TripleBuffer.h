@@ -0,0 +1,172 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_HAL_TRIPLEBUFFER_H
+#define RL_HAL_TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace rl
+{
+	namespace hal
+	{
+		/**
+		 * Lock-free exchange of state snapshots between one writer and one reader thread.
+		 * 
+		 * The writer fills the back buffer and publishes it as a complete, timestamped
+		 * snapshot. The reader always obtains the latest published snapshot. Neither
+		 * side ever blocks or retries, so a high-priority real-time reader cannot be
+		 * delayed by a preempted writer and vice versa. Only a single atomic byte is
+		 * shared, which keeps the exchange usable from Xenomai and RTAI threads.
+		 * 
+		 * Only one thread may call update() or load(). Other threads may read the
+		 * front buffer with getFront() if they synchronize with this thread, as
+		 * update() replaces the front buffer.
+		 */
+		template<typename T>
+		class TripleBuffer
+		{
+		public:
+			TripleBuffer() :
+				back(0),
+				buffers(),
+				front(2),
+				middle(1),
+				timestamps()
+			{
+			}
+			
+			explicit TripleBuffer(const T& value) :
+				back(0),
+				buffers{{value, value, value}},
+				front(2),
+				middle(1),
+				timestamps()
+			{
+			}
+			
+			/**
+			 * Buffer to fill by the writer.
+			 * 
+			 * Contains an older snapshot, fields not written before publish()
+			 * are therefore stale.
+			 */
+			T& getBack()
+			{
+				return this->buffers[this->back];
+			}
+			
+			/**
+			 * Snapshot selected by the last call to update().
+			 */
+			const T& getFront() const
+			{
+				return this->buffers[this->front];
+			}
+			
+			/**
+			 * Arrival time of the snapshot selected by the last call to update().
+			 */
+			const ::std::chrono::steady_clock::time_point& getTimestamp() const
+			{
+				return this->timestamps[this->front];
+			}
+			
+			/**
+			 * Latest published snapshot for the reader.
+			 * 
+			 * The reference remains valid and unchanged until the next call to load() or update().
+			 */
+			const T& load()
+			{
+				this->update();
+				return this->getFront();
+			}
+			
+			/**
+			 * Make the back buffer the latest snapshot.
+			 */
+			void publish(const ::std::chrono::steady_clock::time_point& timestamp = ::std::chrono::steady_clock::now())
+			{
+				this->timestamps[this->back] = timestamp;
+				this->back = this->middle.exchange(this->back | FRESH, ::std::memory_order_acq_rel) & INDEX;
+			}
+			
+			void store(const T& value)
+			{
+				this->getBack() = value;
+				this->publish();
+			}
+			
+			/**
+			 * Make the latest published snapshot the front buffer.
+			 * 
+			 * @return False if no snapshot was published since the last call.
+			 */
+			bool update()
+			{
+				if (!(this->middle.load(::std::memory_order_relaxed) & FRESH))
+				{
+					return false;
+				}
+				
+				this->front = this->middle.exchange(this->front, ::std::memory_order_acq_rel) & INDEX;
+				
+				return true;
+			}
+			
+		protected:
+			
+		private:
+			static_assert(2 == ATOMIC_CHAR_LOCK_FREE, "std::atomic<std::uint8_t> must be lock-free");
+			
+			static constexpr ::std::uint8_t FRESH = 4;
+			
+			static constexpr ::std::uint8_t INDEX = 3;
+			
+			::std::uint8_t back;
+			
+			::std::array<T, 3> buffers;
+			
+			::std::uint8_t front;
+			
+			::std::atomic<::std::uint8_t> middle;
+			
+			::std::array<::std::chrono::steady_clock::time_point, 3> timestamps;
+		};
+		
+		template<typename T>
+		constexpr ::std::uint8_t TripleBuffer<T>::FRESH;
+		
+		template<typename T>
+		constexpr ::std::uint8_t TripleBuffer<T>::INDEX;
+	}
+}
+
+#endif // RL_HAL_TRIPLEBUFFER_H
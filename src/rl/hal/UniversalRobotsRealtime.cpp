@@ -25,6 +25,7 @@
 //
 
 #include <array>
+#include <cstring>
 
 #include "DeviceException.h"
 #include "UniversalRobotsRealtime.h"
@@ -106,6 +107,7 @@ namespace rl
 			JointCurrentSensor(6),
 			JointPositionSensor(6),
 			JointVelocitySensor(6),
+			ReactiveDevice(),
 			in(),
 			socket(Socket::Tcp(Socket::Address::Ipv4(address, 30003)))
 		{
@@ -140,23 +142,27 @@ namespace rl
 		::rl::math::ForceVector
 		UniversalRobotsRealtime::getCartesianForce() const
 		{
+			const Message& in = this->getMessage();
+			
 			::rl::math::ForceVector f;
-			f.force().x() = this->in.tcpForce[0];
-			f.force().y() = this->in.tcpForce[1];
-			f.force().z() = this->in.tcpForce[2];
-			f.moment().x() = this->in.tcpForce[3];
-			f.moment().y() = this->in.tcpForce[4];
-			f.moment().z() = this->in.tcpForce[5];
+			f.force().x() = in.tcpForce[0];
+			f.force().y() = in.tcpForce[1];
+			f.force().z() = in.tcpForce[2];
+			f.moment().x() = in.tcpForce[3];
+			f.moment().y() = in.tcpForce[4];
+			f.moment().z() = in.tcpForce[5];
 			return f;
 		}
 		
 		::rl::math::Transform
 		UniversalRobotsRealtime::getCartesianPosition() const
 		{
+			const Message& in = this->getMessage();
+			
 			::rl::math::Transform x;
 			x.setIdentity();
 			
-			::rl::math::Vector3 orientation(this->in.toolVectorActual[3], this->in.toolVectorActual[4], this->in.toolVectorActual[5]);
+			::rl::math::Vector3 orientation(in.toolVectorActual[3], in.toolVectorActual[4], in.toolVectorActual[5]);
 			::rl::math::Real norm = orientation.norm();
 			
 			if (::std::abs(norm) <= ::std::numeric_limits<::rl::math::Real>::epsilon())
@@ -168,9 +174,9 @@ namespace rl
 				x.linear() = ::rl::math::AngleAxis(norm, orientation.normalized()).matrix();
 			}
 			
-			x.translation().x() = this->in.toolVectorActual[0];
-			x.translation().y() = this->in.toolVectorActual[1];
-			x.translation().z() = this->in.toolVectorActual[2];
+			x.translation().x() = in.toolVectorActual[0];
+			x.translation().y() = in.toolVectorActual[1];
+			x.translation().z() = in.toolVectorActual[2];
 			
 			return x;
 		}
@@ -178,26 +184,32 @@ namespace rl
 		::rl::math::MotionVector
 		UniversalRobotsRealtime::getCartesianVelocity() const
 		{
+			const Message& in = this->getMessage();
+			
 			::rl::math::MotionVector v;
-			v.linear().x() = this->in.tcpSpeedActual[0];
-			v.linear().y() = this->in.tcpSpeedActual[1];
-			v.linear().z() = this->in.tcpSpeedActual[2];
-			v.angular().x() = this->in.tcpSpeedActual[3];
-			v.angular().y() = this->in.tcpSpeedActual[4];
-			v.angular().z() = this->in.tcpSpeedActual[5];
+			v.linear().x() = in.tcpSpeedActual[0];
+			v.linear().y() = in.tcpSpeedActual[1];
+			v.linear().z() = in.tcpSpeedActual[2];
+			v.angular().x() = in.tcpSpeedActual[3];
+			v.angular().y() = in.tcpSpeedActual[4];
+			v.angular().z() = in.tcpSpeedActual[5];
 			return v;
 		}
 		
 		::boost::dynamic_bitset<>
 		UniversalRobotsRealtime::getDigitalInput() const
 		{
-			return ::boost::dynamic_bitset<>(64, this->in.digitalInputBits);
+			const Message& in = this->getMessage();
+			
+			return ::boost::dynamic_bitset<>(64, in.digitalInputBits);
 		}
 		
 		bool
 		UniversalRobotsRealtime::getDigitalInput(const ::std::size_t& i) const
 		{
-			return (this->in.digitalInputBits & (1ULL << i)) ? true : false;
+			const Message& in = this->getMessage();
+			
+			return (in.digitalInputBits & (1ULL << i)) ? true : false;
 		}
 		
 		::std::size_t
@@ -209,13 +221,17 @@ namespace rl
 		::boost::dynamic_bitset<>
 		UniversalRobotsRealtime::getDigitalOutput() const
 		{
-			return ::boost::dynamic_bitset<>(64, this->in.digitalOutputs);
+			const Message& in = this->getMessage();
+			
+			return ::boost::dynamic_bitset<>(64, in.digitalOutputs);
 		}
 		
 		bool
 		UniversalRobotsRealtime::getDigitalOutput(const ::std::size_t& i) const
 		{
-			return (this->in.digitalOutputs & (1ULL << i)) ? true : false;
+			const Message& in = this->getMessage();
+			
+			return (in.digitalOutputs & (1ULL << i)) ? true : false;
 		}
 		
 		::std::size_t
@@ -224,14 +240,58 @@ namespace rl
 			return 64;
 		}
 		
+		::std::size_t
+		UniversalRobotsRealtime::frame(const ::std::uint8_t* buf, const ::std::size_t& count) const
+		{
+			::std::uint32_t messageSize;
+			
+			if (count < sizeof(messageSize))
+			{
+				return 0;
+			}
+			
+			::std::memcpy(&messageSize, buf, sizeof(messageSize));
+			Endian::bigToHost(messageSize);
+			
+			switch (messageSize)
+			{
+			case 756:
+			case 764:
+			case 812:
+			case 1044:
+			case 1060:
+			case 1108:
+			case 1116:
+			case 1140:
+			case 1220:
+				return count < messageSize ? 0 : messageSize;
+				break;
+			default:
+				throw DeviceException("UniversalRobotsRealtime::frame() - Incorrect message size " + ::std::to_string(messageSize));
+				break;
+			}
+		}
+		
+		int
+		UniversalRobotsRealtime::getDescriptor() const
+		{
+#ifdef WIN32
+			return -1;
+#else // WIN32
+			return this->socket.getDescriptor();
+#endif // WIN32
+		}
+		
 		::rl::math::Vector
 		UniversalRobotsRealtime::getJointCurrent() const
 		{
+			const Message& in = this->getMessage();
+			
 			::rl::math::Vector i(this->getDof());
 			
 			for (::std::size_t j = 0; j < 6; ++j)
 			{
-				i(j) = this->in.iActual[j];
+				i(j) = in.iActual[j];
 			}
 			
 			return i;
@@ -240,17 +300,27 @@ namespace rl
 		UniversalRobotsRealtime::JointMode
 		UniversalRobotsRealtime::getJointMode(const ::std::size_t& i) const
 		{
-			return static_cast<JointMode>(static_cast<int>(this->in.jointModes[i]));
+			const Message& in = this->getMessage();
+			
+			return static_cast<JointMode>(static_cast<int>(in.jointModes[i]));
+		}
+		
+		const UniversalRobotsRealtime::Message&
+		UniversalRobotsRealtime::getMessage() const
+		{
+			return this->in.getFront();
 		}
 		
 		::rl::math::Vector
 		UniversalRobotsRealtime::getJointPosition() const
 		{
+			const Message& in = this->getMessage();
+			
 			::rl::math::Vector q(this->getDof());
 			
 			for (::std::size_t i = 0; i < 6; ++i)
 			{
-				q(i) = this->in.qActual[i];
+				q(i) = in.qActual[i];
 			}
 			
 			return q;
@@ -259,11 +329,13 @@ namespace rl
 		::rl::math::Vector
 		UniversalRobotsRealtime::getJointVelocity() const
 		{
+			const Message& in = this->getMessage();
+			
 			::rl::math::Vector qd(this->getDof());
 			
 			for (::std::size_t i = 0; i < 6; ++i)
 			{
-				qd(i) = this->in.qdActual[i];
+				qd(i) = in.qdActual[i];
 			}
 			
 			return qd;
@@ -272,25 +344,33 @@ namespace rl
 		UniversalRobotsRealtime::ProgramState
 		UniversalRobotsRealtime::getProgramState() const
 		{
-			return static_cast<ProgramState>(static_cast<int>(this->in.programState));
+			const Message& in = this->getMessage();
+			
+			return static_cast<ProgramState>(static_cast<int>(in.programState));
 		}
 		
 		UniversalRobotsRealtime::RobotMode
 		UniversalRobotsRealtime::getRobotMode() const
 		{
-			return static_cast<RobotMode>(static_cast<int>(this->in.robotMode));
+			const Message& in = this->getMessage();
+			
+			return static_cast<RobotMode>(static_cast<int>(in.robotMode));
 		}
 		
 		UniversalRobotsRealtime::SafetyMode
 		UniversalRobotsRealtime::getSafetyMode() const
 		{
-			return static_cast<SafetyMode>(static_cast<int>(this->in.safetyMode));
+			const Message& in = this->getMessage();
+			
+			return static_cast<SafetyMode>(static_cast<int>(in.safetyMode));
 		}
 		
 		UniversalRobotsRealtime::SafetyStatus
 		UniversalRobotsRealtime::getSafetyStatus() const
 		{
-			return static_cast<SafetyStatus>(static_cast<int>(this->in.safetyStatus));
+			const Message& in = this->getMessage();
+			
+			return static_cast<SafetyStatus>(static_cast<int>(in.safetyStatus));
 		}
 		
 		void
@@ -302,6 +382,20 @@ namespace rl
 			this->setConnected(true);
 		}
 		
+		void
+		UniversalRobotsRealtime::receive(const ::std::uint8_t* buf, const ::std::size_t& count)
+		{
+			::std::array<::std::uint8_t, 1220> buffer;
+			::std::memcpy(buffer.data(), buf, count);
+			
+			Message& in = this->in.getBack();
+			::std::uint8_t* ptr = buffer.data();
+			in.unserialize(ptr, in.messageSize);
+			in.unserialize(ptr);
+			in.received = this->getTimestamp();
+			this->in.publish(in.received);
+		}
+		
 		void
 		UniversalRobotsRealtime::start()
 		{
@@ -311,17 +405,24 @@ namespace rl
 		void
 		UniversalRobotsRealtime::step()
 		{
+			if (this->isReactive())
+			{
+				this->in.update();
+				return;
+			}
+			
 			::std::array<::std::uint8_t, 1220> buffer;
+			Message& in = this->in.getBack();
 			
-			this->socket.recv(buffer.data(), sizeof(this->in.messageSize));
+			this->socket.recv(buffer.data(), sizeof(in.messageSize));
 #if !defined(__APPLE__) && !defined(__QNX__) && !defined(WIN32) && !defined(__CYGWIN__)
 			this->socket.setOption(Socket::Option::quickack, 1);
 #endif // !__APPLE__ && !__QNX__ && !WIN32 && !__CYGWIN__
 			
 			::std::uint8_t* ptr = buffer.data();
-			this->in.unserialize(ptr, this->in.messageSize);
+			in.unserialize(ptr, in.messageSize);
 			
-			switch (this->in.messageSize)
+			switch (in.messageSize)
 			{
 			case 756:
 			case 764:
@@ -332,14 +433,17 @@ namespace rl
 			case 1116:
 			case 1140:
 			case 1220:
-				this->socket.recv(ptr, this->in.messageSize - sizeof(this->in.messageSize));
+				this->socket.recv(ptr, in.messageSize - sizeof(in.messageSize));
 #if !defined(__APPLE__) && !defined(__QNX__) && !defined(WIN32) && !defined(__CYGWIN__)
 				this->socket.setOption(Socket::Option::quickack, 1);
 #endif // !__APPLE__ && !__QNX__ && !WIN32 && !__CYGWIN__
-				this->in.unserialize(ptr);
+				in.unserialize(ptr);
+				in.received = ::std::chrono::steady_clock::now();
+				this->in.publish(in.received);
+				this->in.update();
 				break;
 			default:
-				throw DeviceException("UniversalRobotsRealtime::step() - Incorrect message size " + ::std::to_string(this->in.messageSize));
+				throw DeviceException("UniversalRobotsRealtime::step() - Incorrect message size " + ::std::to_string(in.messageSize));
 				break;
 			}
 		}
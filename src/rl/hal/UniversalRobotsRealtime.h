@@ -27,6 +27,7 @@
 #ifndef RL_HAL_UNIVERSALROBOTSREALTIME_H
 #define RL_HAL_UNIVERSALROBOTSREALTIME_H
 
+#include <chrono>
 #include <cstdint>
 
 #include "CartesianForceSensor.h"
@@ -39,7 +40,9 @@
 #include "JointCurrentSensor.h"
 #include "JointPositionSensor.h"
 #include "JointVelocitySensor.h"
+#include "ReactiveDevice.h"
 #include "Socket.h"
+#include "TripleBuffer.h"
 
 namespace rl
 {
@@ -51,6 +54,9 @@ namespace rl
 		 * Supports versions 1.5, 1.6, 1.7, 1.8, 3.0, 3.1, 3.2, 3.3, 3.4, 3.5, 3.6,
 		 * 3.7, 3.8, 3.9, 3.10, 3.11, 3.12, 3.13, 3.14, 3.15, 5.0, 5.1, 5.2, 5.3, 5.4,
 		 * 5.5, 5.6, 5.7, 5.8, 5.9, 5.10.
+		 *
+		 * When added to a Reactor, messages are received by the reactor and step()
+		 * does nothing.
 		 */
 		class RL_HAL_EXPORT UniversalRobotsRealtime :
 			public CartesianForceSensor,
@@ -61,7 +67,8 @@ namespace rl
 			public DigitalOutputReader,
 			public JointCurrentSensor,
 			public JointPositionSensor,
-			public JointVelocitySensor
+			public JointVelocitySensor,
+			public ReactiveDevice
 		{
 		public:
 			enum class JointMode
@@ -99,6 +106,112 @@ namespace rl
 			RL_HAL_DEPRECATED static constexpr JointMode JOINT_MODE_RUNNING = JointMode::running;
 			RL_HAL_DEPRECATED static constexpr JointMode JOINT_MODE_IDLE = JointMode::idle;
 			
+			/**
+			 * Complete message of the realtime interface.
+			 */
+			struct Message
+			{
+				void unserialize(::std::uint8_t* ptr);
+				
+				template<typename T>
+				void unserialize(::std::uint8_t*& ptr, T& t)
+				{
+					::std::memcpy(&t, ptr, sizeof(t));
+					Endian::bigToHost(t);
+					ptr += sizeof(t);
+				}
+				
+				template<typename T, ::std::size_t N>
+				void unserialize(::std::uint8_t*& ptr, T (&t)[N])
+				{
+					for (::std::size_t i = 0; i < N; ++i)
+					{
+						this->unserialize(ptr, t[i]);
+					}
+				}
+				
+				::std::uint32_t messageSize;
+				
+				double time;
+				
+				double qTarget[6];
+				
+				double qdTarget[6];
+				
+				double qddTarget[6];
+				
+				double iTarget[6];
+				
+				double mTarget[6];
+				
+				double qActual[6];
+				
+				double qdActual[6];
+				
+				double iActual[6];
+				
+				double iControl[6];
+				
+				double toolVectorActual[6];
+				
+				double tcpSpeedActual[6];
+				
+				double tcpForce[6];
+				
+				double toolVectorTarget[6];
+				
+				double tcpSpeedTarget[6];
+				
+				::std::int64_t digitalInputBits;
+				
+				double motorTemperatures[6];
+				
+				double controllerTimer;
+				
+				double testValue;
+				
+				double robotMode;
+				
+				double jointModes[6];
+				
+				double safetyMode;
+				
+				double toolAccelerometerValues[3];
+				
+				double speedScaling;
+				
+				double linearMomentumNorm;
+				
+				double vMain;
+				
+				double vRobot;
+				
+				double iRobot;
+				
+				double vActual[6];
+				
+				::std::int64_t digitalOutputs;
+				
+				double programState;
+				
+				double elbowPosition[3];
+				
+				double elbowVelocity[3];
+				
+				double safetyStatus;
+				
+				double payloadMass;
+				
+				double payloadCog[3];
+				
+				double payloadInertia[6];
+				
+				/**
+				 * Arrival time of the message.
+				 */
+				::std::chrono::steady_clock::time_point received;
+			};
+			
 			enum class ProgramState
 			{
 				stopping = 0,
@@ -225,10 +338,21 @@ namespace rl
 			
 			::std::size_t getDigitalOutputCount() const;
 			
+			int getDescriptor() const;
+			
 			::rl::math::Vector getJointCurrent() const;
 			
 			JointMode getJointMode(const ::std::size_t& i) const;
 			
+			/**
+			 * Latest complete message, updated once per call to step().
+			 * 
+			 * All getters read from this snapshot, so the values obtained between
+			 * two calls to step() belong to the same message. Call the getters
+			 * from the thread calling step().
+			 */
+			const Message& getMessage() const;
+			
 			::rl::math::Vector getJointPosition() const;
 			
 			::rl::math::Vector getJointVelocity() const;
@@ -250,107 +374,12 @@ namespace rl
 			void stop();
 			
 		protected:
+			::std::size_t frame(const ::std::uint8_t* buf, const ::std::size_t& count) const;
 			
-		private:
-			struct Message
-			{
-				void unserialize(::std::uint8_t* ptr);
-				
-				template<typename T>
-				void unserialize(::std::uint8_t*& ptr, T& t)
-				{
-					::std::memcpy(&t, ptr, sizeof(t));
-					Endian::bigToHost(t);
-					ptr += sizeof(t);
-				}
-				
-				template<typename T, ::std::size_t N>
-				void unserialize(::std::uint8_t*& ptr, T (&t)[N])
-				{
-					for (::std::size_t i = 0; i < N; ++i)
-					{
-						this->unserialize(ptr, t[i]);
-					}
-				}
-				
-				::std::uint32_t messageSize;
-				
-				double time;
-				
-				double qTarget[6];
-				
-				double qdTarget[6];
-				
-				double qddTarget[6];
-				
-				double iTarget[6];
-				
-				double mTarget[6];
-				
-				double qActual[6];
-				
-				double qdActual[6];
-				
-				double iActual[6];
-				
-				double iControl[6];
-				
-				double toolVectorActual[6];
-				
-				double tcpSpeedActual[6];
-				
-				double tcpForce[6];
-				
-				double toolVectorTarget[6];
-				
-				double tcpSpeedTarget[6];
-				
-				::std::int64_t digitalInputBits;
-				
-				double motorTemperatures[6];
-				
-				double controllerTimer;
-				
-				double testValue;
-				
-				double robotMode;
-				
-				double jointModes[6];
-				
-				double safetyMode;
-				
-				double toolAccelerometerValues[3];
-				
-				double speedScaling;
-				
-				double linearMomentumNorm;
-				
-				double vMain;
-				
-				double vRobot;
-				
-				double iRobot;
-				
-				double vActual[6];
-				
-				::std::int64_t digitalOutputs;
-				
-				double programState;
-				
-				double elbowPosition[3];
-				
-				double elbowVelocity[3];
-				
-				double safetyStatus;
-				
-				double payloadMass;
-				
-				double payloadCog[3];
-				
-				double payloadInertia[6];
-			};
+			void receive(const ::std::uint8_t* buf, const ::std::size_t& count);
 			
-			Message in;
+		private:
+			TripleBuffer<Message> in;
 			
 			Socket socket;
 		};
@@ -24,7 +24,9 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <iostream>
 #include <rl/math/Constants.h>
 #include <rl/math/Units.h>
@@ -112,12 +114,27 @@ namespace rl
 			JointPositionSensor(6),
 			JointVelocityActuator(6),
 			JointVelocitySensor(6),
+			holdPosition(&Output::targetQ),
+			holdVelocity(&Output::targetQd),
 			input(),
+			inputs(),
 			output(),
+			outputs(),
+			recipe(),
+			recipeId(0),
+			recipes(),
 			socket2(Socket::Tcp(Socket::Address::Ipv4(address, 30002))),
 			socket4(Socket::Tcp(Socket::Address::Ipv4(address, 30004))),
 			version()
 		{
+			this->inputs.insert(this->inputs.end(), getAnalogOutputInputs().begin(), getAnalogOutputInputs().end());
+			this->inputs.insert(this->inputs.end(), getBitRegisterInputs().begin(), getBitRegisterInputs().end());
+			this->inputs.insert(this->inputs.end(), getDigitalOutputInputs().begin(), getDigitalOutputInputs().end());
+			
+			for (::std::size_t i = 0; i < getOutputVariables().size(); ++i)
+			{
+				this->outputs.push_back(getOutputVariables()[i].name);
+			}
 		}
 		
 		UniversalRobotsRtde::~UniversalRobotsRtde()
@@ -144,25 +161,40 @@ namespace rl
 		::rl::math::Real
 		UniversalRobotsRtde::getAnalogInput(const ::std::size_t& i) const
 		{
+			const Output& output = this->getOutput();
+			
 			switch (i)
 			{
 			case 0:
-				return this->output.standardAnalogInput0;
+				return output.standardAnalogInput0;
 				break;
 			case 1:
-				return this->output.standardAnalogInput1;
+				return output.standardAnalogInput1;
 				break;
 			case 2:
-				return this->output.toolAnalogInput0;
+				return output.toolAnalogInput0;
 				break;
 			case 3:
-				return this->output.toolAnalogInput1;
+				return output.toolAnalogInput1;
 				break;
 			default:
 				return ::std::numeric_limits<::rl::math::Real>::signaling_NaN();
 			}
 		}
 		
+		const ::std::vector<::std::string>&
+		UniversalRobotsRtde::getAnalogOutputInputs()
+		{
+			static const ::std::vector<::std::string> inputs = {
+				"standard_analog_output_mask",
+				"standard_analog_output_type",
+				"standard_analog_output_0",
+				"standard_analog_output_1"
+			};
+			
+			return inputs;
+		}
+		
 		::std::size_t
 		UniversalRobotsRtde::getAnalogInputCount() const
 		{
@@ -172,19 +204,21 @@ namespace rl
 		::rl::math::Real
 		UniversalRobotsRtde::getAnalogInputMaximum(const ::std::size_t& i) const
 		{
+			const Output& output = this->getOutput();
+			
 			switch (i)
 			{
 			case 0:
-				return 0 == (this->output.analogIoTypes & 1) ? 20 * ::rl::math::constants::milli2unit : 10;
+				return 0 == (output.analogIoTypes & 1) ? 20 * ::rl::math::constants::milli2unit : 10;
 				break;
 			case 1:
-				return 0 == (this->output.analogIoTypes & 2) ? 20 * ::rl::math::constants::milli2unit : 10;
+				return 0 == (output.analogIoTypes & 2) ? 20 * ::rl::math::constants::milli2unit : 10;
 				break;
 			case 2:
-				return 0 == (this->output.toolAnalogInputTypes & 1) ? 1 : 24;
+				return 0 == (output.toolAnalogInputTypes & 1) ? 1 : 24;
 				break;
 			case 3:
-				return 0 == (this->output.toolAnalogInputTypes & 2) ? 1 : 24;
+				return 0 == (output.toolAnalogInputTypes & 2) ? 1 : 24;
 				break;
 			default:
 				return ::std::numeric_limits<::rl::math::Real>::signaling_NaN();
@@ -214,19 +248,21 @@ namespace rl
 		::rl::math::Units
 		UniversalRobotsRtde::getAnalogInputUnit(const ::std::size_t& i) const
 		{
+			const Output& output = this->getOutput();
+			
 			switch (i)
 			{
 			case 0:
-				return 0 == (this->output.analogIoTypes & 1) ? ::rl::math::Units::ampere : ::rl::math::Units::volt;
+				return 0 == (output.analogIoTypes & 1) ? ::rl::math::Units::ampere : ::rl::math::Units::volt;
 				break;
 			case 1:
-				return 0 == (this->output.analogIoTypes & 2) ? ::rl::math::Units::ampere : ::rl::math::Units::volt;
+				return 0 == (output.analogIoTypes & 2) ? ::rl::math::Units::ampere : ::rl::math::Units::volt;
 				break;
 			case 2:
-				return 0 == (this->output.toolAnalogInputTypes & 1) ? ::rl::math::Units::ampere : ::rl::math::Units::volt;
+				return 0 == (output.toolAnalogInputTypes & 1) ? ::rl::math::Units::ampere : ::rl::math::Units::volt;
 				break;
 			case 3:
-				return 0 == (this->output.toolAnalogInputTypes & 2) ? ::rl::math::Units::ampere : ::rl::math::Units::volt;
+				return 0 == (output.toolAnalogInputTypes & 2) ? ::rl::math::Units::ampere : ::rl::math::Units::volt;
 				break;
 			default:
 				return ::rl::math::Units::none;
@@ -237,19 +273,21 @@ namespace rl
 		::rl::math::Real
 		UniversalRobotsRtde::getAnalogOutput(const ::std::size_t& i) const
 		{
+			const Output& output = this->getOutput();
+			
 			switch (i)
 			{
 			case 0:
-				return this->output.standardAnalogOutput0;
+				return output.standardAnalogOutput0;
 				break;
 			case 1:
-				return this->output.standardAnalogOutput1;
+				return output.standardAnalogOutput1;
 				break;
 			case 2:
-				return this->output.toolOutputVoltage;
+				return output.toolOutputVoltage;
 				break;
 			case 3:
-				return this->output.toolOutputCurrent;
+				return output.toolOutputCurrent;
 				break;
 			default:
 				return ::std::numeric_limits<::rl::math::Real>::signaling_NaN();
@@ -265,13 +303,15 @@ namespace rl
 		::rl::math::Real
 		UniversalRobotsRtde::getAnalogOutputMaximum(const ::std::size_t& i) const
 		{
+			const Output& output = this->getOutput();
+			
 			switch (i)
 			{
 			case 0:
-				return 0 == (this->output.analogIoTypes & 4) ? 20 * ::rl::math::constants::milli2unit : 10;
+				return 0 == (output.analogIoTypes & 4) ? 20 * ::rl::math::constants::milli2unit : 10;
 				break;
 			case 1:
-				return 0 == (this->output.analogIoTypes & 8) ? 20 * ::rl::math::constants::milli2unit : 10;
+				return 0 == (output.analogIoTypes & 8) ? 20 * ::rl::math::constants::milli2unit : 10;
 				break;
 			case 2:
 				return 24;
@@ -307,13 +347,15 @@ namespace rl
 		::rl::math::Units
 		UniversalRobotsRtde::getAnalogOutputUnit(const ::std::size_t& i) const
 		{
+			const Output& output = this->getOutput();
+			
 			switch (i)
 			{
 			case 0:
-				return 0 == (this->output.analogIoTypes & 4) ? ::rl::math::Units::ampere : ::rl::math::Units::volt;
+				return 0 == (output.analogIoTypes & 4) ? ::rl::math::Units::ampere : ::rl::math::Units::volt;
 				break;
 			case 1:
-				return 0 == (this->output.analogIoTypes & 8) ? ::rl::math::Units::ampere : ::rl::math::Units::volt;
+				return 0 == (output.analogIoTypes & 8) ? ::rl::math::Units::ampere : ::rl::math::Units::volt;
 				break;
 			case 2:
 				return ::rl::math::Units::volt;
@@ -327,25 +369,40 @@ namespace rl
 			}
 		}
 		
+		const ::std::vector<::std::string>&
+		UniversalRobotsRtde::getBitRegisterInputs()
+		{
+			static const ::std::vector<::std::string> inputs = {
+				"input_bit_registers0_to_31",
+				"input_bit_registers32_to_63"
+			};
+			
+			return inputs;
+		}
+		
 		::rl::math::ForceVector
 		UniversalRobotsRtde::getCartesianForce() const
 		{
+			const Output& output = this->getOutput();
+			
 			::rl::math::ForceVector f;
-			f.force().x() = this->output.actualTcpForce[0];
-			f.force().y() = this->output.actualTcpForce[1];
-			f.force().z() = this->output.actualTcpForce[2];
-			f.moment().x() = this->output.actualTcpForce[3];
-			f.moment().y() = this->output.actualTcpForce[4];
-			f.moment().z() = this->output.actualTcpForce[5];
+			f.force().x() = output.actualTcpForce[0];
+			f.force().y() = output.actualTcpForce[1];
+			f.force().z() = output.actualTcpForce[2];
+			f.moment().x() = output.actualTcpForce[3];
+			f.moment().y() = output.actualTcpForce[4];
+			f.moment().z() = output.actualTcpForce[5];
 			return f;
 		}
 		
 		::rl::math::Transform
 		UniversalRobotsRtde::getCartesianPosition() const
 		{
+			const Output& output = this->getOutput();
+			
 			::rl::math::Transform x = ::rl::math::Transform::Identity();
 			
-			::rl::math::Vector3 orientation(this->output.actualTcpPose[3], this->output.actualTcpPose[4], this->output.actualTcpPose[5]);
+			::rl::math::Vector3 orientation(output.actualTcpPose[3], output.actualTcpPose[4], output.actualTcpPose[5]);
 			::rl::math::Real norm = orientation.norm();
 			
 			if (::std::abs(norm) <= ::std::numeric_limits<::rl::math::Real>::epsilon())
@@ -357,9 +414,9 @@ namespace rl
 				x.linear() = ::rl::math::AngleAxis(norm, orientation.normalized()).matrix();
 			}
 			
-			x.translation().x() = this->output.actualTcpPose[0];
-			x.translation().y() = this->output.actualTcpPose[1];
-			x.translation().z() = this->output.actualTcpPose[2];
+			x.translation().x() = output.actualTcpPose[0];
+			x.translation().y() = output.actualTcpPose[1];
+			x.translation().z() = output.actualTcpPose[2];
 			
 			return x;
 		}
@@ -367,9 +424,11 @@ namespace rl
 		::rl::math::Transform
 		UniversalRobotsRtde::getCartesianPositionTarget() const
 		{
+			const Output& output = this->getOutput();
+			
 			::rl::math::Transform x = ::rl::math::Transform::Identity();
 			
-			::rl::math::Vector3 orientation(this->output.targetTcpPose[3], this->output.targetTcpPose[4], this->output.targetTcpPose[5]);
+			::rl::math::Vector3 orientation(output.targetTcpPose[3], output.targetTcpPose[4], output.targetTcpPose[5]);
 			::rl::math::Real norm = orientation.norm();
 			
 			if (::std::abs(norm) <= ::std::numeric_limits<::rl::math::Real>::epsilon())
@@ -381,9 +440,9 @@ namespace rl
 				x.linear() = ::rl::math::AngleAxis(norm, orientation.normalized()).matrix();
 			}
 			
-			x.translation().x() = this->output.targetTcpPose[0];
-			x.translation().y() = this->output.targetTcpPose[1];
-			x.translation().z() = this->output.targetTcpPose[2];
+			x.translation().x() = output.targetTcpPose[0];
+			x.translation().y() = output.targetTcpPose[1];
+			x.translation().z() = output.targetTcpPose[2];
 			
 			return x;
 		}
@@ -391,39 +450,47 @@ namespace rl
 		::rl::math::MotionVector
 		UniversalRobotsRtde::getCartesianVelocity() const
 		{
+			const Output& output = this->getOutput();
+			
 			::rl::math::MotionVector v;
-			v.linear().x() = this->output.actualTcpSpeed[0];
-			v.linear().y() = this->output.actualTcpSpeed[1];
-			v.linear().z() = this->output.actualTcpSpeed[2];
-			v.angular().x() = this->output.actualTcpSpeed[3];
-			v.angular().y() = this->output.actualTcpSpeed[4];
-			v.angular().z() = this->output.actualTcpSpeed[5];
+			v.linear().x() = output.actualTcpSpeed[0];
+			v.linear().y() = output.actualTcpSpeed[1];
+			v.linear().z() = output.actualTcpSpeed[2];
+			v.angular().x() = output.actualTcpSpeed[3];
+			v.angular().y() = output.actualTcpSpeed[4];
+			v.angular().z() = output.actualTcpSpeed[5];
 			return v;
 		}
 		
 		::rl::math::MotionVector
 		UniversalRobotsRtde::getCartesianVelocityTarget() const
 		{
+			const Output& output = this->getOutput();
+			
 			::rl::math::MotionVector v;
-			v.linear().x() = this->output.targetTcpSpeed[0];
-			v.linear().y() = this->output.targetTcpSpeed[1];
-			v.linear().z() = this->output.targetTcpSpeed[2];
-			v.angular().x() = this->output.targetTcpSpeed[3];
-			v.angular().y() = this->output.targetTcpSpeed[4];
-			v.angular().z() = this->output.targetTcpSpeed[5];
+			v.linear().x() = output.targetTcpSpeed[0];
+			v.linear().y() = output.targetTcpSpeed[1];
+			v.linear().z() = output.targetTcpSpeed[2];
+			v.angular().x() = output.targetTcpSpeed[3];
+			v.angular().y() = output.targetTcpSpeed[4];
+			v.angular().z() = output.targetTcpSpeed[5];
 			return v;
 		}
 		
 		::boost::dynamic_bitset<>
 		UniversalRobotsRtde::getDigitalInput() const
 		{
-			return ::boost::dynamic_bitset<>(18, this->output.actualDigitalInputBits);
+			const Output& output = this->getOutput();
+			
+			return ::boost::dynamic_bitset<>(18, output.actualDigitalInputBits);
 		}
 		
 		bool
 		UniversalRobotsRtde::getDigitalInput(const ::std::size_t& i) const
 		{
-			return (this->output.actualDigitalInputBits & (1ULL << i)) ? true : false;
+			const Output& output = this->getOutput();
+			
+			return (output.actualDigitalInputBits & (1ULL << i)) ? true : false;
 		}
 		
 		::std::size_t
@@ -435,13 +502,17 @@ namespace rl
 		::boost::dynamic_bitset<>
 		UniversalRobotsRtde::getDigitalOutput() const
 		{
-			return ::boost::dynamic_bitset<>(18, this->output.actualDigitalOutputBits);
+			const Output& output = this->getOutput();
+			
+			return ::boost::dynamic_bitset<>(18, output.actualDigitalOutputBits);
 		}
 		
 		bool
 		UniversalRobotsRtde::getDigitalOutput(const ::std::size_t& i) const
 		{
-			return (this->output.actualDigitalOutputBits & (1ULL << i)) ? true : false;
+			const Output& output = this->getOutput();
+			
+			return (output.actualDigitalOutputBits & (1ULL << i)) ? true : false;
 		}
 		
 		::std::size_t
@@ -450,14 +521,35 @@ namespace rl
 			return 18;
 		}
 		
+		const ::std::vector<::std::string>&
+		UniversalRobotsRtde::getDigitalOutputInputs()
+		{
+			static const ::std::vector<::std::string> inputs = {
+				"standard_digital_output_mask",
+				"configurable_digital_output_mask",
+				"standard_digital_output",
+				"configurable_digital_output"
+			};
+			
+			return inputs;
+		}
+		
+		const ::std::vector<::std::string>&
+		UniversalRobotsRtde::getInputs() const
+		{
+			return this->inputs;
+		}
+		
 		::rl::math::Vector
 		UniversalRobotsRtde::getJointCurrent() const
 		{
+			const Output& output = this->getOutput();
+			
 			::rl::math::Vector i(this->getDof());
 			
 			for (::std::ptrdiff_t j = 0; j < i.size(); ++j)
 			{
-				i(j) = this->output.targetCurrent[j];
+				i(j) = output.targetCurrent[j];
 			}
 			
 			return i;
@@ -466,18 +558,22 @@ namespace rl
 		UniversalRobotsRtde::JointMode
 		UniversalRobotsRtde::getJointMode(const ::std::size_t& i) const
 		{
+			const Output& output = this->getOutput();
+			
 			assert(i < 6);
-			return static_cast<JointMode>(this->output.jointMode[i]);
+			return static_cast<JointMode>(output.jointMode[i]);
 		}
 		
 		::rl::math::Vector
 		UniversalRobotsRtde::getJointPosition() const
 		{
+			const Output& output = this->getOutput();
+			
 			::rl::math::Vector q(this->getDof());
 			
 			for (::std::ptrdiff_t i = 0; i < q.size(); ++i)
 			{
-				q(i) = this->output.targetQ[i];
+				q(i) = output.targetQ[i];
 			}
 			
 			return q;
@@ -486,11 +582,13 @@ namespace rl
 		::rl::math::Vector
 		UniversalRobotsRtde::getJointTemperature() const
 		{
+			const Output& output = this->getOutput();
+			
 			::rl::math::Vector temperature(this->getDof());
 			
 			for (::std::ptrdiff_t i = 0; i < temperature.size(); ++i)
 			{
-				temperature(i) = this->output.jointTemperatures[i];
+				temperature(i) = output.jointTemperatures[i];
 			}
 			
 			return temperature;
@@ -499,44 +597,141 @@ namespace rl
 		::rl::math::Vector
 		UniversalRobotsRtde::getJointVelocity() const
 		{
+			const Output& output = this->getOutput();
+			
 			::rl::math::Vector qd(this->getDof());
 			
 			for (::std::ptrdiff_t i = 0; i < qd.size(); ++i)
 			{
-				qd(i) = this->output.targetQd[i];
+				qd(i) = output.targetQd[i];
 			}
 			
 			return qd;
 		}
 		
+		const UniversalRobotsRtde::Output&
+		UniversalRobotsRtde::getOutput() const
+		{
+			return this->output.getFront();
+		}
+		
+		const ::std::vector<::std::string>&
+		UniversalRobotsRtde::getOutputs() const
+		{
+			return this->outputs;
+		}
+		
+		const ::std::vector<UniversalRobotsRtde::Variable>&
+		UniversalRobotsRtde::getOutputVariables()
+		{
+			static const ::std::vector<Variable> variables = []() {
+				::std::vector<Variable> variables = {
+					{"timestamp", offsetof(Output, timestamp), Type::float64, 1},
+					{"target_q", offsetof(Output, targetQ), Type::float64, 6},
+					{"target_qd", offsetof(Output, targetQd), Type::float64, 6},
+					{"target_qdd", offsetof(Output, targetQdd), Type::float64, 6},
+					{"target_current", offsetof(Output, targetCurrent), Type::float64, 6},
+					{"target_moment", offsetof(Output, targetMoment), Type::float64, 6},
+					{"actual_q", offsetof(Output, actualQ), Type::float64, 6},
+					{"actual_qd", offsetof(Output, actualQd), Type::float64, 6},
+					{"actual_current", offsetof(Output, actualCurrent), Type::float64, 6},
+					{"actual_TCP_pose", offsetof(Output, actualTcpPose), Type::float64, 6},
+					{"actual_TCP_speed", offsetof(Output, actualTcpSpeed), Type::float64, 6},
+					{"actual_TCP_force", offsetof(Output, actualTcpForce), Type::float64, 6},
+					{"target_TCP_pose", offsetof(Output, targetTcpPose), Type::float64, 6},
+					{"target_TCP_speed", offsetof(Output, targetTcpSpeed), Type::float64, 6},
+					{"actual_digital_input_bits", offsetof(Output, actualDigitalInputBits), Type::uint64, 1},
+					{"joint_temperatures", offsetof(Output, jointTemperatures), Type::float64, 6},
+					{"robot_mode", offsetof(Output, robotMode), Type::int32, 1},
+					{"joint_mode", offsetof(Output, jointMode), Type::int32, 6},
+					{"safety_mode", offsetof(Output, safetyMode), Type::int32, 1},
+					{"speed_scaling", offsetof(Output, speedScaling), Type::float64, 1},
+					{"actual_digital_output_bits", offsetof(Output, actualDigitalOutputBits), Type::uint64, 1},
+					{"runtime_state", offsetof(Output, runtimeState), Type::uint32, 1},
+					{"robot_status_bits", offsetof(Output, robotStatusBits), Type::uint32, 1},
+					{"safety_status_bits", offsetof(Output, safetyStatusBits), Type::uint32, 1},
+					{"analog_io_types", offsetof(Output, analogIoTypes), Type::uint32, 1},
+					{"standard_analog_input0", offsetof(Output, standardAnalogInput0), Type::float64, 1},
+					{"standard_analog_input1", offsetof(Output, standardAnalogInput1), Type::float64, 1},
+					{"standard_analog_output0", offsetof(Output, standardAnalogOutput0), Type::float64, 1},
+					{"standard_analog_output1", offsetof(Output, standardAnalogOutput1), Type::float64, 1},
+					{"tool_analog_input_types", offsetof(Output, toolAnalogInputTypes), Type::uint32, 1},
+					{"tool_analog_input0", offsetof(Output, toolAnalogInput0), Type::float64, 1},
+					{"tool_analog_input1", offsetof(Output, toolAnalogInput1), Type::float64, 1},
+					{"tool_output_voltage", offsetof(Output, toolOutputVoltage), Type::int32, 1},
+					{"tool_output_current", offsetof(Output, toolOutputCurrent), Type::float64, 1},
+					{"output_bit_registers0_to_31", offsetof(Output, outputBitRegisters0), Type::uint32, 1},
+					{"output_bit_registers32_to_63", offsetof(Output, outputBitRegisters1), Type::uint32, 1}
+				};
+				
+				for (::std::size_t i = 0; i < 24; ++i)
+				{
+					variables.push_back({"output_int_register_" + ::std::to_string(i), offsetof(Output, outputIntRegister) + i * sizeof(::std::int32_t), Type::int32, 1});
+				}
+				
+				for (::std::size_t i = 0; i < 24; ++i)
+				{
+					variables.push_back({"output_double_register_" + ::std::to_string(i), offsetof(Output, outputDoubleRegister) + i * sizeof(double), Type::float64, 1});
+				}
+				
+				return variables;
+			}();
+			
+			return variables;
+		}
+		
 		UniversalRobotsRtde::RobotMode
 		UniversalRobotsRtde::getRobotMode() const
 		{
-			return static_cast<RobotMode>(this->output.robotMode);
+			const Output& output = this->getOutput();
+			
+			return static_cast<RobotMode>(output.robotMode);
 		}
 		
 		::std::uint32_t
 		UniversalRobotsRtde::getRobotStatusBits() const
 		{
-			return this->output.robotStatusBits;
+			const Output& output = this->getOutput();
+			
+			return output.robotStatusBits;
 		}
 		
 		UniversalRobotsRtde::RuntimeState
 		UniversalRobotsRtde::getRuntimeState() const
 		{
-			return static_cast<RuntimeState>(this->output.runtimeState);
+			const Output& output = this->getOutput();
+			
+			return static_cast<RuntimeState>(output.runtimeState);
 		}
 		
 		UniversalRobotsRtde::SafetyMode
 		UniversalRobotsRtde::getSafetyMode() const
 		{
-			return static_cast<SafetyMode>(this->output.safetyMode);
+			const Output& output = this->getOutput();
+			
+			return static_cast<SafetyMode>(output.safetyMode);
 		}
 		
 		::std::uint32_t
 		UniversalRobotsRtde::getSafetyStatusBits() const
 		{
-			return this->output.safetyStatusBits;
+			const Output& output = this->getOutput();
+			
+			return output.safetyStatusBits;
+		}
+		
+		bool
+		UniversalRobotsRtde::hasInputs(const ::std::vector<::std::string>& group) const
+		{
+			for (::std::size_t i = 0; i < group.size(); ++i)
+			{
+				if (this->inputs.end() != ::std::find(this->inputs.begin(), this->inputs.end(), group[i]))
+				{
+					return true;
+				}
+			}
+			
+			return false;
 		}
 		
 		void
@@ -556,104 +751,76 @@ namespace rl
 			this->send(Command::getUrcontrolVersion);
 			this->recv();
 			
-			static constexpr const char* outputsArray[] = {
-				"timestamp",
-				"target_q",
-				"target_qd",
-				"target_qdd",
-				"target_current",
-				"target_moment",
-				"actual_q",
-				"actual_qd",
-				"actual_current",
-				"actual_TCP_pose",
-				"actual_TCP_speed",
-				"actual_TCP_force",
-				"target_TCP_pose",
-				"target_TCP_speed",
-				"actual_digital_input_bits",
-				"joint_temperatures",
+			::std::vector<::std::string> outputs = this->outputs;
+			
+			static constexpr const char* requiredArray[] = {
 				"robot_mode",
-				"joint_mode",
-				"safety_mode",
-				"speed_scaling",
-				"actual_digital_output_bits",
 				"runtime_state",
-				"robot_status_bits",
-				"safety_status_bits",
-				"analog_io_types",
-				"standard_analog_input0",
-				"standard_analog_input1",
-				"standard_analog_output0",
-				"standard_analog_output1",
-				"tool_analog_input_types",
-				"tool_analog_input0",
-				"tool_analog_input1",
-				"tool_output_voltage",
-				"tool_output_current",
-				"output_bit_registers0_to_31",
-				"output_bit_registers32_to_63",
-				"output_int_register_0",
-				"output_int_register_1",
-				"output_int_register_2",
-				"output_int_register_3",
-				"output_int_register_4",
-				"output_int_register_5",
-				"output_int_register_6",
-				"output_int_register_7",
-				"output_int_register_8",
-				"output_int_register_9",
-				"output_int_register_10",
-				"output_int_register_11",
-				"output_int_register_12",
-				"output_int_register_13",
-				"output_int_register_14",
-				"output_int_register_15",
-				"output_int_register_16",
-				"output_int_register_17",
-				"output_int_register_18",
-				"output_int_register_19",
-				"output_int_register_20",
-				"output_int_register_21",
-				"output_int_register_22",
-				"output_int_register_23",
-				"output_double_register_0",
-				"output_double_register_1",
-				"output_double_register_2",
-				"output_double_register_3",
-				"output_double_register_4",
-				"output_double_register_5",
-				"output_double_register_6",
-				"output_double_register_7",
-				"output_double_register_8",
-				"output_double_register_9",
-				"output_double_register_10",
-				"output_double_register_11",
-				"output_double_register_12",
-				"output_double_register_13",
-				"output_double_register_14",
-				"output_double_register_15",
-				"output_double_register_16",
-				"output_double_register_17",
-				"output_double_register_18",
-				"output_double_register_19",
-				"output_double_register_20",
-				"output_double_register_21",
-				"output_double_register_22",
-				"output_double_register_23"
+				"safety_mode"
 			};
-			static const ::std::vector<::std::string> outputs(::std::begin(outputsArray), ::std::end(outputsArray));
+			
+			for (::std::size_t i = 0; i < ::std::extent<decltype(requiredArray)>::value; ++i)
+			{
+				if (outputs.end() == ::std::find(outputs.begin(), outputs.end(), requiredArray[i]))
+				{
+					outputs.push_back(requiredArray[i]);
+				}
+			}
+			
+			if (outputs.end() != ::std::find(outputs.begin(), outputs.end(), "target_q"))
+			{
+				this->holdPosition = &Output::targetQ;
+			}
+			else if (outputs.end() != ::std::find(outputs.begin(), outputs.end(), "actual_q"))
+			{
+				this->holdPosition = &Output::actualQ;
+			}
+			else
+			{
+				outputs.push_back("target_q");
+				this->holdPosition = &Output::targetQ;
+			}
+			
+			if (outputs.end() != ::std::find(outputs.begin(), outputs.end(), "target_qd"))
+			{
+				this->holdVelocity = &Output::targetQd;
+			}
+			else if (outputs.end() != ::std::find(outputs.begin(), outputs.end(), "actual_qd"))
+			{
+				this->holdVelocity = &Output::actualQd;
+			}
+			else
+			{
+				this->holdVelocity = nullptr;
+			}
+			
+			this->recipe.clear();
+			
+			for (::std::size_t i = 0; i < outputs.size(); ++i)
+			{
+				for (::std::size_t j = 0; j < getOutputVariables().size(); ++j)
+				{
+					if (outputs[i] == getOutputVariables()[j].name)
+					{
+						this->recipe.push_back(&getOutputVariables()[j]);
+						break;
+					}
+				}
+			}
+			
 			this->send(Command::controlPackageSetupOutputs, outputs);
 			this->recv();
 			
-			static constexpr const char* inputs1Array[] = {
+			this->recipes = Recipes();
+			
+			static const ::std::vector<::std::string> integerRegister = {
 				"input_int_register_0"
 			};
-			static const ::std::vector<::std::string> inputs1(::std::begin(inputs1Array), ::std::end(inputs1Array));
-			this->send(Command::controlPackageSetupInputs, inputs1);
+			this->send(Command::controlPackageSetupInputs, integerRegister);
 			this->recv();
+			this->recipes.integerRegister = this->recipeId;
 			
-			static constexpr const char* inputs2Array[] = {
+			static const ::std::vector<::std::string> doubleRegister = {
 				"input_double_register_0",
 				"input_double_register_1",
 				"input_double_register_2",
@@ -668,37 +835,30 @@ namespace rl
 				"input_double_register_11",
 				"input_double_register_12"
 			};
-			static const ::std::vector<::std::string> inputs2(::std::begin(inputs2Array), ::std::end(inputs2Array));
-			this->send(Command::controlPackageSetupInputs, inputs2);
+			this->send(Command::controlPackageSetupInputs, doubleRegister);
 			this->recv();
+			this->recipes.doubleRegister = this->recipeId;
 			
-			static constexpr const char* inputs3Array[] = {
-				"standard_digital_output_mask",
-				"configurable_digital_output_mask",
-				"standard_digital_output",
-				"configurable_digital_output"
-			};
-			static const ::std::vector<::std::string> inputs3(::std::begin(inputs3Array), ::std::end(inputs3Array));
-			this->send(Command::controlPackageSetupInputs, inputs3);
-			this->recv();
+			if (this->hasInputs(getDigitalOutputInputs()))
+			{
+				this->send(Command::controlPackageSetupInputs, getDigitalOutputInputs());
+				this->recv();
+				this->recipes.digitalOutputs = this->recipeId;
+			}
 			
-			static constexpr const char* inputs4Array[] = {
-				"standard_analog_output_mask",
-				"standard_analog_output_type",
-				"standard_analog_output_0",
-				"standard_analog_output_1"
-			};
-			static const ::std::vector<::std::string> inputs4(::std::begin(inputs4Array), ::std::end(inputs4Array));
-			this->send(Command::controlPackageSetupInputs, inputs4);
-			this->recv();
+			if (this->hasInputs(getAnalogOutputInputs()))
+			{
+				this->send(Command::controlPackageSetupInputs, getAnalogOutputInputs());
+				this->recv();
+				this->recipes.analogOutputs = this->recipeId;
+			}
 			
-			static constexpr const char* inputs5Array[] = {
-				"input_bit_registers0_to_31",
-				"input_bit_registers32_to_63"
-			};
-			static const ::std::vector<::std::string> inputs5(::std::begin(inputs5Array), ::std::end(inputs5Array));
-			this->send(Command::controlPackageSetupInputs, inputs5);
-			this->recv();
+			if (this->hasInputs(getBitRegisterInputs()))
+			{
+				this->send(Command::controlPackageSetupInputs, getBitRegisterInputs());
+				this->recv();
+				this->recipes.bitRegisters = this->recipeId;
+			}
 		}
 		
 		void
@@ -747,6 +907,8 @@ namespace rl
 						throw DeviceException("Input recipe invalid");
 					}
 					
+					this->recipeId = recipeId;
+					
 					::std::string variableTypes(reinterpret_cast<char*>(ptr), packageSize - 4);
 //					::std::cout << "variableTypes: " << variableTypes << ::std::endl;
 					ptr += packageSize - 4;
@@ -776,56 +938,45 @@ namespace rl
 					
 					break;
 				case Command::dataPackage:
-					this->unserialize(ptr, this->output.timestamp);
-					this->unserialize(ptr, this->output.targetQ);
-					this->unserialize(ptr, this->output.targetQd);
-					this->unserialize(ptr, this->output.targetQdd);
-					this->unserialize(ptr, this->output.targetCurrent);
-					this->unserialize(ptr, this->output.targetMoment);
-					this->unserialize(ptr, this->output.actualQ);
-					this->unserialize(ptr, this->output.actualQd);
-					this->unserialize(ptr, this->output.actualCurrent);
-					this->unserialize(ptr, this->output.actualTcpPose);
-					this->unserialize(ptr, this->output.actualTcpSpeed);
-					this->unserialize(ptr, this->output.actualTcpForce);
-					this->unserialize(ptr, this->output.targetTcpPose);
-					this->unserialize(ptr, this->output.targetTcpSpeed);
-					this->unserialize(ptr, this->output.actualDigitalInputBits);
-					this->unserialize(ptr, this->output.jointTemperatures);
-					this->unserialize(ptr, this->output.robotMode);
-					this->unserialize(ptr, this->output.jointMode);
-					this->unserialize(ptr, this->output.safetyMode);
-					this->unserialize(ptr, this->output.speedScaling);
-					this->unserialize(ptr, this->output.actualDigitalOutputBits);
-					this->unserialize(ptr, this->output.runtimeState);
-					this->unserialize(ptr, this->output.robotStatusBits);
-					this->unserialize(ptr, this->output.safetyStatusBits);
-					this->unserialize(ptr, this->output.analogIoTypes);
-					this->unserialize(ptr, this->output.standardAnalogInput0);
-					this->unserialize(ptr, this->output.standardAnalogInput1);
-					this->unserialize(ptr, this->output.standardAnalogOutput0);
-					this->unserialize(ptr, this->output.standardAnalogOutput1);
-					this->unserialize(ptr, this->output.toolAnalogInputTypes);
-					this->unserialize(ptr, this->output.toolAnalogInput0);
-					this->unserialize(ptr, this->output.toolAnalogInput1);
-					this->unserialize(ptr, this->output.toolOutputVoltage);
-					this->unserialize(ptr, this->output.toolOutputCurrent);
-					this->unserialize(ptr, this->output.outputBitRegisters0);
-					this->unserialize(ptr, this->output.outputBitRegisters1);
-					this->unserialize(ptr, this->output.outputIntRegister);
-					this->unserialize(ptr, this->output.outputDoubleRegister);
+				{
+					Output& output = this->output.getBack();
+					
+					for (::std::size_t i = 0; i < this->recipe.size(); ++i)
+					{
+						switch (this->recipe[i]->type)
+						{
+						case Type::float64:
+							this->unserialize<double>(ptr, *this->recipe[i], output);
+							break;
+						case Type::int32:
+							this->unserialize<::std::int32_t>(ptr, *this->recipe[i], output);
+							break;
+						case Type::uint32:
+							this->unserialize<::std::uint32_t>(ptr, *this->recipe[i], output);
+							break;
+						case Type::uint64:
+							this->unserialize<::std::uint64_t>(ptr, *this->recipe[i], output);
+							break;
+						default:
+							break;
+						}
+					}
+					
+					output.received = ::std::chrono::steady_clock::now();
+					this->output.publish(output.received);
+					this->output.update();
 					
 					this->input.inputDoubleRegister.resize(this->getDof() + this->getDof() + 1);
 					
 					for (::std::size_t i = 0; i < this->getDof(); ++i)
 					{
-						this->input.inputDoubleRegister[i] = this->output.targetQ[i];
-						this->input.inputDoubleRegister[this->getDof() + i] = this->output.targetQd[i];
+						this->input.inputDoubleRegister[i] = (output.*this->holdPosition)[i];
+						this->input.inputDoubleRegister[this->getDof() + i] = nullptr != this->holdVelocity ? (output.*this->holdVelocity)[i] : 0;
 					}
 					
 					this->input.inputDoubleRegister[this->getDof() + this->getDof()] = 0;
 					
-					switch (this->getSafetyMode())
+					switch (static_cast<SafetyMode>(output.safetyMode))
 					{
 					case SafetyMode::normal:
 						break;
@@ -854,6 +1005,7 @@ namespace rl
 					default:
 						break;
 					}
+				}
 					break;
 				case Command::getUrcontrolVersion:
 					this->unserialize(ptr, this->version.major);
@@ -988,7 +1140,7 @@ namespace rl
 			buffer.push_back(0);
 			buffer.push_back(0);
 			buffer.push_back(static_cast<::std::uint8_t>(Command::dataPackage));
-			buffer.push_back(4);
+			buffer.push_back(this->recipes.analogOutputs);
 			
 			buffer.resize(buffer.size() + 2 + 2 * sizeof(double));
 			
@@ -1012,7 +1164,7 @@ namespace rl
 			buffer.push_back(0);
 			buffer.push_back(0);
 			buffer.push_back(static_cast<::std::uint8_t>(Command::dataPackage));
-			buffer.push_back(5);
+			buffer.push_back(this->recipes.bitRegisters);
 			
 			::std::uint8_t* ptr = &buffer[4];
 			
@@ -1041,7 +1193,7 @@ namespace rl
 			buffer.push_back(0);
 			buffer.push_back(0);
 			buffer.push_back(static_cast<::std::uint8_t>(Command::dataPackage));
-			buffer.push_back(3);
+			buffer.push_back(this->recipes.digitalOutputs);
 			
 			buffer.resize(buffer.size() + 4);
 			
@@ -1065,7 +1217,7 @@ namespace rl
 			buffer.push_back(0);
 			buffer.push_back(0);
 			buffer.push_back(static_cast<::std::uint8_t>(Command::dataPackage));
-			buffer.push_back(2);
+			buffer.push_back(this->recipes.doubleRegister);
 			
 			buffer.resize(buffer.size() + this->input.inputDoubleRegister.size() * sizeof(double));
 			
@@ -1089,7 +1241,7 @@ namespace rl
 			buffer.push_back(0);
 			buffer.push_back(0);
 			buffer.push_back(static_cast<::std::uint8_t>(Command::dataPackage));
-			buffer.push_back(1);
+			buffer.push_back(this->recipes.integerRegister);
 			
 			buffer.resize(buffer.size() + this->input.inputIntRegister.size() * sizeof(::std::int32_t));
 			
@@ -1106,6 +1258,11 @@ namespace rl
 		void
 		UniversalRobotsRtde::setAnalogOutput(const ::std::size_t& i, const ::rl::math::Real& value)
 		{
+			if (0 == this->recipes.analogOutputs)
+			{
+				throw DeviceException("Analog outputs not selected in inputs");
+			}
+			
 			if (!this->input.standardAnalogOutput0)
 			{
 				this->input.standardAnalogOutput0 = 0;
@@ -1164,6 +1321,15 @@ namespace rl
 		void
 		UniversalRobotsRtde::setDigitalOutput(const ::std::size_t& i, const bool& value)
 		{
+			if (i < 16 && 0 == this->recipes.digitalOutputs)
+			{
+				throw DeviceException("Digital outputs not selected in inputs");
+			}
+			else if (i >= 16 && 0 == this->recipes.bitRegisters)
+			{
+				throw DeviceException("Bit registers not selected in inputs");
+			}
+			
 			if (i < 8)
 			{
 				if (!this->input.standardDigitalOutput)
@@ -1235,6 +1401,24 @@ namespace rl
 			}
 		}
 		
+		void
+		UniversalRobotsRtde::setInputs(const ::std::vector<::std::string>& inputs)
+		{
+			for (::std::size_t i = 0; i < inputs.size(); ++i)
+			{
+				if (
+					getAnalogOutputInputs().end() == ::std::find(getAnalogOutputInputs().begin(), getAnalogOutputInputs().end(), inputs[i]) &&
+					getBitRegisterInputs().end() == ::std::find(getBitRegisterInputs().begin(), getBitRegisterInputs().end(), inputs[i]) &&
+					getDigitalOutputInputs().end() == ::std::find(getDigitalOutputInputs().begin(), getDigitalOutputInputs().end(), inputs[i])
+				)
+				{
+					throw DeviceException("Unsupported input variable " + inputs[i]);
+				}
+			}
+			
+			this->inputs = inputs;
+		}
+		
 		void
 		UniversalRobotsRtde::setJointAcceleration(const ::rl::math::Vector& qdd)
 		{
@@ -1265,6 +1449,27 @@ namespace rl
 			}
 		}
 		
+		void
+		UniversalRobotsRtde::setOutputs(const ::std::vector<::std::string>& outputs)
+		{
+			for (::std::size_t i = 0; i < outputs.size(); ++i)
+			{
+				::std::size_t j = 0;
+				
+				while (j < getOutputVariables().size() && outputs[i] != getOutputVariables()[j].name)
+				{
+					++j;
+				}
+				
+				if (getOutputVariables().size() == j)
+				{
+					throw DeviceException("Unsupported output variable " + outputs[i]);
+				}
+			}
+			
+			this->outputs = outputs;
+		}
+		
 		void
 		UniversalRobotsRtde::start()
 		{
@@ -27,7 +27,10 @@
 #ifndef RL_HAL_UNIVERSALROBOTSRTDE_H
 #define RL_HAL_UNIVERSALROBOTSRTDE_H
 
+#include <chrono>
 #include <cstdint>
+#include <string>
+#include <vector>
 #include <boost/optional.hpp>
 
 #include "AnalogInputReader.h"
@@ -48,6 +51,7 @@
 #include "JointVelocityActuator.h"
 #include "JointVelocitySensor.h"
 #include "Socket.h"
+#include "TripleBuffer.h"
 
 namespace rl
 {
@@ -55,6 +59,10 @@ namespace rl
 	{
 		/**
 		 * Universal Robots RTDE interface (3.3).
+		 * 
+		 * The output and input variables exchanged with the controller can be
+		 * restricted with setOutputs() and setInputs() before calling open().
+		 * Only the selected outputs are transmitted and parsed in each cycle.
 		 */
 		class RL_HAL_EXPORT UniversalRobotsRtde :
 			public CyclicDevice,
@@ -106,6 +114,95 @@ namespace rl
 			RL_HAL_DEPRECATED static constexpr JointMode JOINT_MODE_RUNNING = JointMode::running;
 			RL_HAL_DEPRECATED static constexpr JointMode JOINT_MODE_IDLE_MODE = JointMode::idleMode;
 			
+			/**
+			 * Output variables of one data package.
+			 * 
+			 * Variables that are not selected with setOutputs() are zero.
+			 */
+			struct Output
+			{
+				double actualCurrent[6];
+				
+				::std::uint64_t actualDigitalInputBits;
+				
+				::std::uint64_t actualDigitalOutputBits;
+				
+				double actualQ[6];
+				
+				double actualQd[6];
+				
+				double actualTcpForce[6];
+				
+				double actualTcpPose[6];
+				
+				double actualTcpSpeed[6];
+				
+				::std::uint32_t analogIoTypes;
+				
+				::std::int32_t jointMode[6];
+				
+				double jointTemperatures[6];
+				
+				::std::uint32_t outputBitRegisters0;
+				
+				::std::uint32_t outputBitRegisters1;
+				
+				double outputDoubleRegister[24];
+				
+				::std::int32_t outputIntRegister[24];
+				
+				::std::int32_t robotMode;
+				
+				::std::uint32_t robotStatusBits;
+				
+				::std::uint32_t runtimeState;
+				
+				::std::int32_t safetyMode;
+				
+				::std::uint32_t safetyStatusBits;
+				
+				double speedScaling;
+				
+				double standardAnalogInput0;
+				
+				double standardAnalogInput1;
+				
+				double standardAnalogOutput0;
+				
+				double standardAnalogOutput1;
+				
+				double targetCurrent[6];
+				
+				double targetMoment[6];
+				
+				double targetQ[6];
+				
+				double targetQd[6];
+				
+				double targetQdd[6];
+				
+				double targetTcpPose[6];
+				
+				double targetTcpSpeed[6];
+				
+				double timestamp;
+				
+				double toolAnalogInput0;
+				
+				double toolAnalogInput1;
+				
+				::std::uint32_t toolAnalogInputTypes;
+				
+				double toolOutputCurrent;
+				
+				::std::int32_t toolOutputVoltage;
+				
+				/**
+				 * Arrival time of the data package.
+				 */
+				::std::chrono::steady_clock::time_point received;
+			};
+			
 			enum class RobotMode
 			{
 				disconnected = 0,
@@ -267,6 +364,8 @@ namespace rl
 			
 			::std::size_t getDigitalOutputCount() const;
 			
+			const ::std::vector<::std::string>& getInputs() const;
+			
 			::rl::math::Vector getJointCurrent() const;
 			
 			JointMode getJointMode(const ::std::size_t& i) const;
@@ -277,6 +376,17 @@ namespace rl
 			
 			::rl::math::Vector getJointVelocity() const;
 			
+			/**
+			 * Latest complete data package, updated once per call to step().
+			 * 
+			 * All getters read from this snapshot, so the values obtained between
+			 * two calls to step() belong to the same data package. Call the getters
+			 * from the thread calling step().
+			 */
+			const Output& getOutput() const;
+			
+			const ::std::vector<::std::string>& getOutputs() const;
+			
 			RobotMode getRobotMode() const;
 			
 			::std::uint32_t getRobotStatusBits() const;
@@ -301,12 +411,43 @@ namespace rl
 			
 			void setDigitalOutput(const ::std::size_t& i, const bool& value);
 			
+			/**
+			 * Select the input variables set up by open().
+			 * 
+			 * Inputs are set up in groups of analog outputs
+			 * (standard_analog_output_mask, standard_analog_output_type,
+			 * standard_analog_output_0, standard_analog_output_1),
+			 * bit registers (input_bit_registers0_to_31, input_bit_registers32_to_63),
+			 * and digital outputs (standard_digital_output_mask,
+			 * configurable_digital_output_mask, standard_digital_output,
+			 * configurable_digital_output). Naming one variable selects its group.
+			 * The integer and double registers used for motion commands are always
+			 * set up. By default, all groups are selected.
+			 * 
+			 * @pre !isConnected()
+			 */
+			void setInputs(const ::std::vector<::std::string>& inputs);
+			
 			void setJointAcceleration(const ::rl::math::Vector& qdd);
 			
 			void setJointPosition(const ::rl::math::Vector& q);
 			
 			void setJointVelocity(const ::rl::math::Vector& qd);
 			
+			/**
+			 * Select the output variables requested by open().
+			 * 
+			 * Accepts the RTDE names of the variables used by the getters, e.g.,
+			 * actual_q, actual_qd, target_q, actual_TCP_pose, or output_int_register_0.
+			 * The robot_mode, runtime_state, and safety_mode variables are always
+			 * requested, as is target_q unless actual_q is selected to hold the
+			 * position when no command is set. Getters based on variables that
+			 * are not selected return zero. By default, all variables are selected.
+			 * 
+			 * @pre !isConnected()
+			 */
+			void setOutputs(const ::std::vector<::std::string>& outputs);
+			
 			void start();
 			
 			void step();
@@ -355,83 +496,37 @@ namespace rl
 				::boost::optional<::std::uint8_t> standardDigitalOutputMask;
 			};
 			
-			struct Output
+			
+			struct Recipes
 			{
-				double actualCurrent[6];
+				::std::uint8_t analogOutputs;
 				
-				::std::uint64_t actualDigitalInputBits;
+				::std::uint8_t bitRegisters;
 				
-				::std::uint64_t actualDigitalOutputBits;
+				::std::uint8_t digitalOutputs;
 				
-				double actualQ[6];
+				::std::uint8_t doubleRegister;
 				
-				double actualQd[6];
-				
-				double actualTcpForce[6];
-				
-				double actualTcpPose[6];
-				
-				double actualTcpSpeed[6];
-				
-				::std::uint32_t analogIoTypes;
-				
-				::std::int32_t jointMode[6];
-				
-				double jointTemperatures[6];
-				
-				::std::uint32_t outputBitRegisters0;
-				
-				::std::uint32_t outputBitRegisters1;
-				
-				double outputDoubleRegister[24];
-				
-				::std::int32_t outputIntRegister[24];
-				
-				::std::int32_t robotMode;
-				
-				::std::uint32_t robotStatusBits;
-				
-				::std::uint32_t runtimeState;
-				
-				::std::int32_t safetyMode;
-				
-				::std::uint32_t safetyStatusBits;
-				
-				double speedScaling;
-				
-				double standardAnalogInput0;
-				
-				double standardAnalogInput1;
-				
-				double standardAnalogOutput0;
-				
-				double standardAnalogOutput1;
-				
-				double targetCurrent[6];
-				
-				double targetMoment[6];
-				
-				double targetQ[6];
-				
-				double targetQd[6];
-				
-				double targetQdd[6];
-				
-				double targetTcpPose[6];
-				
-				double targetTcpSpeed[6];
-				
-				double timestamp;
-				
-				double toolAnalogInput0;
+				::std::uint8_t integerRegister;
+			};
+			
+			enum class Type
+			{
+				float64,
+				int32,
+				uint32,
+				uint64
+			};
+			
+			struct Variable
+			{
+				::std::string name;
 				
-				double toolAnalogInput1;
+				::std::size_t offset;
 				
-				::std::uint32_t toolAnalogInputTypes;
+				Type type;
 				
-				double toolOutputCurrent;
-				
-				::std::int32_t toolOutputVoltage;
+				::std::size_t count;
 			};
 			
 			struct Version
@@ -445,6 +540,16 @@ namespace rl
 				::std::uint32_t minor;
 			};
 			
+			static const ::std::vector<::std::string>& getAnalogOutputInputs();
+			
+			static const ::std::vector<::std::string>& getBitRegisterInputs();
+			
+			static const ::std::vector<::std::string>& getDigitalOutputInputs();
+			
+			static const ::std::vector<Variable>& getOutputVariables();
+			
+			bool hasInputs(const ::std::vector<::std::string>& group) const;
+			
 			void recv();
 			
 			void send(::std::uint8_t* buffer, const ::std::size_t& size);
@@ -499,9 +604,34 @@ namespace rl
 				}
 			}
 			
+			template<typename T>
+			void unserialize(::std::uint8_t*& ptr, const Variable& variable, Output& output)
+			{
+				T* t = reinterpret_cast<T*>(reinterpret_cast<::std::uint8_t*>(&output) + variable.offset);
+				
+				for (::std::size_t i = 0; i < variable.count; ++i)
+				{
+					this->unserialize(ptr, t[i]);
+				}
+			}
+			
+			double (Output::*holdPosition)[6];
+			
+			double (Output::*holdVelocity)[6];
+			
 			Input input;
 			
-			Output output;
+			::std::vector<::std::string> inputs;
+			
+			TripleBuffer<Output> output;
+			
+			::std::vector<::std::string> outputs;
+			
+			::std::vector<const Variable*> recipe;
+			
+			::std::uint8_t recipeId;
+			
+			Recipes recipes;
 			
 			Socket socket2;
 			
@@ -413,7 +413,7 @@ namespace rl
 		}
 		
 		::rl::math::Real
-		Kinematics::distance(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2) const
+		Kinematics::distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const
 		{
 			return this->inverseOfTransformedDistance(this->transformedDistance(q1, q2));
 		}
@@ -668,7 +668,7 @@ namespace rl
 		}
 		
 		void
-		Kinematics::interpolate(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2, const ::rl::math::Real& alpha, ::rl::math::Vector& q) const
+		Kinematics::interpolate(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2, const ::rl::math::Real& alpha, ::rl::math::Vector& q) const
 		{
 			assert(q1.size() == this->getDof());
 			assert(q2.size() == this->getDof());
@@ -977,7 +977,7 @@ namespace rl
 		}
 		
 		::rl::math::Real
-		Kinematics::transformedDistance(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2) const
+		Kinematics::transformedDistance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const
 		{
 			assert(q1.size() == this->getDof());
 			assert(q2.size() == this->getDof());
@@ -0,0 +1,219 @@
+//
+// Copyright (c) 2009, Markus Rickert, Andre Gaschler
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef RL_MATH_FIXEDDEGREEPOLYNOMIAL_H
+#define RL_MATH_FIXEDDEGREEPOLYNOMIAL_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+#include "Function.h"
+#include "Polynomial.h"
+#include "TypeTraits.h"
+
+namespace rl
+{
+	namespace math
+	{
+		/**
+		 * A polynomial function with a degree known at compile time.
+		 *
+		 * \f[ f(x) = c_0 + c_1 x + c_2 x^2 + \ldots + c_{N - 1} x^{N - 1} + c_N x^N \f]
+		 *
+		 * Coefficients are stored inline, so that evaluating the polynomial and
+		 * its derivatives does not allocate memory for fixed-size types.
+		 *
+		 * @see Polynomial
+		 */
+		template<typename T, ::std::size_t N>
+		class FixedDegreePolynomial : public Function<T>
+		{
+		public:
+			EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+			
+			FixedDegreePolynomial() :
+				Function<T>(0, 0),
+				c()
+			{
+			}
+			
+			explicit FixedDegreePolynomial(const Polynomial<T>& polynomial) :
+				Function<T>(polynomial.lower(), polynomial.upper()),
+				c()
+			{
+				assert(N == polynomial.degree());
+				
+				for (::std::size_t i = 0; i < N + 1; ++i)
+				{
+					this->c[i] = polynomial.coefficient(i);
+				}
+			}
+			
+			virtual ~FixedDegreePolynomial()
+			{
+			}
+			
+			static FixedDegreePolynomial CubicFirst(const T& y0, const T& y1, const T& yd0, const T& yd1, const Real& x1 = 1)
+			{
+				static_assert(3 == N, "CubicFirst requires a polynomial of degree 3");
+				return FixedDegreePolynomial(Polynomial<T>::CubicFirst(y0, y1, yd0, yd1, x1));
+			}
+			
+			static FixedDegreePolynomial QuinticFirstSecond(const T& y0, const T& y1, const T& yd0, const T& yd1, const T& ydd0, const T& ydd1, const Real& x1 = 1)
+			{
+				static_assert(5 == N, "QuinticFirstSecond requires a polynomial of degree 5");
+				return FixedDegreePolynomial(Polynomial<T>::QuinticFirstSecond(y0, y1, yd0, yd1, ydd0, ydd1, x1));
+			}
+			
+			static FixedDegreePolynomial SepticFirstSecondThird(const T& y0, const T& y1, const T& yd0, const T& yd1, const T& ydd0, const T& ydd1, const T& yddd0, const T& yddd1, const Real& x1 = 1)
+			{
+				static_assert(7 == N, "SepticFirstSecondThird requires a polynomial of degree 7");
+				return FixedDegreePolynomial(Polynomial<T>::SepticFirstSecondThird(y0, y1, yd0, yd1, ydd0, ydd1, yddd0, yddd1, x1));
+			}
+			
+			FixedDegreePolynomial* clone() const
+			{
+				return new FixedDegreePolynomial(*this);
+			}
+			
+			T& coefficient(const ::std::size_t& i)
+			{
+				return this->c[i];
+			}
+			
+			const T& coefficient(const ::std::size_t& i) const
+			{
+				return this->c[i];
+			}
+			
+			::std::size_t degree() const
+			{
+				return N;
+			}
+			
+			/**
+			 * Evaluates the function value and the first derivatives for a given value x.
+			 *
+			 * @param[in] x Input value of the function and its derivatives
+			 * @param[out] y Function value followed by the first y.size() - 1 derivatives
+			 *
+			 * @see Polynomial::evaluate
+			 */
+			template<typename Container>
+			void evaluate(const Real& x, Container& y) const
+			{
+				assert(x > this->lower() - this->functionBoundary);
+				assert(x < this->upper() + this->functionBoundary);
+				assert(y.size() > 0);
+				
+				y[0] = this->c[N];
+				
+				for (::std::size_t j = 1; j < y.size(); ++j)
+				{
+					y[j] = 0 * this->c[N];
+				}
+				
+				for (::std::size_t i = N; i-- > 0;)
+				{
+					for (::std::size_t j = ::std::min<::std::size_t>(y.size() - 1, N - i); j > 0; --j)
+					{
+						y[j] *= x;
+						y[j] += y[j - 1];
+					}
+					
+					y[0] *= x;
+					y[0] += this->c[i];
+				}
+				
+				Real factorial = 1;
+				
+				for (::std::size_t j = 2; j < y.size(); ++j)
+				{
+					factorial *= j;
+					y[j] *= factorial;
+				}
+			}
+			
+			T operator()(const Real& x, const ::std::size_t& derivative = 0) const
+			{
+				assert(x > this->lower() - this->functionBoundary);
+				assert(x < this->upper() + this->functionBoundary);
+				
+				if (derivative > N)
+				{
+					return TypeTraits<T>::Zero(TypeTraits<T>::size(this->c[0]));
+				}
+				
+				T y = FixedDegreePolynomial::falling(N, derivative) * this->c[N];
+				
+				for (::std::size_t i = N; i-- > derivative;)
+				{
+					y *= x;
+					y += FixedDegreePolynomial::falling(i, derivative) * this->c[i];
+				}
+				
+				return y;
+			}
+			
+			/**
+			 * Returns a polynomial with the same coefficients and a dynamic degree.
+			 */
+			Polynomial<T> polynomial() const
+			{
+				Polynomial<T> f(N);
+				f.lower() = this->lower();
+				f.upper() = this->upper();
+				
+				for (::std::size_t i = 0; i < N + 1; ++i)
+				{
+					f.coefficient(i) = this->c[i];
+				}
+				
+				return f;
+			}
+			
+		protected:
+			::std::array<T, N + 1> c;
+			
+		private:
+			static Real falling(const ::std::size_t& n, const ::std::size_t& k)
+			{
+				Real factor = 1;
+				
+				for (::std::size_t i = n - k + 1; i <= n; ++i)
+				{
+					factor *= i;
+				}
+				
+				return factor;
+			}
+		};
+	}
+}
+
+#endif // RL_MATH_FIXEDDEGREEPOLYNOMIAL_H
@@ -0,0 +1,482 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef RL_MATH_FLATKDTREENEARESTNEIGHBORS_H
+#define RL_MATH_FLATKDTREENEARESTNEIGHBORS_H
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <rl/std/iterator.h>
+
+namespace rl
+{
+	namespace math
+	{
+		/**
+		 * k-d tree with implicit node layout.
+		 *
+		 * Cuts are stored in a flat array with the children of node i at
+		 * 2i+1 and 2i+2, and leaves are buckets of consecutive values, so that
+		 * a search only touches contiguous memory. Values inserted with push
+		 * are collected in a buffer and periodically merged into a forest of
+		 * static trees with sizes in decreasing order (logarithmic method).
+		 * Searches are exact and reuse an internal workspace, therefore
+		 * concurrent queries on the same instance are not supported.
+		 *
+		 * Jon Louis Bentley. Multidimensional binary search trees used for
+		 * associative searching. Communications of the ACM, 18(9):509-517,
+		 * September 1975.
+		 *
+		 * http://dx.doi.org/10.1145/361002.361007
+		 *
+		 * Jon Louis Bentley and James B. Saxe. Decomposable searching problems
+		 * I. Static-to-dynamic transformation. Journal of Algorithms,
+		 * 1(4):301-358, December 1980.
+		 *
+		 * http://dx.doi.org/10.1016/0196-6774(80)90015-2
+		 */
+		template<typename MetricT>
+		class FlatKdtreeNearestNeighbors
+		{
+		public:
+			typedef const typename MetricT::Value& const_reference;
+			
+			typedef ::std::ptrdiff_t difference_type;
+			
+			typedef typename MetricT::Value& reference;
+			
+			typedef ::std::size_t size_type;
+			
+			typedef typename MetricT::Value value_type;
+			
+			typedef typename MetricT::Distance Distance;
+			
+			typedef MetricT Metric;
+			
+			typedef typename MetricT::Size Size;
+			
+			typedef typename MetricT::Value Value;
+			
+			typedef ::std::pair<Distance, Value> Neighbor;
+			
+			explicit FlatKdtreeNearestNeighbors(const Metric& metric) :
+				bucketSize(16),
+				buffer(),
+				metric(metric),
+				sidedist(),
+				trees(),
+				values(0)
+			{
+			}
+			
+			explicit FlatKdtreeNearestNeighbors(Metric&& metric = Metric()) :
+				bucketSize(16),
+				buffer(),
+				metric(::std::move(metric)),
+				sidedist(),
+				trees(),
+				values(0)
+			{
+			}
+			
+			template<typename InputIterator>
+			FlatKdtreeNearestNeighbors(InputIterator first, InputIterator last, const Metric& metric) :
+				bucketSize(16),
+				buffer(),
+				metric(metric),
+				sidedist(),
+				trees(),
+				values(0)
+			{
+				this->insert(first, last);
+			}
+			
+			template<typename InputIterator>
+			FlatKdtreeNearestNeighbors(InputIterator first, InputIterator last, Metric&& metric = Metric()) :
+				bucketSize(16),
+				buffer(),
+				metric(::std::move(metric)),
+				sidedist(),
+				trees(),
+				values(0)
+			{
+				this->insert(first, last);
+			}
+			
+			~FlatKdtreeNearestNeighbors()
+			{
+			}
+			
+			void clear()
+			{
+				this->buffer.clear();
+				this->trees.clear();
+				this->values = 0;
+			}
+			
+			::std::vector<Value> data() const
+			{
+				::std::vector<Value> data;
+				data.reserve(this->values);
+				
+				for (::std::size_t i = 0; i < this->trees.size(); ++i)
+				{
+					data.insert(data.end(), this->trees[i].values.begin(), this->trees[i].values.end());
+				}
+				
+				data.insert(data.end(), this->buffer.begin(), this->buffer.end());
+				
+				return data;
+			}
+			
+			bool empty() const
+			{
+				return 0 == this->values;
+			}
+			
+			/**
+			 * Maximum number of values stored in a leaf.
+			 */
+			::std::size_t getBucketSize() const
+			{
+				return this->bucketSize;
+			}
+			
+			template<typename InputIterator>
+			void insert(InputIterator first, InputIterator last)
+			{
+				if (this->empty())
+				{
+					::std::vector<Value> values(first, last);
+					
+					if (!values.empty())
+					{
+						this->values += values.size();
+						this->trees.emplace_back();
+						this->build(this->trees.back(), ::std::move(values));
+					}
+				}
+				else
+				{
+					for (InputIterator i = first; i != last; ++i)
+					{
+						this->push(*i);
+					}
+				}
+			}
+			
+			::std::vector<Neighbor> nearest(const Value& query, const ::std::size_t& k, const bool& sorted = true) const
+			{
+				return this->search(query, &k, nullptr, sorted);
+			}
+			
+			void push(const Value& value)
+			{
+				this->buffer.push_back(value);
+				++this->values;
+				
+				if (this->buffer.size() >= this->bucketSize)
+				{
+					this->flush();
+				}
+			}
+			
+			::std::vector<Neighbor> radius(const Value& query, const Distance& radius, const bool& sorted = true) const
+			{
+				return this->search(query, nullptr, &radius, sorted);
+			}
+			
+			/**
+			 * Set maximum number of values stored in a leaf.
+			 *
+			 * Only affects trees that are built after this call.
+			 */
+			void setBucketSize(const ::std::size_t& bucketSize)
+			{
+				this->bucketSize = ::std::max<::std::size_t>(1, bucketSize);
+			}
+			
+			::std::size_t size() const
+			{
+				return this->values;
+			}
+			
+			void swap(FlatKdtreeNearestNeighbors& other)
+			{
+				using ::std::swap;
+				swap(this->bucketSize, other.bucketSize);
+				swap(this->buffer, other.buffer);
+				swap(this->metric, other.metric);
+				swap(this->sidedist, other.sidedist);
+				swap(this->trees, other.trees);
+				swap(this->values, other.values);
+			}
+			
+			friend void swap(FlatKdtreeNearestNeighbors& lhs, FlatKdtreeNearestNeighbors& rhs)
+			{
+				lhs.swap(rhs);
+			}
+			
+		protected:
+			
+		private:
+			struct CoordinateCompare
+			{
+				CoordinateCompare(const Size& index) :
+					index(index)
+				{
+				}
+				
+				bool operator()(const Value& lhs, const Value& rhs) const
+				{
+					using ::std::begin;
+					return *(begin(lhs) + this->index) < *(begin(rhs) + this->index);
+				}
+				
+				Size index;
+			};
+			
+			struct NeighborCompare
+			{
+				bool operator()(const Neighbor& lhs, const Neighbor& rhs) const
+				{
+					return lhs.first < rhs.first;
+				}
+			};
+			
+			struct Node
+			{
+				Size index;
+				
+				Distance value;
+			};
+			
+			struct Tree
+			{
+				Tree() :
+					depth(0),
+					nodes(),
+					values()
+				{
+				}
+				
+				::std::size_t depth;
+				
+				::std::vector<Node> nodes;
+				
+				::std::vector<Value> values;
+			};
+			
+			void build(Tree& tree, ::std::vector<Value>&& values)
+			{
+				tree.values = ::std::move(values);
+				tree.depth = 0;
+				
+				for (::std::size_t n = tree.values.size(); n > this->bucketSize; n = (n + 1) / 2)
+				{
+					++tree.depth;
+				}
+				
+				tree.nodes.resize((static_cast<::std::size_t>(1) << tree.depth) - 1);
+				
+				if (tree.depth > 0)
+				{
+					this->divide(tree, 0, 0, 0, tree.values.size());
+				}
+			}
+			
+			void check(const Value& query, const Value& value, const ::std::size_t* k, const Distance* radius, ::std::vector<Neighbor>& neighbors) const
+			{
+				Distance distance = this->metric(query, value);
+				
+				if (nullptr == k || neighbors.size() < *k || distance < neighbors.front().first)
+				{
+					if (nullptr == radius || distance < *radius)
+					{
+						if (nullptr != k && *k == neighbors.size())
+						{
+							::std::pop_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
+							neighbors.pop_back();
+						}
+						
+						neighbors.emplace_back(distance, value);
+						::std::push_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
+					}
+				}
+			}
+			
+			void divide(Tree& tree, const ::std::size_t& node, const ::std::size_t& depth, const ::std::size_t& first, const ::std::size_t& last)
+			{
+				using ::std::begin;
+				using ::rl::std17::size;
+				
+				::std::size_t dim = size(tree.values[first]);
+				Distance max = Distance();
+				Size index = 0;
+				
+				for (::std::size_t i = 0; i < dim; ++i)
+				{
+					Distance min = *(begin(tree.values[first]) + i);
+					Distance max2 = min;
+					
+					for (::std::size_t j = first + 1; j < last; ++j)
+					{
+						Distance value = *(begin(tree.values[j]) + i);
+						min = ::std::min(min, value);
+						max2 = ::std::max(max2, value);
+					}
+					
+					if (max2 - min > max)
+					{
+						max = max2 - min;
+						index = i;
+					}
+				}
+				
+				::std::size_t mid = first + (last - first) / 2;
+				::std::nth_element(tree.values.begin() + first, tree.values.begin() + mid, tree.values.begin() + last, CoordinateCompare(index));
+				
+				tree.nodes[node].index = index;
+				tree.nodes[node].value = *(begin(tree.values[mid]) + index);
+				
+				if (depth + 1 < tree.depth)
+				{
+					this->divide(tree, 2 * node + 1, depth + 1, first, mid);
+					this->divide(tree, 2 * node + 2, depth + 1, mid, last);
+				}
+			}
+			
+			void flush()
+			{
+				::std::vector<Value> carry;
+				carry.swap(this->buffer);
+				
+				while (!this->trees.empty() && this->trees.back().values.size() <= carry.size())
+				{
+					carry.insert(carry.end(), this->trees.back().values.begin(), this->trees.back().values.end());
+					this->trees.pop_back();
+				}
+				
+				this->trees.emplace_back();
+				this->build(this->trees.back(), ::std::move(carry));
+				this->buffer.reserve(this->bucketSize);
+			}
+			
+			::std::vector<Neighbor> search(const Value& query, const ::std::size_t* k, const Distance* radius, const bool& sorted) const
+			{
+				using ::rl::std17::size;
+				
+				::std::vector<Neighbor> neighbors;
+				
+				if (this->empty())
+				{
+					return neighbors;
+				}
+				
+				if (nullptr != k)
+				{
+					neighbors.reserve(::std::min(*k, this->size()));
+				}
+				
+				this->sidedist.assign(size(query), Distance());
+				
+				for (::std::size_t i = 0; i < this->trees.size(); ++i)
+				{
+					this->search(this->trees[i], 0, 0, 0, this->trees[i].values.size(), query, k, radius, neighbors, Distance());
+				}
+				
+				for (::std::size_t i = 0; i < this->buffer.size(); ++i)
+				{
+					this->check(query, this->buffer[i], k, radius, neighbors);
+				}
+				
+				if (sorted)
+				{
+					::std::sort_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
+				}
+				
+				return neighbors;
+			}
+			
+			void search(const Tree& tree, const ::std::size_t& node, const ::std::size_t& depth, const ::std::size_t& first, const ::std::size_t& last, const Value& query, const ::std::size_t* k, const Distance* radius, ::std::vector<Neighbor>& neighbors, const Distance& mindist) const
+			{
+				using ::std::begin;
+				
+				if (depth == tree.depth)
+				{
+					for (::std::size_t i = first; i < last; ++i)
+					{
+						this->check(query, tree.values[i], k, radius, neighbors);
+					}
+				}
+				else
+				{
+					const Node& cut = tree.nodes[node];
+					::std::size_t mid = first + (last - first) / 2;
+					
+					Distance value = *(begin(query) + cut.index);
+					Distance diff = value - cut.value;
+					
+					::std::size_t best = diff < 0 ? 0 : 1;
+					::std::size_t worst = diff < 0 ? 1 : 0;
+					
+					this->search(tree, 2 * node + 1 + best, depth + 1, 0 == best ? first : mid, 0 == best ? mid : last, query, k, radius, neighbors, mindist);
+					
+					Distance cutdist = this->metric(value, cut.value, cut.index);
+					Distance newdist = mindist - this->sidedist[cut.index] + cutdist;
+					
+					if (nullptr == k || neighbors.size() < *k || newdist <= neighbors.front().first)
+					{
+						if (nullptr == radius || newdist < *radius)
+						{
+							Distance dist = this->sidedist[cut.index];
+							this->sidedist[cut.index] = cutdist;
+							this->search(tree, 2 * node + 1 + worst, depth + 1, 0 == worst ? first : mid, 0 == worst ? mid : last, query, k, radius, neighbors, newdist);
+							this->sidedist[cut.index] = dist;
+						}
+					}
+				}
+			}
+			
+			::std::size_t bucketSize;
+			
+			::std::vector<Value> buffer;
+			
+			Metric metric;
+			
+			mutable ::std::vector<Distance> sidedist;
+			
+			::std::vector<Tree> trees;
+			
+			::std::size_t values;
+		};
+	}
+}
+
+#endif // RL_MATH_FLATKDTREENEARESTNEIGHBORS_H
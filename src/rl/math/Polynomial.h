@@ -31,6 +31,7 @@
 #define EIGEN_QUATERNIONBASE_PLUGIN <rl/math/QuaternionBaseAddons.h>
 #define EIGEN_TRANSFORM_PLUGIN <rl/math/TransformAddons.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <stdexcept>
@@ -229,6 +230,51 @@ namespace rl
 				return f;
 			}
 			
+			/**
+			 * Evaluates the function value and the first derivatives for a given value x.
+			 *
+			 * All values are computed in a single Horner sweep over the coefficients.
+			 * The elements of y are overwritten in place, so no memory is allocated
+			 * if they already match the dimension of the coefficients.
+			 *
+			 * @param[in] x Input value of the function and its derivatives
+			 * @param[out] y Function value followed by the first y.size() - 1 derivatives
+			 */
+			template<typename Container>
+			void evaluate(const Real& x, Container& y) const
+			{
+				assert(x > this->lower() - this->functionBoundary);
+				assert(x < this->upper() + this->functionBoundary);
+				assert(y.size() > 0);
+				
+				y[0] = this->c[this->degree()];
+				
+				for (::std::size_t j = 1; j < y.size(); ++j)
+				{
+					y[j] = 0 * this->c[this->degree()];
+				}
+				
+				for (::std::size_t i = this->degree(); i-- > 0;)
+				{
+					for (::std::size_t j = ::std::min<::std::size_t>(y.size() - 1, this->degree() - i); j > 0; --j)
+					{
+						y[j] *= x;
+						y[j] += y[j - 1];
+					}
+					
+					y[0] *= x;
+					y[0] += this->c[i];
+				}
+				
+				Real factorial = 1;
+				
+				for (::std::size_t j = 2; j < y.size(); ++j)
+				{
+					factorial *= j;
+					y[j] *= factorial;
+				}
+			}
+			
 			/**
 			 * Returns the array of the maximum function values of each dimension
 			 * within the definition range, not regarding the sign of the function values.
@@ -336,22 +382,27 @@ namespace rl
 			
 			T operator()(const Real& x, const ::std::size_t& derivative = 0) const
 			{
-				if (derivative > 0)
+				assert(x > this->lower() - this->functionBoundary);
+				assert(x < this->upper() + this->functionBoundary);
+				
+				if (derivative > this->degree())
 				{
-					Polynomial f = this->derivative();
+					return TypeTraits<T>::Zero(TypeTraits<T>::size(this->c[0]));
+				}
+				else if (derivative > 0)
+				{
+					T y = Polynomial::falling(this->degree(), derivative) * this->c[this->degree()];
 					
-					for (::std::size_t i = 1; i < derivative; ++i)
+					for (::std::size_t i = this->degree(); i-- > derivative;)
 					{
-						f = f.derivative();
+						y *= x;
+						y += Polynomial::falling(i, derivative) * this->c[i];
 					}
 					
-					return f(x);
+					return y;
 				}
 				else
 				{
-					assert(x > this->lower() - this->functionBoundary);
-					assert(x < this->upper() + this->functionBoundary);
-					
 					T y = this->c[this->degree()];
 					
 					for (::std::size_t i = 1; i < this->degree() + 1; ++i)
@@ -708,7 +759,21 @@ namespace rl
 			::std::vector<T> c;
 			
 		private:
-			
+			/**
+			 * Falling factorial n (n - 1) ... (n - k + 1), the factor of the
+			 * coefficient of degree n in the k-th derivative.
+			 */
+			static Real falling(const ::std::size_t& n, const ::std::size_t& k)
+			{
+				Real factor = 1;
+				
+				for (::std::size_t i = n - k + 1; i <= n; ++i)
+				{
+					factor *= i;
+				}
+				
+				return factor;
+			}
 		};
 	}
 }
@@ -27,6 +27,7 @@
 #ifndef RL_MATH_SPLINE_H
 #define RL_MATH_SPLINE_H
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
@@ -57,8 +58,64 @@ namespace rl
 			
 			typedef typename ::std::vector<Polynomial<T>>::reverse_iterator ReverseIterator;
 			
+			/**
+			 * Evaluates a spline at sample points that are mostly in increasing order.
+			 *
+			 * The cursor remembers the last active polynomial, so that a sweep over
+			 * sorted sample points advances in amortized constant time per sample.
+			 * Sample points before the last one fall back to a binary search.
+			 * A cursor is invalidated when polynomials are added to or removed from
+			 * the spline.
+			 */
+			class Cursor
+			{
+			public:
+				explicit Cursor(const Spline& spline) :
+					i(0),
+					spline(&spline)
+				{
+				}
+				
+				/**
+				 * Index of the polynomial used in the last evaluation.
+				 */
+				::std::size_t getSegment() const
+				{
+					return this->i;
+				}
+				
+				T operator()(const Real& x, const ::std::size_t& derivative = 0)
+				{
+					assert(x >= this->spline->lower() - this->spline->functionBoundary);
+					assert(x <= this->spline->upper() + this->spline->functionBoundary);
+					assert(this->spline->polynomials.size() > 0);
+					
+					if (this->i > 0 && x <= this->spline->breakpoints[this->i])
+					{
+						this->i = this->spline->segment(x);
+					}
+					else
+					{
+						while (this->i + 1 < this->spline->polynomials.size() && x > this->spline->breakpoints[this->i + 1])
+						{
+							++this->i;
+						}
+					}
+					
+					return this->spline->polynomials[this->i](x - this->spline->breakpoints[this->i], derivative);
+				}
+				
+			protected:
+				
+			private:
+				::std::size_t i;
+				
+				const Spline* spline;
+			};
+			
 			Spline() :
 				Function<T>(0, 0),
+				breakpoints(),
 				polynomials()
 			{
 			}
@@ -1121,6 +1178,7 @@ namespace rl
 			
 			void clear()
 			{
+				this->breakpoints.clear();
 				this->polynomials.clear();
 				this->x0 = 0;
 				this->x1 = 0;
@@ -1131,6 +1189,11 @@ namespace rl
 				return new Spline(*this);
 			}
 			
+			Cursor cursor() const
+			{
+				return Cursor(*this);
+			}
+			
 			Spline derivative() const
 			{
 				Spline spline;
@@ -1159,6 +1222,29 @@ namespace rl
 				return this->polynomials.end();
 			}
 			
+			/**
+			 * Evaluates the spline at a sequence of sample points.
+			 *
+			 * The output is resized to the number of sample points, existing
+			 * elements are overwritten in place. Sample points in increasing order
+			 * are evaluated in amortized constant time per sample.
+			 *
+			 * @param[in] x Sample points
+			 * @param[out] y Function values or derivatives at the sample points
+			 * @param[in] derivative Order of the derivative
+			 */
+			void evaluate(const ::std::vector<Real>& x, ::std::vector<T>& y, const ::std::size_t& derivative = 0) const
+			{
+				y.resize(x.size());
+				
+				Cursor cursor(*this);
+				
+				for (::std::size_t i = 0; i < x.size(); ++i)
+				{
+					y[i] = cursor(x[i], derivative);
+				}
+			}
+			
 			Polynomial<T>& front()
 			{
 				return this->polynomials.front();
@@ -1257,15 +1343,9 @@ namespace rl
 				assert(x <= this->upper() + this->functionBoundary);
 				assert(this->polynomials.size() > 0);
 				
-				Real x0 = this->lower();
-				::std::size_t i = 0;
-				
-				for (; x > x0 + this->polynomials[i].duration() && i + 1 < this->polynomials.size(); ++i)
-				{
-					x0 += this->polynomials[i].duration();
-				}
+				::std::size_t i = this->segment(x);
 				
-				return this->polynomials[i](x - x0, derivative);
+				return this->polynomials[i](x - this->breakpoints[i], derivative);
 			}
 			
 			Polynomial<T>& operator[](const ::std::size_t& i)
@@ -1283,10 +1363,12 @@ namespace rl
 				if (!this->polynomials.empty())
 				{
 					this->x1 -= this->polynomials.back().duration();
+					this->breakpoints.pop_back();
 					this->polynomials.pop_back();
 					
 					if (this->polynomials.empty())
 					{
+						this->breakpoints.clear();
 						this->x0 = 0;
 					}
 				}
@@ -1297,8 +1379,10 @@ namespace rl
 				if (this->polynomials.empty())
 				{
 					this->x0 = polynomial.lower();
+					this->breakpoints.push_back(this->x0);
 				}
 				
+				this->breakpoints.push_back(this->breakpoints.back() + polynomial.duration());
 				this->polynomials.push_back(polynomial);
 				this->x1 += polynomial.duration();
 			}
@@ -1331,6 +1415,18 @@ namespace rl
 				return spline;
 			}
 			
+			/**
+			 * Returns the index of the polynomial that defines the spline at x.
+			 *
+			 * Uses a binary search on the cumulative polynomial durations.
+			 */
+			::std::size_t segment(const Real& x) const
+			{
+				assert(this->polynomials.size() > 0);
+				
+				return ::std::lower_bound(this->breakpoints.begin() + 1, this->breakpoints.end() - 1, x) - (this->breakpoints.begin() + 1);
+			}
+			
 			::std::size_t size() const
 			{
 				return this->polynomials.size();
@@ -1357,6 +1453,11 @@ namespace rl
 			}
 			
 		protected:
+			/**
+			 * Cumulative polynomial durations, starting at the lower bound.
+			 */
+			::std::vector<Real> breakpoints;
+			
 			::std::vector<Polynomial<T>> polynomials;
 			
 		private:
@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "Data.h"
+#include "Model.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		Data::Data() :
+			a(),
+			f(),
+			fX(),
+			G(),
+			iC(),
+			invM(),
+			J(),
+			Jdqd(),
+			M(),
+			q(),
+			qd(),
+			qdd(),
+			tau(),
+			V(),
+			v(),
+			x(),
+			xBatch(),
+			xT()
+		{
+		}
+		
+		Data::Data(const Model& model) :
+			a(model.getTransforms(), ::rl::math::MotionVector::Zero()),
+			f(model.getTransforms(), ::rl::math::ForceVector::Zero()),
+			fX(model.getTransforms(), ::rl::math::ForceVector::Zero()),
+			G(::rl::math::Vector::Zero(model.getDof())),
+			iC(model.getTransforms(), ::rl::math::RigidBodyInertia::Zero()),
+			invM(::rl::math::Matrix::Identity(model.getDof(), model.getDof())),
+			J(::rl::math::Matrix::Zero(6 * model.getOperationalDof(), model.getDof())),
+			Jdqd(::rl::math::Vector::Zero(6 * model.getOperationalDof())),
+			M(::rl::math::Matrix::Identity(model.getDof(), model.getDof())),
+			q(model.getHomePosition()),
+			qd(::rl::math::Vector::Zero(model.getDof())),
+			qdd(::rl::math::Vector::Zero(model.getDof())),
+			tau(::rl::math::Vector::Zero(model.getDof())),
+			V(::rl::math::Vector::Zero(model.getDof())),
+			v(model.getTransforms(), ::rl::math::MotionVector::Zero()),
+			x(model.getTransforms(), ::rl::math::PlueckerTransform::Identity()),
+			xBatch(model.getTransforms()),
+			xT(model.getTransforms(), ::rl::math::PlueckerTransform::Identity())
+		{
+		}
+		
+		Data::~Data()
+		{
+		}
+	}
+}
@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_MDL_DATA_H
+#define RL_MDL_DATA_H
+
+#include <vector>
+#include <rl/math/Matrix.h>
+#include <rl/math/Spatial.h>
+#include <rl/math/Vector.h>
+
+#include <rl/mdl/export.h>
+
+namespace rl
+{
+	namespace mdl
+	{
+		class Model;
+		
+		/**
+		 * Workspace for kinematics and dynamics algorithms.
+		 *
+		 * Holds all quantities that depend on the current state of a model,
+		 * while the model itself only provides the immutable description of
+		 * topology, joint axes, and inertias. Algorithms taking a workspace as
+		 * argument, e.g., Kinematic::forwardPosition(Data&) const or
+		 * Dynamic::inverseDynamics(Data&) const, do not modify the model, so a
+		 * single model can be shared by several threads with one workspace each.
+		 *
+		 * Per-frame quantities are stored once for each transform of the model and
+		 * refer to its output frame, using the order of Model::getTransform().
+		 * Joint space quantities use the external coordinates of the model, i.e.,
+		 * before applying Model::getGammaPosition() and Model::getGammaVelocity().
+		 */
+		class RL_MDL_EXPORT Data
+		{
+		public:
+			Data();
+			
+			/**
+			 * Create workspace with all quantities sized for a model.
+			 *
+			 * Positions are initialized with the home position of the model,
+			 * all other quantities are set to zero.
+			 */
+			explicit Data(const Model& model);
+			
+			virtual ~Data();
+			
+			/** Frame accelerations in frame coordinates. */
+			::std::vector<::rl::math::MotionVector, ::Eigen::aligned_allocator<::rl::math::MotionVector>> a;
+			
+			/** Frame forces in frame coordinates. */
+			::std::vector<::rl::math::ForceVector, ::Eigen::aligned_allocator<::rl::math::ForceVector>> f;
+			
+			/** External forces acting on bodies in world coordinates. */
+			::std::vector<::rl::math::ForceVector, ::Eigen::aligned_allocator<::rl::math::ForceVector>> fX;
+			
+			/** Gravity vector \f$\vec{G}(\vec{q})\f$. */
+			::rl::math::Vector G;
+			
+			/** Composite rigid body inertias of the subtrees rooted at each frame. */
+			::std::vector<::rl::math::RigidBodyInertia, ::Eigen::aligned_allocator<::rl::math::RigidBodyInertia>> iC;
+			
+			/** Joint space mass matrix inverse \f$\matr{M}^{-1}(\vec{q})\f$. */
+			::rl::math::Matrix invM;
+			
+			/** Jacobian matrix \f$\matr{J}(\vec{q})\f$. */
+			::rl::math::Matrix J;
+			
+			/** Jacobian derivative vector \f$\dot{\matr{J}}(\vec{q}, \dot{\vec{q}}) \, \dot{\vec{q}}\f$. */
+			::rl::math::Vector Jdqd;
+			
+			/** Joint space mass matrix \f$\matr{M}(\vec{q})\f$. */
+			::rl::math::Matrix M;
+			
+			/** Joint positions \f$\vec{q}\f$. */
+			::rl::math::Vector q;
+			
+			/** Joint velocities \f$\dot{\vec{q}}\f$. */
+			::rl::math::Vector qd;
+			
+			/** Joint accelerations \f$\ddot{\vec{q}}\f$. */
+			::rl::math::Vector qdd;
+			
+			/** Joint torques \f$\vec{\tau}\f$. */
+			::rl::math::Vector tau;
+			
+			/** Centrifugal and Coriolis vector \f$\vec{V}(\vec{q}, \dot{\vec{q}})\f$. */
+			::rl::math::Vector V;
+			
+			/** Frame velocities in frame coordinates. */
+			::std::vector<::rl::math::MotionVector, ::Eigen::aligned_allocator<::rl::math::MotionVector>> v;
+			
+			/** Frame poses in world coordinates. */
+			::std::vector<::rl::math::PlueckerTransform, ::Eigen::aligned_allocator<::rl::math::PlueckerTransform>> x;
+			
+			/**
+			 * Frame poses in world coordinates for a batch of configurations.
+			 *
+			 * One matrix per transform with one configuration per row and the upper
+			 * \f$3 \times 4\f$ part of the homogeneous matrix in column-major order.
+			 *
+			 * @see Kinematic::forwardPosition(Data&, const ::rl::math::Matrix&) const
+			 */
+			::std::vector<::rl::math::Matrix> xBatch;
+			
+			/** Transforms from input to output frame, including joint motion. */
+			::std::vector<::rl::math::PlueckerTransform, ::Eigen::aligned_allocator<::rl::math::PlueckerTransform>> xT;
+			
+		protected:
+			
+		private:
+			
+		};
+	}
+}
+
+#endif // RL_MDL_DATA_H
@@ -0,0 +1,367 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "DormandPrinceIntegrator.h"
+#include "Dynamic.h"
+#include "Exception.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		namespace
+		{
+			/** Runge-Kutta matrix, the last row equals the weights of the solution of fifth order. */
+			constexpr ::rl::math::Real a[7][6] = {
+				{0, 0, 0, 0, 0, 0},
+				{1.0 / 5.0, 0, 0, 0, 0, 0},
+				{3.0 / 40.0, 9.0 / 40.0, 0, 0, 0, 0},
+				{44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0, 0, 0, 0},
+				{19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0, 0, 0},
+				{9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0, 0},
+				{35.0 / 384.0, 0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0}
+			};
+			
+			/** Coefficients of dense output. */
+			constexpr ::rl::math::Real d[7] = {
+				-12715105075.0 / 11282082432.0,
+				0,
+				87487479700.0 / 32700410799.0,
+				-10690763975.0 / 1880347072.0,
+				701980252875.0 / 199316789632.0,
+				-1453857185.0 / 822651844.0,
+				69997945.0 / 29380423.0
+			};
+			
+			/** Difference between the weights of fifth and fourth order. */
+			constexpr ::rl::math::Real e[7] = {
+				71.0 / 57600.0,
+				0,
+				-71.0 / 16695.0,
+				71.0 / 1920.0,
+				-17253.0 / 339200.0,
+				22.0 / 525.0,
+				-1.0 / 40.0
+			};
+		}
+		
+		DormandPrinceIntegrator::DormandPrinceIntegrator(Dynamic* dynamic) :
+			Integrator(dynamic),
+			absoluteTolerance(static_cast<::rl::math::Real>(1.0e-6)),
+			dq(),
+			dqd(),
+			evaluations(0),
+			kq(),
+			kqd(),
+			lastStepSize(0),
+			minimumStepSize(static_cast<::rl::math::Real>(1.0e-12)),
+			q(),
+			q0(),
+			qd(),
+			qd0(),
+			qdd(),
+			rejections(0),
+			relativeTolerance(static_cast<::rl::math::Real>(1.0e-6)),
+			stepSize(0),
+			steps(0),
+			tau()
+		{
+			this->resize();
+		}
+		
+		DormandPrinceIntegrator::~DormandPrinceIntegrator()
+		{
+		}
+		
+		const ::rl::math::Real&
+		DormandPrinceIntegrator::getAbsoluteTolerance() const
+		{
+			return this->absoluteTolerance;
+		}
+		
+		const ::std::size_t&
+		DormandPrinceIntegrator::getEvaluations() const
+		{
+			return this->evaluations;
+		}
+		
+		const ::rl::math::Real&
+		DormandPrinceIntegrator::getLastStepSize() const
+		{
+			return this->lastStepSize;
+		}
+		
+		const ::rl::math::Real&
+		DormandPrinceIntegrator::getMinimumStepSize() const
+		{
+			return this->minimumStepSize;
+		}
+		
+		const ::std::size_t&
+		DormandPrinceIntegrator::getRejections() const
+		{
+			return this->rejections;
+		}
+		
+		const ::rl::math::Real&
+		DormandPrinceIntegrator::getRelativeTolerance() const
+		{
+			return this->relativeTolerance;
+		}
+		
+		const ::rl::math::Real&
+		DormandPrinceIntegrator::getStepSize() const
+		{
+			return this->stepSize;
+		}
+		
+		const ::std::size_t&
+		DormandPrinceIntegrator::getSteps() const
+		{
+			return this->steps;
+		}
+		
+		void
+		DormandPrinceIntegrator::integrate(const ::rl::math::Real& dt)
+		{
+			if (dt <= 0)
+			{
+				return;
+			}
+			
+			if (static_cast<::std::size_t>(this->q0.size()) != this->dynamic->getDof())
+			{
+				this->resize();
+			}
+			
+			this->q = this->dynamic->getPosition();
+			this->qd = this->dynamic->getVelocity();
+			
+			// reuse the last derivative if state and torque are unchanged since the last call
+			
+			if (0 == this->lastStepSize || this->q != this->q0 || this->qd != this->qd0 || this->dynamic->getTorque() != this->tau)
+			{
+				this->q0 = this->q;
+				this->qd0 = this->qd;
+				this->tau = this->dynamic->getTorque();
+				
+				this->dynamic->forwardDynamics();
+				++this->evaluations;
+				
+				this->kq.col(0) = this->qd0;
+				this->kqd.col(0) = this->dynamic->getAcceleration();
+			}
+			
+			::rl::math::Real h = this->stepSize > 0 ? this->stepSize : dt;
+			bool rejected = false;
+			::rl::math::Real t = 0;
+			
+			while (t < dt)
+			{
+				::rl::math::Real proposed = h;
+				bool last = false;
+				
+				if (t + h >= dt)
+				{
+					h = dt - t;
+					last = true;
+				}
+				
+				// stages 2 to 7, the last one at the solution of fifth order
+				
+				for (::std::size_t i = 1; i < 7; ++i)
+				{
+					this->q = this->q0;
+					this->qd = this->qd0;
+					
+					for (::std::size_t j = 0; j < i; ++j)
+					{
+						if (0 != a[i][j])
+						{
+							this->q += h * a[i][j] * this->kq.col(j);
+							this->qd += h * a[i][j] * this->kqd.col(j);
+						}
+					}
+					
+					this->dynamic->setPosition(this->q);
+					this->dynamic->setVelocity(this->qd);
+					this->dynamic->forwardDynamics();
+					++this->evaluations;
+					
+					this->kq.col(i) = this->qd;
+					this->kqd.col(i) = this->dynamic->getAcceleration();
+				}
+				
+				// scaled error norm
+				
+				::rl::math::Real error = 0;
+				
+				for (::std::ptrdiff_t i = 0; i < this->q.size(); ++i)
+				{
+					::rl::math::Real eq = 0;
+					::rl::math::Real eqd = 0;
+					
+					for (::std::size_t j = 0; j < 7; ++j)
+					{
+						eq += e[j] * this->kq(i, j);
+						eqd += e[j] * this->kqd(i, j);
+					}
+					
+					eq *= h / (this->absoluteTolerance + this->relativeTolerance * ::std::max(::std::abs(this->q0(i)), ::std::abs(this->q(i))));
+					eqd *= h / (this->absoluteTolerance + this->relativeTolerance * ::std::max(::std::abs(this->qd0(i)), ::std::abs(this->qd(i))));
+					
+					error += eq * eq + eqd * eqd;
+				}
+				
+				error = this->q.size() > 0 ? ::std::sqrt(error / (2 * this->q.size())) : 0;
+				
+				// reject non-finite error with minimum factor, so that minimum step size is reached
+				
+				if (!::std::isfinite(error))
+				{
+					error = ::std::numeric_limits<::rl::math::Real>::infinity();
+				}
+				
+				// step size control with safety factor 0.9 and bounds 0.2 and 5
+				
+				::rl::math::Real factor = error > 0 ? static_cast<::rl::math::Real>(0.9) * ::std::pow(error, static_cast<::rl::math::Real>(-0.2)) : 5;
+				factor = ::std::max(static_cast<::rl::math::Real>(0.2), ::std::min(rejected ? 1 : static_cast<::rl::math::Real>(5), factor));
+				
+				if (error <= 1)
+				{
+					for (::std::size_t i = 0; i < 2; ++i)
+					{
+						::rl::math::Matrix& dy = 0 == i ? this->dq : this->dqd;
+						const ::rl::math::Matrix& k = 0 == i ? this->kq : this->kqd;
+						const ::rl::math::Vector& y0 = 0 == i ? this->q0 : this->qd0;
+						const ::rl::math::Vector& y1 = 0 == i ? this->q : this->qd;
+						
+						dy.col(0) = y0;
+						dy.col(1) = y1 - y0;
+						dy.col(2) = h * k.col(0) - dy.col(1);
+						dy.col(3) = dy.col(1) - h * k.col(6) - dy.col(2);
+						dy.col(4).setZero();
+						
+						for (::std::size_t j = 0; j < 7; ++j)
+						{
+							if (0 != d[j])
+							{
+								dy.col(4) += h * d[j] * k.col(j);
+							}
+						}
+					}
+					
+					this->q0 = this->q;
+					this->qd0 = this->qd;
+					this->kq.col(0) = this->kq.col(6);
+					this->kqd.col(0) = this->kqd.col(6);
+					
+					this->lastStepSize = h;
+					++this->steps;
+					rejected = false;
+					
+					t = last ? dt : t + h;
+					h *= factor;
+					
+					this->stepSize = last && proposed > h ? proposed : h;
+				}
+				else
+				{
+					++this->rejections;
+					rejected = true;
+					
+					h *= factor;
+					
+					if (h < this->minimumStepSize)
+					{
+						this->dynamic->setPosition(this->q0);
+						this->dynamic->setVelocity(this->qd0);
+						throw Exception("rl::mdl::DormandPrinceIntegrator::integrate() - Step size below minimum");
+					}
+				}
+			}
+			
+			this->qdd = this->kqd.col(0);
+			
+			this->dynamic->setPosition(this->q0);
+			this->dynamic->setVelocity(this->qd0);
+			this->dynamic->setAcceleration(this->qdd);
+		}
+		
+		void
+		DormandPrinceIntegrator::interpolate(const ::rl::math::Real& theta, ::rl::math::Vector& q, ::rl::math::Vector& qd) const
+		{
+			::rl::math::Real theta1 = 1 - theta;
+			
+			q = this->dq.col(0) + theta * (this->dq.col(1) + theta1 * (this->dq.col(2) + theta * (this->dq.col(3) + theta1 * this->dq.col(4))));
+			qd = this->dqd.col(0) + theta * (this->dqd.col(1) + theta1 * (this->dqd.col(2) + theta * (this->dqd.col(3) + theta1 * this->dqd.col(4))));
+		}
+		
+		void
+		DormandPrinceIntegrator::resize()
+		{
+			this->lastStepSize = 0;
+			this->dq = ::rl::math::Matrix::Zero(this->dynamic->getDof(), 5);
+			this->dqd = ::rl::math::Matrix::Zero(this->dynamic->getDof(), 5);
+			this->kq.resize(this->dynamic->getDof(), 7);
+			this->kqd.resize(this->dynamic->getDof(), 7);
+			this->q.resize(this->dynamic->getDof());
+			this->q0.resize(this->dynamic->getDof());
+			this->qd.resize(this->dynamic->getDof());
+			this->qd0.resize(this->dynamic->getDof());
+			this->qdd.resize(this->dynamic->getDof());
+			this->tau.resize(this->dynamic->getDof());
+		}
+		
+		void
+		DormandPrinceIntegrator::setAbsoluteTolerance(const ::rl::math::Real& absoluteTolerance)
+		{
+			this->absoluteTolerance = absoluteTolerance;
+		}
+		
+		void
+		DormandPrinceIntegrator::setMinimumStepSize(const ::rl::math::Real& minimumStepSize)
+		{
+			this->minimumStepSize = minimumStepSize;
+		}
+		
+		void
+		DormandPrinceIntegrator::setRelativeTolerance(const ::rl::math::Real& relativeTolerance)
+		{
+			this->relativeTolerance = relativeTolerance;
+		}
+		
+		void
+		DormandPrinceIntegrator::setStepSize(const ::rl::math::Real& stepSize)
+		{
+			this->stepSize = stepSize;
+		}
+	}
+}
@@ -0,0 +1,190 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_MDL_DORMANDPRINCEINTEGRATOR_H
+#define RL_MDL_DORMANDPRINCEINTEGRATOR_H
+
+#include <cstddef>
+#include <rl/math/Matrix.h>
+#include <rl/math/Vector.h>
+
+#include "Integrator.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		/**
+		 * Adaptive integration via Dormand-Prince 5(4).
+		 *
+		 * \f[ \vec{y} = \begin{pmatrix} \vec{q} \\ \dot{\vec{q}} \end{pmatrix} \f]
+		 * \f[ \dot{\vec{y}} = \begin{pmatrix} \dot{\vec{q}} \\ f(t, \vec{q}, \dot{\vec{q}}) \end{pmatrix} \f]
+		 * \f[ \vec{y}_{i + 1} = \vec{y}_{i} + h \sum_{j = 1}^{6} b_{j} \, \vec{k}_{j} \f]
+		 * \f[ \vec{e}_{i + 1} = h \sum_{j = 1}^{7} (b_{j} - \hat{b}_{j}) \, \vec{k}_{j} \f]
+		 *
+		 * The time step \f$\Delta t\f$ is covered by as many internal steps
+		 * \f$h\f$ as necessary to keep the scaled error norm
+		 * \f$\sqrt{\frac{1}{2n} \sum_{l} \left( \frac{e_{l}}{\mathrm{atol} + \mathrm{rtol} \, \max(|y_{i,l}|, |y_{i+1,l}|)} \right)^{2}}\f$
+		 * below one. The last derivative of an accepted step is reused as the
+		 * first derivative of the next one, resulting in six evaluations of
+		 * Dynamic::forwardDynamics() per accepted step. This also applies
+		 * across calls to integrate() as long as position, velocity, and
+		 * torque have not been changed in between. The step size is carried
+		 * over between calls. All state buffers are allocated once for the
+		 * degrees of freedom of the model.
+		 *
+		 * J. R. Dormand and P. J. Prince, A family of embedded Runge-Kutta
+		 * formulae, Journal of Computational and Applied Mathematics, 6(1):19-26,
+		 * 1980.
+		 *
+		 * E. Hairer, S. P. N&oslash;rsett, and G. Wanner, Solving Ordinary
+		 * Differential Equations I, Springer, 1993.
+		 *
+		 * @pre Dynamic::setPosition()
+		 * @pre Dynamic::setVelocity()
+		 * @pre Dynamic::setTorque()
+		 * @post Dynamic::getPosition()
+		 * @post Dynamic::getVelocity()
+		 * @post Dynamic::getAcceleration()
+		 *
+		 * @see Dynamic::forwardDynamics()
+		 */
+		class RL_MDL_EXPORT DormandPrinceIntegrator : public Integrator
+		{
+		public:
+			DormandPrinceIntegrator(Dynamic* dynamic);
+			
+			virtual ~DormandPrinceIntegrator();
+			
+			const ::rl::math::Real& getAbsoluteTolerance() const;
+			
+			/**
+			 * Number of evaluations of Dynamic::forwardDynamics() since construction.
+			 */
+			const ::std::size_t& getEvaluations() const;
+			
+			/**
+			 * Size of the last accepted internal step.
+			 */
+			const ::rl::math::Real& getLastStepSize() const;
+			
+			const ::rl::math::Real& getMinimumStepSize() const;
+			
+			/**
+			 * Number of rejected internal steps since construction.
+			 */
+			const ::std::size_t& getRejections() const;
+			
+			const ::rl::math::Real& getRelativeTolerance() const;
+			
+			/**
+			 * Proposed size of the next internal step.
+			 */
+			const ::rl::math::Real& getStepSize() const;
+			
+			/**
+			 * Number of accepted internal steps since construction.
+			 */
+			const ::std::size_t& getSteps() const;
+			
+			/**
+			 * @param[in] dt Integration time step \f$\Delta t\f$
+			 * 
+			 * @throws Exception if the step size falls below getMinimumStepSize()
+			 */
+			void integrate(const ::rl::math::Real& dt);
+			
+			/**
+			 * Dense output of fourth order within the last accepted internal step.
+			 * 
+			 * @param[in] theta Fraction of the last accepted step, from zero
+			 * at its start to one at its end (getLastStepSize())
+			 * @param[out] q Joint positions
+			 * @param[out] qd Joint velocities
+			 */
+			void interpolate(const ::rl::math::Real& theta, ::rl::math::Vector& q, ::rl::math::Vector& qd) const;
+			
+			void setAbsoluteTolerance(const ::rl::math::Real& absoluteTolerance);
+			
+			void setMinimumStepSize(const ::rl::math::Real& minimumStepSize);
+			
+			void setRelativeTolerance(const ::rl::math::Real& relativeTolerance);
+			
+			/**
+			 * Size of the first internal step, non-positive to start with
+			 * the full time step.
+			 */
+			void setStepSize(const ::rl::math::Real& stepSize);
+			
+		protected:
+			
+		private:
+			void resize();
+			
+			::rl::math::Real absoluteTolerance;
+			
+			/** Dense output coefficients for the positions of the last accepted step. */
+			::rl::math::Matrix dq;
+			
+			/** Dense output coefficients for the velocities of the last accepted step. */
+			::rl::math::Matrix dqd;
+			
+			::std::size_t evaluations;
+			
+			/** Stage derivatives of the positions. */
+			::rl::math::Matrix kq;
+			
+			/** Stage derivatives of the velocities. */
+			::rl::math::Matrix kqd;
+			
+			::rl::math::Real lastStepSize;
+			
+			::rl::math::Real minimumStepSize;
+			
+			::rl::math::Vector q;
+			
+			::rl::math::Vector q0;
+			
+			::rl::math::Vector qd;
+			
+			::rl::math::Vector qd0;
+			
+			::rl::math::Vector qdd;
+			
+			::std::size_t rejections;
+			
+			::rl::math::Real relativeTolerance;
+			
+			::rl::math::Real stepSize;
+			
+			::std::size_t steps;
+			
+			::rl::math::Vector tau;
+		};
+	}
+}
+
+#endif // RL_MDL_DORMANDPRINCEINTEGRATOR_H
@@ -30,6 +30,7 @@
 #include <rl/math/Rotation.h>
 #include <rl/math/Spatial.h>
 
+#include "Body.h"
 #include "EulerCauchyIntegrator.h"
 #include "Exception.h"
 #include "Dynamic.h"
@@ -48,7 +49,9 @@ namespace rl
 			invM(),
 			invMx(),
 			M(),
-			V()
+			V(),
+			lambda(),
+			outBodies()
 		{
 		}
 		
@@ -56,6 +59,53 @@ namespace rl
 		{
 		}
 		
+		void
+		Dynamic::calculateBatchGravity(const ::rl::math::Matrix& q, ::rl::math::Matrix& G)
+		{
+			assert(q.cols() == this->getDofPosition());
+			assert(G.rows() == q.rows());
+			assert(G.cols() == this->getDof());
+			
+			::rl::math::Vector qi(this->getDofPosition());
+			::rl::math::Vector tmp = ::rl::math::Vector::Zero(this->getDof());
+			
+			this->setVelocity(tmp);
+			this->setAcceleration(tmp);
+			
+			for (::std::ptrdiff_t i = 0; i < q.rows(); ++i)
+			{
+				qi = q.row(i).transpose();
+				this->setPosition(qi);
+				this->inverseDynamics();
+				G.row(i) = this->getTorque().transpose();
+			}
+		}
+		
+		void
+		Dynamic::calculateBatchInverseDynamics(const ::rl::math::Matrix& q, const ::rl::math::Matrix& qd, const ::rl::math::Matrix& qdd, ::rl::math::Matrix& tau)
+		{
+			assert(q.cols() == this->getDofPosition());
+			assert(qd.rows() == q.rows() && qd.cols() == this->getDof());
+			assert(qdd.rows() == q.rows() && qdd.cols() == this->getDof());
+			assert(tau.rows() == q.rows() && tau.cols() == this->getDof());
+			
+			::rl::math::Vector qi(this->getDofPosition());
+			::rl::math::Vector qdi(this->getDof());
+			::rl::math::Vector qddi(this->getDof());
+			
+			for (::std::ptrdiff_t i = 0; i < q.rows(); ++i)
+			{
+				qi = q.row(i).transpose();
+				qdi = qd.row(i).transpose();
+				qddi = qdd.row(i).transpose();
+				this->setPosition(qi);
+				this->setVelocity(qdi);
+				this->setAcceleration(qddi);
+				this->inverseDynamics();
+				tau.row(i) = this->getTorque().transpose();
+			}
+		}
+		
 		void
 		Dynamic::calculateCentrifugalCoriolis()
 		{
@@ -78,6 +128,13 @@ namespace rl
 			this->setWorldGravity(g);
 		}
 		
+		void
+		Dynamic::calculateCentrifugalCoriolis(Data& data) const
+		{
+			this->forwardPosition(data);
+			this->recursiveNewtonEuler(data, this->gammaVelocity * data.qd, ::rl::math::Vector::Zero(this->getDof()), ::rl::math::Vector3::Zero(), data.V);
+		}
+		
 		void
 		Dynamic::calculateGravity()
 		{
@@ -97,79 +154,283 @@ namespace rl
 		}
 		
 		void
-		Dynamic::calculateMassMatrix()
+		Dynamic::calculateGravity(Data& data) const
 		{
-			this->calculateMassMatrix(this->M);
+			this->forwardPosition(data);
+			this->recursiveNewtonEuler(data, ::rl::math::Vector::Zero(this->getDof()), ::rl::math::Vector::Zero(this->getDof()), this->getWorldGravity(), data.G);
 		}
 		
 		void
-		Dynamic::calculateMassMatrix(::rl::math::Matrix& M)
+		Dynamic::calculateMassMatrix(const bool& doCrba)
 		{
-			::rl::math::Vector3 g = this->getWorldGravity();
-			
-			::rl::math::Vector tmp = ::rl::math::Vector::Zero(this->getDof());
-			
-			this->setVelocity(tmp);
-			this->setWorldGravity(::rl::math::Vector3::Zero());
-			
-			for (::std::size_t i = 0; i < this->getDof(); ++i)
+			this->calculateMassMatrix(this->M, doCrba);
+		}
+		
+		void
+		Dynamic::calculateMassMatrix(::rl::math::Matrix& M, const bool& doCrba)
+		{
+			if (doCrba)
+			{
+				this->compositeRigidBody(M);
+				M = M * this->gammaVelocity;
+			}
+			else
 			{
-				for (::std::size_t j = 0; j < this->getDof(); ++j)
+				::rl::math::Vector3 g = this->getWorldGravity();
+				
+				::rl::math::Vector tmp = ::rl::math::Vector::Zero(this->getDof());
+				
+				this->setVelocity(tmp);
+				this->setWorldGravity(::rl::math::Vector3::Zero());
+				
+				for (::std::size_t i = 0; i < this->getDof(); ++i)
 				{
-					tmp(j) = i == j ? 1 : 0;
+					for (::std::size_t j = 0; j < this->getDof(); ++j)
+					{
+						tmp(j) = i == j ? 1 : 0;
+					}
+					
+					this->setAcceleration(tmp);
+					this->inverseDynamics();
+					
+					M.col(i) = this->getTorque();
 				}
 				
-				this->setAcceleration(tmp);
-				this->inverseDynamics();
+				this->setWorldGravity(g);
+			}
+		}
+		
+		void
+		Dynamic::calculateMassMatrix(Data& data) const
+		{
+			this->forwardPosition(data);
+			this->compositeRigidBody(data, data.M);
+			data.M = data.M * this->gammaVelocity;
+		}
+		
+		void
+		Dynamic::calculateMassMatrixInverse(const bool& doCrba)
+		{
+			this->calculateMassMatrixInverse(this->invM, doCrba);
+		}
+		
+		void
+		Dynamic::calculateMassMatrixInverse(::rl::math::Matrix& invM, const bool& doCrba)
+		{
+			if (doCrba)
+			{
+				::rl::math::Matrix L(this->getDof(), this->getDof());
+				this->compositeRigidBody(L);
+				this->factorizeLtl(L);
+				this->invertLtl(L, invM);
+				
+				invM = this->invGammaVelocity * invM;
+			}
+			else
+			{
+				::rl::math::Vector3 g = this->getWorldGravity();
+				
+				::rl::math::Vector tmp = ::rl::math::Vector::Zero(this->getDof());
+				
+				this->setVelocity(tmp);
+				this->setWorldGravity(::rl::math::Vector3::Zero());
 				
-				M.col(i) = this->getTorque();
+				for (::std::size_t i = 0; i < this->getDof(); ++i)
+				{
+					for (::std::size_t j = 0; j < this->getDof(); ++j)
+					{
+						tmp(j) = i == j ? 1 : 0;
+					}
+					
+					this->setTorque(tmp);
+					this->forwardDynamics();
+					
+					invM.col(i) = this->getAcceleration();
+				}
+				
+				this->setWorldGravity(g);
 			}
+		}
+		
+		void
+		Dynamic::calculateMassMatrixInverse(Data& data) const
+		{
+			this->forwardPosition(data);
 			
-			this->setWorldGravity(g);
+			::rl::math::Matrix L(this->getDof(), this->getDof());
+			this->compositeRigidBody(data, L);
+			this->factorizeLtl(L);
+			this->invertLtl(L, data.invM);
+			
+			data.invM = this->invGammaVelocity * data.invM;
 		}
 		
 		void
-		Dynamic::calculateMassMatrixInverse()
+		Dynamic::calculateOperationalMassMatrixInverse()
 		{
-			this->calculateMassMatrixInverse(this->invM);
+			this->calculateOperationalMassMatrixInverse(this->J, this->invM, this->invMx);
 		}
 		
 		void
-		Dynamic::calculateMassMatrixInverse(::rl::math::Matrix& invM)
+		Dynamic::calculateOperationalMassMatrixInverse(const ::rl::math::Matrix& J, const ::rl::math::Matrix& invM, ::rl::math::Matrix& invMx) const
 		{
-			::rl::math::Vector3 g = this->getWorldGravity();
+			invMx = J * invM * J.transpose();
+		}
+		
+		void
+		Dynamic::compositeRigidBody(::rl::math::Matrix& H)
+		{
+			for (::std::vector<Frame*>::iterator i = this->frames.begin(); i != this->frames.end(); ++i)
+			{
+				(*i)->iC.setZero();
+			}
 			
-			::rl::math::Vector tmp = ::rl::math::Vector::Zero(this->getDof());
+			for (::std::vector<Body*>::iterator i = this->bodies.begin(); i != this->bodies.end(); ++i)
+			{
+				(*i)->iC = (*i)->i;
+			}
 			
-			this->setVelocity(tmp);
-			this->setWorldGravity(::rl::math::Vector3::Zero());
+			for (::std::vector<Transform*>::reverse_iterator i = this->transforms.rbegin(); i != this->transforms.rend(); ++i)
+			{
+				// I^c + X^* * I^c * X
+				(*i)->in->iC += (*i)->x / (*i)->out->iC;
+			}
+			
+			H.setZero();
 			
-			for (::std::size_t i = 0; i < this->getDof(); ++i)
+			::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic, ::Eigen::ColMajor, 6, 6> F;
+			
+			for (::std::size_t i = 0; i < this->transforms.size(); ++i)
 			{
-				for (::std::size_t j = 0; j < this->getDof(); ++j)
+				if (this->offsets[i] < 0)
 				{
-					tmp(j) = i == j ? 1 : 0;
+					continue;
 				}
 				
-				this->setTorque(tmp);
-				this->forwardDynamics();
+				Joint* joint = static_cast<Joint*>(this->transforms[i]);
+				
+				F.resize(6, joint->getDof());
 				
-				invM.col(i) = this->getAcceleration();
+				for (::std::size_t k = 0; k < joint->getDof(); ++k)
+				{
+					// I^c * S
+					F.col(k) = (joint->out->iC * ::rl::math::MotionVector(joint->S.col(k))).matrix();
+				}
+				
+				// S^T * F
+				H.block(this->offsets[i], this->offsets[i], joint->getDof(), joint->getDof()) = joint->S.transpose() * F;
+				
+				for (::std::ptrdiff_t j = i; this->parents[j] >= 0; j = this->parents[j])
+				{
+					for (::std::size_t k = 0; k < joint->getDof(); ++k)
+					{
+						// X^* * F
+						F.col(k) = (this->transforms[j]->x / ::rl::math::ForceVector(F.col(k))).matrix();
+					}
+					
+					::std::ptrdiff_t parent = this->parents[j];
+					
+					if (this->offsets[parent] >= 0)
+					{
+						Joint* ancestor = static_cast<Joint*>(this->transforms[parent]);
+						// F^T * S
+						H.block(this->offsets[i], this->offsets[parent], joint->getDof(), ancestor->getDof()) = F.transpose() * ancestor->S;
+						H.block(this->offsets[parent], this->offsets[i], ancestor->getDof(), joint->getDof()) = H.block(this->offsets[i], this->offsets[parent], joint->getDof(), ancestor->getDof()).transpose();
+					}
+				}
 			}
-			
-			this->setWorldGravity(g);
 		}
 		
 		void
-		Dynamic::calculateOperationalMassMatrixInverse()
+		Dynamic::compositeRigidBody(Data& data, ::rl::math::Matrix& H) const
 		{
-			this->calculateOperationalMassMatrixInverse(this->J, this->invM, this->invMx);
+			for (::std::size_t i = 0; i < this->transforms.size(); ++i)
+			{
+				if (nullptr != this->outBodies[i])
+				{
+					data.iC[i] = this->outBodies[i]->i;
+				}
+				else
+				{
+					data.iC[i].setZero();
+				}
+			}
+			
+			for (::std::ptrdiff_t i = this->transforms.size() - 1; i >= 0; --i)
+			{
+				if (this->parents[i] >= 0)
+				{
+					// I^c + X^* * I^c * X
+					data.iC[this->parents[i]] += data.xT[i] / data.iC[i];
+				}
+			}
+			
+			H.setZero();
+			
+			::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic, ::Eigen::ColMajor, 6, 6> F;
+			
+			for (::std::size_t i = 0; i < this->transforms.size(); ++i)
+			{
+				if (this->offsets[i] < 0)
+				{
+					continue;
+				}
+				
+				Joint* joint = static_cast<Joint*>(this->transforms[i]);
+				
+				F.resize(6, joint->getDof());
+				
+				for (::std::size_t k = 0; k < joint->getDof(); ++k)
+				{
+					// I^c * S
+					F.col(k) = (data.iC[i] * ::rl::math::MotionVector(joint->S.col(k))).matrix();
+				}
+				
+				// S^T * F
+				H.block(this->offsets[i], this->offsets[i], joint->getDof(), joint->getDof()) = joint->S.transpose() * F;
+				
+				for (::std::ptrdiff_t j = i; this->parents[j] >= 0; j = this->parents[j])
+				{
+					for (::std::size_t k = 0; k < joint->getDof(); ++k)
+					{
+						// X^* * F
+						F.col(k) = (data.xT[j] / ::rl::math::ForceVector(F.col(k))).matrix();
+					}
+					
+					::std::ptrdiff_t parent = this->parents[j];
+					
+					if (this->offsets[parent] >= 0)
+					{
+						Joint* ancestor = static_cast<Joint*>(this->transforms[parent]);
+						// F^T * S
+						H.block(this->offsets[i], this->offsets[parent], joint->getDof(), ancestor->getDof()) = F.transpose() * ancestor->S;
+						H.block(this->offsets[parent], this->offsets[i], ancestor->getDof(), joint->getDof()) = H.block(this->offsets[i], this->offsets[parent], joint->getDof(), ancestor->getDof()).transpose();
+					}
+				}
+			}
 		}
 		
 		void
-		Dynamic::calculateOperationalMassMatrixInverse(const ::rl::math::Matrix& J, const ::rl::math::Matrix& invM, ::rl::math::Matrix& invMx) const
+		Dynamic::factorizeLtl(::rl::math::Matrix& H) const
 		{
-			invMx = J * invM * J.transpose();
+			// H = L^T * L
+			for (::std::ptrdiff_t k = H.rows() - 1; k >= 0; --k)
+			{
+				H(k, k) = ::std::sqrt(H(k, k));
+				
+				for (::std::ptrdiff_t i = this->lambda[k]; i >= 0; i = this->lambda[i])
+				{
+					H(k, i) /= H(k, k);
+				}
+				
+				for (::std::ptrdiff_t i = this->lambda[k]; i >= 0; i = this->lambda[i])
+				{
+					for (::std::ptrdiff_t j = i; j >= 0; j = this->lambda[j])
+					{
+						H(i, j) -= H(k, i) * H(k, j);
+					}
+				}
+			}
 		}
 		
 		void
@@ -198,6 +459,25 @@ namespace rl
 			}
 		}
 		
+		void
+		Dynamic::forwardDynamics(Data& data) const
+		{
+			this->forwardPosition(data);
+			
+			::rl::math::Vector h(this->getDof());
+			this->recursiveNewtonEuler(data, this->gammaVelocity * data.qd, ::rl::math::Vector::Zero(this->getDof()), this->getWorldGravity(), h);
+			
+			::rl::math::Matrix L(this->getDof(), this->getDof());
+			this->compositeRigidBody(data, L);
+			this->factorizeLtl(L);
+			
+			// H^-1 * (tau - C - G)
+			::rl::math::Vector qdd = data.tau - h;
+			this->solveLtl(L, qdd);
+			
+			data.qdd = this->invGammaVelocity * qdd;
+		}
+		
 		const ::rl::math::Vector&
 		Dynamic::getCentrifugalCoriolis() const
 		{
@@ -242,6 +522,13 @@ namespace rl
 			}
 		}
 		
+		void
+		Dynamic::inverseDynamics(Data& data) const
+		{
+			this->forwardPosition(data);
+			this->recursiveNewtonEuler(data, this->gammaVelocity * data.qd, this->gammaVelocity * data.qdd, this->getWorldGravity(), data.tau);
+		}
+		
 		void
 		Dynamic::inverseForce()
 		{
@@ -251,6 +538,125 @@ namespace rl
 			}
 		}
 		
+		void
+		Dynamic::invertLtl(const ::rl::math::Matrix& L, ::rl::math::Matrix& invH) const
+		{
+			for (::std::ptrdiff_t k = 0; k < L.rows(); ++k)
+			{
+				invH.col(k).setZero();
+				invH(k, k) = 1;
+				
+				// L^-T * e_k, only nonzero for ancestors of k
+				for (::std::ptrdiff_t i = k; i >= 0; i = this->lambda[i])
+				{
+					invH(i, k) /= L(i, i);
+					
+					for (::std::ptrdiff_t j = this->lambda[i]; j >= 0; j = this->lambda[j])
+					{
+						invH(j, k) -= L(i, j) * invH(i, k);
+					}
+				}
+				
+				// L^-1 * L^-T * e_k
+				for (::std::ptrdiff_t i = 0; i < L.rows(); ++i)
+				{
+					for (::std::ptrdiff_t j = this->lambda[i]; j >= 0; j = this->lambda[j])
+					{
+						invH(i, k) -= L(i, j) * invH(j, k);
+					}
+					
+					invH(i, k) /= L(i, i);
+				}
+			}
+		}
+		
+		void
+		Dynamic::recursiveNewtonEuler(Data& data, const ::rl::math::Vector& qd, const ::rl::math::Vector& qdd, const ::rl::math::Vector3& g, ::rl::math::Vector& tau) const
+		{
+			::rl::math::MotionVector a0;
+			a0.angular().setZero();
+			a0.linear() = g;
+			
+			for (::std::size_t i = 0; i < this->transforms.size(); ++i)
+			{
+				::rl::math::MotionVector v = this->parents[i] < 0 ? ::rl::math::MotionVector::Zero() : data.v[this->parents[i]];
+				::rl::math::MotionVector a = this->parents[i] < 0 ? a0 : data.a[this->parents[i]];
+				
+				if (this->offsets[i] >= 0)
+				{
+					Joint* joint = static_cast<Joint*>(this->transforms[i]);
+					// S * qd
+					::rl::math::MotionVector vj(joint->S * qd.segment(this->offsets[i], joint->getDof()));
+					// S * qdd
+					::rl::math::MotionVector aj(joint->S * qdd.segment(this->offsets[i], joint->getDof()));
+					// X * v + vj
+					data.v[i] = data.xT[i] * v + vj;
+					// X * a + aj + cj + v x vj
+					data.a[i] = data.xT[i] * a + aj + joint->c + data.v[i].cross(vj);
+				}
+				else
+				{
+					// X * v
+					data.v[i] = data.xT[i] * v;
+					// X * a
+					data.a[i] = data.xT[i] * a;
+				}
+				
+				if (nullptr != this->outBodies[i])
+				{
+					const ::rl::math::RigidBodyInertia& inertia = this->outBodies[i]->i;
+					// I * a + v x I * v - X_0 * f^x
+					data.f[i] = inertia * data.a[i] + data.v[i].cross(inertia * data.v[i]) - data.x[i] * data.fX[i];
+				}
+				else
+				{
+					data.f[i].setZero();
+				}
+			}
+			
+			for (::std::ptrdiff_t i = this->transforms.size() - 1; i >= 0; --i)
+			{
+				if (this->offsets[i] >= 0)
+				{
+					Joint* joint = static_cast<Joint*>(this->transforms[i]);
+					// S^T * f
+					tau.segment(this->offsets[i], joint->getDof()) = joint->S.transpose() * data.f[i].matrix();
+				}
+				
+				if (this->parents[i] >= 0)
+				{
+					// f + X * f
+					data.f[this->parents[i]] = data.f[this->parents[i]] + data.xT[i] / data.f[i];
+				}
+			}
+		}
+		
+		void
+		Dynamic::solveLtl(const ::rl::math::Matrix& L, ::rl::math::Vector& x) const
+		{
+			// L^-T * x
+			for (::std::ptrdiff_t i = L.rows() - 1; i >= 0; --i)
+			{
+				x(i) /= L(i, i);
+				
+				for (::std::ptrdiff_t j = this->lambda[i]; j >= 0; j = this->lambda[j])
+				{
+					x(j) -= L(i, j) * x(i);
+				}
+			}
+			
+			// L^-1 * L^-T * x
+			for (::std::ptrdiff_t i = 0; i < L.rows(); ++i)
+			{
+				for (::std::ptrdiff_t j = this->lambda[i]; j >= 0; j = this->lambda[j])
+				{
+					x(i) -= L(i, j) * x(j);
+				}
+				
+				x(i) /= L(i, i);
+			}
+		}
+		
 		void
 		Dynamic::rungeKuttaNystrom(const ::rl::math::Real& dt)
 		{
@@ -268,6 +674,39 @@ namespace rl
 			this->G = ::rl::math::Vector::Zero(this->getDof());
 			this->invM = ::rl::math::Matrix::Identity(this->getDof(), this->getDof());
 			this->invMx = ::rl::math::Matrix::Identity(6 * this->getOperationalDof(), 6 * this->getOperationalDof());
+			
+			this->lambda.clear();
+			this->outBodies.clear();
+			
+			for (::std::size_t i = 0; i < this->transforms.size(); ++i)
+			{
+				this->outBodies.push_back(dynamic_cast<Body*>(this->transforms[i]->out));
+			}
+			
+			for (::std::size_t i = 0; i < this->transforms.size(); ++i)
+			{
+				if (this->offsets[i] < 0)
+				{
+					continue;
+				}
+				
+				// last degree of freedom of closest ancestor joint
+				::std::ptrdiff_t parent = -1;
+				
+				for (::std::ptrdiff_t j = this->parents[i]; j >= 0; j = this->parents[j])
+				{
+					if (this->offsets[j] >= 0)
+					{
+						parent = this->offsets[j] + static_cast<Joint*>(this->transforms[j])->getDof() - 1;
+						break;
+					}
+				}
+				
+				for (::std::size_t j = 0; j < static_cast<Joint*>(this->transforms[i])->getDof(); ++j)
+				{
+					this->lambda.push_back(0 == j ? parent : this->offsets[i] + j - 1);
+				}
+			}
 		}
 	}
 }
@@ -40,6 +40,41 @@ namespace rl
 			
 			virtual ~Dynamic();
 			
+			/**
+			 * Calculate gravity vectors for a batch of configurations.
+			 *
+			 * Configurations and results are stored one per row. This is a
+			 * convenience function that evaluates inverseDynamics() once per
+			 * configuration, joint velocities and accelerations are set to zero
+			 * once for the whole batch.
+			 *
+			 * @param[in] q Joint positions, one configuration per row (\f$n \times\f$ getDofPosition())
+			 * @param[out] G Gravity vectors (\f$n \times\f$ getDof())
+			 *
+			 * @post Model state corresponds to the last configuration in \p q
+			 *
+			 * @see calculateGravity(::rl::math::Vector&)
+			 */
+			void calculateBatchGravity(const ::rl::math::Matrix& q, ::rl::math::Matrix& G);
+			
+			/**
+			 * Calculate inverse dynamics for a batch of configurations.
+			 *
+			 * Configurations and results are stored one per row. This is a
+			 * convenience function that evaluates inverseDynamics() once per
+			 * configuration.
+			 *
+			 * @param[in] q Joint positions, one configuration per row (\f$n \times\f$ getDofPosition())
+			 * @param[in] qd Joint velocities (\f$n \times\f$ getDof())
+			 * @param[in] qdd Joint accelerations (\f$n \times\f$ getDof())
+			 * @param[out] tau Joint torques (\f$n \times\f$ getDof())
+			 *
+			 * @post Model state corresponds to the last configuration in \p q
+			 *
+			 * @see inverseDynamics()
+			 */
+			void calculateBatchInverseDynamics(const ::rl::math::Matrix& q, const ::rl::math::Matrix& qd, const ::rl::math::Matrix& qdd, ::rl::math::Matrix& tau);
+			
 			/**
 			 * Calculate centrifugal and Coriolis vector.
 			 *
@@ -63,6 +98,15 @@ namespace rl
 			 */
 			void calculateCentrifugalCoriolis(::rl::math::Vector& V);
 			
+			/**
+			 * Calculate centrifugal and Coriolis vector in a workspace.
+			 *
+			 * @param[in,out] data Workspace with joint positions and velocities, receives Data::V
+			 *
+			 * @see inverseDynamics(Data&) const
+			 */
+			void calculateCentrifugalCoriolis(Data& data) const;
+			
 			/**
 			 * Calculate gravity vector.
 			 *
@@ -84,47 +128,93 @@ namespace rl
 			 */
 			void calculateGravity(::rl::math::Vector& G);
 			
+			/**
+			 * Calculate gravity vector in a workspace.
+			 *
+			 * @param[in,out] data Workspace with joint positions, receives Data::G
+			 *
+			 * @see inverseDynamics(Data&) const
+			 */
+			void calculateGravity(Data& data) const;
+			
 			/**
 			 * Calculate joint space mass matrix.
 			 *
+			 * @param[in] doCrba Use composite-rigid-body algorithm or inverse dynamics
+			 *
 			 * @pre setPosition()
 			 * @post getMassMatrix()
 			 *
 			 * @see inverseDynamics()
 			 */
-			void calculateMassMatrix();
+			void calculateMassMatrix(const bool& doCrba = true);
 			
 			/**
 			 * Calculate joint space mass matrix.
 			 *
-			 * @param[out] M Joint space mass matrix \f$\matr{M}^{-1}(\vec{q})\f$
+			 * With the composite-rigid-body algorithm, the composite inertias
+			 * are accumulated in one backward pass over the kinematic tree and
+			 * each joint only contributes to the entries of its ancestors.
+			 * Otherwise, one column is calculated per unit acceleration via
+			 * inverse dynamics.
+			 *
+			 * @param[out] M Joint space mass matrix \f$\matr{M}(\vec{q})\f$
+			 * @param[in] doCrba Use composite-rigid-body algorithm or inverse dynamics
 			 *
 			 * @pre setPosition()
 			 *
 			 * @see inverseDynamics()
 			 */
-			void calculateMassMatrix(::rl::math::Matrix& M);
+			void calculateMassMatrix(::rl::math::Matrix& M, const bool& doCrba = true);
+			
+			/**
+			 * Calculate joint space mass matrix in a workspace via composite-rigid-body algorithm.
+			 *
+			 * @param[in,out] data Workspace with joint positions, receives Data::M
+			 */
+			void calculateMassMatrix(Data& data) const;
 			
 			/**
 			 * Calculate joint space mass matrix inverse.
 			 *
+			 * @param[in] doCrba Use composite-rigid-body algorithm with LTL factorization or forward dynamics
+			 *
 			 * @pre setPosition()
 			 * @post getMassMatrixInverse()
 			 *
 			 * @see forwardDynamics()
 			 */
-			void calculateMassMatrixInverse();
+			void calculateMassMatrixInverse(const bool& doCrba = true);
 			
 			/**
 			 * Calculate joint space mass matrix inverse.
 			 *
+			 * With the composite-rigid-body algorithm, the mass matrix is
+			 * factorized into \f$\matr{L}^{\mathrm{T}} \, \matr{L}\f$
+			 * without fill-in along the branches of the kinematic tree and
+			 * inverted by sparse back substitution. Otherwise, one column is
+			 * calculated per unit torque via forward dynamics.
+			 *
+			 * Roy Featherstone. Efficient factorization of the joint-space
+			 * inertia matrix for branched kinematic trees. The International
+			 * Journal of Robotics Research, 24(6):487-500, 2005.
+			 *
 			 * @param[out] invM Joint space mass matrix inverse \f$\matr{M}^{-1}(\vec{q})\f$
+			 * @param[in] doCrba Use composite-rigid-body algorithm with LTL factorization or forward dynamics
 			 *
 			 * @pre setPosition()
 			 *
 			 * @see forwardDynamics()
 			 */
-			void calculateMassMatrixInverse(::rl::math::Matrix& invM);
+			void calculateMassMatrixInverse(::rl::math::Matrix& invM, const bool& doCrba = true);
+			
+			/**
+			 * Calculate joint space mass matrix inverse in a workspace via
+			 * composite-rigid-body algorithm and LTL factorization.
+			 *
+			 * @param[in,out] data Workspace with joint positions, receives Data::invM
+			 */
+			void calculateMassMatrixInverse(Data& data) const;
 			
 			/**
 			 * Calculate operational space mass matrix inverse.
@@ -160,6 +250,17 @@ namespace rl
 			 */
 			void forwardDynamics();
 			
+			/**
+			 * Forward dynamics in a workspace.
+			 *
+			 * Solves \f$\matr{M}(\vec{q}) \, \ddot{\vec{q}} = \vec{\tau} - \vec{C}(\vec{q}, \dot{\vec{q}}) - \vec{G}(\vec{q})\f$
+			 * via composite-rigid-body algorithm and LTL factorization, with
+			 * the bias forces calculated via inverse dynamics.
+			 *
+			 * @param[in,out] data Workspace with joint positions, velocities, and torques, receives Data::qdd
+			 */
+			void forwardDynamics(Data& data) const;
+			
 			/**
 			 * Access calculated centrifugal and Coriolis vector.
 			 *
@@ -226,6 +327,16 @@ namespace rl
 			 */
 			void inverseDynamics();
 			
+			/**
+			 * Inverse dynamics in a workspace via recursive Newton-Euler algorithm.
+			 *
+			 * Frame poses, velocities, accelerations, and forces of the workspace are
+			 * updated, the model is not modified.
+			 *
+			 * @param[in,out] data Workspace with joint positions, velocities, and accelerations, receives Data::tau
+			 */
+			void inverseDynamics(Data& data) const;
+			
 			void inverseForce();
 			
 			RL_MDL_DEPRECATED void rungeKuttaNystrom(const ::rl::math::Real& dt);
@@ -289,7 +400,21 @@ namespace rl
 			::rl::math::Vector V;
 			
 		private:
+			void compositeRigidBody(::rl::math::Matrix& H);
+			
+			void compositeRigidBody(Data& data, ::rl::math::Matrix& H) const;
+			
+			void factorizeLtl(::rl::math::Matrix& H) const;
+			
+			void invertLtl(const ::rl::math::Matrix& L, ::rl::math::Matrix& invH) const;
+			
+			void recursiveNewtonEuler(Data& data, const ::rl::math::Vector& qd, const ::rl::math::Vector& qdd, const ::rl::math::Vector3& g, ::rl::math::Vector& tau) const;
+			
+			void solveLtl(const ::rl::math::Matrix& L, ::rl::math::Vector& x) const;
+			
+			::std::vector<::std::ptrdiff_t> lambda;
 			
+			::std::vector<Body*> outBodies;
 		};
 	}
 }
@@ -88,6 +88,8 @@ namespace rl
 			
 			::rl::math::ArticulatedBodyInertia iA;
 			
+			::rl::math::RigidBodyInertia iC;
+			
 			::rl::math::ForceVector pA;
 			
 			::rl::math::MotionVector v;
@@ -49,6 +49,13 @@ namespace rl
 		{
 		}
 		
+		void
+		Helical::calculateTransform(const ::rl::math::ConstVectorRef& q, ::rl::math::PlueckerTransform& x) const
+		{
+			x.linear() = ::rl::math::AngleAxis(q(0), this->S.block<3, 1>(0, 0)).toRotationMatrix();
+			x.translation() = this->S.block<3, 1>(3, 0) * this->h * (q(0) + this->offset(0));
+		}
+		
 		::rl::math::Real
 		Helical::getPitch() const
 		{
@@ -66,8 +73,7 @@ namespace rl
 		Helical::setPosition(const ::rl::math::ConstVectorRef& q)
 		{
 			this->q = q;
-			this->x.linear() = ::rl::math::AngleAxis(this->q(0), this->S.block<3, 1>(0, 0)).toRotationMatrix();
-			this->x.translation() = this->S.block<3, 1>(3, 0) * this->h * (this->q(0) + this->offset(0));
+			this->calculateTransform(this->q, this->x);
 		}
 	}
 }
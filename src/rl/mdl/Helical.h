@@ -40,6 +40,8 @@ namespace rl
 			
 			virtual ~Helical();
 			
+			void calculateTransform(const ::rl::math::ConstVectorRef& q, ::rl::math::PlueckerTransform& x) const;
+			
 			::rl::math::Real getPitch() const;
 			
 			void setPitch(const ::rl::math::Real& h);
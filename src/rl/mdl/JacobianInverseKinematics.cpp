@@ -24,6 +24,13 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "JacobianInverseKinematics.h"
 #include "Kinematic.h"
 
@@ -41,7 +48,9 @@ namespace rl
 			method(Method::svd),
 			randDistribution(0, 1),
 			randEngine(::std::random_device()()),
-			steps(100)
+			solutions(1),
+			steps(100),
+			workers(1)
 		{
 		}
 		
@@ -61,12 +70,24 @@ namespace rl
 			return this->method;
 		}
 		
+		const ::std::size_t&
+		JacobianInverseKinematics::getSolutions() const
+		{
+			return this->solutions;
+		}
+		
 		const ::std::size_t&
 		JacobianInverseKinematics::getSteps() const
 		{
 			return this->steps;
 		}
 		
+		const ::std::size_t&
+		JacobianInverseKinematics::getWorkers() const
+		{
+			return this->workers;
+		}
+		
 		void
 		JacobianInverseKinematics::seed(const ::std::mt19937::result_type& value)
 		{
@@ -85,15 +106,32 @@ namespace rl
 			this->method = method;
 		}
 		
+		void
+		JacobianInverseKinematics::setSolutions(const ::std::size_t& solutions)
+		{
+			this->solutions = ::std::max<::std::size_t>(1, solutions);
+		}
+		
 		void
 		JacobianInverseKinematics::setSteps(const ::std::size_t& steps)
 		{
 			this->steps = steps;
 		}
 		
+		void
+		JacobianInverseKinematics::setWorkers(const ::std::size_t& workers)
+		{
+			this->workers = ::std::max<::std::size_t>(1, workers);
+		}
+		
 		bool
 		JacobianInverseKinematics::solve()
 		{
+			if (this->workers > 1 || this->solutions > 1)
+			{
+				return this->solveConcurrent();
+			}
+			
 			::std::chrono::steady_clock::time_point start = ::std::chrono::steady_clock::now();
 			double remaining = ::std::chrono::duration<double>(this->getDuration()).count();
 			::std::size_t attempt = 0;
@@ -181,5 +219,162 @@ namespace rl
 			
 			return false;
 		}
+		
+		bool
+		JacobianInverseKinematics::solveConcurrent()
+		{
+			::std::chrono::steady_clock::time_point start = ::std::chrono::steady_clock::now();
+			::std::atomic<::std::size_t> attempt(0);
+			::std::atomic<bool> done(false);
+			::std::atomic<::std::size_t> iteration(0);
+			::std::mutex mutex;
+			::std::vector<::rl::math::Vector> solutions;
+			
+			const ::rl::math::Vector q0 = this->kinematic->getPosition();
+			
+			::std::vector<::std::mt19937::result_type> seeds(this->workers);
+			
+			for (::std::size_t i = 0; i < seeds.size(); ++i)
+			{
+				seeds[i] = this->randEngine();
+			}
+			
+			::std::function<void(const ::std::size_t&)> worker = [&](const ::std::size_t& w)
+			{
+				::std::uniform_real_distribution<::rl::math::Real> randDistribution(this->randDistribution);
+				::std::mt19937 randEngine(seeds[w]);
+				Data data(*this->kinematic);
+				
+				::rl::math::Vector q(this->kinematic->getDofPosition());
+				::rl::math::Vector q2(this->kinematic->getDofPosition());
+				::rl::math::Vector dq(this->kinematic->getDof());
+				::rl::math::Vector dx(6 * this->kinematic->getOperationalDof());
+				::rl::math::Matrix invJ(this->kinematic->getDof(), 6 * this->kinematic->getOperationalDof());
+				
+				::rl::math::Vector rand(this->kinematic->getDof());
+				
+				for (::std::size_t a = attempt++; a <= this->getRandomRestarts() && !done; a = attempt++)
+				{
+					if (a > 0)
+					{
+						for (::std::size_t i = 0; i < this->kinematic->getDof(); ++i)
+						{
+							rand(i) = randDistribution(randEngine);
+						}
+						
+						q = this->kinematic->generatePositionUniform(rand);
+					}
+					else
+					{
+						q = q0;
+					}
+					
+					for (::std::size_t i = 0; i < this->steps && !done && iteration++ < this->getIterations(); ++i)
+					{
+						if (::std::chrono::steady_clock::now() - start > this->getDuration())
+						{
+							return;
+						}
+						
+						data.q = q;
+						this->kinematic->forwardPosition(data);
+						dx.setZero();
+						
+						for (::std::size_t j = 0; j < this->goals.size(); ++j)
+						{
+							::rl::math::VectorBlock dxi = dx.segment(6 * this->goals[j].second, 6);
+							dxi = this->kinematic->getOperationalPosition(data, this->goals[j].second).toDelta(this->goals[j].first);
+						}
+						
+						if (dx.squaredNorm() < ::std::pow(this->getEpsilon(), 2))
+						{
+							this->kinematic->normalize(q);
+							
+							if (this->kinematic->isValid(q))
+							{
+								::std::lock_guard<::std::mutex> lock(mutex);
+								
+								if (solutions.size() < this->solutions)
+								{
+									solutions.push_back(q);
+								}
+								
+								if (solutions.size() >= this->solutions)
+								{
+									done = true;
+								}
+								
+								break;
+							}
+						}
+						
+						this->kinematic->calculateJacobian(data);
+						
+						switch (this->method)
+						{
+						case Method::dls:
+							this->kinematic->calculateJacobianInverse(data.J, invJ, 0, false);
+							dq = invJ * dx;
+							break;
+						case Method::svd:
+							this->kinematic->calculateJacobianInverse(data.J, invJ, 0, true);
+							dq = invJ * dx;
+							break;
+						case Method::transpose:
+							{
+								::rl::math::Vector tmp = data.J * data.J.transpose() * dx;
+								::rl::math::Real alpha = dx.dot(tmp) / tmp.dot(tmp);
+								dq = alpha * data.J.transpose() * dx;
+							}
+							break;
+						default:
+							break;
+						}
+						
+						this->kinematic->step(q, dq, q2);
+						
+						if (this->kinematic->transformedDistance(q, q2) > ::std::pow(this->delta, 2))
+						{
+							this->kinematic->interpolate(q, q2, this->delta, q2);
+						}
+						
+						q = q2;
+					}
+				}
+			};
+			
+			::std::vector<::std::thread> threads;
+			
+			for (::std::size_t w = 1; w < this->workers; ++w)
+			{
+				threads.push_back(::std::thread(worker, w));
+			}
+			
+			worker(0);
+			
+			for (::std::size_t w = 0; w < threads.size(); ++w)
+			{
+				threads[w].join();
+			}
+			
+			if (solutions.empty())
+			{
+				return false;
+			}
+			
+			::std::size_t best = 0;
+			
+			for (::std::size_t i = 1; i < solutions.size(); ++i)
+			{
+				if (this->kinematic->transformedDistance(q0, solutions[i]) < this->kinematic->transformedDistance(q0, solutions[best]))
+				{
+					best = i;
+				}
+			}
+			
+			this->kinematic->setPosition(solutions[best]);
+			
+			return true;
+		}
 	}
 }
@@ -67,21 +67,46 @@ namespace rl
 			
 			const Method& getMethod() const;
 			
+			const ::std::size_t& getSolutions() const;
+			
 			const ::std::size_t& getSteps() const;
 			
+			const ::std::size_t& getWorkers() const;
+			
 			void seed(const ::std::mt19937::result_type& value);
 			
 			void setDelta(const ::rl::math::Real& delta);
 			
 			void setMethod(const Method& method);
 			
+			/**
+			 * Number of valid solutions to collect before returning.
+			 *
+			 * With more than one solution, random restarts continue after the
+			 * first valid solution and the one with the smallest joint space
+			 * distance to the initial position is returned.
+			 */
+			void setSolutions(const ::std::size_t& solutions);
+			
 			void setSteps(const ::std::size_t& steps);
 			
+			/**
+			 * Number of threads running random restarts concurrently.
+			 *
+			 * Each worker uses its own Data workspace and a random engine
+			 * seeded from seed(), so the restarts of each worker are
+			 * reproducible. All workers stop as soon as enough valid
+			 * solutions have been found.
+			 */
+			void setWorkers(const ::std::size_t& workers);
+			
 			bool solve();
 			
 		protected:
 			
 		private:
+			bool solveConcurrent();
+			
 			::rl::math::Real delta;
 			
 			Method method;
@@ -90,7 +115,11 @@ namespace rl
 			
 			::std::mt19937 randEngine;
 			
+			::std::size_t solutions;
+			
 			::std::size_t steps;
+			
+			::std::size_t workers;
 		};
 	}
 }
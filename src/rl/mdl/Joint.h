@@ -43,6 +43,8 @@ namespace rl
 			
 			virtual ~Joint();
 			
+			virtual void calculateTransform(const ::rl::math::ConstVectorRef& q, ::rl::math::PlueckerTransform& x) const = 0;
+			
 			virtual void clamp(::rl::math::VectorRef q) const;
 			
 			virtual ::rl::math::Real distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const;
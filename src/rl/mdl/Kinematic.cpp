@@ -52,6 +52,137 @@ namespace rl
 		{
 		}
 		
+		void
+		Kinematic::calculateBatchJacobian(const ::rl::math::Matrix& q, ::rl::math::Matrix& J, const bool& inWorldFrame)
+		{
+			Data data(*this);
+			this->calculateBatchJacobian(data, q, J, inWorldFrame);
+			
+			if (q.rows() > 0)
+			{
+				::rl::math::Vector qi = q.row(q.rows() - 1).transpose();
+				this->setPosition(qi);
+				this->forwardPosition();
+			}
+		}
+		
+		void
+		Kinematic::calculateBatchJacobian(Data& data, const ::rl::math::Matrix& q, ::rl::math::Matrix& J, const bool& inWorldFrame) const
+		{
+			assert(q.cols() == this->getDofPosition());
+			assert(J.rows() == q.rows());
+			assert(J.cols() == this->getOperationalDof() * 6 * this->getDof());
+			
+			this->forwardPosition(data, q);
+			
+			::std::ptrdiff_t rows = this->getOperationalDof() * 6;
+			bool identity = this->gammaVelocity.isIdentity(0);
+			::rl::math::Matrix tmp(identity ? 0 : q.rows(), identity ? 0 : rows * this->gammaVelocity.rows());
+			::rl::math::Matrix& J0 = identity ? J : tmp;
+			
+			J0.setZero();
+			
+			::rl::math::Matrix s(q.rows(), 6);
+			::rl::math::Matrix v(q.rows(), 3);
+			
+			for (::std::size_t j = 0; j < this->getOperationalDof(); ++j)
+			{
+				const ::rl::math::Matrix& x = data.xBatch[this->operationals[j]];
+				
+				for (::std::ptrdiff_t i = this->operationals[j]; i >= 0; i = this->parents[i])
+				{
+					if (this->offsets[i] < 0)
+					{
+						continue;
+					}
+					
+					Joint* joint = static_cast<Joint*>(this->transforms[i]);
+					const ::rl::math::Matrix& x0 = data.xBatch[i];
+					
+					for (::std::size_t k = 0; k < joint->getDof(); ++k)
+					{
+						// X_0^-1 * S
+						for (::std::size_t l = 0; l < 3; ++l)
+						{
+							s.col(l) = x0.col(l) * joint->S(0, k) + (x0.col(3 + l) * joint->S(1, k) + x0.col(6 + l) * joint->S(2, k));
+							s.col(3 + l) = x0.col(l) * joint->S(3, k) + (x0.col(3 + l) * joint->S(4, k) + x0.col(6 + l) * joint->S(5, k));
+						}
+						
+						for (::std::size_t l = 0; l < 3; ++l)
+						{
+							s.col(3 + l).array() += x0.col(9 + (l + 1) % 3).array() * s.col((l + 2) % 3).array() - x0.col(9 + (l + 2) % 3).array() * s.col((l + 1) % 3).array();
+						}
+						
+						::std::ptrdiff_t column = (this->offsets[i] + k) * rows + j * 6;
+						
+						if (inWorldFrame)
+						{
+							for (::std::size_t l = 0; l < 3; ++l)
+							{
+								J0.col(column + l) = s.col(3 + l).array() + (s.col((l + 1) % 3).array() * x.col(9 + (l + 2) % 3).array() - s.col((l + 2) % 3).array() * x.col(9 + (l + 1) % 3).array());
+								J0.col(column + 3 + l) = s.col(l);
+							}
+						}
+						else
+						{
+							// X * X_0^-1 * S
+							for (::std::size_t l = 0; l < 3; ++l)
+							{
+								v.col(l) = s.col(3 + l).array() - (x.col(9 + (l + 1) % 3).array() * s.col((l + 2) % 3).array() - x.col(9 + (l + 2) % 3).array() * s.col((l + 1) % 3).array());
+							}
+							
+							for (::std::size_t l = 0; l < 3; ++l)
+							{
+								J0.col(column + l) = x.col(3 * l).array() * v.col(0).array() + (x.col(3 * l + 1).array() * v.col(1).array() + x.col(3 * l + 2).array() * v.col(2).array());
+								J0.col(column + 3 + l) = x.col(3 * l).array() * s.col(0).array() + (x.col(3 * l + 1).array() * s.col(1).array() + x.col(3 * l + 2).array() * s.col(2).array());
+							}
+						}
+					}
+				}
+			}
+			
+			if (!identity)
+			{
+				::rl::math::Matrix Ji(rows, this->gammaVelocity.rows());
+				
+				for (::std::ptrdiff_t i = 0; i < q.rows(); ++i)
+				{
+					Ji = ::Eigen::Map<const ::rl::math::Matrix>(tmp.row(i).transpose().eval().data(), rows, this->gammaVelocity.rows());
+					Ji = Ji * this->gammaVelocity;
+					J.row(i) = ::Eigen::Map<const ::rl::math::Vector>(Ji.data(), Ji.size()).transpose();
+				}
+			}
+		}
+		
+		void
+		Kinematic::calculateBatchOperationalPosition(const ::rl::math::Matrix& q, ::rl::math::Matrix& x)
+		{
+			Data data(*this);
+			this->calculateBatchOperationalPosition(data, q, x);
+			
+			if (q.rows() > 0)
+			{
+				::rl::math::Vector qi = q.row(q.rows() - 1).transpose();
+				this->setPosition(qi);
+				this->forwardPosition();
+			}
+		}
+		
+		void
+		Kinematic::calculateBatchOperationalPosition(Data& data, const ::rl::math::Matrix& q, ::rl::math::Matrix& x) const
+		{
+			assert(q.cols() == this->getDofPosition());
+			assert(x.rows() == q.rows());
+			assert(x.cols() == this->getOperationalDof() * 12);
+			
+			this->forwardPosition(data, q);
+			
+			for (::std::size_t j = 0; j < this->getOperationalDof(); ++j)
+			{
+				x.middleCols(j * 12, 12) = data.xBatch[this->operationals[j]];
+			}
+		}
+		
 		bool
 		Kinematic::calculateInversePosition(const ::rl::math::Transform& x, const ::std::size_t& leaf, const ::rl::math::Real& delta, const ::rl::math::Real& epsilon, const ::std::size_t& iterations)
 		{
@@ -75,32 +206,89 @@ namespace rl
 			assert(J.rows() == this->getOperationalDof() * 6);
 			assert(J.cols() == this->getDof());
 			
-			::rl::math::Vector tmp(this->getDof());
+			this->forwardPosition();
 			
-			for (::std::size_t i = 0; i < this->getDof(); ++i)
+			J.setZero();
+			
+			for (::std::size_t j = 0; j < this->getOperationalDof(); ++j)
 			{
-				for (::std::size_t j = 0; j < this->getDof(); ++j)
+				const ::rl::math::PlueckerTransform& x = this->getOperationalFrame(j)->x;
+				
+				for (::std::ptrdiff_t i = this->operationals[j]; i >= 0; i = this->parents[i])
 				{
-					tmp(j) = i == j ? 1 : 0;
+					if (this->offsets[i] < 0)
+					{
+						continue;
+					}
+					
+					Joint* joint = static_cast<Joint*>(this->transforms[i]);
+					
+					for (::std::size_t k = 0; k < joint->getDof(); ++k)
+					{
+						// X_0^-1 * S
+						::rl::math::MotionVector s = joint->out->x / ::rl::math::MotionVector(joint->S.col(k));
+						
+						if (inWorldFrame)
+						{
+							J.block(j * 6, this->offsets[i] + k, 3, 1) = s.linear() + s.angular().cross(x.translation());
+							J.block(j * 6 + 3, this->offsets[i] + k, 3, 1) = s.angular();
+						}
+						else
+						{
+							// X * X_0^-1 * S
+							::rl::math::MotionVector v = x * s;
+							J.block(j * 6, this->offsets[i] + k, 3, 1) = v.linear();
+							J.block(j * 6 + 3, this->offsets[i] + k, 3, 1) = v.angular();
+						}
+					}
 				}
+			}
+			
+			J = J * this->gammaVelocity;
+		}
+		
+		void
+		Kinematic::calculateJacobian(Data& data, const bool& inWorldFrame) const
+		{
+			this->forwardPosition(data);
+			
+			data.J.setZero();
+			
+			for (::std::size_t j = 0; j < this->getOperationalDof(); ++j)
+			{
+				const ::rl::math::PlueckerTransform& x = data.x[this->operationals[j]];
 				
-				this->setVelocity(tmp);
-				this->forwardVelocity();
-				
-				for (::std::size_t j = 0; j < this->getOperationalDof(); ++j)
+				for (::std::ptrdiff_t i = this->operationals[j]; i >= 0; i = this->parents[i])
 				{
-					if (inWorldFrame)
+					if (this->offsets[i] < 0)
 					{
-						J.block(j * 6, i, 3, 1) = this->getOperationalPosition(j).linear() * this->getOperationalVelocity(j).linear();
-						J.block(j * 6 + 3, i, 3, 1) = this->getOperationalPosition(j).linear() * this->getOperationalVelocity(j).angular();
+						continue;
 					}
-					else
+					
+					Joint* joint = static_cast<Joint*>(this->transforms[i]);
+					
+					for (::std::size_t k = 0; k < joint->getDof(); ++k)
 					{
-						J.block(j * 6, i, 3, 1) = this->getOperationalVelocity(j).linear();
-						J.block(j * 6 + 3, i, 3, 1) = this->getOperationalVelocity(j).angular();
+						// X_0^-1 * S
+						::rl::math::MotionVector s = data.x[i] / ::rl::math::MotionVector(joint->S.col(k));
+						
+						if (inWorldFrame)
+						{
+							data.J.block(j * 6, this->offsets[i] + k, 3, 1) = s.linear() + s.angular().cross(x.translation());
+							data.J.block(j * 6 + 3, this->offsets[i] + k, 3, 1) = s.angular();
+						}
+						else
+						{
+							// X * X_0^-1 * S
+							::rl::math::MotionVector v = x * s;
+							data.J.block(j * 6, this->offsets[i] + k, 3, 1) = v.linear();
+							data.J.block(j * 6 + 3, this->offsets[i] + k, 3, 1) = v.angular();
+						}
 					}
 				}
 			}
+			
+			data.J = data.J * this->gammaVelocity;
 		}
 		
 		void
@@ -112,24 +300,112 @@ namespace rl
 		void
 		Kinematic::calculateJacobianDerivative(::rl::math::Vector& Jdqd, const bool& inWorldFrame)
 		{
-			::rl::math::Vector tmp = ::rl::math::Vector::Zero(this->getDof());
+			this->forwardPosition();
 			
-			this->setAcceleration(tmp);
-			this->forwardVelocity();
-			this->forwardAcceleration();
+			for (::std::size_t j = 0; j < this->getOperationalDof(); ++j)
+			{
+				const ::rl::math::PlueckerTransform& x = this->getOperationalFrame(j)->x;
+				
+				::rl::math::MotionVector v = ::rl::math::MotionVector::Zero();
+				
+				for (::std::ptrdiff_t i = this->operationals[j]; i >= 0; i = this->parents[i])
+				{
+					if (this->offsets[i] >= 0)
+					{
+						// X_0^-1 * vj
+						v += this->transforms[i]->out->x / static_cast<Joint*>(this->transforms[i])->v;
+					}
+				}
+				
+				// X * v
+				::rl::math::MotionVector vn = x * v;
+				
+				::rl::math::MotionVector a = ::rl::math::MotionVector::Zero();
+				
+				for (::std::ptrdiff_t i = this->operationals[j]; i >= 0; i = this->parents[i])
+				{
+					if (this->offsets[i] >= 0)
+					{
+						Joint* joint = static_cast<Joint*>(this->transforms[i]);
+						// X_0^-1 * vj
+						::rl::math::MotionVector vj = joint->out->x / joint->v;
+						// X_0^-1 * cj + v x vj
+						a += joint->out->x / joint->c + v.cross(vj);
+						v -= vj;
+					}
+				}
+				
+				// X * a
+				a = x * a;
+				
+				if (inWorldFrame)
+				{
+					// R * (a + omega x v), R * alpha
+					Jdqd.segment(j * 6, 3) = x.linear() * (a.linear() + vn.angular().cross(vn.linear()));
+					Jdqd.segment(j * 6 + 3, 3) = x.linear() * a.angular();
+				}
+				else
+				{
+					Jdqd.segment(j * 6, 3) = a.linear();
+					Jdqd.segment(j * 6 + 3, 3) = a.angular();
+				}
+			}
+		}
+		
+		void
+		Kinematic::calculateJacobianDerivative(Data& data, const bool& inWorldFrame) const
+		{
+			this->forwardPosition(data);
+			
+			::rl::math::Vector qd = this->gammaVelocity * data.qd;
 			
 			for (::std::size_t j = 0; j < this->getOperationalDof(); ++j)
 			{
+				const ::rl::math::PlueckerTransform& x = data.x[this->operationals[j]];
+				
+				::rl::math::MotionVector v = ::rl::math::MotionVector::Zero();
+				
+				for (::std::ptrdiff_t i = this->operationals[j]; i >= 0; i = this->parents[i])
+				{
+					if (this->offsets[i] >= 0)
+					{
+						Joint* joint = static_cast<Joint*>(this->transforms[i]);
+						// X_0^-1 * S * qd
+						v += data.x[i] / ::rl::math::MotionVector(joint->S * qd.segment(this->offsets[i], joint->getDof()));
+					}
+				}
+				
+				// X * v
+				::rl::math::MotionVector vn = x * v;
+				
+				::rl::math::MotionVector a = ::rl::math::MotionVector::Zero();
+				
+				for (::std::ptrdiff_t i = this->operationals[j]; i >= 0; i = this->parents[i])
+				{
+					if (this->offsets[i] >= 0)
+					{
+						Joint* joint = static_cast<Joint*>(this->transforms[i]);
+						// X_0^-1 * S * qd
+						::rl::math::MotionVector vj = data.x[i] / ::rl::math::MotionVector(joint->S * qd.segment(this->offsets[i], joint->getDof()));
+						// X_0^-1 * cj + v x vj
+						a += data.x[i] / joint->c + v.cross(vj);
+						v -= vj;
+					}
+				}
+				
+				// X * a
+				a = x * a;
+				
 				if (inWorldFrame)
 				{
-					::rl::math::Matrix33 wR = this->getOperationalVelocity(j).angular().cross33() * this->getOperationalPosition(j).linear();
-					Jdqd.segment(j * 6, 3) = this->getOperationalPosition(j).linear() * this->getOperationalAcceleration(j).linear() + wR * this->getOperationalVelocity(j).linear();
-					Jdqd.segment(j * 6 + 3, 3) = this->getOperationalPosition(j).linear() * this->getOperationalAcceleration(j).angular() + wR * this->getOperationalVelocity(j).angular();
+					// R * (a + omega x v), R * alpha
+					data.Jdqd.segment(j * 6, 3) = x.linear() * (a.linear() + vn.angular().cross(vn.linear()));
+					data.Jdqd.segment(j * 6 + 3, 3) = x.linear() * a.angular();
 				}
 				else
 				{
-					Jdqd.segment(j * 6, 3) = this->getOperationalAcceleration(j).linear();
-					Jdqd.segment(j * 6 + 3, 3) = this->getOperationalAcceleration(j).angular();
+					data.Jdqd.segment(j * 6, 3) = a.linear();
+					data.Jdqd.segment(j * 6 + 3, 3) = a.angular();
 				}
 			}
 		}
@@ -190,6 +466,34 @@ namespace rl
 			}
 		}
 		
+		void
+		Kinematic::forwardAcceleration(Data& data) const
+		{
+			::rl::math::Vector qd = this->gammaVelocity * data.qd;
+			::rl::math::Vector qdd = this->gammaVelocity * data.qdd;
+			
+			for (::std::size_t i = 0; i < this->transforms.size(); ++i)
+			{
+				::rl::math::MotionVector a = this->parents[i] < 0 ? ::rl::math::MotionVector::Zero() : data.a[this->parents[i]];
+				
+				if (this->offsets[i] >= 0)
+				{
+					Joint* joint = static_cast<Joint*>(this->transforms[i]);
+					// S * qd
+					::rl::math::MotionVector vj(joint->S * qd.segment(this->offsets[i], joint->getDof()));
+					// S * qdd
+					::rl::math::MotionVector aj(joint->S * qdd.segment(this->offsets[i], joint->getDof()));
+					// X * a + aj + cj + v x vj
+					data.a[i] = data.xT[i] * a + aj + joint->c + data.v[i].cross(vj);
+				}
+				else
+				{
+					// X * a
+					data.a[i] = data.xT[i] * a;
+				}
+			}
+		}
+		
 		void
 		Kinematic::forwardPosition()
 		{
@@ -199,6 +503,135 @@ namespace rl
 			}
 		}
 		
+		void
+		Kinematic::forwardPosition(Data& data) const
+		{
+			::rl::math::Vector q = this->gammaPosition * data.q;
+			
+			for (::std::size_t i = 0, j = 0; i < this->transforms.size(); ++i)
+			{
+				if (this->offsets[i] >= 0)
+				{
+					Joint* joint = static_cast<Joint*>(this->transforms[i]);
+					joint->calculateTransform(q.segment(j, joint->getDofPosition()), data.xT[i]);
+					j += joint->getDofPosition();
+				}
+				else
+				{
+					data.xT[i] = this->transforms[i]->x;
+				}
+				
+				// X_0 * X
+				data.x[i] = (this->parents[i] < 0 ? this->transforms[i]->in->x : data.x[this->parents[i]]) * data.xT[i];
+			}
+		}
+		
+		void
+		Kinematic::forwardPosition(Data& data, const ::rl::math::Matrix& q) const
+		{
+			::rl::math::Matrix q0(q.rows(), this->gammaPosition.rows());
+			::rl::math::Vector qi(q.cols());
+			
+			for (::std::ptrdiff_t i = 0; i < q.rows(); ++i)
+			{
+				qi = q.row(i).transpose();
+				q0.row(i) = (this->gammaPosition * qi).transpose();
+			}
+			
+			data.xBatch.resize(this->transforms.size());
+			
+			::rl::math::Matrix in(q.rows(), 12);
+			::rl::math::Matrix xT(q.rows(), 12);
+			::rl::math::Vector c(q.rows());
+			::rl::math::Vector c1(q.rows());
+			::rl::math::Vector s(q.rows());
+			::rl::math::PlueckerTransform t;
+			::Eigen::Matrix<::rl::math::Real, 3, 4> affine;
+			
+			for (::std::size_t i = 0, j = 0; i < this->transforms.size(); ++i)
+			{
+				if (Revolute* revolute = dynamic_cast<Revolute*>(this->transforms[i]))
+				{
+					// see ::Eigen::AngleAxis::toRotationMatrix()
+					for (::std::ptrdiff_t k = 0; k < q.rows(); ++k)
+					{
+						c(k) = ::std::cos(q0(k, j) + revolute->offset(0));
+						s(k) = ::std::sin(q0(k, j) + revolute->offset(0));
+					}
+					
+					const ::rl::math::Real& x = revolute->S(0, 0);
+					const ::rl::math::Real& y = revolute->S(1, 0);
+					const ::rl::math::Real& z = revolute->S(2, 0);
+					
+					c1 = (1 - c.array()).matrix();
+					xT.col(0) = (c1 * x * x).array() + c.array();
+					xT.col(1) = c1 * x * y + s * z;
+					xT.col(2) = c1 * x * z - s * y;
+					xT.col(3) = c1 * x * y - s * z;
+					xT.col(4) = (c1 * y * y).array() + c.array();
+					xT.col(5) = c1 * y * z + s * x;
+					xT.col(6) = c1 * x * z + s * y;
+					xT.col(7) = c1 * y * z - s * x;
+					xT.col(8) = (c1 * z * z).array() + c.array();
+					xT.rightCols(3).setZero();
+					j += revolute->getDofPosition();
+				}
+				else if (Prismatic* prismatic = dynamic_cast<Prismatic*>(this->transforms[i]))
+				{
+					for (::std::size_t k = 0; k < 9; ++k)
+					{
+						xT.col(k).setConstant(0 == k % 4 ? 1 : 0);
+					}
+					
+					for (::std::size_t k = 0; k < 3; ++k)
+					{
+						xT.col(9 + k) = (q0.col(j).array() + prismatic->offset(0)) * prismatic->S(3 + k, 0);
+					}
+					
+					j += prismatic->getDofPosition();
+				}
+				else if (this->offsets[i] >= 0)
+				{
+					Joint* joint = static_cast<Joint*>(this->transforms[i]);
+					
+					for (::std::ptrdiff_t k = 0; k < q.rows(); ++k)
+					{
+						joint->calculateTransform(q0.row(k).segment(j, joint->getDofPosition()).transpose(), t);
+						affine = t.transform().affine();
+						xT.row(k) = ::Eigen::Map<const ::rl::math::Vector>(affine.data(), 12).transpose();
+					}
+					
+					j += joint->getDofPosition();
+				}
+				else
+				{
+					affine = this->transforms[i]->x.transform().affine();
+					xT.rowwise() = ::Eigen::Map<const ::rl::math::Vector>(affine.data(), 12).transpose();
+				}
+				
+				if (this->parents[i] < 0)
+				{
+					affine = this->transforms[i]->in->x.transform().affine();
+					in.rowwise() = ::Eigen::Map<const ::rl::math::Vector>(affine.data(), 12).transpose();
+				}
+				
+				// X_0 * X, see ::Eigen::Transform::operator*()
+				const ::rl::math::Matrix& x0 = this->parents[i] < 0 ? in : data.xBatch[this->parents[i]];
+				::rl::math::Matrix& x = data.xBatch[i];
+				x.resize(q.rows(), 12);
+				
+				for (::std::size_t k = 0; k < 4; ++k)
+				{
+					for (::std::size_t l = 0; l < 3; ++l)
+					{
+						x.col(3 * k + l) = x0.col(l).cwiseProduct(xT.col(3 * k)) + (x0.col(3 + l).cwiseProduct(xT.col(3 * k + 1)) + x0.col(6 + l).cwiseProduct(xT.col(3 * k + 2)));
+					}
+				}
+				
+				x.rightCols(3) += x0.rightCols(3);
+			}
+		}
+		
 		void
 		Kinematic::forwardVelocity()
 		{
@@ -208,6 +641,29 @@ namespace rl
 			}
 		}
 		
+		void
+		Kinematic::forwardVelocity(Data& data) const
+		{
+			::rl::math::Vector qd = this->gammaVelocity * data.qd;
+			
+			for (::std::size_t i = 0; i < this->transforms.size(); ++i)
+			{
+				::rl::math::MotionVector v = this->parents[i] < 0 ? ::rl::math::MotionVector::Zero() : data.v[this->parents[i]];
+				
+				if (this->offsets[i] >= 0)
+				{
+					Joint* joint = static_cast<Joint*>(this->transforms[i]);
+					// X * v + S * qd
+					data.v[i] = data.xT[i] * v + ::rl::math::MotionVector(joint->S * qd.segment(this->offsets[i], joint->getDof()));
+				}
+				else
+				{
+					// X * v
+					data.v[i] = data.xT[i] * v;
+				}
+			}
+		}
+		
 		const ::rl::math::Matrix&
 		Kinematic::getJacobian() const
 		{
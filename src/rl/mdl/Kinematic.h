@@ -44,6 +44,66 @@ namespace rl
 			
 			virtual ~Kinematic();
 			
+			/**
+			 * Calculate Jacobian matrices for a batch of configurations.
+			 *
+			 * Configurations and results are stored one per row, so that each joint
+			 * coordinate and each matrix entry is contiguous across the batch.
+			 * Row \f$k\f$ of \p J holds the column-major entries of the Jacobian
+			 * calculated by calculateJacobian(::rl::math::Matrix&, const bool&)
+			 * for row \f$k\f$ of \p q.
+			 *
+			 * @param[in] q Joint positions, one configuration per row (\f$n \times\f$ getDofPosition())
+			 * @param[out] J Jacobian matrices (\f$n \times 6 \,\f$ getOperationalDof() \f$\,\f$ getDof())
+			 * @param[in] inWorldFrame Calculate in world or tool frame
+			 *
+			 * @post Model state corresponds to the last configuration in \p q
+			 *
+			 * @see calculateBatchJacobian(Data&, const ::rl::math::Matrix&, ::rl::math::Matrix&, const bool&) const
+			 */
+			void calculateBatchJacobian(const ::rl::math::Matrix& q, ::rl::math::Matrix& J, const bool& inWorldFrame = true);
+			
+			/**
+			 * Calculate Jacobian matrices for a batch of configurations in a workspace.
+			 *
+			 * Each column is assembled for all configurations at once from the frame
+			 * poses calculated by forwardPosition(Data&, const ::rl::math::Matrix&) const.
+			 *
+			 * @param[in,out] data Workspace, receives Data::xBatch
+			 * @param[in] q Joint positions, one configuration per row (\f$n \times\f$ getDofPosition())
+			 * @param[out] J Jacobian matrices (\f$n \times 6 \,\f$ getOperationalDof() \f$\,\f$ getDof())
+			 * @param[in] inWorldFrame Calculate in world or tool frame
+			 */
+			void calculateBatchJacobian(Data& data, const ::rl::math::Matrix& q, ::rl::math::Matrix& J, const bool& inWorldFrame = true) const;
+			
+			/**
+			 * Calculate operational positions for a batch of configurations.
+			 *
+			 * Configurations and results are stored one per row. Columns \f$12 i\f$ to
+			 * \f$12 i + 11\f$ hold the upper \f$3 \times 4\f$ part of the homogeneous
+			 * matrix of operational frame \f$i\f$ in column-major order, i.e.,
+			 * rotation followed by translation.
+			 *
+			 * @param[in] q Joint positions, one configuration per row (\f$n \times\f$ getDofPosition())
+			 * @param[out] x Operational positions (\f$n \times 12 \,\f$ getOperationalDof())
+			 *
+			 * @post Model state corresponds to the last configuration in \p q
+			 *
+			 * @see calculateBatchOperationalPosition(Data&, const ::rl::math::Matrix&, ::rl::math::Matrix&) const
+			 */
+			void calculateBatchOperationalPosition(const ::rl::math::Matrix& q, ::rl::math::Matrix& x);
+			
+			/**
+			 * Calculate operational positions for a batch of configurations in a workspace.
+			 *
+			 * @param[in,out] data Workspace, receives Data::xBatch
+			 * @param[in] q Joint positions, one configuration per row (\f$n \times\f$ getDofPosition())
+			 * @param[out] x Operational positions (\f$n \times 12 \,\f$ getOperationalDof())
+			 *
+			 * @see forwardPosition(Data&, const ::rl::math::Matrix&) const
+			 */
+			void calculateBatchOperationalPosition(Data& data, const ::rl::math::Matrix& q, ::rl::math::Matrix& x) const;
+			
 			RL_MDL_DEPRECATED bool calculateInversePosition(
 				const ::rl::math::Transform& x,
 				const ::std::size_t& leaf = 0,
@@ -60,22 +120,39 @@ namespace rl
 			 * @pre setPosition()
 			 * @post getJacobian()
 			 *
-			 * @see forwardVelocity()
+			 * @see calculateJacobian(::rl::math::Matrix&, const bool&)
 			 */
 			void calculateJacobian(const bool& inWorldFrame = true);
 			
 			/**
 			 * Calculate Jacobian matrix.
 			 *
+			 * Columns are assembled in a single pass over the joints on the path
+			 * from each operational frame to the root, using the joint motion subspaces
+			 * transformed into world coordinates. Frame poses are updated via
+			 * forwardPosition(), velocities and accelerations remain unchanged.
+			 *
 			 * @param[out] J Jacobian matrix \f$\matr{J}(\vec{q})\f$
 			 * @param[in] inWorldFrame Calculate in world or tool frame
 			 *
 			 * @pre setPosition()
 			 *
-			 * @see forwardVelocity()
+			 * @see forwardPosition()
 			 */
 			void calculateJacobian(::rl::math::Matrix& J, const bool& inWorldFrame = true);
 			
+			/**
+			 * Calculate Jacobian matrix in a workspace.
+			 *
+			 * @param[in,out] data Workspace with joint positions, receives Jacobian matrix
+			 * @param[in] inWorldFrame Calculate in world or tool frame
+			 *
+			 * @post Data::J
+			 *
+			 * @see forwardPosition(Data&) const
+			 */
+			void calculateJacobian(Data& data, const bool& inWorldFrame = true) const;
+			
 			/**
 			 * Calculate Jacobian derivative vector.
 			 *
@@ -85,25 +162,40 @@ namespace rl
 			 * @pre setVelocity()
 			 * @post getJacobianDerivative()
 			 *
-			 * @see forwardVelocity
-			 * @see forwardAcceleration
+			 * @see calculateJacobianDerivative(::rl::math::Vector&, const bool&)
 			 */
 			void calculateJacobianDerivative(const bool& inWorldFrame = true);
 			
 			/**
 			 * Calculate Jacobian derivative vector.
 			 *
+			 * Velocity product terms are accumulated along the path from each
+			 * operational frame to the root in the same pass as the Jacobian,
+			 * without modifying joint accelerations. Frame poses are updated via
+			 * forwardPosition().
+			 *
 			 * @param[out] Jdqd Jacobian derivative vector \f$\dot{\matr{J}}(\vec{q}, \dot{\vec{q}}) \, \dot{\vec{q}}\f$
 			 * @param[in] inWorldFrame Calculate in world or tool frame
 			 *
 			 * @pre setPosition()
 			 * @pre setVelocity()
 			 *
-			 * @see forwardVelocity()
-			 * @see forwardAcceleration()
+			 * @see forwardPosition()
 			 */
 			void calculateJacobianDerivative(::rl::math::Vector& Jdqd, const bool& inWorldFrame = true);
 			
+			/**
+			 * Calculate Jacobian derivative vector in a workspace.
+			 *
+			 * @param[in,out] data Workspace with joint positions and velocities, receives Jacobian derivative vector
+			 * @param[in] inWorldFrame Calculate in world or tool frame
+			 *
+			 * @post Data::Jdqd
+			 *
+			 * @see forwardPosition(Data&) const
+			 */
+			void calculateJacobianDerivative(Data& data, const bool& inWorldFrame = true) const;
+			
 			/**
 			 * Calculate Jacobian matrix inverse.
 			 *
@@ -166,12 +258,41 @@ namespace rl
 			 */
 			void forwardAcceleration();
 			
+			/**
+			 * @pre forwardVelocity(Data&) const
+			 * @post getOperationalAcceleration(const Data&, const ::std::size_t&) const
+			 */
+			void forwardAcceleration(Data& data) const;
+			
 			/**
 			 * @pre setPosition()
 			 * @post getOperationalPosition()
 			 */
 			void forwardPosition();
 			
+			/**
+			 * Calculate frame poses in a workspace without modifying the model.
+			 *
+			 * @post getOperationalPosition(const Data&, const ::std::size_t&) const
+			 */
+			void forwardPosition(Data& data) const;
+			
+			/**
+			 * Calculate frame poses for a batch of configurations in a workspace.
+			 *
+			 * Joint transforms and their products are calculated column-wise, i.e.,
+			 * each entry of a frame pose is evaluated for all configurations at once.
+			 * Revolute and prismatic joints are evaluated element-wise with the same
+			 * operations as their calculateTransform(), other joints are evaluated
+			 * once per configuration. Results agree with forwardPosition(Data&) const
+			 * up to rounding, as Eigen's summation order for fixed-size products
+			 * depends on the SIMD width.
+			 *
+			 * @param[in,out] data Workspace, receives Data::xBatch
+			 * @param[in] q Joint positions, one configuration per row (\f$n \times\f$ getDofPosition())
+			 */
+			void forwardPosition(Data& data, const ::rl::math::Matrix& q) const;
+			
 			/**
 			 * @pre setPosition()
 			 * @pre setVelocity()
@@ -179,6 +300,12 @@ namespace rl
 			 */
 			void forwardVelocity();
 			
+			/**
+			 * @pre forwardPosition(Data&) const
+			 * @post getOperationalVelocity(const Data&, const ::std::size_t&) const
+			 */
+			void forwardVelocity(Data& data) const;
+			
 			/**
 			 * Access calculated Jacobian matrix.
 			 *
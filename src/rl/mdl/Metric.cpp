@@ -52,7 +52,7 @@ namespace rl
 		}
 		
 		::rl::math::Real
-		Metric::distance(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2) const
+		Metric::distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const
 		{
 			assert(q1.size() == this->getDofPosition());
 			assert(q2.size() == this->getDofPosition());
@@ -71,7 +71,7 @@ namespace rl
 		}
 		
 		void
-		Metric::interpolate(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2, const ::rl::math::Real& alpha, ::rl::math::Vector& q) const
+		Metric::interpolate(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2, const ::rl::math::Real& alpha, ::rl::math::Vector& q) const
 		{
 			assert(q1.size() == this->getDofPosition());
 			assert(q2.size() == this->getDofPosition());
@@ -147,7 +147,7 @@ namespace rl
 		}
 		
 		::rl::math::Real
-		Metric::transformedDistance(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2) const
+		Metric::transformedDistance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const
 		{
 			assert(q1.size() == this->getDofPosition());
 			assert(q2.size() == this->getDofPosition());
@@ -49,6 +49,9 @@ namespace rl
 			leaves(),
 			manufacturer(),
 			name(),
+			offsets(),
+			operationals(),
+			parents(),
 			root(0),
 			tools(),
 			transforms(),
@@ -321,6 +324,14 @@ namespace rl
 			return this->tree[this->leaves[i]]->a;
 		}
 		
+		const ::rl::math::MotionVector&
+		Model::getOperationalAcceleration(const Data& data, const ::std::size_t& i) const
+		{
+			assert(i < this->getOperationalDof());
+			
+			return data.a[this->operationals[i]];
+		}
+		
 		::std::size_t
 		Model::getOperationalDof() const
 		{
@@ -351,6 +362,14 @@ namespace rl
 			return this->tree[this->leaves[i]]->x.transform();
 		}
 		
+		const ::rl::math::Transform&
+		Model::getOperationalPosition(const Data& data, const ::std::size_t& i) const
+		{
+			assert(i < this->getOperationalDof());
+			
+			return data.x[this->operationals[i]].transform();
+		}
+		
 		const ::rl::math::MotionVector&
 		Model::getOperationalVelocity(const ::std::size_t& i) const
 		{
@@ -359,6 +378,14 @@ namespace rl
 			return this->tree[this->leaves[i]]->v;
 		}
 		
+		const ::rl::math::MotionVector&
+		Model::getOperationalVelocity(const Data& data, const ::std::size_t& i) const
+		{
+			assert(i < this->getOperationalDof());
+			
+			return data.v[this->operationals[i]];
+		}
+		
 		const ::std::string&
 		Model::getManufacturer() const
 		{
@@ -731,8 +758,12 @@ namespace rl
 			this->dof = 0;
 			this->dofPosition = 0;
 			this->elements.clear();
+			this->frames.clear();
 			this->joints.clear();
 			this->leaves.clear();
+			this->offsets.clear();
+			this->operationals.clear();
+			this->parents.clear();
 			this->tools.clear();
 			this->transforms.clear();
 			
@@ -744,6 +775,19 @@ namespace rl
 				this->dofPosition += this->joints[i]->getDofPosition();
 			}
 			
+			for (::std::size_t i = 0, j = 0; i < this->transforms.size(); ++i)
+			{
+				if (Joint* joint = dynamic_cast<Joint*>(this->transforms[i]))
+				{
+					this->offsets.push_back(j);
+					j += joint->getDof();
+				}
+				else
+				{
+					this->offsets.push_back(-1);
+				}
+			}
+			
 			this->gammaPosition = ::rl::math::Matrix::Identity(this->getDofPosition(), this->getDofPosition());
 			this->gammaVelocity = ::rl::math::Matrix::Identity(this->getDof(), this->getDof());
 			this->home = ::rl::math::Vector::Zero(this->getDofPosition());
@@ -755,6 +799,8 @@ namespace rl
 		Model::update(const Vertex& u)
 		{
 			Frame* frame = this->tree[u].get();
+			// transform leading into u was added last
+			::std::ptrdiff_t parent = static_cast<::std::ptrdiff_t>(this->transforms.size()) - 1;
 			this->elements.push_back(frame);
 			this->frames.push_back(frame);
 			
@@ -773,6 +819,7 @@ namespace rl
 					Transform* transform = this->tree[e].get();
 					this->elements.push_back(transform);
 					this->transforms.push_back(transform);
+					this->parents.push_back(parent);
 					transform->in = this->tree[u].get();
 					transform->out = this->tree[v].get();
 					
@@ -787,6 +834,7 @@ namespace rl
 			else
 			{
 				this->leaves.push_back(u);
+				this->operationals.push_back(parent);
 				
 				for (InEdgeIteratorPair i = ::boost::in_edges(u, this->tree); i.first != i.second; ++i.first)
 				{
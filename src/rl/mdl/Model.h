@@ -36,6 +36,7 @@
 #include <rl/math/Units.h>
 #include <rl/math/Vector.h>
 
+#include "Data.h"
 #include "Frame.h"
 #include "Transform.h"
 
@@ -116,6 +117,8 @@ namespace rl
 			
 			const ::rl::math::MotionVector& getOperationalAcceleration(const ::std::size_t& i) const;
 			
+			const ::rl::math::MotionVector& getOperationalAcceleration(const Data& data, const ::std::size_t& i) const;
+			
 			::std::size_t getOperationalDof() const;
 			
 			const ::rl::math::ForceVector& getOperationalForce(const ::std::size_t& i) const;
@@ -124,8 +127,12 @@ namespace rl
 			
 			const ::rl::math::Transform& getOperationalPosition(const ::std::size_t& i) const;
 			
+			const ::rl::math::Transform& getOperationalPosition(const Data& data, const ::std::size_t& i) const;
+			
 			const ::rl::math::MotionVector& getOperationalVelocity(const ::std::size_t& i) const;
 			
+			const ::rl::math::MotionVector& getOperationalVelocity(const Data& data, const ::std::size_t& i) const;
+			
 			const ::std::string& getManufacturer() const;
 			
 			::rl::math::Vector getMaximum() const;
@@ -267,6 +274,12 @@ namespace rl
 			
 			::std::string name;
 			
+			::std::vector<::std::ptrdiff_t> offsets;
+			
+			::std::vector<::std::ptrdiff_t> operationals;
+			
+			::std::vector<::std::ptrdiff_t> parents;
+			
 			Vertex root;
 			
 			::std::vector<Edge> tools;
@@ -45,11 +45,18 @@ namespace rl
 		{
 		}
 		
+		void
+		Prismatic::calculateTransform(const ::rl::math::ConstVectorRef& q, ::rl::math::PlueckerTransform& x) const
+		{
+			x.linear().setIdentity();
+			x.translation() = this->S.block<3, 1>(3, 0) * (q(0) + this->offset(0));
+		}
+		
 		void
 		Prismatic::setPosition(const ::rl::math::ConstVectorRef& q)
 		{
 			this->q = q;
-			this->x.translation() = this->S.block<3, 1>(3, 0) * (this->q(0) + this->offset(0));
+			this->calculateTransform(this->q, this->x);
 		}
 	}
 }
@@ -40,6 +40,8 @@ namespace rl
 			
 			virtual ~Prismatic();
 			
+			void calculateTransform(const ::rl::math::ConstVectorRef& q, ::rl::math::PlueckerTransform& x) const;
+			
 			void setPosition(const ::rl::math::ConstVectorRef& q);
 			
 		protected:
@@ -40,6 +40,8 @@ namespace rl
 			
 			virtual ~SixDof();
 			
+			void calculateTransform(const ::rl::math::ConstVectorRef& q, ::rl::math::PlueckerTransform& x) const;
+			
 			void clamp(::rl::math::VectorRef q) const;
 			
 			::rl::math::Real distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const;
@@ -62,6 +62,13 @@ namespace rl
 		{
 		}
 		
+		void
+		Spherical::calculateTransform(const ::rl::math::ConstVectorRef& q, ::rl::math::PlueckerTransform& x) const
+		{
+			x.linear() = ::Eigen::Map<const ::rl::math::Quaternion>(q.data()).toRotationMatrix();
+			x.translation().setZero();
+		}
+		
 		void
 		Spherical::clamp(::rl::math::VectorRef q) const
 		{
@@ -127,7 +134,7 @@ namespace rl
 		Spherical::setPosition(const ::rl::math::ConstVectorRef& q)
 		{
 			this->q = q;
-			this->x.linear() = ::Eigen::Map<const ::rl::math::Quaternion>(this->q.data()).toRotationMatrix();
+			this->calculateTransform(this->q, this->x);
 		}
 		
 		void
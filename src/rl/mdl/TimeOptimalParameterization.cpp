@@ -0,0 +1,410 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Dynamic.h"
+#include "Exception.h"
+#include "TimeOptimalParameterization.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		TimeOptimalParameterization::TimeOptimalParameterization(Model* model) :
+			acceleration(::rl::math::Vector::Constant(model->getDof(), ::std::numeric_limits<::rl::math::Real>::infinity())),
+			model(model),
+			steps(1000),
+			speed(model->getSpeed()),
+			torque()
+		{
+		}
+		
+		TimeOptimalParameterization::~TimeOptimalParameterization()
+		{
+		}
+		
+		void
+		TimeOptimalParameterization::calculateConstraints(const ::rl::math::Matrix& q, const ::rl::math::Matrix& qd, const ::rl::math::Matrix& qdd, ::rl::math::MatrixRef a, ::rl::math::MatrixRef b, ::rl::math::MatrixRef c) const
+		{
+			::std::size_t dof = this->model->getDof();
+			
+			a.leftCols(dof) = qd;
+			b.leftCols(dof) = qdd;
+			c.leftCols(dof).setZero();
+			
+			if (this->torque.size() > 0)
+			{
+				Dynamic* dynamic = dynamic_cast<Dynamic*>(this->model);
+				
+				if (nullptr == dynamic)
+				{
+					throw Exception("rl::mdl::TimeOptimalParameterization::parameterize() - Torque limits require a dynamic model");
+				}
+				
+				::rl::math::Matrix zero = ::rl::math::Matrix::Zero(q.rows(), dof);
+				::rl::math::Matrix gravity(q.rows(), dof);
+				::rl::math::Matrix tau(q.rows(), dof);
+				
+				dynamic->calculateBatchInverseDynamics(q, zero, zero, gravity);
+				c.rightCols(dof) = gravity;
+				
+				dynamic->calculateBatchInverseDynamics(q, zero, qd, tau);
+				a.rightCols(dof) = tau - gravity;
+				
+				dynamic->calculateBatchInverseDynamics(q, qd, qdd, tau);
+				b.rightCols(dof) = tau - gravity;
+			}
+		}
+		
+		const ::rl::math::Vector&
+		TimeOptimalParameterization::getAcceleration() const
+		{
+			return this->acceleration;
+		}
+		
+		::std::size_t
+		TimeOptimalParameterization::getSteps() const
+		{
+			return this->steps;
+		}
+		
+		const ::rl::math::Vector&
+		TimeOptimalParameterization::getSpeed() const
+		{
+			return this->speed;
+		}
+		
+		const ::rl::math::Vector&
+		TimeOptimalParameterization::getTorque() const
+		{
+			return this->torque;
+		}
+		
+		::rl::math::Spline<::rl::math::Vector>
+		TimeOptimalParameterization::parameterize(const ::rl::math::Spline<::rl::math::Vector>& path) const
+		{
+			if (path.size() < 1)
+			{
+				throw Exception("rl::mdl::TimeOptimalParameterization::parameterize() - Path is empty");
+			}
+			
+			if (this->model->getDof() != this->model->getDofPosition())
+			{
+				throw Exception("rl::mdl::TimeOptimalParameterization::parameterize() - Joint positions and velocities differ in dimension");
+			}
+			
+			::std::size_t dof = this->model->getDof();
+			
+			// grid on path parameter including all breakpoints
+			
+			::rl::math::Real length = 0;
+			
+			for (::std::size_t i = 0; i < path.size(); ++i)
+			{
+				length += path[i].duration();
+			}
+			
+			if (length <= 0)
+			{
+				// zero-length path, no grid spacing
+				::rl::math::Polynomial<::rl::math::Vector> f(0);
+				f.coefficient(0) = path[0](0);
+				
+				::rl::math::Spline<::rl::math::Vector> trajectory;
+				trajectory.push_back(f);
+				return trajectory;
+			}
+			
+			::std::vector<::std::size_t> segment;
+			::std::vector<::rl::math::Real> sigma;
+			::std::vector<::rl::math::Real> s;
+			::rl::math::Real start = 0;
+			
+			for (::std::size_t i = 0; i < path.size(); ++i)
+			{
+				::rl::math::Real duration = path[i].duration();
+				// at least one interior point, as velocity may be zero at both ends of a segment
+				::std::size_t m = ::std::max<::std::size_t>(2, static_cast<::std::size_t>(::std::ceil(this->steps * duration / length)));
+				
+				for (::std::size_t k = 0; k < m; ++k)
+				{
+					segment.push_back(i);
+					sigma.push_back(duration * k / m);
+					s.push_back(start + sigma.back());
+				}
+				
+				start += duration;
+			}
+			
+			segment.push_back(path.size() - 1);
+			sigma.push_back(path.back().duration());
+			s.push_back(start);
+			
+			::std::size_t n = s.size();
+			
+			::rl::math::Matrix q(n, dof);
+			::rl::math::Matrix qd(n, dof);
+			::rl::math::Matrix qdd(n, dof);
+			::rl::math::Matrix q1(n, dof);
+			::rl::math::Matrix qd1(n, dof);
+			::rl::math::Matrix qdd1(n, dof);
+			::std::vector<::rl::math::Real> maximum(n, ::std::numeric_limits<::rl::math::Real>::infinity());
+			
+			for (::std::size_t i = 0; i < n; ++i)
+			{
+				q.row(i) = path[segment[i]](sigma[i]).transpose();
+				qd.row(i) = path[segment[i]](sigma[i], 1).transpose();
+				qdd.row(i) = path[segment[i]](sigma[i], 2).transpose();
+				
+				::rl::math::Real sigma1 = ::std::min(sigma[i] + s[::std::min(i + 1, n - 1)] - s[i], path[segment[i]].duration());
+				q1.row(i) = path[segment[i]](sigma1).transpose();
+				qd1.row(i) = path[segment[i]](sigma1, 1).transpose();
+				qdd1.row(i) = path[segment[i]](sigma1, 2).transpose();
+				
+				if (i > 0 && segment[i] != segment[i - 1])
+				{
+					if ((qd1.row(i - 1) - qd.row(i)).norm() > 1.0e-6 * ::std::max<::rl::math::Real>(1, qd1.row(i - 1).norm()))
+					{
+						maximum[i] = 0;
+					}
+				}
+			}
+			
+			maximum.front() = 0;
+			maximum.back() = 0;
+			
+			// path constraints a * sdd + b * sd^2 + c in [-bound, bound] at start and end of each grid interval
+			
+			::std::size_t m = this->torque.size() > 0 ? 2 * dof : dof;
+			::std::size_t constraints = 2 * m;
+			::rl::math::Matrix a(n, constraints);
+			::rl::math::Matrix b(n, constraints);
+			::rl::math::Matrix c(n, constraints);
+			::rl::math::Vector bound(constraints);
+			
+			this->calculateConstraints(q, qd, qdd, a.leftCols(m), b.leftCols(m), c.leftCols(m));
+			this->calculateConstraints(q1, qd1, qdd1, a.rightCols(m), b.rightCols(m), c.rightCols(m));
+			
+			bound.segment(0, dof) = this->acceleration;
+			bound.segment(m, dof) = this->acceleration;
+			
+			if (this->torque.size() > 0)
+			{
+				bound.segment(dof, dof) = this->torque;
+				bound.segment(m + dof, dof) = this->torque;
+			}
+			
+			// end of grid interval with sd^2 + 2 * delta * sdd
+			
+			for (::std::size_t i = 0; i < n; ++i)
+			{
+				::rl::math::Real delta = s[::std::min(i + 1, n - 1)] - s[i];
+				a.block(i, m, 1, m) += 2 * delta * b.block(i, m, 1, m);
+			}
+			
+			// constraints on sdd as lower(i, k) + slope(i, k) * sd^2 <= sdd <= upper(i, k) + slope(i, k) * sd^2
+			
+			::rl::math::Matrix lower(n, constraints);
+			::rl::math::Matrix slope(n, constraints);
+			::rl::math::Matrix upper(n, constraints);
+			::Eigen::Matrix<bool, ::Eigen::Dynamic, ::Eigen::Dynamic> active(n, constraints);
+			
+			for (::std::size_t i = 0; i < n; ++i)
+			{
+				for (::std::size_t j = 0; j < dof; ++j)
+				{
+					if (qd(i, j) != 0)
+					{
+						maximum[i] = ::std::min(maximum[i], ::std::pow(this->speed(j) / qd(i, j), 2));
+					}
+				}
+				
+				for (::std::size_t k = 0; k < constraints; ++k)
+				{
+					active(i, k) = ::std::abs(a(i, k)) > ::std::numeric_limits<::rl::math::Real>::epsilon() * ::std::abs(b(i, k));
+					
+					if (active(i, k))
+					{
+						lower(i, k) = ((a(i, k) > 0 ? -bound(k) : bound(k)) - c(i, k)) / a(i, k);
+						slope(i, k) = -b(i, k) / a(i, k);
+						upper(i, k) = ((a(i, k) > 0 ? bound(k) : -bound(k)) - c(i, k)) / a(i, k);
+						
+						if (lower(i, k) > upper(i, k))
+						{
+							maximum[i] = 0;
+						}
+					}
+					else if (b(i, k) > 0)
+					{
+						maximum[i] = ::std::min(maximum[i], (bound(k) - c(i, k)) / b(i, k));
+					}
+					else if (b(i, k) < 0)
+					{
+						maximum[i] = ::std::min(maximum[i], (bound(k) + c(i, k)) / -b(i, k));
+					}
+				}
+				
+				for (::std::size_t k = 0; k < constraints; ++k)
+				{
+					for (::std::size_t l = 0; l < constraints; ++l)
+					{
+						if (active(i, k) && active(i, l) && slope(i, k) > slope(i, l))
+						{
+							maximum[i] = ::std::min(maximum[i], (upper(i, l) - lower(i, k)) / (slope(i, k) - slope(i, l)));
+						}
+					}
+				}
+				
+				maximum[i] = ::std::max<::rl::math::Real>(0, maximum[i]);
+			}
+			
+			// backward pass computing upper bounds of controllable sets
+			
+			::std::vector<::rl::math::Real> controllable(n);
+			controllable.back() = maximum.back();
+			
+			for (::std::size_t i = n - 1; i-- > 0;)
+			{
+				::rl::math::Real delta = s[i + 1] - s[i];
+				::rl::math::Real x = maximum[i];
+				
+				for (::std::size_t k = 0; k < constraints; ++k)
+				{
+					::rl::math::Real alpha = 1 + 2 * delta * slope(i, k);
+					
+					if (active(i, k) && alpha > 0)
+					{
+						x = ::std::min(x, (controllable[i + 1] - 2 * delta * lower(i, k)) / alpha);
+					}
+				}
+				
+				controllable[i] = ::std::max<::rl::math::Real>(0, x);
+			}
+			
+			// forward pass with maximum path acceleration
+			
+			::std::vector<::rl::math::Real> x(n);
+			x.front() = 0;
+			
+			for (::std::size_t i = 0; i < n - 1; ++i)
+			{
+				::rl::math::Real delta = s[i + 1] - s[i];
+				::rl::math::Real sdd = ::std::numeric_limits<::rl::math::Real>::infinity();
+				
+				for (::std::size_t k = 0; k < constraints; ++k)
+				{
+					if (active(i, k))
+					{
+						sdd = ::std::min(sdd, upper(i, k) + slope(i, k) * x[i]);
+					}
+				}
+				
+				x[i + 1] = ::std::max<::rl::math::Real>(0, ::std::min(controllable[i + 1], x[i] + 2 * delta * sdd));
+			}
+			
+			// compose path polynomials with piecewise quadratic path parameter
+			
+			::rl::math::Spline<::rl::math::Vector> trajectory;
+			
+			for (::std::size_t i = 0; i < n - 1; ++i)
+			{
+				::rl::math::Real delta = s[i + 1] - s[i];
+				::rl::math::Real sd0 = ::std::sqrt(x[i]);
+				::rl::math::Real sd1 = ::std::sqrt(x[i + 1]);
+				
+				if (!(sd0 + sd1 > 0))
+				{
+					throw Exception("rl::mdl::TimeOptimalParameterization::parameterize() - Path is not feasible within limits");
+				}
+				
+				::rl::math::Real dt = 2 * delta / (sd0 + sd1);
+				::rl::math::Real sdd = (x[i + 1] - x[i]) / (2 * delta);
+				
+				const ::rl::math::Polynomial<::rl::math::Vector>& p = path[segment[i]];
+				::rl::math::Polynomial<::rl::math::Vector> f(2 * p.degree());
+				
+				for (::std::size_t k = 0; k < f.degree() + 1; ++k)
+				{
+					f.coefficient(k) = ::rl::math::Vector::Zero(dof);
+				}
+				
+				::std::vector<::rl::math::Real> power(1, 1);
+				
+				for (::std::size_t k = 0; k < p.degree() + 1; ++k)
+				{
+					for (::std::size_t l = 0; l < power.size(); ++l)
+					{
+						f.coefficient(l) += power[l] * p.coefficient(k);
+					}
+					
+					::std::vector<::rl::math::Real> next(power.size() + 2, 0);
+					
+					for (::std::size_t l = 0; l < power.size(); ++l)
+					{
+						next[l] += power[l] * sigma[i];
+						next[l + 1] += power[l] * sd0;
+						next[l + 2] += power[l] * sdd / 2;
+					}
+					
+					power.swap(next);
+				}
+				
+				f.upper() = dt;
+				trajectory.push_back(f);
+			}
+			
+			return trajectory;
+		}
+		
+		void
+		TimeOptimalParameterization::setAcceleration(const ::rl::math::Vector& acceleration)
+		{
+			this->acceleration = acceleration;
+		}
+		
+		void
+		TimeOptimalParameterization::setSteps(const ::std::size_t& steps)
+		{
+			this->steps = ::std::max<::std::size_t>(1, steps);
+		}
+		
+		void
+		TimeOptimalParameterization::setSpeed(const ::rl::math::Vector& speed)
+		{
+			this->speed = speed;
+		}
+		
+		void
+		TimeOptimalParameterization::setTorque(const ::rl::math::Vector& torque)
+		{
+			this->torque = torque;
+		}
+	}
+}
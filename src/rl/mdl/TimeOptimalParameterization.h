@@ -0,0 +1,194 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef RL_MDL_TIMEOPTIMALPARAMETERIZATION_H
+#define RL_MDL_TIMEOPTIMALPARAMETERIZATION_H
+
+#include <iterator>
+#include <vector>
+#include <rl/math/Matrix.h>
+#include <rl/math/Spline.h>
+#include <rl/math/Vector.h>
+#include <rl/mdl/export.h>
+
+namespace rl
+{
+	namespace mdl
+	{
+		class Model;
+		
+		/**
+		 * Time-optimal parameterization of a joint space path.
+		 *
+		 * Computes the fastest traversal of a geometric path \f$q(s)\f$ that
+		 * starts and ends at rest and respects joint velocity and acceleration
+		 * limits, and optionally joint torque limits of a Dynamic model.
+		 * Controllable sets of the squared path velocity \f$\dot{s}^2\f$ are
+		 * propagated backward over a grid on the path parameter, followed by
+		 * a greedy forward pass with maximum path acceleration.
+		 *
+		 * Joint jerk limits are not supported. The path acceleration is
+		 * piecewise constant, so joint accelerations change abruptly between
+		 * grid intervals.
+		 *
+		 * Hung Pham and Quang-Cuong Pham. A new approach to time-optimal path
+		 * parameterization based on reachability analysis. IEEE Transactions on
+		 * Robotics, 34(3):645-659, June 2018.
+		 *
+		 * http://dx.doi.org/10.1109/TRO.2018.2819195
+		 */
+		class RL_MDL_EXPORT TimeOptimalParameterization
+		{
+		public:
+			TimeOptimalParameterization(Model* model);
+			
+			virtual ~TimeOptimalParameterization();
+			
+			/**
+			 * Geometric path through a sequence of joint positions.
+			 *
+			 * Consecutive distinct positions are connected by straight lines,
+			 * parameterized by their Euclidean length in joint space. The
+			 * trajectory stops at every inner position, unless a blend greater
+			 * than zero replaces the corners by parabolic segments.
+			 *
+			 * @param[in] blend Fraction of each line that is used for blending,
+			 * in the interval [0, 1)
+			 *
+			 * @see rl::math::Spline::LinearParabolicPercentage
+			 */
+			template<typename InputIterator>
+			static ::rl::math::Spline<::rl::math::Vector> Path(InputIterator first, InputIterator last, const ::rl::math::Real& blend = 0)
+			{
+				::std::vector<::rl::math::Real> x;
+				::std::vector<::rl::math::Vector> y;
+				
+				for (InputIterator i = first; i != last; ++i)
+				{
+					if (y.empty())
+					{
+						x.push_back(0);
+						y.push_back(*i);
+					}
+					else if ((*i - y.back()).norm() > 0)
+					{
+						x.push_back(x.back() + (*i - y.back()).norm());
+						y.push_back(*i);
+					}
+				}
+				
+				if (y.size() > 2 && blend > 0)
+				{
+					return ::rl::math::Spline<::rl::math::Vector>::LinearParabolicPercentage(x, y, blend);
+				}
+				
+				::rl::math::Spline<::rl::math::Vector> f;
+				
+				for (::std::size_t i = 1; i < y.size(); ++i)
+				{
+					::rl::math::Polynomial<::rl::math::Vector> fi = ::rl::math::Polynomial<::rl::math::Vector>::Linear(y[i - 1], y[i], x[i] - x[i - 1]);
+					f.push_back(fi);
+				}
+				
+				return f;
+			}
+			
+			/**
+			 * Maximum joint accelerations, unlimited by default.
+			 */
+			const ::rl::math::Vector& getAcceleration() const;
+			
+			/**
+			 * Minimum number of grid intervals on the path parameter.
+			 */
+			::std::size_t getSteps() const;
+			
+			/**
+			 * Maximum joint velocities, initialized with Model::getSpeed().
+			 */
+			const ::rl::math::Vector& getSpeed() const;
+			
+			/**
+			 * Maximum joint torques, empty if torque limits are disabled.
+			 */
+			const ::rl::math::Vector& getTorque() const;
+			
+			/**
+			 * Returns the time-optimal trajectory along a path.
+			 *
+			 * The path is evaluated on a grid that includes all of its
+			 * breakpoints. Within each grid interval the path acceleration is
+			 * constant, so that every polynomial of the path is composed exactly
+			 * with the time parameterization.
+			 *
+			 * @param[in] path Geometric path with at least one polynomial
+			 * @return Trajectory starting at time zero, or a single constant
+			 * polynomial of zero duration if the path has zero duration
+			 *
+			 * @throw Exception if the path cannot be followed within the limits
+			 *
+			 * @post If torque limits are set, model state corresponds to the
+			 * last grid point
+			 */
+			::rl::math::Spline<::rl::math::Vector> parameterize(const ::rl::math::Spline<::rl::math::Vector>& path) const;
+			
+			void setAcceleration(const ::rl::math::Vector& acceleration);
+			
+			void setSteps(const ::std::size_t& steps);
+			
+			void setSpeed(const ::rl::math::Vector& speed);
+			
+			/**
+			 * Sets maximum joint torques, requires a Dynamic model.
+			 *
+			 * An empty vector disables torque limits.
+			 */
+			void setTorque(const ::rl::math::Vector& torque);
+			
+		protected:
+			
+		private:
+			/**
+			 * Joint acceleration and torque as linear functions of path acceleration
+			 * and squared path velocity.
+			 */
+			void calculateConstraints(const ::rl::math::Matrix& q, const ::rl::math::Matrix& qd, const ::rl::math::Matrix& qdd, ::rl::math::MatrixRef a, ::rl::math::MatrixRef b, ::rl::math::MatrixRef c) const;
+			
+			::rl::math::Vector acceleration;
+			
+			Model* model;
+			
+			::std::size_t steps;
+			
+			::rl::math::Vector speed;
+			
+			::rl::math::Vector torque;
+		};
+	}
+}
+
+#endif // RL_MDL_TIMEOPTIMALPARAMETERIZATION_H
@@ -27,6 +27,8 @@
 #ifndef RL_PLAN_ADDRRTCONCON_H
 #define RL_PLAN_ADDRRTCONCON_H
 
+#include <vector>
+
 #include "RrtConCon.h"
 
 namespace rl
@@ -62,6 +64,8 @@ namespace rl
 			
 			void setLower(const ::rl::math::Real& lower);
 			
+			void reset();
+			
 			void setRadius(const ::rl::math::Real& radius);
 			
 			bool solve();
@@ -76,17 +80,13 @@ namespace rl
 			::rl::math::Real radius;
 			
 		protected:
-			struct VertexBundle : Rrt::VertexBundle
-			{
-				::rl::math::Real radius;
-			};
+			Vertex addVertex(Tree& tree, const ::rl::math::ConstVectorRef& q);
 			
-			Vertex addVertex(Tree& tree, const VectorPtr& q);
-			
-			static VertexBundle* get(const Tree& tree, const Vertex& v);
+			::rl::math::Real& getVertexRadius(const Tree& tree, const Vertex& v);
 			
 		private:
-			
+			/** Vertex radii of each tree, indexed by VertexBundle::index. */
+			::std::vector<::std::vector<::rl::math::Real>> radii;
 		};
 	}
 }
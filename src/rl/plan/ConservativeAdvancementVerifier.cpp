@@ -0,0 +1,271 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <limits>
+#include <unordered_map>
+#include <rl/mdl/Body.h>
+#include <rl/mdl/Fixed.h>
+#include <rl/mdl/Frame.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/Prismatic.h>
+#include <rl/mdl/Revolute.h>
+#include <rl/sg/Body.h>
+#include <rl/sg/DistanceScene.h>
+#include <rl/sg/Model.h>
+
+#include "ConservativeAdvancementVerifier.h"
+#include "Exception.h"
+#include "SimpleModel.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		ConservativeAdvancementVerifier::ConservativeAdvancementVerifier() :
+			Verifier(),
+			epsilon(static_cast<::rl::math::Real>(1.0e-3)),
+			bounds(),
+			queries(0),
+			boundsKinematic(nullptr),
+			boundsModel(nullptr)
+		{
+		}
+		
+		ConservativeAdvancementVerifier::~ConservativeAdvancementVerifier()
+		{
+		}
+		
+		::rl::math::Real
+		ConservativeAdvancementVerifier::getEpsilon() const
+		{
+			return this->epsilon;
+		}
+		
+		::std::size_t
+		ConservativeAdvancementVerifier::getQueries() const
+		{
+			return this->queries;
+		}
+		
+		bool
+		ConservativeAdvancementVerifier::isColliding(const ::rl::math::Vector& u, const ::rl::math::Vector& v, const ::rl::math::Real& d)
+		{
+			assert(u.size() == this->getModel()->getDofPosition());
+			assert(v.size() == this->getModel()->getDofPosition());
+			
+			::rl::sg::DistanceScene* scene = dynamic_cast<::rl::sg::DistanceScene*>(this->getModel()->scene);
+			
+			if (nullptr == scene)
+			{
+				throw Exception("rl::plan::ConservativeAdvancementVerifier::isColliding() - Scene does not support distance queries");
+			}
+			
+			if (this->getModel()->mdl != this->boundsKinematic || this->getModel()->model != this->boundsModel)
+			{
+				this->updateBounds();
+			}
+			
+			::rl::math::Vector delta(u.size());
+			
+			for (::std::size_t i = 0, j = 0; i < this->getModel()->mdl->getJoints(); j += this->getModel()->mdl->getJoint(i)->getDofPosition(), ++i)
+			{
+				::rl::mdl::Joint* joint = this->getModel()->mdl->getJoint(i);
+				
+				for (::std::size_t k = 0; k < joint->getDofPosition(); ++k)
+				{
+					delta(j + k) = joint->distance(u.segment(j, joint->getDofPosition()), v.segment(j, joint->getDofPosition()));
+				}
+			}
+			
+			::std::vector<::rl::math::Real> motion(this->bounds.size(), 0);
+			
+			for (::std::size_t i = 0; i < this->bounds.size(); ++i)
+			{
+				for (::std::size_t j = 0; j < this->bounds[i].size(); ++j)
+				{
+					motion[i] += this->bounds[i][j].second * delta(this->bounds[i][j].first);
+				}
+			}
+			
+			::rl::math::Vector inter(u.size());
+			::rl::math::Vector3 point1;
+			::rl::math::Vector3 point2;
+			::rl::math::Real t = 0;
+			
+			this->queries = 0;
+			
+			while (t < 1)
+			{
+				this->getModel()->interpolate(u, v, t, inter);
+				this->getModel()->setPosition(inter);
+				this->getModel()->updateFrames();
+				++this->queries;
+				
+				::rl::math::Real step = ::std::numeric_limits<::rl::math::Real>::infinity();
+				
+				for (::std::size_t i = 0; i < this->bounds.size(); ++i)
+				{
+					if (!this->getModel()->isColliding(i))
+					{
+						continue;
+					}
+					
+					::rl::sg::Body* body = this->getModel()->model->getBody(i);
+					
+					for (::rl::sg::Scene::Iterator j = scene->begin(); j != scene->end(); ++j)
+					{
+						if (this->getModel()->model != *j)
+						{
+							for (::rl::sg::Model::Iterator k = (*j)->begin(); k != (*j)->end(); ++k)
+							{
+								::rl::math::Real distance = scene->distance(body, *k, point1, point2);
+								
+								if (distance < this->epsilon)
+								{
+									return true;
+								}
+								
+								if (motion[i] > 0)
+								{
+									step = ::std::min(step, distance / motion[i]);
+								}
+							}
+						}
+					}
+					
+					for (::std::size_t j = 0; j < i; ++j)
+					{
+						if (this->getModel()->areColliding(i, j))
+						{
+							::rl::math::Real distance = scene->distance(body, this->getModel()->model->getBody(j), point1, point2);
+							
+							if (distance < this->epsilon)
+							{
+								return true;
+							}
+							
+							if (motion[i] + motion[j] > 0)
+							{
+								step = ::std::min(step, distance / (motion[i] + motion[j]));
+							}
+						}
+					}
+				}
+				
+				t += step;
+			}
+			
+			return false;
+		}
+		
+		void
+		ConservativeAdvancementVerifier::setEpsilon(const ::rl::math::Real& epsilon)
+		{
+			this->epsilon = epsilon;
+		}
+		
+		void
+		ConservativeAdvancementVerifier::updateBounds()
+		{
+			::rl::mdl::Kinematic* mdl = this->getModel()->mdl;
+			
+			if (nullptr == mdl)
+			{
+				throw Exception("rl::plan::ConservativeAdvancementVerifier::updateBounds() - Model requires rl::mdl kinematics");
+			}
+			
+			::std::unordered_map<const ::rl::mdl::Frame*, const ::rl::mdl::Transform*> transforms;
+			
+			for (::std::size_t i = 0; i < mdl->getTransforms(); ++i)
+			{
+				transforms[mdl->getTransform(i)->out] = mdl->getTransform(i);
+			}
+			
+			::std::unordered_map<const ::rl::mdl::Joint*, ::std::size_t> offsets;
+			
+			for (::std::size_t i = 0, j = 0; i < mdl->getJoints(); j += mdl->getJoint(i)->getDofPosition(), ++i)
+			{
+				offsets[mdl->getJoint(i)] = j;
+			}
+			
+			this->bounds.resize(this->getModel()->model->getNumBodies());
+			
+			for (::std::size_t i = 0; i < this->bounds.size(); ++i)
+			{
+				::rl::sg::Body* body = this->getModel()->model->getBody(i);
+				::rl::math::Real reach = 0;
+				
+				if (!body->points.empty())
+				{
+					for (::std::size_t j = 0; j < body->points.size(); ++j)
+					{
+						reach = ::std::max(reach, body->points[j].norm());
+					}
+				}
+				else if (body->min != body->max)
+				{
+					reach = body->min.cwiseAbs().cwiseMax(body->max.cwiseAbs()).norm();
+				}
+				else if (body->getNumShapes() > 0)
+				{
+					throw Exception("rl::plan::ConservativeAdvancementVerifier::updateBounds() - Body " + body->getName() + " has no bounding box or points, load scene with doBoundingBoxPoints");
+				}
+				
+				this->bounds[i].clear();
+				
+				const ::rl::mdl::Frame* frame = mdl->getBody(i);
+				::std::unordered_map<const ::rl::mdl::Frame*, const ::rl::mdl::Transform*>::const_iterator transform = transforms.find(frame);
+				
+				while (transforms.end() != transform)
+				{
+					if (const ::rl::mdl::Revolute* revolute = dynamic_cast<const ::rl::mdl::Revolute*>(transform->second))
+					{
+						this->bounds[i].emplace_back(offsets[revolute], reach);
+					}
+					else if (const ::rl::mdl::Prismatic* prismatic = dynamic_cast<const ::rl::mdl::Prismatic*>(transform->second))
+					{
+						this->bounds[i].emplace_back(offsets[prismatic], 1);
+						reach += ::std::max(::std::abs(prismatic->min(0)), ::std::abs(prismatic->max(0)));
+					}
+					else if (const ::rl::mdl::Fixed* fixed = dynamic_cast<const ::rl::mdl::Fixed*>(transform->second))
+					{
+						reach += fixed->getTransform().translation().norm();
+					}
+					else
+					{
+						throw Exception("rl::plan::ConservativeAdvancementVerifier::updateBounds() - Only revolute and prismatic joints supported");
+					}
+					
+					transform = transforms.find(transform->second->in);
+				}
+			}
+			
+			this->boundsKinematic = mdl;
+			this->boundsModel = this->getModel()->model;
+		}
+	}
+}
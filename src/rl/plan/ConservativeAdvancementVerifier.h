@@ -0,0 +1,114 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef RL_PLAN_CONSERVATIVEADVANCEMENTVERIFIER_H
+#define RL_PLAN_CONSERVATIVEADVANCEMENTVERIFIER_H
+
+#include <utility>
+#include <vector>
+
+#include "Verifier.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		class Kinematic;
+	}
+	
+	namespace sg
+	{
+		class Model;
+	}
+	
+	namespace plan
+	{
+		/**
+		 * Continuous collision checking via conservative advancement.
+		 *
+		 * For every body, the displacement of its points along a straight-line
+		 * motion is bounded by the joint motions weighted with the maximum
+		 * distance of the body from the respective joint axis along the
+		 * kinematic chain. Starting from u, the motion is advanced by the
+		 * largest step that keeps all bodies within their distance to the
+		 * environment and to other bodies, until v is reached or a distance
+		 * drops below epsilon.
+		 *
+		 * Requires a model based on rl::mdl with revolute and prismatic joints,
+		 * an rl::sg::DistanceScene, and bodies with bounding box or convex hull
+		 * points.
+		 *
+		 * Fabian Schwarzer, Mitul Saha, and Jean-Claude Latombe. Adaptive
+		 * dynamic collision checking for single and multiple articulated
+		 * robots in complex environments. IEEE Transactions on Robotics,
+		 * 21(3):338-353, 2005.
+		 *
+		 * http://dx.doi.org/10.1109/TRO.2004.838008
+		 */
+		class RL_PLAN_EXPORT ConservativeAdvancementVerifier : public Verifier
+		{
+		public:
+			ConservativeAdvancementVerifier();
+			
+			virtual ~ConservativeAdvancementVerifier();
+			
+			::rl::math::Real getEpsilon() const;
+			
+			/** Number of configurations evaluated by the last call to isColliding(). */
+			::std::size_t getQueries() const;
+			
+			bool isColliding(const ::rl::math::Vector& u, const ::rl::math::Vector& v, const ::rl::math::Real& d);
+			
+			void setEpsilon(const ::rl::math::Real& epsilon);
+			
+			/** Distances below epsilon are treated as collisions. */
+			::rl::math::Real epsilon;
+			
+		protected:
+			/**
+			 * Weighted position coordinates bounding the motion of each body.
+			 * 
+			 * The bounds only depend on the geometry of the model and are computed
+			 * again if the kinematics or the scene model of the model change.
+			 */
+			void updateBounds();
+			
+			::std::vector<::std::vector<::std::pair<::std::size_t, ::rl::math::Real>>> bounds;
+			
+			::std::size_t queries;
+			
+		private:
+			/** Kinematics the bounds were computed for. */
+			const ::rl::mdl::Kinematic* boundsKinematic;
+			
+			/** Scene model the bounds were computed for. */
+			const ::rl::sg::Model* boundsModel;
+		};
+	}
+}
+
+#endif // RL_PLAN_CONSERVATIVEADVANCEMENTVERIFIER_H
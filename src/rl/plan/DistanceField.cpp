@@ -0,0 +1,372 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <thread>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif // WIN32
+
+#include "DistanceField.h"
+#include "DistanceModel.h"
+#include "Exception.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		namespace
+		{
+			struct Header
+			{
+				char magic[4];
+				
+				::std::uint32_t version;
+				
+				::std::uint64_t size[3];
+				
+				double origin[3];
+				
+				double resolution;
+			};
+			
+			constexpr char magic[4] = {'R', 'L', 'D', 'F'};
+			
+			constexpr ::std::uint32_t version = 1;
+		}
+		
+		DistanceField::DistanceField() :
+			data(nullptr),
+			mapping(nullptr),
+			mappingSize(0),
+			origin(::rl::math::Vector3::Zero()),
+			resolution(0),
+			size(),
+			values()
+		{
+			this->size.fill(0);
+		}
+		
+		DistanceField::~DistanceField()
+		{
+			this->clear();
+		}
+		
+		float
+		DistanceField::at(const ::std::size_t& x, const ::std::size_t& y, const ::std::size_t& z) const
+		{
+			return this->data[(z * this->size[1] + y) * this->size[0] + x];
+		}
+		
+		void
+		DistanceField::build(const ::std::vector<DistanceModel*>& models, const ::rl::math::AlignedBox3& boundingBox, const ::rl::math::Real& resolution)
+		{
+			if (models.empty())
+			{
+				throw Exception("rl::plan::DistanceField::build() - No models");
+			}
+			
+			if (resolution <= 0)
+			{
+				throw Exception("rl::plan::DistanceField::build() - Resolution must be positive");
+			}
+			
+			this->clear();
+			
+			::std::array<::std::size_t, 3> size;
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				size[i] = static_cast<::std::size_t>(::std::ceil(boundingBox.sizes()(i) / resolution)) + 1;
+			}
+			
+			::std::vector<float> values(size[0] * size[1] * size[2]);
+			
+			auto sample = [&](const ::std::size_t& worker)
+			{
+				for (::std::size_t z = worker; z < size[2]; z += models.size())
+				{
+					for (::std::size_t y = 0; y < size[1]; ++y)
+					{
+						for (::std::size_t x = 0; x < size[0]; ++x)
+						{
+							::rl::math::Vector3 point = boundingBox.min() + resolution * ::rl::math::Vector3(x, y, z);
+							::rl::math::Real distance = models[worker]->exactDistance(point);
+							values[(z * size[1] + y) * size[0] + x] = static_cast<float>(::std::min<::rl::math::Real>(distance, ::std::numeric_limits<float>::max()));
+						}
+					}
+				}
+			};
+			
+			::std::vector<::std::thread> threads;
+			
+			for (::std::size_t i = 1; i < models.size(); ++i)
+			{
+				threads.push_back(::std::thread(sample, i));
+			}
+			
+			sample(0);
+			
+			for (::std::size_t i = 0; i < threads.size(); ++i)
+			{
+				threads[i].join();
+			}
+			
+			this->origin = boundingBox.min();
+			this->resolution = resolution;
+			this->size = size;
+			this->values.swap(values);
+			this->data = this->values.data();
+		}
+		
+		void
+		DistanceField::clear()
+		{
+#ifndef WIN32
+			if (nullptr != this->mapping)
+			{
+				::munmap(this->mapping, this->mappingSize);
+			}
+#endif // WIN32
+			
+			this->data = nullptr;
+			this->mapping = nullptr;
+			this->mappingSize = 0;
+			this->origin.setZero();
+			this->resolution = 0;
+			this->size.fill(0);
+			this->values.clear();
+			this->values.shrink_to_fit();
+		}
+		
+		bool
+		DistanceField::contains(const ::rl::math::Vector3& point) const
+		{
+			return !this->empty() && this->getBoundingBox().contains(point);
+		}
+		
+		::rl::math::Real
+		DistanceField::distance(const ::rl::math::Vector3& point) const
+		{
+			::std::size_t index[3];
+			::rl::math::Real weight[3];
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				::rl::math::Real coordinate = (point(i) - this->origin(i)) / this->resolution;
+				coordinate = ::std::max<::rl::math::Real>(0, ::std::min<::rl::math::Real>(coordinate, this->size[i] - 1));
+				index[i] = ::std::min(static_cast<::std::size_t>(coordinate), this->size[i] > 1 ? this->size[i] - 2 : 0);
+				weight[i] = this->size[i] > 1 ? coordinate - index[i] : 0;
+			}
+			
+			::std::size_t next[3];
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				next[i] = this->size[i] > 1 ? index[i] + 1 : index[i];
+			}
+			
+			::rl::math::Real c00 = (1 - weight[0]) * this->at(index[0], index[1], index[2]) + weight[0] * this->at(next[0], index[1], index[2]);
+			::rl::math::Real c10 = (1 - weight[0]) * this->at(index[0], next[1], index[2]) + weight[0] * this->at(next[0], next[1], index[2]);
+			::rl::math::Real c01 = (1 - weight[0]) * this->at(index[0], index[1], next[2]) + weight[0] * this->at(next[0], index[1], next[2]);
+			::rl::math::Real c11 = (1 - weight[0]) * this->at(index[0], next[1], next[2]) + weight[0] * this->at(next[0], next[1], next[2]);
+			
+			::rl::math::Real c0 = (1 - weight[1]) * c00 + weight[1] * c10;
+			::rl::math::Real c1 = (1 - weight[1]) * c01 + weight[1] * c11;
+			
+			return (1 - weight[2]) * c0 + weight[2] * c1;
+		}
+		
+		bool
+		DistanceField::empty() const
+		{
+			return nullptr == this->data;
+		}
+		
+		::rl::math::AlignedBox3
+		DistanceField::getBoundingBox() const
+		{
+			return ::rl::math::AlignedBox3(
+				this->origin,
+				this->origin + this->resolution * ::rl::math::Vector3(
+					this->size[0] > 0 ? this->size[0] - 1 : 0,
+					this->size[1] > 0 ? this->size[1] - 1 : 0,
+					this->size[2] > 0 ? this->size[2] - 1 : 0
+				)
+			);
+		}
+		
+		::rl::math::Real
+		DistanceField::getError() const
+		{
+			return ::std::sqrt(static_cast<::rl::math::Real>(3)) * this->resolution;
+		}
+		
+		const ::rl::math::Real&
+		DistanceField::getResolution() const
+		{
+			return this->resolution;
+		}
+		
+		const ::std::array<::std::size_t, 3>&
+		DistanceField::getSize() const
+		{
+			return this->size;
+		}
+		
+		void
+		DistanceField::load(const ::std::string& filename)
+		{
+			this->clear();
+			
+			Header header;
+			::std::size_t count = 0;
+			
+#ifdef WIN32
+			::std::ifstream file(filename.c_str(), ::std::ios::binary);
+			
+			if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+			{
+				throw Exception("rl::plan::DistanceField::load() - Could not read " + filename);
+			}
+#else // WIN32
+			int fd = ::open(filename.c_str(), O_RDONLY);
+			
+			if (-1 == fd)
+			{
+				throw Exception("rl::plan::DistanceField::load() - Could not open " + filename);
+			}
+			
+			struct ::stat stat;
+			
+			if (-1 == ::fstat(fd, &stat) || static_cast<::std::size_t>(stat.st_size) < sizeof(header))
+			{
+				::close(fd);
+				throw Exception("rl::plan::DistanceField::load() - Could not read " + filename);
+			}
+			
+			void* mapping = ::mmap(nullptr, stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			::close(fd);
+			
+			if (MAP_FAILED == mapping)
+			{
+				throw Exception("rl::plan::DistanceField::load() - Could not map " + filename);
+			}
+			
+			this->mapping = mapping;
+			this->mappingSize = stat.st_size;
+			::std::memcpy(&header, mapping, sizeof(header));
+#endif // WIN32
+			
+			if (0 != ::std::memcmp(header.magic, magic, sizeof(magic)) || version != header.version)
+			{
+				this->clear();
+				throw Exception("rl::plan::DistanceField::load() - Unsupported format in " + filename);
+			}
+			
+			if (!(header.resolution > 0) || !::std::isfinite(header.resolution))
+			{
+				this->clear();
+				throw Exception("rl::plan::DistanceField::load() - Invalid resolution in " + filename);
+			}
+			
+			count = 1;
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				if (0 == header.size[i] || header.size[i] > ::std::numeric_limits<::std::size_t>::max() / sizeof(float) / count)
+				{
+					this->clear();
+					throw Exception("rl::plan::DistanceField::load() - Invalid size in " + filename);
+				}
+				
+				count *= static_cast<::std::size_t>(header.size[i]);
+			}
+			
+#ifdef WIN32
+			this->values.resize(count);
+			
+			if (!file.read(reinterpret_cast<char*>(this->values.data()), count * sizeof(float)))
+			{
+				this->clear();
+				throw Exception("rl::plan::DistanceField::load() - Truncated file " + filename);
+			}
+			
+			this->data = this->values.data();
+#else // WIN32
+			if ((this->mappingSize - sizeof(header)) / sizeof(float) < count)
+			{
+				this->clear();
+				throw Exception("rl::plan::DistanceField::load() - Truncated file " + filename);
+			}
+			
+			this->data = reinterpret_cast<const float*>(static_cast<const char*>(this->mapping) + sizeof(header));
+#endif // WIN32
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				this->origin(i) = header.origin[i];
+				this->size[i] = header.size[i];
+			}
+			
+			this->resolution = header.resolution;
+		}
+		
+		void
+		DistanceField::save(const ::std::string& filename) const
+		{
+			Header header;
+			::std::memcpy(header.magic, magic, sizeof(magic));
+			header.version = version;
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				header.size[i] = this->size[i];
+				header.origin[i] = this->origin(i);
+			}
+			
+			header.resolution = this->resolution;
+			
+			::std::ofstream file(filename.c_str(), ::std::ios::binary);
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(reinterpret_cast<const char*>(this->data), this->size[0] * this->size[1] * this->size[2] * sizeof(float));
+			
+			if (!file)
+			{
+				throw Exception("rl::plan::DistanceField::save() - Could not write " + filename);
+			}
+		}
+	}
+}
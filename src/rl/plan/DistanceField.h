@@ -0,0 +1,117 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef RL_PLAN_DISTANCEFIELD_H
+#define RL_PLAN_DISTANCEFIELD_H
+
+#include <array>
+#include <string>
+#include <vector>
+#include <rl/math/AlignedBox.h>
+#include <rl/math/Vector.h>
+#include <rl/plan/export.h>
+
+namespace rl
+{
+	namespace plan
+	{
+		class DistanceModel;
+		
+		/**
+		 * Workspace distance field sampled on a regular grid.
+		 *
+		 * Distances to the obstacles of a DistanceModel are sampled at the
+		 * vertices of a grid covering a bounding box and interpolated
+		 * trilinearly in between. Values are stored in single precision.
+		 *
+		 * A field can be saved to a file in native byte order and loaded again,
+		 * on POSIX systems by mapping the file into memory.
+		 */
+		class RL_PLAN_EXPORT DistanceField
+		{
+		public:
+			DistanceField();
+			
+			DistanceField(const DistanceField&) = delete;
+			
+			virtual ~DistanceField();
+			
+			DistanceField& operator=(const DistanceField&) = delete;
+			
+			/**
+			 * Samples the obstacle distances on a grid with the given resolution.
+			 *
+			 * The grid is sampled concurrently with one thread per model. Each
+			 * model needs its own scene with the same static obstacles.
+			 */
+			void build(const ::std::vector<DistanceModel*>& models, const ::rl::math::AlignedBox3& boundingBox, const ::rl::math::Real& resolution);
+			
+			void clear();
+			
+			bool contains(const ::rl::math::Vector3& point) const;
+			
+			/** Trilinear interpolation of the sampled distances. */
+			::rl::math::Real distance(const ::rl::math::Vector3& point) const;
+			
+			bool empty() const;
+			
+			::rl::math::AlignedBox3 getBoundingBox() const;
+			
+			/** Upper bound on the deviation of distance() from the sampled distance function. */
+			::rl::math::Real getError() const;
+			
+			const ::rl::math::Real& getResolution() const;
+			
+			const ::std::array<::std::size_t, 3>& getSize() const;
+			
+			void load(const ::std::string& filename);
+			
+			void save(const ::std::string& filename) const;
+			
+		protected:
+			
+		private:
+			float at(const ::std::size_t& x, const ::std::size_t& y, const ::std::size_t& z) const;
+			
+			const float* data;
+			
+			void* mapping;
+			
+			::std::size_t mappingSize;
+			
+			::rl::math::Vector3 origin;
+			
+			::rl::math::Real resolution;
+			
+			::std::array<::std::size_t, 3> size;
+			
+			::std::vector<float> values;
+		};
+	}
+}
+
+#endif // RL_PLAN_DISTANCEFIELD_H
@@ -27,6 +27,7 @@
 #include <rl/sg/Body.h>
 #include <rl/sg/DistanceScene.h>
 
+#include "DistanceField.h"
 #include "DistanceModel.h"
 
 namespace rl
@@ -34,7 +35,8 @@ namespace rl
 	namespace plan
 	{
 		DistanceModel::DistanceModel() :
-			SimpleModel()
+			SimpleModel(),
+			field(nullptr)
 		{
 		}
 		
@@ -45,19 +47,17 @@ namespace rl
 		::rl::math::Real
 		DistanceModel::distance(const ::rl::math::Vector3& point)
 		{
-			::rl::math::Real distance = ::std::numeric_limits<::rl::math::Real>::max();
-			::rl::math::Vector3 point1;
-			::rl::math::Vector3 point2;
-			
-			for (::rl::sg::Scene::Iterator i = this->scene->begin(); i != this->scene->end(); ++i)
+			if (nullptr != this->field && this->field->contains(point))
 			{
-				if (*i != this->model)
+				::rl::math::Real distance = this->field->distance(point) - this->field->getError();
+				
+				if (distance > this->field->getError())
 				{
-					distance = ::std::min(distance, dynamic_cast<::rl::sg::DistanceScene*>(this->scene)->distance(*i, point, point1, point2));
+					return distance;
 				}
 			}
 			
-			return distance;
+			return this->exactDistance(point);
 		}
 		
 		::rl::math::Real
@@ -185,5 +185,23 @@ namespace rl
 				}
 			}
 		}
+		
+		::rl::math::Real
+		DistanceModel::exactDistance(const ::rl::math::Vector3& point)
+		{
+			::rl::math::Real distance = ::std::numeric_limits<::rl::math::Real>::max();
+			::rl::math::Vector3 point1;
+			::rl::math::Vector3 point2;
+			
+			for (::rl::sg::Scene::Iterator i = this->scene->begin(); i != this->scene->end(); ++i)
+			{
+				if (*i != this->model)
+				{
+					distance = ::std::min(distance, dynamic_cast<::rl::sg::DistanceScene*>(this->scene)->distance(*i, point, point1, point2));
+				}
+			}
+			
+			return distance;
+		}
 	}
 }
@@ -37,6 +37,8 @@ namespace rl
 {
 	namespace plan
 	{
+		class DistanceField;
+		
 		class RL_PLAN_EXPORT DistanceModel : public SimpleModel
 		{
 		public:
@@ -46,12 +48,25 @@ namespace rl
 			
 			using SimpleModel::distance;
 			
+			/**
+			 * Distance of a point to all models but the robot.
+			 *
+			 * Inside the bounding box of field, the interpolated distance reduced
+			 * by its error bound is returned, unless this is within the error
+			 * bound of the surface and exactDistance() is used instead.
+			 */
 			virtual ::rl::math::Real distance(const ::rl::math::Vector3& point);
 			
 			virtual ::rl::math::Real distance(const ::std::size_t& body, ::rl::math::Vector3& point1, ::rl::math::Vector3& point2);
 			
 			virtual void distance(const ::std::size_t& body, RealList& distances, Vector3List& points1, Vector3List& points2);
 			
+			/** Distance of a point to all models but the robot as reported by the scene. */
+			::rl::math::Real exactDistance(const ::rl::math::Vector3& point);
+			
+			/** Optional distance field of the static obstacles. */
+			DistanceField* field;
+			
 		protected:
 			
 		private:
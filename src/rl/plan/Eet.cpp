@@ -24,6 +24,7 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <cassert>
 #include <chrono>
 #include <rl/math/Quaternion.h>
 #include <rl/math/Rotation.h>
@@ -68,7 +69,8 @@ namespace rl
 			randEngine(::std::random_device()()),
 			explorationTimeStart(),
 			explorationTimeStop(),
-			nn(WorkspaceMetric(&this->distanceWeight, &this->alternativeDistanceComputation))
+			nn(WorkspaceMetric(&this->distanceWeight, &this->alternativeDistanceComputation)),
+			transforms()
 		{
 		}
 		
@@ -80,10 +82,11 @@ namespace rl
 		Eet::addEdge(const Vertex& u, const Vertex& v, Tree& tree)
 		{
 			Edge e = ::boost::add_edge(u, v, tree).first;
+			tree[::boost::graph_bundle].parents[get(tree, v)->index] = get(tree, u)->index;
 			
 			if (nullptr != this->getViewer())
 			{
-				this->getViewer()->drawConfigurationEdge(*get(tree, u)->q, *get(tree, v)->q);
+				this->getViewer()->drawConfigurationEdge(getConfiguration(tree, u), getConfiguration(tree, v));
 			}
 			
 			return e;
@@ -102,18 +105,25 @@ namespace rl
 		}
 		
 		Eet::Vertex
-		Eet::addVertex(Tree& tree, const VectorPtr& q)
+		Eet::addVertex(Tree& tree, const ::rl::math::ConstVectorRef& q)
 		{
-			::std::shared_ptr<VertexBundle> bundle = ::std::make_shared<VertexBundle>();
-			bundle->index = ::boost::num_vertices(tree) - 1;
-			bundle->q = q;
+			TreeBundle& treeBundle = tree[::boost::graph_bundle];
+			
+			if (treeBundle.q.empty())
+			{
+				treeBundle.q.setStride(q.size());
+			}
 			
 			Vertex v = ::boost::add_vertex(tree);
-			tree[v] = bundle;
+			tree[v].index = treeBundle.q.push_back(q);
+			treeBundle.parents.push_back(tree[v].index);
+			
+			assert(tree[v].index == this->transforms.size());
+			this->transforms.push_back(::rl::math::Transform::Identity());
 			
 			if (nullptr != this->getViewer())
 			{
-				this->getViewer()->drawConfigurationVertex(*get(tree, v)->q);
+				this->getViewer()->drawConfigurationVertex(getConfiguration(tree, v));
 			}
 			
 			return v;
@@ -134,28 +144,27 @@ namespace rl
 		Rrt::Vertex
 		Eet::connect(Tree& tree, const Neighbor& nearest, const ::rl::math::Transform& chosen)
 		{
-			::rl::math::Real distance = this->distance(*get(tree, nearest.second)->t, chosen);
+			::rl::math::Real distance = this->distance(this->getTransform(tree, nearest.second), chosen);
 			
 			Vertex connected = nullptr;
 			Vertex n = nearest.second;
 			int state = 1;
 			
+			::rl::math::Vector q(this->getModel()->getDofPosition());
+			::rl::math::Transform t;
+			
 			do
 			{
-				VertexBundle best;
-				best.q = ::std::make_shared<::rl::math::Vector>(this->getModel()->getDofPosition());
-				best.t = ::std::make_shared<::rl::math::Transform>();
-				
-				state = this->expand(get(tree, n), *get(tree, nearest.second)->t, chosen, distance, best); // TODO
+				state = this->expand(getConfiguration(tree, n), this->getTransform(tree, nearest.second), chosen, distance, q, t); // TODO
 				
 				if (state >= 0)
 				{
-					connected = this->addVertex(tree, best.q);
-					get(tree, connected)->t = best.t;
+					connected = this->addVertex(tree, q);
+					this->getTransform(tree, connected) = t;
 					this->addEdge(n, connected, tree);
 					n = connected;
 					
-					::rl::math::Real distance2 = this->distance(*get(tree, n)->t, chosen);
+					::rl::math::Real distance2 = this->distance(this->getTransform(tree, n), chosen);
 					
 					if (distance2 > distance)
 					{
@@ -173,7 +182,7 @@ namespace rl
 			
 			if (nullptr != connected)
 			{
-				this->nn.push(WorkspaceMetric::Value(get(tree, connected)->t.get(), connected));
+				this->nn.push(WorkspaceMetric::Value(&this->getTransform(tree, connected), connected));
 			}
 			
 			return connected;
@@ -194,13 +203,13 @@ namespace rl
 		}
 		
 		int
-		Eet::expand(const VertexBundle* nearest, const ::rl::math::Transform& nearest2, const ::rl::math::Transform& chosen, const ::rl::math::Real& distance, VertexBundle& expanded)
+		Eet::expand(const ::rl::math::ConstVectorRef& nearest, const ::rl::math::Transform& nearest2, const ::rl::math::Transform& chosen, const ::rl::math::Real& distance, ::rl::math::Vector& expanded, ::rl::math::Transform& expanded2)
 		{
 			int state = 1;
 			
 			::rl::math::Vector6 tdot = nearest2.toDelta(chosen, true);
 			
-			this->getModel()->setPosition(*nearest->q);
+			this->getModel()->setPosition(nearest);
 			this->getModel()->updateFrames();
 			this->getModel()->updateJacobian();
 			this->getModel()->updateJacobianInverse();
@@ -222,31 +231,31 @@ namespace rl
 				qdot *= this->getDelta();
 			}
 			
-			this->getModel()->step(*nearest->q, qdot, *expanded.q);
+			this->getModel()->step(nearest, qdot, expanded);
 			
 			if (this->getModel()->getManipulabilityMeasure() < static_cast<::rl::math::Real>(1.0e-3)) // within singularity
 			{
-				*expanded.q = this->getSampler()->generate(); // uniform sampling for singularities
-				::rl::math::Real tmp = this->getModel()->distance(*nearest->q, *expanded.q);
-				this->getModel()->interpolate(*nearest->q, *expanded.q, this->getDelta() / tmp, *expanded.q);
+				expanded = this->getSampler()->generate(); // uniform sampling for singularities
+				::rl::math::Real tmp = this->getModel()->distance(nearest, expanded);
+				this->getModel()->interpolate(nearest, expanded, this->getDelta() / tmp, expanded);
 			}
 			
-			if (!this->getModel()->isValid(*expanded.q))
+			if (!this->getModel()->isValid(expanded))
 			{
 				return -1;
 			}
 			
 			if (nullptr != this->getViewer())
 			{
-				this->getViewer()->drawConfiguration(*expanded.q);
+				this->getViewer()->drawConfiguration(expanded);
 			}
 			
-			if (this->getModel()->isColliding(*expanded.q))
+			if (this->getModel()->isColliding(expanded))
 			{
 				return -1;
 			}
 			
-			*expanded.t = this->getModel()->forwardPosition();
+			expanded2 = this->getModel()->forwardPosition();
 			
 			return state;
 		}
@@ -254,18 +263,17 @@ namespace rl
 		Rrt::Vertex
 		Eet::extend(Tree& tree, const Neighbor& nearest, const ::rl::math::Transform& chosen)
 		{
-			::rl::math::Real distance = this->distance(*get(tree, nearest.second)->t, chosen);
+			::rl::math::Real distance = this->distance(this->getTransform(tree, nearest.second), chosen);
 			
 			Vertex extended = nullptr;
 			
-			VertexBundle best;
-			best.q = ::std::make_shared<::rl::math::Vector>(this->getModel()->getDofPosition());
-			best.t = ::std::make_shared<::rl::math::Transform>();
+			::rl::math::Vector q(this->getModel()->getDofPosition());
+			::rl::math::Transform t;
 			
-			if (this->expand(get(tree, nearest.second), *get(tree, nearest.second)->t, chosen, distance, best) >= 0)
+			if (this->expand(getConfiguration(tree, nearest.second), this->getTransform(tree, nearest.second), chosen, distance, q, t) >= 0)
 			{
-				extended = this->addVertex(tree, best.q);
-				get(tree, extended)->t = best.t;
+				extended = this->addVertex(tree, q);
+				this->getTransform(tree, extended) = t;
 				this->addEdge(nearest.second, extended, tree);
 			}
 			
@@ -278,12 +286,6 @@ namespace rl
 			return this->gaussDistribution(this->gaussEngine);
 		}
 		
-		Eet::VertexBundle*
-		Eet::get(const Tree& tree, const Vertex& v)
-		{
-			return static_cast<VertexBundle*>(tree[v].get());
-		}
-		
 		::rl::math::Real
 		Eet::getAlpha() const
 		{
@@ -380,6 +382,12 @@ namespace rl
 			return Rrt::getPath();
 		}
 		
+		::rl::math::Transform&
+		Eet::getTransform(const Tree& tree, const Vertex& v)
+		{
+			return this->transforms[get(tree, v)->index];
+		}
+		
 		Rrt::Neighbor
 		Eet::nearest(const Tree& tree, const ::rl::math::Transform& chosen)
 		{
@@ -404,6 +412,7 @@ namespace rl
 			}
 			
 			this->nn.clear();
+			this->transforms.clear();
 		}
 		
 		void
@@ -546,11 +555,11 @@ namespace rl
 			
 			// tree initialization with start configuration
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->getStart()));
+			this->begin[0] = this->addVertex(this->tree[0], *this->getStart());
 			this->getModel()->setPosition(*this->getStart());
 			this->getModel()->updateFrames();
-			get(this->tree[0], this->begin[0])->t = ::std::make_shared<::rl::math::Transform>(this->getModel()->forwardPosition());
-			this->nn.push(WorkspaceMetric::Value(get(this->tree[0], this->begin[0])->t.get(), begin[0]));
+			this->getTransform(this->tree[0], this->begin[0]) = this->getModel()->forwardPosition();
+			this->nn.push(WorkspaceMetric::Value(&this->getTransform(this->tree[0], this->begin[0]), begin[0]));
 			
 			::rl::math::Transform chosen;
 			chosen.setIdentity();
@@ -577,9 +586,9 @@ namespace rl
 					{
 						// sample within sphere
 						
-						chosen.translation().x() = this->gauss() * sigma * i->radius + (*i->center).x();
-						chosen.translation().y() = this->gauss() * sigma * i->radius + (*i->center).y();
-						chosen.translation().z() = this->gauss() * sigma * i->radius + (*i->center).z();
+						chosen.translation().x() = this->gauss() * sigma * i->radius + i->center.x();
+						chosen.translation().y() = this->gauss() * sigma * i->radius + i->center.y();
+						chosen.translation().z() = this->gauss() * sigma * i->radius + i->center.z();
 						
 						for (::std::size_t k = 0; k < 3; ++k)
 						{
@@ -599,7 +608,7 @@ namespace rl
 							
 							chosen.linear() = ::rl::math::Quaternion::Random(
 								::rl::math::Vector3(this->gauss(), this->gauss(), this->gauss()),
-								::rl::math::Quaternion((*get(this->tree[0], nearest.second)->t).linear()),
+								::rl::math::Quaternion((this->getTransform(this->tree[0], nearest.second)).linear()),
 								::rl::math::Vector3::Constant(sigma / this->beta)
 							).toRotationMatrix();
 						}
@@ -616,7 +625,7 @@ namespace rl
 					{
 						if (this->goalEpsilonUseOrientation)
 						{
-							if (this->distance(*get(this->tree[0], connected)->t, goal) < this->goalEpsilon)
+							if (this->distance(this->getTransform(this->tree[0], connected), goal) < this->goalEpsilon)
 							{
 								this->end[0] = connected;
 								return true;
@@ -624,7 +633,7 @@ namespace rl
 						}
 						else
 						{
-							if ((get(this->tree[0], connected)->t->translation() - goal.translation()).norm() < this->goalEpsilon)
+							if ((this->getTransform(this->tree[0], connected).translation() - goal.translation()).norm() < this->goalEpsilon)
 							{
 								this->end[0] = connected;
 								return true;
@@ -636,7 +645,7 @@ namespace rl
 						
 						for (WorkspaceSphereVector::reverse_iterator k = ++path.rbegin(); k.base() != i; ++k) // search spheres backwards
 						{
-							if (((*get(this->tree[0], connected)->t).translation() - *k->center).norm() < k->radius) // position is within sphere
+							if ((this->getTransform(this->tree[0], connected).translation() - k->center).norm() < k->radius) // position is within sphere
 							{
 								i = k.base(); // advance to matching sphere
 								sigma = gamma; // reset exploration/exploitation balance
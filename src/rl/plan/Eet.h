@@ -27,11 +27,11 @@
 #ifndef RL_PLAN_EET_H
 #define RL_PLAN_EET_H
 
+#include <deque>
 #include <random>
 #include <rl/math/GnatNearestNeighbors.h>
 
 #include "RrtCon.h"
-#include "TransformPtr.h"
 #include "WorkspaceMetric.h"
 
 namespace rl
@@ -171,14 +171,9 @@ namespace rl
 			::rl::math::Vector3 min;
 			
 		protected:
-			struct VertexBundle : Rrt::VertexBundle
-			{
-				TransformPtr t;
-			};
-			
 			Edge addEdge(const Vertex& u, const Vertex& v, Tree& tree);
 			
-			Vertex addVertex(Tree& tree, const VectorPtr& q);
+			Vertex addVertex(Tree& tree, const ::rl::math::ConstVectorRef& q);
 			
 			using RrtCon::connect;
 			
@@ -186,7 +181,7 @@ namespace rl
 			
 			::rl::math::Real distance(const ::rl::math::Transform& t1, const ::rl::math::Transform& t2) const;
 			
-			int expand(const VertexBundle* nearest, const ::rl::math::Transform& nearest2, const ::rl::math::Transform& chosen, const ::rl::math::Real& distance, VertexBundle& expanded);
+			int expand(const ::rl::math::ConstVectorRef& nearest, const ::rl::math::Transform& nearest2, const ::rl::math::Transform& chosen, const ::rl::math::Real& distance, ::rl::math::Vector& expanded, ::rl::math::Transform& expanded2);
 			
 			using RrtCon::extend;
 			
@@ -194,7 +189,7 @@ namespace rl
 			
 			::std::normal_distribution<::rl::math::Real>::result_type gauss();
 			
-			static VertexBundle* get(const Tree& tree, const Vertex& v);
+			::rl::math::Transform& getTransform(const Tree& tree, const Vertex& v);
 			
 			using RrtCon::nearest;
 			
@@ -216,6 +211,14 @@ namespace rl
 			::std::chrono::steady_clock::time_point explorationTimeStop;
 			
 			::rl::math::GnatNearestNeighbors<WorkspaceMetric> nn;
+			
+			/**
+			 * Workspace frames of the vertices, indexed by VertexBundle::index.
+			 * 
+			 * Elements keep their address as the container grows, the nearest
+			 * neighbors in workspace refer to them.
+			 */
+			::std::deque<::rl::math::Transform, ::Eigen::aligned_allocator<::rl::math::Transform>> transforms;
 		};
 	}
 }
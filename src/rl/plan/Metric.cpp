@@ -46,11 +46,11 @@ namespace rl
 		{
 			if (this->transformed)
 			{
-				return this->model->transformedDistance(*lhs.first, *rhs.first);
+				return this->model->transformedDistance(lhs.get(), rhs.get());
 			}
 			else
 			{
-				return this->model->distance(*lhs.first, *rhs.first);
+				return this->model->distance(lhs.get(), rhs.get());
 			}
 		}
 		
@@ -61,33 +61,48 @@ namespace rl
 		}
 		
 		Metric::Value::Value() :
+			dimension(),
 			first(),
 			second()
 		{
 		}
 		
-		Metric::Value::Value(const ::rl::math::Vector* first, void* second) :
+		Metric::Value::Value(const ::rl::math::Real* first, const ::std::size_t& dimension, void* second) :
+			dimension(dimension),
 			first(first),
 			second(second)
 		{
 		}
 		
+		Metric::Value::Value(const ::rl::math::Vector* first, void* second) :
+			dimension(first->size()),
+			first(first->data()),
+			second(second)
+		{
+		}
+		
 		const ::rl::math::Real*
 		Metric::Value::begin() const
 		{
-			return this->first->data();
+			return this->first;
 		}
 		
 		const ::rl::math::Real*
 		Metric::Value::end() const
 		{
-			return this->first->data() + this->first->size();
+			return this->first + this->dimension;
+		}
+		
+		::Eigen::Map<const ::rl::math::Vector>
+		Metric::Value::get() const
+		{
+			return ::Eigen::Map<const ::rl::math::Vector>(this->first, this->dimension);
 		}
 		
 		::std::size_t
 		Metric::Value::size() const
 		{
-			return this->first->size();
+			return this->dimension;
 		}
 	}
 }
@@ -44,21 +44,34 @@ namespace rl
 			
 			typedef ::std::size_t Size;
 			
+			/**
+			 * Configuration and associated vertex.
+			 *
+			 * The configuration is referenced by a pointer to its coefficients,
+			 * so it may point into a Vector or into contiguous storage such as
+			 * VectorArena.
+			 */
 			struct Value
 			{
 				typedef const ::rl::math::Real* const_iterator;
 				
 				Value();
 				
+				Value(const ::rl::math::Real* first, const ::std::size_t& dimension, void* second);
+				
 				Value(const ::rl::math::Vector* first, void* second);
 				
 				const ::rl::math::Real* begin() const;
 				
 				const ::rl::math::Real* end() const;
 				
+				::Eigen::Map<const ::rl::math::Vector> get() const;
+				
 				::std::size_t size() const;
 				
-				const ::rl::math::Vector* first;
+				::std::size_t dimension;
+				
+				const ::rl::math::Real* first;
 				
 				void* second;
 			};
@@ -71,7 +71,7 @@ namespace rl
 		}
 		
 		::rl::math::Real
-		Model::distance(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2) const
+		Model::distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const
 		{
 			if (nullptr != this->kin)
 			{
@@ -396,7 +396,7 @@ namespace rl
 		}
 		
 		void
-		Model::interpolate(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2, const ::rl::math::Real& alpha, ::rl::math::Vector& q) const
+		Model::interpolate(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2, const ::rl::math::Real& alpha, ::rl::math::Vector& q) const
 		{
 			if (nullptr != this->kin)
 			{
@@ -526,7 +526,7 @@ namespace rl
 		}
 		
 		::rl::math::Real
-		Model::transformedDistance(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2) const
+		Model::transformedDistance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const
 		{
 			if (nullptr != this->kin)
 			{
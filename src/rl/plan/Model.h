@@ -50,7 +50,7 @@ namespace rl
 			
 			virtual void clamp(::rl::math::Vector& q) const;
 			
-			virtual ::rl::math::Real distance(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2) const;
+			virtual ::rl::math::Real distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const;
 			
 			virtual void forwardForce(const ::rl::math::Vector& tau, ::rl::math::Vector& f) const;
 			
@@ -102,7 +102,7 @@ namespace rl
 			
 			virtual void inverseVelocity(const ::rl::math::Vector& tdot, ::rl::math::Vector& qdot) const;
 			
-			virtual void interpolate(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2, const ::rl::math::Real& alpha, ::rl::math::Vector& q) const;
+			virtual void interpolate(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2, const ::rl::math::Real& alpha, ::rl::math::Vector& q) const;
 			
 			virtual bool isColliding(const ::std::size_t& i) const;
 			
@@ -124,7 +124,7 @@ namespace rl
 			
 			virtual ::rl::math::Real transformedDistance(const ::rl::math::Real& d) const;
 			
-			virtual ::rl::math::Real transformedDistance(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2) const;
+			virtual ::rl::math::Real transformedDistance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const;
 			
 			virtual ::rl::math::Real transformedDistance(const ::rl::math::Real& q1, const ::rl::math::Real& q2, const ::std::size_t& i) const;
 			
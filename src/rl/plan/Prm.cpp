@@ -24,6 +24,9 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <functional>
+#include <thread>
+#include <tuple>
 #include <boost/graph/dijkstra_shortest_paths.hpp>
 #include <boost/graph/incremental_components.hpp>
 
@@ -45,27 +48,38 @@ namespace rl
 			astar(true),
 			degree(::std::numeric_limits<::std::size_t>::max()),
 			k(30),
+			lazy(false),
 			radius(::std::numeric_limits<::rl::math::Real>::max()),
 			sampler(nullptr),
 			verifier(nullptr),
+			workers(),
 			begin(nullptr),
 			ds(
 				::boost::get(&VertexBundle::rank, graph),
 				::boost::get(&VertexBundle::parent, graph)
 			),
 			end(nullptr),
-			graph()
+			graph(),
+			condition(),
+			function(),
+			generation(0),
+			mutex(),
+			pending(0),
+			stopped(false),
+			threads()
 		{
 		}
 		
 		Prm::~Prm()
 		{
+			this->stop();
 		}
 		
 		Prm::Edge
 		Prm::addEdge(const Vertex& u, const Vertex& v, const ::rl::math::Real& weight)
 		{
 			Edge e = ::boost::add_edge(u, v, this->graph).first;
+			this->graph[e].verified = !this->lazy;
 			this->graph[e].weight = weight;
 			
 			this->ds.union_set(u, v);
@@ -94,9 +108,28 @@ namespace rl
 			return v;
 		}
 		
+		void
+		Prm::addWorker(Sampler* sampler, Verifier* verifier)
+		{
+			this->workers.push_back(::std::make_pair(sampler, verifier));
+		}
+		
+		void
+		Prm::clearWorkers()
+		{
+			this->stop();
+			this->workers.clear();
+		}
+		
 		void
 		Prm::construct(const ::std::size_t& steps)
 		{
+			if (!this->workers.empty())
+			{
+				this->constructConcurrent(steps);
+				return;
+			}
+			
 			for (::std::size_t i = 0; i < steps; ++i)
 			{
 				VectorPtr q = ::std::make_shared<::rl::math::Vector>(this->getModel()->getDofPosition());
@@ -106,6 +139,112 @@ namespace rl
 			}
 		}
 		
+		void
+		Prm::constructConcurrent(const ::std::size_t& steps)
+		{
+			::std::vector<::std::pair<Sampler*, Verifier*>> workers(1, ::std::make_pair(this->sampler, this->verifier));
+			workers.insert(workers.end(), this->workers.begin(), this->workers.end());
+			
+			for (::std::size_t i = 0; i < steps;)
+			{
+				::std::size_t n = ::std::min(steps - i, 16 * workers.size());
+				
+				// sample collision-free configurations, sample j is always generated by worker j % workers.size()
+				
+				::std::vector<VectorPtr> samples(n);
+				
+				this->run([&](const ::std::size_t& w)
+				{
+					for (::std::size_t j = w; j < n; j += workers.size())
+					{
+						samples[j] = ::std::make_shared<::rl::math::Vector>(workers[w].first->generateCollisionFree());
+					}
+				});
+				
+				// insert vertices in sample order and collect candidate edges
+				
+				::std::vector<::std::tuple<Vertex, Vertex, ::rl::math::Real>> candidates;
+				
+				for (::std::size_t j = 0; j < n; ++j)
+				{
+					Vertex v = this->addVertex(samples[j]);
+					
+					::std::vector<Neighbor> neighbors = this->graph[::boost::graph_bundle].nn->nearest(Metric::Value(this->graph[v].q.get(), v), this->k);
+					
+					for (::std::size_t l = 0; l < neighbors.size(); ++l)
+					{
+						::rl::math::Real d = this->graph[::boost::graph_bundle].nn->isTransformedDistance() ? this->getModel()->inverseOfTransformedDistance(neighbors[l].first) : neighbors[l].first;
+						
+						if (d < this->radius)
+						{
+							candidates.push_back(::std::make_tuple(static_cast<Vertex>(neighbors[l].second.second), v, d));
+						}
+					}
+					
+					this->graph[::boost::graph_bundle].nn->push(Metric::Value(this->graph[v].q.get(), v));
+				}
+				
+				// verify and merge candidate edges in candidate order, in rounds of one edge per worker
+				// skipping edges whose vertices are already connected, as sequential construction does
+				
+				::std::vector<::std::size_t> round;
+				::std::vector<unsigned char> colliding(workers.size(), false);
+				
+				for (::std::size_t j = 0; j < candidates.size();)
+				{
+					round.clear();
+					
+					for (; j < candidates.size() && round.size() < workers.size(); ++j)
+					{
+						Vertex u = ::std::get<0>(candidates[j]);
+						Vertex v = ::std::get<1>(candidates[j]);
+						
+						if (::boost::degree(u, this->graph) < this->degree && ::boost::degree(v, this->graph) < this->degree)
+						{
+							if (this->lazy)
+							{
+								this->addEdge(u, v, ::std::get<2>(candidates[j]));
+							}
+							else if (!::boost::same_component(u, v, this->ds))
+							{
+								round.push_back(j);
+							}
+						}
+					}
+					
+					if (round.empty())
+					{
+						continue;
+					}
+					
+					this->run([&](const ::std::size_t& w)
+					{
+						if (w < round.size())
+						{
+							colliding[w] = workers[w].second->isColliding(
+								*this->graph[::std::get<0>(candidates[round[w]])].q,
+								*this->graph[::std::get<1>(candidates[round[w]])].q,
+								::std::get<2>(candidates[round[w]])
+							);
+						}
+					});
+					
+					for (::std::size_t l = 0; l < round.size(); ++l)
+					{
+						Vertex u = ::std::get<0>(candidates[round[l]]);
+						Vertex v = ::std::get<1>(candidates[round[l]]);
+						
+						if (!colliding[l] && ::boost::degree(u, this->graph) < this->degree && ::boost::degree(v, this->graph) < this->degree && !::boost::same_component(u, v, this->ds))
+						{
+							this->addEdge(u, v, ::std::get<2>(candidates[round[l]]));
+						}
+					}
+				}
+				
+				i += n;
+			}
+		}
+		
 		::std::size_t
 		Prm::getMaxDegree() const
 		{
@@ -211,7 +350,11 @@ namespace rl
 					
 					if (d < this->radius)
 					{
-						if (!::boost::same_component(u, v, this->ds))
+						if (this->lazy)
+						{
+							this->addEdge(u, v, d);
+						}
+						else if (!::boost::same_component(u, v, this->ds))
 						{
 							if (!this->verifier->isColliding(*this->graph[u].q, *this->graph[v].q, d))
 							{
@@ -225,6 +368,12 @@ namespace rl
 			this->graph[::boost::graph_bundle].nn->push(Metric::Value(this->graph[v].q.get(), v));
 		}
 		
+		bool
+		Prm::isLazy() const
+		{
+			return this->lazy;
+		}
+		
 		void
 		Prm::reset()
 		{
@@ -234,6 +383,12 @@ namespace rl
 			this->end = nullptr;
 		}
 		
+		void
+		Prm::setLazy(const bool& lazy)
+		{
+			this->lazy = lazy;
+		}
+		
 		void
 		Prm::setMaxDegree(const ::std::size_t& degree)
 		{
@@ -287,9 +442,12 @@ namespace rl
 			this->end = this->addVertex(::std::make_shared<::rl::math::Vector>(*this->getGoal()));
 			this->insert(this->end);
 			
+			// construct in batches when using workers, so threads are not started for single samples
+			::std::size_t steps = this->workers.empty() ? 1 : 16 * (this->workers.size() + 1);
+			
 			while ((::std::chrono::steady_clock::now() - this->time) < this->getDuration() && !::boost::same_component(this->begin, this->end, this->ds))
 			{
-				this->construct(1);
+				this->construct(steps);
 			}
 			
 			if (!::boost::same_component(this->begin, this->end, this->ds))
@@ -297,6 +455,91 @@ namespace rl
 				return false;
 			}
 			
+			if (!this->lazy)
+			{
+				this->search();
+				return true;
+			}
+			
+			do
+			{
+				this->search();
+				
+				if (this->verifyPath())
+				{
+					return true;
+				}
+				
+				this->updateComponents();
+				
+				while ((::std::chrono::steady_clock::now() - this->time) < this->getDuration() && !::boost::same_component(this->begin, this->end, this->ds))
+				{
+					this->construct(steps);
+				}
+			}
+			while ((::std::chrono::steady_clock::now() - this->time) < this->getDuration() && ::boost::same_component(this->begin, this->end, this->ds));
+			
+			return false;
+		}
+		
+		void
+		Prm::run(const ::std::function<void(const ::std::size_t&)>& f)
+		{
+			if (this->threads.size() != this->workers.size())
+			{
+				this->stop();
+				
+				for (::std::size_t w = 1; w <= this->workers.size(); ++w)
+				{
+					this->threads.push_back(::std::thread([this, w]()
+					{
+						::std::size_t generation = 0;
+						
+						while (true)
+						{
+							{
+								::std::unique_lock<::std::mutex> lock(this->mutex);
+								this->condition.wait(lock, [this, &generation]() { return this->stopped || this->generation != generation; });
+								
+								if (this->stopped)
+								{
+									return;
+								}
+								
+								generation = this->generation;
+							}
+							
+							this->function(w);
+							
+							::std::lock_guard<::std::mutex> lock(this->mutex);
+							
+							if (0 == --this->pending)
+							{
+								this->condition.notify_all();
+							}
+						}
+					}));
+				}
+			}
+			
+			{
+				::std::lock_guard<::std::mutex> lock(this->mutex);
+				this->function = f;
+				this->pending = this->threads.size();
+				++this->generation;
+			}
+			
+			this->condition.notify_all();
+			
+			f(0);
+			
+			::std::unique_lock<::std::mutex> lock(this->mutex);
+			this->condition.wait(lock, [this]() { return 0 == this->pending; });
+		}
+		
+		void
+		Prm::search()
+		{
 			if (this->astar)
 			{
 				::boost::astar_search(
@@ -332,6 +575,63 @@ namespace rl
 					::boost::default_dijkstra_visitor()
 				);
 			}
+		}
+		
+		void
+		Prm::stop()
+		{
+			{
+				::std::lock_guard<::std::mutex> lock(this->mutex);
+				this->stopped = true;
+			}
+			
+			this->condition.notify_all();
+			
+			for (::std::size_t w = 0; w < this->threads.size(); ++w)
+			{
+				this->threads[w].join();
+			}
+			
+			this->threads.clear();
+			this->stopped = false;
+		}
+		
+		void
+		Prm::updateComponents()
+		{
+			VertexIteratorPair vertices = ::boost::vertices(this->graph);
+			
+			for (VertexIterator i = vertices.first; i != vertices.second; ++i)
+			{
+				this->ds.make_set(*i);
+			}
+			
+			EdgeIteratorPair edges = ::boost::edges(this->graph);
+			
+			for (EdgeIterator i = edges.first; i != edges.second; ++i)
+			{
+				this->ds.union_set(::boost::source(*i, this->graph), ::boost::target(*i, this->graph));
+			}
+		}
+		
+		bool
+		Prm::verifyPath()
+		{
+			for (Vertex i = this->end; i != this->begin; i = this->graph[i].predecessor)
+			{
+				Edge e = ::boost::edge(this->graph[i].predecessor, i, this->graph).first;
+				
+				if (!this->graph[e].verified)
+				{
+					if (this->verifier->isColliding(*this->graph[this->graph[i].predecessor].q, *this->graph[i].q, this->graph[e].weight))
+					{
+						::boost::remove_edge(e, this->graph);
+						return false;
+					}
+					
+					this->graph[e].verified = true;
+				}
+			}
 			
 			return true;
 		}
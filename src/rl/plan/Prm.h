@@ -27,6 +27,12 @@
 #ifndef RL_PLAN_PRM_H
 #define RL_PLAN_PRM_H
 
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/astar_search.hpp>
 #include <boost/pending/disjoint_sets.hpp>
@@ -74,6 +80,23 @@ namespace rl
 			
 			virtual ~Prm();
 			
+			/**
+			 * Add sampler and verifier of an additional worker for construct().
+			 *
+			 * Sampling and edge verification of all workers run concurrently, so
+			 * sampler and verifier have to use a separate model and scene that is
+			 * not shared with any other worker or the planner.
+			 *
+			 * Edges are verified in rounds of one edge per worker and merged in
+			 * the same order as by sequential construction, so that the same
+			 * samples result in the same roadmap. Worker threads are started on
+			 * first use and kept until the planner is destroyed or the workers
+			 * change.
+			 */
+			void addWorker(Sampler* sampler, Verifier* verifier);
+			
+			void clearWorkers();
+			
 			virtual void construct(const ::std::size_t& steps);
 			
 			::std::size_t getMaxDegree() const;
@@ -98,8 +121,24 @@ namespace rl
 			
 			Verifier* getVerifier() const;
 			
+			bool isLazy() const;
+			
 			void reset();
 			
+			/**
+			 * Defer edge verification to solve().
+			 *
+			 * New vertices are connected to all neighbors without verification.
+			 * solve() verifies only the edges on the path found by the graph
+			 * search, removes invalid edges and repeats the search. Verified
+			 * edges are kept for subsequent queries.
+			 *
+			 * Robert Bohlin and Lydia E. Kavraki. Path planning using lazy PRM. In
+			 * Proceedings of the IEEE International Conference on Robotics and
+			 * Automation, pages 521-528, San Francisco, CA, USA, April 2000.
+			 */
+			void setLazy(const bool& lazy);
+			
 			void setMaxDegree(const ::std::size_t& degree);
 			
 			void setMaxNeighbors(const ::std::size_t& k);
@@ -124,6 +163,9 @@ namespace rl
 			/** Maximum number of tested neighbors. */
 			::std::size_t k;
 			
+			/** Defer edge verification to solve(). */
+			bool lazy;
+			
 			/** Maximum radius for connecting neighbors. */
 			::rl::math::Real radius;
 			
@@ -131,9 +173,15 @@ namespace rl
 			
 			Verifier* verifier;
 			
+			/** Samplers and verifiers of additional workers. */
+			::std::vector<::std::pair<Sampler*, Verifier*>> workers;
+			
 		protected:
 			struct EdgeBundle
 			{
+				/** Edge has been checked by verifier. */
+				bool verified;
+				
 				::rl::math::Real weight;
 			};
 			
@@ -227,7 +275,38 @@ namespace rl
 			Graph graph;
 			
 		private:
+			void constructConcurrent(const ::std::size_t& steps);
+			
+			/**
+			 * Call f(w) for every worker w concurrently, f(0) in the calling thread.
+			 */
+			void run(const ::std::function<void(const ::std::size_t&)>& f);
+			
+			void search();
+			
+			void stop();
+			
+			void updateComponents();
+			
+			bool verifyPath();
+			
+			::std::condition_variable condition;
+			
+			/** Function of the current run(). */
+			::std::function<void(const ::std::size_t&)> function;
+			
+			/** Number of run() calls, threads wait for a new one. */
+			::std::size_t generation;
+			
+			::std::mutex mutex;
+			
+			/** Number of threads that have not finished the current run(). */
+			::std::size_t pending;
+			
+			bool stopped;
 			
+			/** Threads of the additional workers. */
+			::std::vector<::std::thread> threads;
 		};
 	}
 }
@@ -40,7 +40,9 @@ namespace rl
 			sampler(nullptr),
 			begin(trees, nullptr),
 			end(trees, nullptr),
-			tree(trees)
+			tree(trees),
+			last(),
+			next()
 		{
 		}
 		
@@ -52,37 +54,42 @@ namespace rl
 		Rrt::addEdge(const Vertex& u, const Vertex& v, Tree& tree)
 		{
 			Edge e = ::boost::add_edge(u, v, tree).first;
+			tree[::boost::graph_bundle].parents[get(tree, v)->index] = get(tree, u)->index;
 			
 			if (nullptr != this->getViewer())
 			{
-				this->getViewer()->drawConfigurationEdge(*get(tree, u)->q, *get(tree, v)->q);
+				this->getViewer()->drawConfigurationEdge(getConfiguration(tree, u), getConfiguration(tree, v));
 			}
 			
 			return e;
 		}
 		
 		Rrt::Vertex
-		Rrt::addVertex(Tree& tree, const VectorPtr& q)
+		Rrt::addVertex(Tree& tree, const ::rl::math::ConstVectorRef& q)
 		{
-			::std::shared_ptr<VertexBundle> bundle = ::std::make_shared<VertexBundle>();
-			bundle->index = ::boost::num_vertices(tree) - 1;
-			bundle->q = q;
+			TreeBundle& treeBundle = tree[::boost::graph_bundle];
+			
+			if (treeBundle.q.empty())
+			{
+				treeBundle.q.setStride(q.size());
+			}
 			
 			Vertex v = ::boost::add_vertex(tree);
-			tree[v] = bundle;
+			tree[v].index = treeBundle.q.push_back(q);
+			treeBundle.parents.push_back(tree[v].index);
 			
-			tree[::boost::graph_bundle].nn->push(Metric::Value(q.get(), v));
+			treeBundle.nn->push(Metric::Value(treeBundle.q.data(tree[v].index), treeBundle.q.getStride(), v));
 			
 			if (nullptr != this->getViewer())
 			{
-				this->getViewer()->drawConfigurationVertex(*get(tree, v)->q);
+				this->getViewer()->drawConfigurationVertex(getConfiguration(tree, v));
 			}
 			
 			return v;
 		}
 		
 		bool
-		Rrt::areEqual(const ::rl::math::Vector& lhs, const ::rl::math::Vector& rhs) const
+		Rrt::areEqual(const ::rl::math::ConstVectorRef& lhs, const ::rl::math::ConstVectorRef& rhs) const
 		{
 			if (this->getModel()->distance(lhs, rhs) > this->epsilon)
 			{
@@ -101,7 +108,7 @@ namespace rl
 		}
 		
 		Rrt::Vertex
-		Rrt::connect(Tree& tree, const Neighbor& nearest, const ::rl::math::Vector& chosen)
+		Rrt::connect(Tree& tree, const Neighbor& nearest, const ::rl::math::ConstVectorRef& chosen)
 		{
 			::rl::math::Real distance = nearest.first;
 			::rl::math::Real step = distance;
@@ -117,22 +124,21 @@ namespace rl
 				step = this->delta;
 			}
 			
-			VectorPtr last = ::std::make_shared<::rl::math::Vector>(this->getModel()->getDofPosition());
+			this->last.resize(this->getModel()->getDofPosition());
+			this->next.resize(this->getModel()->getDofPosition());
 			
-			this->getModel()->interpolate(*get(tree, nearest.second)->q, chosen, step / distance, *last);
+			this->getModel()->interpolate(getConfiguration(tree, nearest.second), chosen, step / distance, this->last);
 			
 			if (nullptr != this->getViewer())
 			{
-//				this->getViewer()->drawConfiguration(*last);
+//				this->getViewer()->drawConfiguration(this->last);
 			}
 			
-			if (this->getModel()->isColliding(*last))
+			if (this->getModel()->isColliding(this->last))
 			{
 				return nullptr;
 			}
 			
-			::rl::math::Vector next(this->getModel()->getDofPosition());
-			
 			while (!reached)
 			{
 				step += this->delta;
@@ -143,39 +149,39 @@ namespace rl
 					step = distance;
 				}
 				
-				this->getModel()->interpolate(*get(tree, nearest.second)->q, chosen, step / distance, next);
+				this->getModel()->interpolate(getConfiguration(tree, nearest.second), chosen, step / distance, this->next);
 				
 				if (nullptr != this->getViewer())
 				{
-//					this->getViewer()->drawConfiguration(next);
+//					this->getViewer()->drawConfiguration(this->next);
 				}
 				
-				if (this->getModel()->isColliding(next))
+				if (this->getModel()->isColliding(this->next))
 				{
 					break;
 				}
 				
-				*last = next;
+				this->last.swap(this->next);
 			}
 			
-			Vertex connected = this->addVertex(tree, last);
+			Vertex connected = this->addVertex(tree, this->last);
 			this->addEdge(nearest.second, connected, tree);
 			return connected;
 		}
 		
 		Rrt::Vertex
-		Rrt::extend(Tree& tree, const Neighbor& nearest, const ::rl::math::Vector& chosen)
+		Rrt::extend(Tree& tree, const Neighbor& nearest, const ::rl::math::ConstVectorRef& chosen)
 		{
 			::rl::math::Real distance = nearest.first;
 			::rl::math::Real step = ::std::min(distance, this->delta);
 			
-			VectorPtr next = ::std::make_shared<::rl::math::Vector>(this->getModel()->getDofPosition());
+			this->next.resize(this->getModel()->getDofPosition());
 			
-			this->getModel()->interpolate(*get(tree, nearest.second)->q, chosen, step / distance, *next);
+			this->getModel()->interpolate(getConfiguration(tree, nearest.second), chosen, step / distance, this->next);
 			
-			if (!this->getModel()->isColliding(*next))
+			if (!this->getModel()->isColliding(this->next))
 			{
-				Vertex extended = this->addVertex(tree, next);
+				Vertex extended = this->addVertex(tree, this->next);
 				this->addEdge(nearest.second, extended, tree);
 				return extended;
 			}
@@ -183,10 +189,16 @@ namespace rl
 			return nullptr;
 		}
 		
-		Rrt::VertexBundle*
+		const Rrt::VertexBundle*
 		Rrt::get(const Tree& tree, const Vertex& v)
 		{
-			return tree[v].get();
+			return &tree[v];
+		}
+		
+		::Eigen::Map<const ::rl::math::Vector>
+		Rrt::getConfiguration(const Tree& tree, const Vertex& v)
+		{
+			return tree[::boost::graph_bundle].q[tree[v].index];
 		}
 		
 		::rl::math::Real
@@ -244,15 +256,16 @@ namespace rl
 		{
 			VectorList path;
 			
-			Vertex i = this->end[0];
+			const TreeBundle& bundle = this->tree[0][::boost::graph_bundle];
+			::std::size_t i = get(this->tree[0], this->end[0])->index;
 			
-			while (::boost::in_degree(i, this->tree[0]) > 0)
+			while (bundle.parents[i] != i)
 			{
-				path.push_front(*get(this->tree[0], i)->q);
-				i = ::boost::source(*::boost::in_edges(i, this->tree[0]).first, this->tree[0]);
+				path.push_front(bundle.q[i]);
+				i = bundle.parents[i];
 			}
 			
-			path.push_front(*get(this->tree[0], i)->q);
+			path.push_front(bundle.q[i]);
 			
 			return path;
 		}
@@ -264,9 +277,9 @@ namespace rl
 		}
 		
 		Rrt::Neighbor
-		Rrt::nearest(const Tree& tree, const ::rl::math::Vector& chosen)
+		Rrt::nearest(const Tree& tree, const ::rl::math::ConstVectorRef& chosen)
 		{
-			::std::vector<NearestNeighbors::Neighbor> neighbors = tree[::boost::graph_bundle].nn->nearest(Metric::Value(&chosen, Vertex()), 1);
+			::std::vector<NearestNeighbors::Neighbor> neighbors = tree[::boost::graph_bundle].nn->nearest(Metric::Value(chosen.data(), chosen.size(), Vertex()), 1);
 			return Neighbor(
 				tree[::boost::graph_bundle].nn->isTransformedDistance() ? this->getModel()->inverseOfTransformedDistance(neighbors.front().first) : neighbors.front().first,
 				neighbors.front().second.second
@@ -280,6 +293,8 @@ namespace rl
 			{
 				this->tree[i].clear();
 				this->tree[i][::boost::graph_bundle].nn->clear();
+				this->tree[i][::boost::graph_bundle].parents.clear();
+				this->tree[i][::boost::graph_bundle].q.clear();
 				this->begin[i] = nullptr;
 				this->end[i] = nullptr;
 			}
@@ -313,7 +328,7 @@ namespace rl
 		{
 			this->time = ::std::chrono::steady_clock::now();
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->getStart()));
+			this->begin[0] = this->addVertex(this->tree[0], *this->getStart());
 			
 			while ((::std::chrono::steady_clock::now() - this->time) < this->getDuration())
 			{
@@ -323,7 +338,7 @@ namespace rl
 				
 				if (nullptr != extended)
 				{
-					if (this->areEqual(*get(this->tree[0], extended)->q, *this->getGoal()))
+					if (this->areEqual(getConfiguration(this->tree[0], extended), *this->getGoal()))
 					{
 						this->end[0] = extended;
 						return true;
@@ -33,7 +33,7 @@
 #include "Metric.h"
 #include "NearestNeighbors.h"
 #include "Planner.h"
-#include "VectorPtr.h"
+#include "VectorArena.h"
 
 namespace rl
 {
@@ -95,11 +95,16 @@ namespace rl
 			Sampler* sampler;
 			
 		protected:
+			/**
+			 * Stored by value in the vertex of the tree.
+			 * 
+			 * Additional data of a vertex is stored in contiguous containers
+			 * indexed by VertexBundle::index, e.g., TreeBundle::q.
+			 */
 			struct VertexBundle
 			{
+				/** Index of configuration in TreeBundle::q. */
 				::std::size_t index;
-				
-				VectorPtr q;
 			};
 			
 			struct TreeBundle;
@@ -108,7 +113,7 @@ namespace rl
 				::boost::listS,
 				::boost::listS,
 				::boost::bidirectionalS,
-				::std::shared_ptr<VertexBundle>,
+				VertexBundle,
 				::boost::no_property,
 				TreeBundle
 			> Tree;
@@ -123,6 +128,12 @@ namespace rl
 			struct TreeBundle
 			{
 				NearestNeighbors* nn;
+				
+				/** Index of parent configuration, root configurations are their own parent. */
+				::std::vector<::std::size_t> parents;
+				
+				/** Configurations of all vertices. */
+				VectorArena q;
 			};
 			
 			typedef ::boost::graph_traits<Tree>::edge_descriptor Edge;
@@ -139,19 +150,21 @@ namespace rl
 			
 			virtual Edge addEdge(const Vertex& u, const Vertex& v, Tree& tree);
 			
-			virtual Vertex addVertex(Tree& tree, const VectorPtr& q);
+			virtual Vertex addVertex(Tree& tree, const ::rl::math::ConstVectorRef& q);
 			
-			bool areEqual(const ::rl::math::Vector& lhs, const ::rl::math::Vector& rhs) const;
+			bool areEqual(const ::rl::math::ConstVectorRef& lhs, const ::rl::math::ConstVectorRef& rhs) const;
 			
 			virtual ::rl::math::Vector choose();
 			
-			virtual Vertex connect(Tree& tree, const Neighbor& nearest, const ::rl::math::Vector& chosen);
+			virtual Vertex connect(Tree& tree, const Neighbor& nearest, const ::rl::math::ConstVectorRef& chosen);
+			
+			virtual Vertex extend(Tree& tree, const Neighbor& nearest, const ::rl::math::ConstVectorRef& chosen);
 			
-			virtual Vertex extend(Tree& tree, const Neighbor& nearest, const ::rl::math::Vector& chosen);
+			static const VertexBundle* get(const Tree& tree, const Vertex& v);
 			
-			static VertexBundle* get(const Tree& tree, const Vertex& v);
+			static ::Eigen::Map<const ::rl::math::Vector> getConfiguration(const Tree& tree, const Vertex& v);
 			
-			virtual Neighbor nearest(const Tree& tree, const ::rl::math::Vector& chosen);
+			virtual Neighbor nearest(const Tree& tree, const ::rl::math::ConstVectorRef& chosen);
 			
 			::std::vector<Vertex> begin;
 			
@@ -160,7 +173,9 @@ namespace rl
 			::std::vector<Tree> tree;
 			
 		private:
+			::rl::math::Vector last;
 			
+			::rl::math::Vector next;
 		};
 	}
 }
@@ -51,25 +51,27 @@ namespace rl
 		{
 			VectorList path;
 			
-			Vertex i = this->end[0];
+			const TreeBundle& bundle0 = this->tree[0][::boost::graph_bundle];
+			::std::size_t i = get(this->tree[0], this->end[0])->index;
 			
-			while (::boost::in_degree(i, this->tree[0]) > 0)
+			while (bundle0.parents[i] != i)
 			{
-				path.push_front(*get(this->tree[0], i)->q);
-				i = ::boost::source(*::boost::in_edges(i, this->tree[0]).first, this->tree[0]);
+				path.push_front(bundle0.q[i]);
+				i = bundle0.parents[i];
 			}
 			
-			path.push_front(*get(this->tree[0], i)->q);
+			path.push_front(bundle0.q[i]);
 			
-			i = ::boost::source(*::boost::in_edges(this->end[1], this->tree[1]).first, this->tree[1]);
+			const TreeBundle& bundle1 = this->tree[1][::boost::graph_bundle];
+			i = bundle1.parents[get(this->tree[1], this->end[1])->index];
 			
-			while (::boost::in_degree(i, this->tree[1]) > 0)
+			while (bundle1.parents[i] != i)
 			{
-				path.push_back(*get(this->tree[1], i)->q);
-				i = ::boost::source(*::boost::in_edges(i, this->tree[1]).first, this->tree[1]);
+				path.push_back(bundle1.q[i]);
+				i = bundle1.parents[i];
 			}
 			
-			path.push_back(*get(this->tree[1], i)->q);
+			path.push_back(bundle1.q[i]);
 			
 			return path;
 		}
@@ -79,8 +81,8 @@ namespace rl
 		{
 			this->time = ::std::chrono::steady_clock::now();
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->getStart()));
-			this->begin[1] = this->addVertex(this->tree[1], ::std::make_shared<::rl::math::Vector>(*this->getGoal()));
+			this->begin[0] = this->addVertex(this->tree[0], *this->getStart());
+			this->begin[1] = this->addVertex(this->tree[1], *this->getGoal());
 			
 			while ((::std::chrono::steady_clock::now() - this->time) < this->getDuration())
 			{
@@ -95,7 +97,7 @@ namespace rl
 					
 					if (nullptr != extended2)
 					{
-						if (this->areEqual(*get(this->tree[0], extended)->q, *get(this->tree[1], extended2)->q))
+						if (this->areEqual(getConfiguration(this->tree[0], extended), getConfiguration(this->tree[1], extended2)))
 						{
 							this->end[0] = extended;
 							this->end[1] = extended2;
@@ -51,8 +51,8 @@ namespace rl
 		{
 			this->time = ::std::chrono::steady_clock::now();
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->getStart()));
-			this->begin[1] = this->addVertex(this->tree[1], ::std::make_shared<::rl::math::Vector>(*this->getGoal()));
+			this->begin[0] = this->addVertex(this->tree[0], *this->getStart());
+			this->begin[1] = this->addVertex(this->tree[1], *this->getGoal());
 			
 			Tree* a = &this->tree[0];
 			Tree* b = &this->tree[1];
@@ -67,12 +67,12 @@ namespace rl
 					
 					if (nullptr != aExtended)
 					{
-						Neighbor bNearest = this->nearest(*b, *get(*a, aExtended)->q);
-						Vertex bExtended = this->extend(*b, bNearest, *get(*a, aExtended)->q);
+						Neighbor bNearest = this->nearest(*b, getConfiguration(*a, aExtended));
+						Vertex bExtended = this->extend(*b, bNearest, getConfiguration(*a, aExtended));
 						
 						if (nullptr != bExtended)
 						{
-							if (this->areEqual(*get(*a, aExtended)->q, *get(*b, bExtended)->q))
+							if (this->areEqual(getConfiguration(*a, aExtended), getConfiguration(*b, bExtended)))
 							{
 								this->end[0] = &this->tree[0] == a ? aExtended : bExtended;
 								this->end[1] = &this->tree[1] == b ? bExtended : aExtended;
@@ -24,7 +24,6 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
-#include <rl/sg/Body.h>
 #include <rl/sg/SimpleScene.h>
 
 #include "SimpleModel.h"
@@ -68,37 +67,14 @@ namespace rl
 		{
 			++this->totalQueries;
 			
-			for (::std::size_t i = 0; i < this->model->getNumBodies(); ++i)
+			if (dynamic_cast<::rl::sg::SimpleScene*>(this->scene)->isColliding(
+				this->model,
+				[this](const ::std::size_t& i) { return this->isColliding(i); },
+				[this](const ::std::size_t& i, const ::std::size_t& j) { return this->areColliding(i, j); },
+				this->body
+			))
 			{
-				if (this->isColliding(i))
-				{
-					for (::rl::sg::Scene::Iterator j = this->scene->begin(); j != this->scene->end(); ++j)
-					{
-						if (this->model != *j)
-						{
-							for (::rl::sg::Model::Iterator k = (*j)->begin(); k != (*j)->end(); ++k)
-							{
-								if (dynamic_cast<::rl::sg::SimpleScene*>(this->scene)->areColliding(this->model->getBody(i), *k))
-								{
-									this->body = i;
-									return true;
-								}
-							}
-						}
-					}
-				}
-				
-				for (::std::size_t j = 0; j < i; ++j)
-				{
-					if (this->areColliding(i, j))
-					{
-						if (dynamic_cast<::rl::sg::SimpleScene*>(this->scene)->areColliding(this->model->getBody(i), this->model->getBody(j)))
-						{
-							this->body = i;
-							return true;
-						}
-					}
-				}
+				return true;
 			}
 			
 			this->body = this->getBodies();
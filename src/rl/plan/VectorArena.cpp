@@ -0,0 +1,152 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cassert>
+
+#include "VectorArena.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		VectorArena::VectorArena(const ::std::size_t& stride, const ::std::size_t& capacity) :
+			capacity(capacity),
+			chunks(),
+			count(0),
+			stride(stride)
+		{
+			assert(capacity > 0);
+		}
+		
+		VectorArena::VectorArena(const VectorArena& other) :
+			capacity(other.capacity),
+			chunks(),
+			count(0),
+			stride(other.stride)
+		{
+			*this = other;
+		}
+		
+		VectorArena::~VectorArena()
+		{
+		}
+		
+		VectorArena&
+		VectorArena::operator=(const VectorArena& other)
+		{
+			if (this != &other)
+			{
+				this->capacity = other.capacity;
+				this->chunks.clear();
+				this->count = 0;
+				this->stride = other.stride;
+				
+				for (::std::size_t i = 0; i < other.size(); ++i)
+				{
+					this->push_back(other[i]);
+				}
+			}
+			
+			return *this;
+		}
+		
+		::Eigen::Map<const ::rl::math::Vector>
+		VectorArena::operator[](const ::std::size_t& i) const
+		{
+			return ::Eigen::Map<const ::rl::math::Vector>(this->data(i), this->stride);
+		}
+		
+		::Eigen::Map<::rl::math::Vector>
+		VectorArena::operator[](const ::std::size_t& i)
+		{
+			return ::Eigen::Map<::rl::math::Vector>(this->data(i), this->stride);
+		}
+		
+		void
+		VectorArena::clear()
+		{
+			this->count = 0;
+		}
+		
+		const ::rl::math::Real*
+		VectorArena::data(const ::std::size_t& i) const
+		{
+			assert(i < this->count);
+			return this->chunks[i / this->capacity].get() + (i % this->capacity) * this->stride;
+		}
+		
+		::rl::math::Real*
+		VectorArena::data(const ::std::size_t& i)
+		{
+			assert(i < this->count);
+			return this->chunks[i / this->capacity].get() + (i % this->capacity) * this->stride;
+		}
+		
+		bool
+		VectorArena::empty() const
+		{
+			return 0 == this->count;
+		}
+		
+		const ::std::size_t&
+		VectorArena::getStride() const
+		{
+			return this->stride;
+		}
+		
+		::std::size_t
+		VectorArena::push_back(const ::rl::math::ConstVectorRef& q)
+		{
+			assert(static_cast<::std::size_t>(q.size()) == this->stride);
+			
+			if (this->count == this->chunks.size() * this->capacity)
+			{
+				this->chunks.emplace_back(new ::rl::math::Real[this->capacity * this->stride]);
+			}
+			
+			::std::size_t i = this->count++;
+			(*this)[i] = q;
+			return i;
+		}
+		
+		void
+		VectorArena::setStride(const ::std::size_t& stride)
+		{
+			if (stride != this->stride)
+			{
+				this->chunks.clear();
+				this->count = 0;
+				this->stride = stride;
+			}
+		}
+		
+		const ::std::size_t&
+		VectorArena::size() const
+		{
+			return this->count;
+		}
+	}
+}
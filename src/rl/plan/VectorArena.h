@@ -0,0 +1,92 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_VECTORARENA_H
+#define RL_PLAN_VECTORARENA_H
+
+#include <memory>
+#include <vector>
+#include <rl/math/Vector.h>
+#include <rl/plan/export.h>
+
+namespace rl
+{
+	namespace plan
+	{
+		/**
+		 * Contiguous storage for configurations of equal dimension.
+		 *
+		 * Configurations are stored with a fixed stride in chunks that are
+		 * never reallocated, so pointers to stored configurations stay valid
+		 * until clear() is called. Chunks are kept on clear() and reused by
+		 * subsequent calls to push_back().
+		 */
+		class RL_PLAN_EXPORT VectorArena
+		{
+		public:
+			explicit VectorArena(const ::std::size_t& stride = 0, const ::std::size_t& capacity = 1024);
+			
+			VectorArena(const VectorArena& other);
+			
+			virtual ~VectorArena();
+			
+			VectorArena& operator=(const VectorArena& other);
+			
+			::Eigen::Map<const ::rl::math::Vector> operator[](const ::std::size_t& i) const;
+			
+			::Eigen::Map<::rl::math::Vector> operator[](const ::std::size_t& i);
+			
+			void clear();
+			
+			const ::rl::math::Real* data(const ::std::size_t& i) const;
+			
+			::rl::math::Real* data(const ::std::size_t& i);
+			
+			bool empty() const;
+			
+			const ::std::size_t& getStride() const;
+			
+			::std::size_t push_back(const ::rl::math::ConstVectorRef& q);
+			
+			void setStride(const ::std::size_t& stride);
+			
+			const ::std::size_t& size() const;
+			
+		protected:
+			
+		private:
+			::std::size_t capacity;
+			
+			::std::vector<::std::unique_ptr<::rl::math::Real[]>> chunks;
+			
+			::std::size_t count;
+			
+			::std::size_t stride;
+		};
+	}
+}
+
+#endif // RL_PLAN_VECTORARENA_H
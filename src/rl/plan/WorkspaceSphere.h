@@ -29,10 +29,9 @@
 
 #include <vector>
 #include <boost/graph/adjacency_list.hpp>
+#include <rl/math/Vector.h>
 #include <rl/plan/export.h>
 
-#include "Vector3Ptr.h"
-
 namespace rl
 {
 	namespace plan
@@ -47,7 +46,7 @@ namespace rl
 			
 			bool operator<(const WorkspaceSphere& rhs) const;
 			
-			Vector3Ptr center;
+			::rl::math::Vector3 center;
 			
 			Vertex parent;
 			
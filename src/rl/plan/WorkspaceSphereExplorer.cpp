@@ -24,7 +24,9 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 
 #include "DistanceModel.h"
 #include "Viewer.h"
@@ -58,7 +60,9 @@ namespace rl
 			graph(),
 			queue(),
 			randDistribution(0, 1),
-			randEngine(::std::random_device()())
+			randEngine(::std::random_device()()),
+			vertexCells(),
+			vertexLevels()
 		{
 		}
 		
@@ -73,7 +77,7 @@ namespace rl
 			
 			if (nullptr != this->viewer)
 			{
-				this->viewer->drawWorkEdge(*this->graph[u].sphere.center, *this->graph[v].sphere.center);
+				this->viewer->drawWorkEdge(this->graph[u].sphere.center, this->graph[v].sphere.center);
 			}
 			
 			return edge;
@@ -83,32 +87,67 @@ namespace rl
 		WorkspaceSphereExplorer::addVertex(const WorkspaceSphere& sphere)
 		{
 			Vertex vertex = ::boost::add_vertex(this->graph);
+			this->graph[vertex].index = ::boost::num_vertices(this->graph) - 1;
 			this->graph[vertex].sphere = sphere;
 			
+			if (sphere.radius > 0)
+			{
+				int level = getLevel(sphere.radius);
+				Cell min = getCell(level, sphere.center - ::rl::math::Vector3::Constant(sphere.radius));
+				Cell max = getCell(level, sphere.center + ::rl::math::Vector3::Constant(sphere.radius));
+				
+				for (::std::int64_t x = min[1]; x <= max[1]; ++x)
+				{
+					for (::std::int64_t y = min[2]; y <= max[2]; ++y)
+					{
+						for (::std::int64_t z = min[3]; z <= max[3]; ++z)
+						{
+							this->vertexCells[{level, x, y, z}].push_back(vertex);
+						}
+					}
+				}
+				
+				this->vertexLevels.insert(level);
+			}
+			
 #ifndef PRINT_WORKSPACE_PATH
 			if (nullptr != this->viewer)
 			{
-				this->viewer->drawSphere(*this->graph[vertex].sphere.center, this->graph[vertex].sphere.radius);
-				this->viewer->drawWorkVertex(*this->graph[vertex].sphere.center);
+				this->viewer->drawSphere(this->graph[vertex].sphere.center, this->graph[vertex].sphere.radius);
+				this->viewer->drawWorkVertex(this->graph[vertex].sphere.center);
 			}
 #endif
 			
 			return vertex;
 		}
 		
+		::std::size_t
+		WorkspaceSphereExplorer::CellHash::operator()(const Cell& cell) const
+		{
+			::std::uint64_t hash = 0;
+			
+			for (::std::size_t i = 0; i < cell.size(); ++i)
+			{
+				hash = (hash ^ static_cast<::std::uint64_t>(cell[i])) * 0x100000001B3;
+				hash ^= hash >> 32;
+			}
+			
+			return static_cast<::std::size_t>(hash);
+		}
+		
 		bool
 		WorkspaceSphereExplorer::explore()
 		{
 			WorkspaceSphere start;
-			start.center = ::std::make_shared<::rl::math::Vector3>(*this->start);
+			start.center = *this->start;
 			start.radius = ::std::min(
-				this->model->distance(*start.center),
-				this->boundingBox.interiorDistance(*start.center)
+				this->model->distance(start.center),
+				this->boundingBox.interiorDistance(start.center)
 			);
 			start.radiusSum = start.radius;
 			start.parent = nullptr;
 			
-			start.priority = (*this->goal - *start.center).norm() - start.radius;
+			start.priority = (*this->goal - start.center).norm() - start.radius;
 			
 			this->queue.insert(start);
 			
@@ -118,6 +157,11 @@ namespace rl
 				
 				this->queue.erase(this->queue.begin());
 				
+				if (nullptr != top.parent && this->isCovered(top.center, nullptr, this->graph[top.parent].index + 1))
+				{
+					continue;
+				}
+				
 				if (top.radius >= this->radius)
 				{
 					Vertex vertex = this->addVertex(top);
@@ -131,13 +175,13 @@ namespace rl
 						this->begin = vertex;
 					}
 					
-					if ((*this->goal - *top.center).norm() < top.radius)
+					if ((*this->goal - top.center).norm() < top.radius)
 					{
 						WorkspaceSphere goal;
-						goal.center = ::std::make_shared<::rl::math::Vector3>(*this->goal);
-						goal.radius = this->model->distance(*goal.center);
+						goal.center = *this->goal;
+						goal.radius = this->model->distance(goal.center);
 						goal.parent = vertex;
-						goal.priority = (*this->goal - *goal.center).norm() - goal.radius;
+						goal.priority = (*this->goal - goal.center).norm() - goal.radius;
 						
 						this->end = this->addVertex(goal);
 						
@@ -153,39 +197,20 @@ namespace rl
 						return true;
 					}
 					
-					::std::multiset<WorkspaceSphere>::iterator i = this->queue.begin();
-					::std::multiset<WorkspaceSphere>::iterator j;
-					
-					while (i != this->queue.end())
-					{
-						if ((*i->center - *top.center).norm() < top.radius)
-						{
-							j = i;
-							++i;
-							this->queue.erase(j);
-						}
-						else
-						{
-							++i;
-						}
-					}
-					
 					for (::std::size_t i = 0; i < ::std::ceil(this->samples * top.radius); ++i)
 //for (::std::size_t i = 0; i < this->samples; ++i) // TODO
 					{
 						WorkspaceSphere sphere;
-						sphere.center = ::std::make_shared<::rl::math::Vector3>(
-							top.radius * ::rl::math::Vector3::RandomOnSphere(::rl::math::Vector2(this->rand(), this->rand())) + *top.center
-						);
+						sphere.center = top.radius * ::rl::math::Vector3::RandomOnSphere(::rl::math::Vector2(this->rand(), this->rand())) + top.center;
 						sphere.parent = vertex;
 						
-						if ((*this->start - *sphere.center).norm() <= this->range && this->boundingBox.contains(*sphere.center))
+						if ((*this->start - sphere.center).norm() <= this->range && this->boundingBox.contains(sphere.center))
 						{
-							if (!this->isCovered(top.parent, *sphere.center))
+							if (!this->isCovered(sphere.center, &top.parent, 0))
 							{
 								sphere.radius = ::std::min(
-									this->model->distance(*sphere.center),
-									this->boundingBox.interiorDistance(*sphere.center)
+									this->model->distance(sphere.center),
+									this->boundingBox.interiorDistance(sphere.center)
 								);
 								sphere.radiusSum = sphere.radius + top.radiusSum;
 								
@@ -194,10 +219,10 @@ namespace rl
 									switch (this->greedy)
 									{
 									case Greedy::distance:
-										sphere.priority = (*this->goal - *sphere.center).norm() - sphere.radius;
+										sphere.priority = (*this->goal - sphere.center).norm() - sphere.radius;
 										break;
 									case Greedy::sourceDistance:
-										sphere.priority = (*this->goal - *sphere.center).norm() - sphere.radius + top.radiusSum;
+										sphere.priority = (*this->goal - sphere.center).norm() - sphere.radius + top.radiusSum;
 										break;
 									case Greedy::space:
 										sphere.priority = 1 / sphere.radius;
@@ -223,6 +248,17 @@ namespace rl
 			return this->boundingBox;
 		}
 		
+		WorkspaceSphereExplorer::Cell
+		WorkspaceSphereExplorer::getCell(const int& level, const ::rl::math::Vector3& point)
+		{
+			return {
+				level,
+				static_cast<::std::int64_t>(::std::floor(::std::ldexp(point.x(), -level))),
+				static_cast<::std::int64_t>(::std::floor(::std::ldexp(point.y(), -level))),
+				static_cast<::std::int64_t>(::std::floor(::std::ldexp(point.z(), -level)))
+			};
+		}
+		
 		::rl::math::Vector3*
 		WorkspaceSphereExplorer::getGoal() const
 		{
@@ -235,6 +271,14 @@ namespace rl
 			return this->greedy;
 		}
 		
+		int
+		WorkspaceSphereExplorer::getLevel(const ::rl::math::Real& radius)
+		{
+			int level = 0;
+			::std::frexp(radius, &level);
+			return level;
+		}
+		
 		DistanceModel*
 		WorkspaceSphereExplorer::getModel() const
 		{
@@ -255,8 +299,8 @@ namespace rl
 #ifdef PRINT_WORKSPACE_PATH
 				if (nullptr != this->viewer)
 				{
-					this->viewer->drawSphere(*this->graph[i].sphere.center, this->graph[i].sphere.radius);
-					this->viewer->drawWorkVertex(*this->graph[i].sphere.center);
+					this->viewer->drawSphere(this->graph[i].sphere.center, this->graph[i].sphere.radius);
+					this->viewer->drawWorkVertex(this->graph[i].sphere.center);
 				}
 #endif
 				
@@ -268,8 +312,8 @@ namespace rl
 #ifdef PRINT_WORKSPACE_PATH
 			if (nullptr != this->viewer)
 			{
-				this->viewer->drawSphere(*this->graph[i].sphere.center, this->graph[i].sphere.radius);
-				this->viewer->drawWorkVertex(*this->graph[i].sphere.center);
+				this->viewer->drawSphere(this->graph[i].sphere.center, this->graph[i].sphere.radius);
+				this->viewer->drawWorkVertex(this->graph[i].sphere.center);
 			}
 #endif
 			
@@ -309,27 +353,29 @@ namespace rl
 		bool
 		WorkspaceSphereExplorer::isCovered(const ::rl::math::Vector3& point) const
 		{
-			for (VertexIteratorPair i = ::boost::vertices(this->graph); i.first != i.second; ++i.first)
-			{
-				if ((point - *this->graph[*i.first].sphere.center).norm() < this->graph[*i.first].sphere.radius)
-				{
-					return true;
-				}
-			}
-			
-			return false;
+			return this->isCovered(point, nullptr, 0);
 		}
 		
 		bool
-		WorkspaceSphereExplorer::isCovered(const Vertex& parent, const ::rl::math::Vector3& point) const
+		WorkspaceSphereExplorer::isCovered(const ::rl::math::Vector3& point, const Vertex* parent, const ::std::size_t& index) const
 		{
-			for (VertexIteratorPair i = ::boost::vertices(this->graph); i.first != i.second; ++i.first)
+			for (::std::set<int>::const_iterator level = this->vertexLevels.begin(); level != this->vertexLevels.end(); ++level)
 			{
-				if (parent != this->graph[*i.first].sphere.parent)
+				::std::unordered_map<Cell, ::std::vector<Vertex>, CellHash>::const_iterator cell = this->vertexCells.find(getCell(*level, point));
+				
+				if (this->vertexCells.end() != cell)
 				{
-					if ((point - *this->graph[*i.first].sphere.center).norm() < this->graph[*i.first].sphere.radius)
+					for (::std::size_t i = 0; i < cell->second.size(); ++i)
 					{
-						return true;
+						const WorkspaceSphere& sphere = this->graph[cell->second[i]].sphere;
+						
+						if (this->graph[cell->second[i]].index >= index && (nullptr == parent || *parent != sphere.parent))
+						{
+							if ((point - sphere.center).norm() < sphere.radius)
+							{
+								return true;
+							}
+						}
 					}
 				}
 			}
@@ -348,6 +394,8 @@ namespace rl
 		{
 			this->graph.clear();
 			this->queue.clear();
+			this->vertexCells.clear();
+			this->vertexLevels.clear();
 			this->begin = nullptr;
 			this->end = nullptr;
 		}
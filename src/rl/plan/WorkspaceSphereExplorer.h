@@ -27,9 +27,13 @@
 #ifndef RL_PLAN_WORKSPACESPHEREEXPLORER_H
 #define RL_PLAN_WORKSPACESPHEREEXPLORER_H
 
+#include <array>
+#include <cstdint>
 #include <list>
 #include <random>
 #include <set>
+#include <unordered_map>
+#include <vector>
 #include <boost/graph/adjacency_list.hpp>
 #include <rl/math/AlignedBox.h>
 #include <rl/math/Vector.h>
@@ -47,6 +51,11 @@ namespace rl
 		/**
 		 * Wavefront expansion.
 		 *
+		 * Expanded spheres are kept in a hierarchical spatial hash with cubic
+		 * cells of edge length 2^level, so coverage queries only visit a single
+		 * cell per level. Queued spheres covered by a later expansion are
+		 * discarded when they reach the front of the queue.
+		 *
 		 * Oliver Brock and Lydia E. Kavraki. Decomposition-based motion planning:
 		 * A framework for real-time motion planning in high-dimensional configuration
 		 * spaces. In Proceedings of the IEEE International Conference on Robotics
@@ -139,6 +148,8 @@ namespace rl
 		protected:
 			struct VertexBundle
 			{
+				::std::size_t index;
+				
 				WorkspaceSphere sphere;
 			};
 			
@@ -161,11 +172,28 @@ namespace rl
 			
 			typedef ::std::pair<VertexIterator, VertexIterator> VertexIteratorPair;
 			
+			/** Level followed by integer coordinates of a hash cell. */
+			typedef ::std::array<::std::int64_t, 4> Cell;
+			
+			struct CellHash
+			{
+				::std::size_t operator()(const Cell& cell) const;
+			};
+			
+			static Cell getCell(const int& level, const ::rl::math::Vector3& point);
+			
+			/** Smallest level with a cell edge length not less than radius. */
+			static int getLevel(const ::rl::math::Real& radius);
+			
 			Edge addEdge(const Vertex& u, const Vertex& v);
 			
 			Vertex addVertex(const WorkspaceSphere& sphere);
 			
-			bool isCovered(const Vertex& parent, const ::rl::math::Vector3& point) const;
+			/**
+			 * Checks spheres expanded with at least the given index, ignoring
+			 * spheres with the given parent unless parent is nullptr.
+			 */
+			bool isCovered(const ::rl::math::Vector3& point, const Vertex* parent, const ::std::size_t& index) const;
 			
 			::std::uniform_real_distribution<::rl::math::Real>::result_type rand();
 			
@@ -181,6 +209,11 @@ namespace rl
 			
 			::std::mt19937 randEngine;
 			
+			/** Expanded spheres in all cells overlapped at the level of their radius. */
+			::std::unordered_map<Cell, ::std::vector<Vertex>, CellHash> vertexCells;
+			
+			::std::set<int> vertexLevels;
+			
 		private:
 			
 		};
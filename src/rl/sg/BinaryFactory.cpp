@@ -0,0 +1,800 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <sys/stat.h>
+#include <Eigen/SVD>
+#include <Inventor/SoDB.h>
+#include <Inventor/SoInput.h>
+#include <Inventor/SoPrimitiveVertex.h>
+#include <Inventor/actions/SoSearchAction.h>
+#include <Inventor/VRMLnodes/SoVRMLBox.h>
+#include <Inventor/VRMLnodes/SoVRMLCone.h>
+#include <Inventor/VRMLnodes/SoVRMLCoordinate.h>
+#include <Inventor/VRMLnodes/SoVRMLCylinder.h>
+#include <Inventor/VRMLnodes/SoVRMLGroup.h>
+#include <Inventor/VRMLnodes/SoVRMLIndexedFaceSet.h>
+#include <Inventor/VRMLnodes/SoVRMLInline.h>
+#include <Inventor/VRMLnodes/SoVRMLShape.h>
+#include <Inventor/VRMLnodes/SoVRMLSphere.h>
+#include <rl/xml/Document.h>
+#include <rl/xml/DomParser.h>
+#include <rl/xml/Node.h>
+#include <rl/xml/Object.h>
+#include <rl/xml/Path.h>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif // WIN32
+
+#include "BinaryFactory.h"
+#include "Body.h"
+#include "Exception.h"
+#include "Model.h"
+#include "Scene.h"
+#include "Shape.h"
+#include "XmlFactory.h"
+#include "so/Body.h"
+#include "so/Model.h"
+#include "so/Scene.h"
+#include "so/Shape.h"
+
+namespace rl
+{
+	namespace sg
+	{
+		namespace
+		{
+			struct Header
+			{
+				char magic[4];
+				
+				::std::uint32_t version;
+			};
+			
+			enum Geometry
+			{
+				GEOMETRY_BOX,
+				GEOMETRY_CONE,
+				GEOMETRY_CYLINDER,
+				GEOMETRY_INDEXEDFACESET,
+				GEOMETRY_SPHERE
+			};
+			
+			constexpr char magic[4] = {'R', 'L', 'S', 'G'};
+			
+			constexpr ::std::uint32_t version = 2;
+			
+			class Reader
+			{
+			public:
+				Reader(const ::std::string& filename) :
+					begin(nullptr),
+					buffer(),
+					end(nullptr),
+					filename(filename),
+					mapping(nullptr),
+					mappingSize(0)
+				{
+#ifdef WIN32
+					::std::ifstream file(filename.c_str(), ::std::ios::binary | ::std::ios::ate);
+					
+					if (!file)
+					{
+						throw Exception("rl::sg::BinaryFactory::load() - could not open " + filename);
+					}
+					
+					this->buffer.resize(static_cast<::std::size_t>(file.tellg()));
+					file.seekg(0);
+					
+					if (!file.read(this->buffer.data(), this->buffer.size()))
+					{
+						throw Exception("rl::sg::BinaryFactory::load() - could not read " + filename);
+					}
+					
+					this->begin = this->buffer.data();
+					this->end = this->begin + this->buffer.size();
+#else // WIN32
+					int fd = ::open(filename.c_str(), O_RDONLY);
+					
+					if (-1 == fd)
+					{
+						throw Exception("rl::sg::BinaryFactory::load() - could not open " + filename);
+					}
+					
+					struct ::stat stat;
+					
+					if (-1 == ::fstat(fd, &stat) || 0 == stat.st_size)
+					{
+						::close(fd);
+						throw Exception("rl::sg::BinaryFactory::load() - could not read " + filename);
+					}
+					
+					void* mapping = ::mmap(nullptr, stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+					::close(fd);
+					
+					if (MAP_FAILED == mapping)
+					{
+						throw Exception("rl::sg::BinaryFactory::load() - could not map " + filename);
+					}
+					
+					this->mapping = mapping;
+					this->mappingSize = stat.st_size;
+					this->begin = static_cast<const char*>(mapping);
+					this->end = this->begin + this->mappingSize;
+#endif // WIN32
+				}
+				
+				~Reader()
+				{
+#ifndef WIN32
+					if (nullptr != this->mapping)
+					{
+						::munmap(this->mapping, this->mappingSize);
+					}
+#endif // WIN32
+				}
+				
+				template<typename T>
+				void read(T* data, const ::std::size_t& count = 1)
+				{
+					this->check(count, sizeof(T));
+					::std::memcpy(data, this->begin, count * sizeof(T));
+					this->begin += count * sizeof(T);
+				}
+				
+				::std::string readString()
+				{
+					::std::uint32_t size;
+					this->read(&size);
+					this->check(size, sizeof(char));
+					::std::string string(this->begin, size);
+					this->begin += size;
+					return string;
+				}
+				
+				::rl::math::Transform readTransform()
+				{
+					double values[16];
+					this->read(values, 16);
+					
+					::rl::math::Transform transform;
+					
+					for (int i = 0; i < 4; ++i)
+					{
+						for (int j = 0; j < 4; ++j)
+						{
+							transform(i, j) = values[i + 4 * j];
+						}
+					}
+					
+					return transform;
+				}
+				
+				template<typename T>
+				void readVector(::std::vector<T>& vector)
+				{
+					::std::uint32_t size;
+					this->read(&size);
+					this->check(size, sizeof(T));
+					vector.resize(size);
+					this->read(vector.data(), size);
+				}
+				
+				::rl::math::Vector3 readVector3()
+				{
+					double values[3];
+					this->read(values, 3);
+					return ::rl::math::Vector3(values[0], values[1], values[2]);
+				}
+				
+			protected:
+				
+			private:
+				void check(const ::std::size_t& count, const ::std::size_t& size) const
+				{
+					if (count > static_cast<::std::size_t>(this->end - this->begin) / size)
+					{
+						throw Exception("rl::sg::BinaryFactory::load() - truncated file " + this->filename);
+					}
+				}
+				
+				const char* begin;
+				
+				::std::vector<char> buffer;
+				
+				const char* end;
+				
+				::std::string filename;
+				
+				void* mapping;
+				
+				::std::size_t mappingSize;
+			};
+			
+			::std::string
+			absolute(const ::std::string& filename)
+			{
+#ifdef WIN32
+				char* path = ::_fullpath(nullptr, filename.c_str(), 0);
+#else // WIN32
+				char* path = ::realpath(filename.c_str(), nullptr);
+#endif // WIN32
+				
+				if (nullptr == path)
+				{
+					return filename;
+				}
+				
+				::std::string result(path);
+				::std::free(path);
+				return result;
+			}
+			
+			/**
+			 * Collect the XML description, its VRML file, and all files
+			 * included via VRML Inline nodes.
+			 */
+			void
+			getSources(const ::std::string& filename, ::std::vector<::std::string>& sources)
+			{
+				::rl::xml::DomParser parser;
+				
+				::rl::xml::Document document = parser.readFile(filename, "", XML_PARSE_NOENT | XML_PARSE_XINCLUDE);
+				document.substitute(XML_PARSE_NOENT | XML_PARSE_XINCLUDE);
+				
+				::rl::xml::Path path(document);
+				
+				::rl::xml::NodeSet scenes = path.eval("(/rl/sg|/rlsg)/scene").getValue<::rl::xml::NodeSet>();
+				
+				if (scenes.empty())
+				{
+					throw Exception("rl::sg::BinaryFactory::save() - No scenes found in file '" + filename + "'");
+				}
+				
+				::std::string href = scenes[0].getLocalPath(scenes[0].getProperty("href"));
+				
+				sources.push_back(absolute(filename));
+				sources.push_back(absolute(href));
+				
+				::SoInput input;
+				
+				if (!input.openFile(href.c_str(), true))
+				{
+					throw Exception("rl::sg::BinaryFactory::save() - Failed to open file '" + href + "'");
+				}
+				
+				::SoVRMLGroup* root = ::SoDB::readAllVRML(&input);
+				
+				if (nullptr == root)
+				{
+					throw Exception("rl::sg::BinaryFactory::save() - Failed to read file '" + href + "'");
+				}
+				
+				root->ref();
+				
+				::SoSearchAction searchAction;
+				searchAction.setInterest(::SoSearchAction::ALL);
+				searchAction.setSearchingAll(true);
+				searchAction.setType(::SoVRMLInline::getClassTypeId());
+				searchAction.apply(root);
+				
+				for (int i = 0; i < searchAction.getPaths().getLength(); ++i)
+				{
+					::SoVRMLInline* inlineNode = static_cast<::SoVRMLInline*>(static_cast<::SoFullPath*>(searchAction.getPaths()[i])->getTail());
+					sources.push_back(absolute(inlineNode->getFullURLName().getString()));
+				}
+				
+				root->unref();
+			}
+			
+			bool
+			isScaled(const ::rl::math::Transform& transform)
+			{
+				::Eigen::JacobiSVD<::rl::math::Matrix33> svd(transform.linear());
+				return (svd.singularValues().array() - 1).abs().maxCoeff() > static_cast<::rl::math::Real>(1.0e-6);
+			}
+			
+			template<typename T>
+			void
+			write(::std::ostream& stream, const T* data, const ::std::size_t& count = 1)
+			{
+				stream.write(reinterpret_cast<const char*>(data), count * sizeof(T));
+			}
+			
+			void
+			writeString(::std::ostream& stream, const ::std::string& string)
+			{
+				::std::uint32_t size = string.size();
+				write(stream, &size);
+				write(stream, string.data(), string.size());
+			}
+			
+			void
+			writeTransform(::std::ostream& stream, const ::rl::math::Transform& transform)
+			{
+				double values[16];
+				
+				for (int i = 0; i < 4; ++i)
+				{
+					for (int j = 0; j < 4; ++j)
+					{
+						values[i + 4 * j] = transform(i, j);
+					}
+				}
+				
+				write(stream, values, 16);
+			}
+			
+			template<typename T>
+			void
+			writeVector(::std::ostream& stream, const ::std::vector<T>& vector)
+			{
+				::std::uint32_t size = vector.size();
+				write(stream, &size);
+				write(stream, vector.data(), vector.size());
+			}
+			
+			void
+			writeVector3(::std::ostream& stream, const ::rl::math::Vector3& vector)
+			{
+				double values[3] = {vector(0), vector(1), vector(2)};
+				write(stream, values, 3);
+			}
+		}
+		
+		BinaryFactory::BinaryFactory()
+		{
+		}
+		
+		BinaryFactory::~BinaryFactory()
+		{
+		}
+		
+		bool
+		BinaryFactory::isCurrent(const ::std::string& filename)
+		{
+			struct ::stat fileStat;
+			
+			if (0 != ::stat(filename.c_str(), &fileStat))
+			{
+				return false;
+			}
+			
+			try
+			{
+				Reader reader(filename);
+				
+				Header header;
+				reader.read(&header);
+				
+				if (0 != ::std::memcmp(header.magic, magic, sizeof(magic)) || version != header.version)
+				{
+					return false;
+				}
+				
+				::std::uint32_t numSources;
+				reader.read(&numSources);
+				
+				for (::std::size_t i = 0; i < numSources; ++i)
+				{
+					::std::string source = reader.readString();
+					::std::int64_t mtime;
+					reader.read(&mtime);
+					::std::uint64_t size;
+					reader.read(&size);
+					
+					struct ::stat sourceStat;
+					
+					if (0 != ::stat(source.c_str(), &sourceStat) || mtime != static_cast<::std::int64_t>(sourceStat.st_mtime) || size != static_cast<::std::uint64_t>(sourceStat.st_size))
+					{
+						return false;
+					}
+				}
+			}
+			catch (const Exception&)
+			{
+				return false;
+			}
+			
+			return true;
+		}
+		
+		void
+		BinaryFactory::load(const ::std::string& filename, Scene* scene)
+		{
+			this->load(filename, scene, false, false);
+		}
+		
+		void
+		BinaryFactory::load(const ::std::string& filename, Scene* scene, const bool& doBoundingBoxPoints, const bool& doPoints)
+		{
+			Reader reader(filename);
+			
+			Header header;
+			reader.read(&header);
+			
+			if (0 != ::std::memcmp(header.magic, magic, sizeof(magic)) || version != header.version)
+			{
+				throw Exception("rl::sg::BinaryFactory::load() - unsupported format in " + filename);
+			}
+			
+			::std::uint32_t numSources;
+			reader.read(&numSources);
+			
+			for (::std::size_t i = 0; i < numSources; ++i)
+			{
+				reader.readString();
+				::std::int64_t mtime;
+				reader.read(&mtime);
+				::std::uint64_t size;
+				reader.read(&size);
+			}
+			
+			::SoDB::init();
+			
+			::std::uint32_t numModels;
+			reader.read(&numModels);
+			
+			for (::std::size_t i = 0; i < numModels; ++i)
+			{
+				Model* model = scene->create();
+				
+				model->setName(reader.readString());
+				
+				::std::uint32_t numBodies;
+				reader.read(&numBodies);
+				
+				for (::std::size_t j = 0; j < numBodies; ++j)
+				{
+					Body* body = model->create();
+					
+					body->setName(reader.readString());
+					
+					::rl::math::Transform frame = reader.readTransform();
+					
+					if (!scene->isScalingSupported() && isScaled(frame))
+					{
+						throw Exception("rl::sg::BinaryFactory::load() - bodyScaleFactor not supported in body '" + body->getName() + "'");
+					}
+					
+					body->setFrame(frame);
+					
+					body->center = reader.readVector3();
+					
+					::rl::math::Vector3 min = reader.readVector3();
+					::rl::math::Vector3 max = reader.readVector3();
+					
+					if (doBoundingBoxPoints)
+					{
+						body->max = max;
+						body->min = min;
+					}
+					
+					::std::vector<double> points;
+					reader.readVector(points);
+					
+					if (doPoints)
+					{
+						for (::std::size_t k = 0; k + 2 < points.size(); k += 3)
+						{
+							body->points.push_back(::rl::math::Vector3(points[k], points[k + 1], points[k + 2]));
+						}
+					}
+					
+					::std::uint32_t numShapes;
+					reader.read(&numShapes);
+					
+					for (::std::size_t k = 0; k < numShapes; ++k)
+					{
+						::std::string name = reader.readString();
+						
+						::rl::math::Transform transform = reader.readTransform();
+						
+						if (!scene->isScalingSupported() && isScaled(transform))
+						{
+							throw Exception("rl::sg::BinaryFactory::load() - shapeScaleFactor not supported");
+						}
+						
+						::std::uint32_t geometry;
+						reader.read(&geometry);
+						
+						::SoVRMLShape* vrmlShape = new ::SoVRMLShape();
+						vrmlShape->ref();
+						
+						switch (geometry)
+						{
+						case GEOMETRY_BOX:
+							{
+								float size[3];
+								reader.read(size, 3);
+								::SoVRMLBox* box = new ::SoVRMLBox();
+								box->size.setValue(size);
+								vrmlShape->geometry = box;
+							}
+							break;
+						case GEOMETRY_CONE:
+							{
+								float values[2];
+								reader.read(values, 2);
+								::SoVRMLCone* cone = new ::SoVRMLCone();
+								cone->bottomRadius.setValue(values[0]);
+								cone->height.setValue(values[1]);
+								vrmlShape->geometry = cone;
+							}
+							break;
+						case GEOMETRY_CYLINDER:
+							{
+								float values[2];
+								reader.read(values, 2);
+								::SoVRMLCylinder* cylinder = new ::SoVRMLCylinder();
+								cylinder->radius.setValue(values[0]);
+								cylinder->height.setValue(values[1]);
+								vrmlShape->geometry = cylinder;
+							}
+							break;
+						case GEOMETRY_INDEXEDFACESET:
+							{
+								::std::uint8_t convex;
+								reader.read(&convex);
+								::std::vector<float> point;
+								reader.readVector(point);
+								::std::vector<::std::int32_t> coordIndex;
+								reader.readVector(coordIndex);
+								
+								::SoVRMLCoordinate* coordinate = new ::SoVRMLCoordinate();
+								coordinate->point.setValues(0, point.size() / 3, reinterpret_cast<const float(*)[3]>(point.data()));
+								
+								::SoVRMLIndexedFaceSet* indexedFaceSet = new ::SoVRMLIndexedFaceSet();
+								indexedFaceSet->convex.setValue(0 != convex);
+								indexedFaceSet->coord = coordinate;
+								indexedFaceSet->coordIndex.setValues(0, coordIndex.size(), coordIndex.data());
+								vrmlShape->geometry = indexedFaceSet;
+							}
+							break;
+						case GEOMETRY_SPHERE:
+							{
+								float radius;
+								reader.read(&radius);
+								::SoVRMLSphere* sphere = new ::SoVRMLSphere();
+								sphere->radius.setValue(radius);
+								vrmlShape->geometry = sphere;
+							}
+							break;
+						default:
+							vrmlShape->unref();
+							throw Exception("rl::sg::BinaryFactory::load() - geometry not supported in " + filename);
+							break;
+						}
+						
+						Shape* shape = body->create(vrmlShape);
+						
+						shape->setName(name);
+						
+						shape->setTransform(transform);
+						
+						vrmlShape->unref();
+					}
+				}
+			}
+		}
+		
+		void
+		BinaryFactory::save(const ::std::string& source, const ::std::string& filename)
+		{
+			so::Scene scene;
+			
+			XmlFactory factory;
+			factory.load(source, &scene, true, true);
+			
+			::std::vector<::std::string> sources;
+			getSources(source, sources);
+			
+			// write to a temporary file first, so that readers never see a partial file
+			::std::string temporary = filename + ".tmp";
+			::std::ofstream file(temporary.c_str(), ::std::ios::binary);
+			
+			Header header;
+			::std::memcpy(header.magic, magic, sizeof(magic));
+			header.version = version;
+			write(file, &header);
+			
+			::std::uint32_t numSources = sources.size();
+			write(file, &numSources);
+			
+			for (::std::size_t i = 0; i < sources.size(); ++i)
+			{
+				struct ::stat sourceStat;
+				
+				if (0 != ::stat(sources[i].c_str(), &sourceStat))
+				{
+					throw Exception("rl::sg::BinaryFactory::save() - could not stat " + sources[i]);
+				}
+				
+				::std::int64_t mtime = sourceStat.st_mtime;
+				::std::uint64_t size = sourceStat.st_size;
+				writeString(file, sources[i]);
+				write(file, &mtime);
+				write(file, &size);
+			}
+			
+			::std::uint32_t numModels = scene.getNumModels();
+			write(file, &numModels);
+			
+			for (::std::size_t i = 0; i < scene.getNumModels(); ++i)
+			{
+				Model* model = scene.getModel(i);
+				
+				writeString(file, model->getName());
+				
+				::std::uint32_t numBodies = model->getNumBodies();
+				write(file, &numBodies);
+				
+				for (::std::size_t j = 0; j < model->getNumBodies(); ++j)
+				{
+					Body* body = model->getBody(j);
+					
+					writeString(file, body->getName());
+					writeTransform(file, body->getFrame());
+					writeVector3(file, body->center);
+					writeVector3(file, body->min);
+					writeVector3(file, body->max);
+					
+					::std::vector<double> points;
+					points.reserve(3 * body->points.size());
+					
+					for (::std::size_t k = 0; k < body->points.size(); ++k)
+					{
+						points.insert(points.end(), body->points[k].data(), body->points[k].data() + 3);
+					}
+					
+					writeVector(file, points);
+					
+					::std::uint32_t numShapes = body->getNumShapes();
+					write(file, &numShapes);
+					
+					for (::std::size_t k = 0; k < body->getNumShapes(); ++k)
+					{
+						so::Shape* shape = static_cast<so::Shape*>(body->getShape(k));
+						
+						writeString(file, shape->getName());
+						writeTransform(file, shape->getTransform());
+						
+						::SoNode* geometry = shape->shape->geometry.getValue();
+						
+						if (geometry->isOfType(::SoVRMLBox::getClassTypeId()))
+						{
+							::SoVRMLBox* box = static_cast<::SoVRMLBox*>(geometry);
+							::std::uint32_t type = GEOMETRY_BOX;
+							write(file, &type);
+							write(file, box->size.getValue().getValue(), 3);
+						}
+						else if (geometry->isOfType(::SoVRMLCone::getClassTypeId()))
+						{
+							::SoVRMLCone* cone = static_cast<::SoVRMLCone*>(geometry);
+							::std::uint32_t type = GEOMETRY_CONE;
+							write(file, &type);
+							float values[2] = {cone->bottomRadius.getValue(), cone->height.getValue()};
+							write(file, values, 2);
+						}
+						else if (geometry->isOfType(::SoVRMLCylinder::getClassTypeId()))
+						{
+							::SoVRMLCylinder* cylinder = static_cast<::SoVRMLCylinder*>(geometry);
+							::std::uint32_t type = GEOMETRY_CYLINDER;
+							write(file, &type);
+							float values[2] = {cylinder->radius.getValue(), cylinder->height.getValue()};
+							write(file, values, 2);
+						}
+						else if (geometry->isOfType(::SoVRMLSphere::getClassTypeId()))
+						{
+							::SoVRMLSphere* sphere = static_cast<::SoVRMLSphere*>(geometry);
+							::std::uint32_t type = GEOMETRY_SPHERE;
+							write(file, &type);
+							float radius = sphere->radius.getValue();
+							write(file, &radius);
+						}
+						else
+						{
+							::std::uint8_t convex = 0;
+							::std::vector<float> point;
+							::std::vector<::std::int32_t> coordIndex;
+							
+							if (geometry->isOfType(::SoVRMLIndexedFaceSet::getClassTypeId()) && nullptr != static_cast<::SoVRMLIndexedFaceSet*>(geometry)->coord.getValue())
+							{
+								::SoVRMLIndexedFaceSet* indexedFaceSet = static_cast<::SoVRMLIndexedFaceSet*>(geometry);
+								::SoVRMLCoordinate* coordinate = static_cast<::SoVRMLCoordinate*>(indexedFaceSet->coord.getValue());
+								
+								convex = indexedFaceSet->convex.getValue() ? 1 : 0;
+								
+								for (int l = 0; l < coordinate->point.getNum(); ++l)
+								{
+									point.insert(point.end(), coordinate->point[l].getValue(), coordinate->point[l].getValue() + 3);
+								}
+								
+								coordIndex.assign(indexedFaceSet->coordIndex.getValues(0), indexedFaceSet->coordIndex.getValues(0) + indexedFaceSet->coordIndex.getNum());
+							}
+							else
+							{
+								::std::pair<::std::vector<float>*, ::std::vector<::std::int32_t>*> mesh(&point, &coordIndex);
+								
+								::SoCallbackAction callbackAction;
+								callbackAction.addTriangleCallback(::SoVRMLGeometry::getClassTypeId(), BinaryFactory::triangleCallback, &mesh);
+								callbackAction.apply(shape->shape);
+							}
+							
+							::std::uint32_t type = GEOMETRY_INDEXEDFACESET;
+							write(file, &type);
+							write(file, &convex);
+							writeVector(file, point);
+							writeVector(file, coordIndex);
+						}
+					}
+				}
+			}
+			
+			file.close();
+			
+			if (!file)
+			{
+				::std::remove(temporary.c_str());
+				throw Exception("rl::sg::BinaryFactory::save() - could not write " + filename);
+			}
+			
+#ifdef WIN32
+			::std::remove(filename.c_str());
+#endif // WIN32
+			
+			if (0 != ::std::rename(temporary.c_str(), filename.c_str()))
+			{
+				::std::remove(temporary.c_str());
+				throw Exception("rl::sg::BinaryFactory::save() - could not write " + filename);
+			}
+		}
+		
+		void
+		BinaryFactory::triangleCallback(void* userData, ::SoCallbackAction* action, const ::SoPrimitiveVertex* v1, const ::SoPrimitiveVertex* v2, const ::SoPrimitiveVertex* v3)
+		{
+			::std::pair<::std::vector<float>*, ::std::vector<::std::int32_t>*>* mesh = static_cast<::std::pair<::std::vector<float>*, ::std::vector<::std::int32_t>*>*>(userData);
+			
+			const ::SoPrimitiveVertex* vertices[3] = {v1, v2, v3};
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				mesh->first->insert(mesh->first->end(), vertices[i]->getPoint().getValue(), vertices[i]->getPoint().getValue() + 3);
+				mesh->second->push_back(mesh->first->size() / 3 - 1);
+			}
+			
+			mesh->second->push_back(-1);
+		}
+	}
+}
@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_SG_BINARYFACTORY_H
+#define RL_SG_BINARYFACTORY_H
+
+#include <Inventor/actions/SoCallbackAction.h>
+
+#include "Factory.h"
+
+namespace rl
+{
+	namespace sg
+	{
+		/**
+		 * Versioned binary scene file.
+		 * 
+		 * Stores the resolved scene of an XML description, i.e., models,
+		 * bodies, body frames, shape transforms, primitive parameters, and
+		 * triangle meshes, in native byte order. Loading maps the file into
+		 * memory and recreates the shapes without parsing VRML or searching
+		 * the Coin3D scene graph.
+		 * 
+		 * The header lists the paths, modification times, and sizes of all
+		 * source files, i.e., the XML description, its VRML file, and all
+		 * files referenced by VRML Inline nodes.
+		 */
+		class RL_SG_EXPORT BinaryFactory : public Factory
+		{
+		public:
+			BinaryFactory();
+			
+			virtual ~BinaryFactory();
+			
+			/**
+			 * Test if a binary file matches the current state of its sources.
+			 * 
+			 * Returns false if the file does not exist, cannot be read, is
+			 * truncated, has an unsupported format, or if any source file is
+			 * missing or differs in modification time or size from the one it
+			 * was written from.
+			 */
+			static bool isCurrent(const ::std::string& filename);
+			
+			void load(const ::std::string& filename, Scene* scene);
+			
+			void load(const ::std::string& filename, Scene* scene, const bool& doBoundingBoxPoints, const bool& doPoints);
+			
+			/**
+			 * Resolve an XML scene description and write it to a binary file.
+			 * 
+			 * Bounding boxes and convex hull points are always stored.
+			 * XmlFactory uses a file named after the description with the
+			 * suffix ".cache" if isCurrent() holds for it. The file is written
+			 * to a temporary file first and then renamed.
+			 */
+			void save(const ::std::string& source, const ::std::string& filename);
+			
+		protected:
+			
+		private:
+			static void triangleCallback(void* userData, ::SoCallbackAction* action, const ::SoPrimitiveVertex* v1, const ::SoPrimitiveVertex* v2, const ::SoPrimitiveVertex* v3);
+		};
+	}
+}
+
+#endif // RL_SG_BINARYFACTORY_H
@@ -91,5 +91,44 @@ namespace rl
 			
 			return false;
 		}
+		
+		bool
+		SimpleScene::isColliding(Model* model, const ::std::function<bool(const ::std::size_t&)>& environment, const ::std::function<bool(const ::std::size_t&, const ::std::size_t&)>& self, ::std::size_t& body)
+		{
+			for (::std::size_t i = 0; i < model->getNumBodies(); ++i)
+			{
+				if (environment(i))
+				{
+					for (Scene::Iterator j = this->begin(); j != this->end(); ++j)
+					{
+						if (model != *j)
+						{
+							for (Model::Iterator k = (*j)->begin(); k != (*j)->end(); ++k)
+							{
+								if (this->areColliding(model->getBody(i), *k))
+								{
+									body = i;
+									return true;
+								}
+							}
+						}
+					}
+				}
+				
+				for (::std::size_t j = 0; j < i; ++j)
+				{
+					if (self(i, j))
+					{
+						if (this->areColliding(model->getBody(i), model->getBody(j)))
+						{
+							body = i;
+							return true;
+						}
+					}
+				}
+			}
+			
+			return false;
+		}
 	}
 }
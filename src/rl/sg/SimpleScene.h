@@ -27,6 +27,8 @@
 #ifndef RL_SG_SIMPLESCENE_H
 #define RL_SG_SIMPLESCENE_H
 
+#include <functional>
+
 #include "Scene.h"
 
 namespace rl
@@ -52,6 +54,20 @@ namespace rl
 			
 			virtual bool isColliding();
 			
+			/**
+			 * Test if a model collides with any other model or with itself.
+			 *
+			 * Bodies of model are tested against all other models if environment
+			 * returns true for their index. A pair of bodies i > j of model is
+			 * tested if self returns true for (i, j).
+			 *
+			 * Backends with a broadphase only refresh the entries of bodies whose
+			 * frame was set since the last query.
+			 *
+			 * @param[out] body Index of the first colliding body found in model
+			 */
+			virtual bool isColliding(Model* model, const ::std::function<bool(const ::std::size_t&)>& environment, const ::std::function<bool(const ::std::size_t&, const ::std::size_t&)>& self, ::std::size_t& body);
+			
 		protected:
 			
 		private:
@@ -38,12 +38,14 @@
 #include <rl/xml/Object.h>
 #include <rl/xml/Path.h>
 
+#include "BinaryFactory.h"
 #include "Body.h"
 #include "Exception.h"
 #include "Model.h"
 #include "Scene.h"
 #include "Shape.h"
 #include "XmlFactory.h"
+#include "so/Scene.h"
 
 namespace rl
 {
@@ -80,6 +82,15 @@ namespace rl
 				throw Exception("rl::sg::XmlFactory::load() - No scenes found in file '" + filename + "'");
 			}
 			
+			// binary cache
+			
+			if (nullptr == dynamic_cast<so::Scene*>(scene) && BinaryFactory::isCurrent(filename + ".cache"))
+			{
+				BinaryFactory factory;
+				factory.load(filename + ".cache", scene, doBoundingBoxPoints, doPoints);
+				return;
+			}
+			
 			::SoDB::init();
 			
 			for (int i = 0; i < ::std::min(1, scenes.size()); ++i)
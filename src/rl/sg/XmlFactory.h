@@ -44,6 +44,16 @@ namespace rl
 			
 			void load(const ::std::string& filename, Scene* scene);
 			
+			/**
+			 * Load an XML scene description.
+			 * 
+			 * If a binary file named after the description with the suffix
+			 * ".cache" matches all its source files, see
+			 * BinaryFactory::isCurrent(), the scene is loaded from there via
+			 * BinaryFactory. Coin3D scenes
+			 * are always loaded from VRML, as the binary file does not store
+			 * appearances.
+			 */
 			void load(const ::std::string& filename, Scene* scene, const bool& doBoundingBoxPoints, const bool& doPoints);
 			
 		protected:
@@ -50,6 +50,7 @@ namespace rl
 			
 			Body::~Body()
 			{
+				dynamic_cast<Scene*>(this->getModel()->getScene())->dirty.erase(this);
 				dynamic_cast<Scene*>(this->getModel()->getScene())->world.removeCollisionObject(&this->object);
 				
 				while (this->shapes.size() > 0)
@@ -104,6 +105,8 @@ namespace rl
 					static_cast<::btScalar>(frame(1, 0)), static_cast<::btScalar>(frame(1, 1)), static_cast<::btScalar>(frame(1, 2)),
 					static_cast<::btScalar>(frame(2, 0)), static_cast<::btScalar>(frame(2, 1)), static_cast<::btScalar>(frame(2, 2))
 				);
+				
+				dynamic_cast<Scene*>(this->getModel()->getScene())->dirty.insert(this);
 			}
 		}
 	}
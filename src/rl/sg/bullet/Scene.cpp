@@ -49,6 +49,7 @@ namespace rl
 				::rl::sg::SimpleScene(),
 				broadphase(),
 				configuration(),
+				dirty(),
 				dispatcher(&configuration),
 				world(&dispatcher, &broadphase, &configuration)
 			{
@@ -200,6 +201,7 @@ namespace rl
 			Scene::isColliding()
 			{
 				this->world.performDiscreteCollisionDetection();
+				this->dirty.clear();
 				
 				for (int i = 0; i < this->world.getDispatcher()->getNumManifolds(); ++i)
 				{
@@ -212,6 +214,31 @@ namespace rl
 				return false;
 			}
 			
+			bool
+			Scene::isColliding(::rl::sg::Model* model, const ::std::function<bool(const ::std::size_t&)>& environment, const ::std::function<bool(const ::std::size_t&, const ::std::size_t&)>& self, ::std::size_t& body)
+			{
+				for (::std::unordered_set<Body*>::iterator i = this->dirty.begin(); i != this->dirty.end(); ++i)
+				{
+					this->world.updateSingleAabb(&(*i)->object);
+				}
+				
+				this->dirty.clear();
+				
+				for (::std::size_t i = 0; i < model->getNumBodies(); ++i)
+				{
+					ModelContactResultCallback resultCallback(model, i, environment, self);
+					this->world.contactTest(&static_cast<Body*>(model->getBody(i))->object, resultCallback);
+					
+					if (resultCallback.collision)
+					{
+						body = i;
+						return true;
+					}
+				}
+				
+				return false;
+			}
+			
 			bool
 			Scene::isScalingSupported() const
 			{
@@ -328,6 +355,41 @@ namespace rl
 				return 0;
 			}
 			
+			Scene::ModelContactResultCallback::ModelContactResultCallback(::rl::sg::Model* model, const ::std::size_t& body, const ::std::function<bool(const ::std::size_t&)>& environment, const ::std::function<bool(const ::std::size_t&, const ::std::size_t&)>& self) :
+				ContactResultCallback(),
+				body(body),
+				environment(environment),
+				model(model),
+				self(self)
+			{
+			}
+			
+			bool
+			Scene::ModelContactResultCallback::needsCollision(::btBroadphaseProxy* proxy0) const
+			{
+				if (this->collision)
+				{
+					return false;
+				}
+				
+				::rl::sg::Body* other = static_cast<Body*>(static_cast<::btCollisionObject*>(proxy0->m_clientObject)->getUserPointer());
+				
+				if (other->getModel() != this->model)
+				{
+					return this->environment(this->body);
+				}
+				
+				for (::std::size_t j = 0; j < this->body; ++j)
+				{
+					if (this->model->getBody(j) == other)
+					{
+						return this->self(this->body, j);
+					}
+				}
+				
+				return false;
+			}
+			
 			Scene::RayResultCallback::RayResultCallback() :
 				collisionShape(nullptr),
 				hitPointWorld()
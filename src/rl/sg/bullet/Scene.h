@@ -27,6 +27,7 @@
 #ifndef RL_SG_BULLET_SCENE_H
 #define RL_SG_BULLET_SCENE_H
 
+#include <unordered_set>
 #include <btBulletCollisionCommon.h>
 
 #include "../DepthScene.h"
@@ -45,6 +46,8 @@ namespace rl
 		 */
 		namespace bullet
 		{
+			class Body;
+			
 			class RL_SG_EXPORT Scene : public ::rl::sg::DepthScene, public ::rl::sg::DistanceScene, public ::rl::sg::RaycastScene, public ::rl::sg::SimpleScene
 			{
 			public:
@@ -72,8 +75,12 @@ namespace rl
 				
 				::rl::math::Real distance(::rl::sg::Shape* shape, const ::rl::math::Vector3& point, ::rl::math::Vector3& point1, ::rl::math::Vector3& point2);
 				
+				using ::rl::sg::SimpleScene::isColliding;
+				
 				bool isColliding();
 				
+				bool isColliding(::rl::sg::Model* model, const ::std::function<bool(const ::std::size_t&)>& environment, const ::std::function<bool(const ::std::size_t&, const ::std::size_t&)>& self, ::std::size_t& body);
+				
 				bool isScalingSupported() const;
 				
 				::rl::sg::Shape* raycast(const ::rl::math::Vector3& source, const ::rl::math::Vector3& target, ::rl::math::Real& distance);
@@ -84,6 +91,9 @@ namespace rl
 				
 				::btDefaultCollisionConfiguration configuration;
 				
+				/** Bodies moved since their broadphase entries were last refreshed. */
+				::std::unordered_set<Body*> dirty;
+				
 				::btCollisionDispatcher dispatcher;
 				
 				::btCollisionWorld world;
@@ -110,6 +120,21 @@ namespace rl
 					::btVector3 positionWorldOnB;
 				};
 				
+				struct ModelContactResultCallback : public ContactResultCallback
+				{
+					ModelContactResultCallback(::rl::sg::Model* model, const ::std::size_t& body, const ::std::function<bool(const ::std::size_t&)>& environment, const ::std::function<bool(const ::std::size_t&, const ::std::size_t&)>& self);
+					
+					bool needsCollision(::btBroadphaseProxy* proxy0) const;
+					
+					::std::size_t body;
+					
+					const ::std::function<bool(const ::std::size_t&)>& environment;
+					
+					::rl::sg::Model* model;
+					
+					const ::std::function<bool(const ::std::size_t&, const ::std::size_t&)>& self;
+				};
+				
 				struct RayResultCallback : public ::btCollisionWorld::RayResultCallback
 				{
 					RayResultCallback();
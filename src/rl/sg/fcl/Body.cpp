@@ -46,6 +46,8 @@ namespace rl
 			
 			Body::~Body()
 			{
+				dynamic_cast<Scene*>(this->getModel()->getScene())->dirty.erase(this);
+				
 				while (this->shapes.size() > 0)
 				{
 					delete this->shapes[0];
@@ -99,6 +101,8 @@ namespace rl
 				{
 					static_cast<Shape*>(*i)->update(this->frame);
 				}
+				
+				dynamic_cast<Scene*>(this->getModel()->getScene())->dirty.insert(this);
 			}
 		}
 	}
@@ -65,6 +65,7 @@ namespace rl
 			Scene::Scene() :
 				::rl::sg::Scene(),
 				::rl::sg::SimpleScene(),
+				dirty(),
 				manager(),
 				bodyForObj()
 			{
@@ -366,17 +367,99 @@ namespace rl
 			Scene::isColliding()
 			{
 				this->manager.update();
+				this->dirty.clear();
 				CollisionData collisionData(bodyForObj);
 				this->manager.collide(&collisionData, Scene::defaultCollisionFunction);
 				return collisionData.result.isCollision();
 			}
 			
+			bool
+			Scene::isColliding(::rl::sg::Model* model, const ::std::function<bool(const ::std::size_t&)>& environment, const ::std::function<bool(const ::std::size_t&, const ::std::size_t&)>& self, ::std::size_t& body)
+			{
+				Model* model1 = static_cast<Model*>(model);
+				
+				if (model1->manager.empty())
+				{
+					return false;
+				}
+				
+				::std::vector<CollisionObject*> objects;
+				
+				for (::std::unordered_set<::rl::sg::Body*>::iterator i = this->dirty.begin(); i != this->dirty.end(); ++i)
+				{
+					static_cast<Body*>(*i)->manager.getObjects(objects);
+				}
+				
+				this->dirty.clear();
+				
+				model1->manager.update();
+				this->manager.update(objects);
+				ModelCollisionData collisionData(this->bodyForObj, model, environment, self);
+				model1->manager.collide(&this->manager, &collisionData, Scene::modelCollisionFunction);
+				
+				if (collisionData.result.isCollision())
+				{
+					body = collisionData.body;
+					return true;
+				}
+				
+				return false;
+			}
+			
 			bool
 			Scene::isScalingSupported() const
 			{
 				return false;
 			}
 			
+			bool
+			Scene::modelCollisionFunction(CollisionObject* o1, CollisionObject* o2, void* data)
+			{
+				ModelCollisionData* collisionData = static_cast<ModelCollisionData*>(data);
+				
+				if (collisionData->done)
+				{
+					return true;
+				}
+				
+				Body* body1 = collisionData->bodyForObj.find(o1)->second;
+				Body* body2 = collisionData->bodyForObj.find(o2)->second;
+				
+				if (body1 == body2)
+				{
+					return false;
+				}
+				
+				::std::size_t i = ::std::find(collisionData->model->begin(), collisionData->model->end(), body1) - collisionData->model->begin();
+				
+				if (body2->getModel() != collisionData->model)
+				{
+					if (!collisionData->environment(i))
+					{
+						return false;
+					}
+				}
+				else
+				{
+					::std::size_t j = ::std::find(collisionData->model->begin(), collisionData->model->end(), body2) - collisionData->model->begin();
+					
+					if (j > i || !collisionData->self(i, j))
+					{
+						return false;
+					}
+				}
+				
+				::fcl::collide(o1, o2, collisionData->request, collisionData->result);
+				
+				if (collisionData->result.isCollision())
+				{
+					collisionData->body = i;
+					collisionData->done = true;
+				}
+				
+				return collisionData->done;
+			}
+			
 			void
 			Scene::remove(::rl::sg::Model* model)
 			{
@@ -417,6 +500,15 @@ namespace rl
 				result()
 			{
 			}
+			
+			Scene::ModelCollisionData::ModelCollisionData(const ::std::unordered_map<CollisionObject*, Body*>& bodyForObj, ::rl::sg::Model* model, const ::std::function<bool(const ::std::size_t&)>& environment, const ::std::function<bool(const ::std::size_t&, const ::std::size_t&)>& self) :
+				CollisionData(bodyForObj),
+				body(0),
+				environment(environment),
+				model(model),
+				self(self)
+			{
+			}
 		}
 	}
 }
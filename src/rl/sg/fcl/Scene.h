@@ -28,6 +28,7 @@
 #define RL_SG_FCL_SCENE_H
 
 #include <unordered_map>
+#include <unordered_set>
 #include <fcl/config.h>
 
 #if FCL_MAJOR_VERSION < 1 && FCL_MINOR_VERSION < 6
@@ -102,14 +103,21 @@ namespace rl
 				
 				::rl::math::Real distance(::rl::sg::Shape* shape, const ::rl::math::Vector3& point, ::rl::math::Vector3& point1, ::rl::math::Vector3& point2);
 				
+				using ::rl::sg::SimpleScene::isColliding;
+				
 				bool isColliding();
 				
+				bool isColliding(::rl::sg::Model* model, const ::std::function<bool(const ::std::size_t&)>& environment, const ::std::function<bool(const ::std::size_t&, const ::std::size_t&)>& self, ::std::size_t& body);
+				
 				bool isScalingSupported() const;
 				
 				void remove(::rl::sg::Model* model);
 				
 				void removeCollisionObject(CollisionObject* collisionObject);
 				
+				/** Bodies moved since their broadphase entries were last refreshed. */
+				::std::unordered_set<::rl::sg::Body*> dirty;
+				
 				DynamicAABBTreeCollisionManager manager;
 				
 			protected:
@@ -141,10 +149,25 @@ namespace rl
 					DistanceResult result;
 				};
 				
+				struct ModelCollisionData : public CollisionData
+				{
+					ModelCollisionData(const ::std::unordered_map<CollisionObject*, Body*>& bodyForObj, ::rl::sg::Model* model, const ::std::function<bool(const ::std::size_t&)>& environment, const ::std::function<bool(const ::std::size_t&, const ::std::size_t&)>& self);
+					
+					::std::size_t body;
+					
+					const ::std::function<bool(const ::std::size_t&)>& environment;
+					
+					::rl::sg::Model* model;
+					
+					const ::std::function<bool(const ::std::size_t&, const ::std::size_t&)>& self;
+				};
+				
 				static bool defaultCollisionFunction(CollisionObject* o1, CollisionObject* o2, void* data);
 				
 				static bool defaultDistanceFunction(CollisionObject* o1, CollisionObject* o2, void* data, Real& dist);
 				
+				static bool modelCollisionFunction(CollisionObject* o1, CollisionObject* o2, void* data);
+				
 				::std::unordered_map<CollisionObject*, Body*> bodyForObj;
 			};
 		}
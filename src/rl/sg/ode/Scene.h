@@ -63,6 +63,8 @@ namespace rl
 				
 				::rl::math::Real depth(::rl::sg::Shape* first, ::rl::sg::Shape* second, ::rl::math::Vector3& point1, ::rl::math::Vector3& point2);
 				
+				using ::rl::sg::SimpleScene::isColliding;
+				
 				bool isColliding();
 				
 				::rl::sg::Shape* raycast(const ::rl::math::Vector3& source, const ::rl::math::Vector3& target, ::rl::math::Real& distance);
@@ -37,8 +37,14 @@ namespace rl
 			Scene::Scene() :
 				::rl::sg::Scene(),
 				::rl::sg::DistanceScene(),
-				::rl::sg::SimpleScene()
+				::rl::sg::SimpleScene(),
+				point()
 			{
+				::PQP_REAL p[3] = {0, 0, 0};
+				
+				this->point.BeginModel(1);
+				this->point.AddTri(p, p, p, 0);
+				this->point.EndModel();
 			}
 			
 			Scene::~Scene()
@@ -117,13 +123,6 @@ namespace rl
 			{
 				Shape* shape1 = static_cast<Shape*>(shape);
 				
-				::rl::math::Real p[3] = {0, 0, 0};
-				
-				::PQP_Model model;
-				model.BeginModel(1);
-				model.AddTri(&p[0], &p[0], &p[0], 0);
-				model.EndModel();
-				
 				::PQP_REAL rotation[3][3] = {
 					{1, 0, 0},
 					{0, 1, 0},
@@ -141,7 +140,7 @@ namespace rl
 					&shape1->model,
 					rotation,
 					translation,
-					&model,
+					&this->point,
 					::std::numeric_limits<::rl::math::Real>::epsilon(),
 					::std::numeric_limits<::rl::math::Real>::epsilon()
 				);
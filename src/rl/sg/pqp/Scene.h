@@ -61,6 +61,14 @@ namespace rl
 				
 				::rl::math::Real distance(::rl::sg::Shape* first, ::rl::sg::Shape* second, ::rl::math::Vector3& point1, ::rl::math::Vector3& point2);
 				
+				/**
+				 * Distance of a point to a shape.
+				 * 
+				 * All point queries of a scene share one point model, and PQP
+				 * updates its models during a query. Concurrent point queries on
+				 * the same scene are therefore a data race, even for different
+				 * shapes.
+				 */
 				::rl::math::Real distance(::rl::sg::Shape* shape, const ::rl::math::Vector3& point, ::rl::math::Vector3& point1, ::rl::math::Vector3& point2);
 				
 				bool isScalingSupported() const;
@@ -68,7 +76,8 @@ namespace rl
 			protected:
 				
 			private:
-				
+				/** Single degenerate triangle at the origin, translated to the query point and shared by all point queries. */
+				::PQP_Model point;
 			};
 		}
 	}
@@ -0,0 +1,130 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+
+#include "Body.h"
+#include "Model.h"
+#include "Shape.h"
+
+namespace rl
+{
+	namespace sg
+	{
+		namespace ssv
+		{
+			Body::Body(Model* model) :
+				::rl::sg::Body(model),
+				direction(0, 3),
+				exact(nullptr),
+				frame(::rl::math::Transform::Identity()),
+				from(0, 3),
+				radius(0)
+			{
+				this->getModel()->add(this);
+			}
+			
+			Body::~Body()
+			{
+				while (this->shapes.size() > 0)
+				{
+					delete this->shapes[0];
+				}
+				
+				this->getModel()->remove(this);
+			}
+			
+			void
+			Body::add(::rl::sg::Shape* shape)
+			{
+				this->shapes.push_back(shape);
+				this->update();
+			}
+			
+			::rl::sg::Shape*
+			Body::create(::SoVRMLShape* shape)
+			{
+				return new Shape(shape, this);
+			}
+			
+			::rl::math::Transform
+			Body::getFrame() const
+			{
+				return this->frame;
+			}
+			
+			void
+			Body::remove(::rl::sg::Shape* shape)
+			{
+				Iterator found = ::std::find(this->shapes.begin(), this->shapes.end(), shape);
+				
+				if (found != this->shapes.end())
+				{
+					this->shapes.erase(found);
+					this->update();
+				}
+			}
+			
+			void
+			Body::setFrame(const ::rl::math::Transform& frame)
+			{
+				this->frame = frame;
+				
+				this->update();
+				
+				if (nullptr != this->exact)
+				{
+					this->exact->setFrame(frame);
+				}
+			}
+			
+			void
+			Body::update()
+			{
+				::std::size_t capsules = 0;
+				
+				for (Iterator i = this->begin(); i != this->end(); ++i)
+				{
+					static_cast<Shape*>(*i)->offset = capsules;
+					capsules += static_cast<Shape*>(*i)->getNumCapsules();
+				}
+				
+				this->direction.resize(capsules, 3);
+				this->from.resize(capsules, 3);
+				this->radius.resize(capsules);
+				
+				for (Iterator i = this->begin(); i != this->end(); ++i)
+				{
+					Shape* shape = static_cast<Shape*>(*i);
+					::rl::math::Transform transform = this->frame * shape->getTransform();
+					this->direction.middleRows(shape->offset, shape->getNumCapsules()) = (transform.linear() * shape->direction).transpose().array();
+					this->from.middleRows(shape->offset, shape->getNumCapsules()) = ((transform.linear() * shape->from).colwise() + transform.translation()).transpose().array();
+					this->radius.segment(shape->offset, shape->getNumCapsules()) = shape->radius;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,369 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <limits>
+
+#include "../Exception.h"
+#include "Body.h"
+#include "Model.h"
+#include "Scene.h"
+#include "Shape.h"
+
+namespace rl
+{
+	namespace sg
+	{
+		namespace ssv
+		{
+			Scene::Scene() :
+				::rl::sg::Scene(),
+				::rl::sg::DistanceScene(),
+				::rl::sg::SimpleScene(),
+				subdivisions(3),
+				exact(nullptr),
+				scratch()
+			{
+			}
+			
+			Scene::~Scene()
+			{
+				while (this->models.size() > 0)
+				{
+					delete this->models[0];
+				}
+			}
+			
+			bool
+			Scene::areColliding(::rl::sg::Body* first, ::rl::sg::Body* second)
+			{
+				Body* body1 = static_cast<Body*>(first);
+				Body* body2 = static_cast<Body*>(second);
+				
+				if (!this->areColliding(body1, 0, body1->radius.size(), body2, 0, body2->radius.size()))
+				{
+					return false;
+				}
+				
+				if (nullptr != this->exact && nullptr != body1->exact && nullptr != body2->exact)
+				{
+					return this->exact->areColliding(body1->exact, body2->exact);
+				}
+				
+				return true;
+			}
+			
+			bool
+			Scene::areColliding(const Body* body1, const ::std::size_t& offset1, const ::std::size_t& size1, const Body* body2, const ::std::size_t& offset2, const ::std::size_t& size2)
+			{
+				for (::std::size_t i = offset1; i < offset1 + size1; ++i)
+				{
+					this->closest(body1->from.row(i).transpose().matrix(), body1->direction.row(i).transpose().matrix(), body2, offset2, size2);
+					
+					if ((this->scratch.distance2.head(size2) < (body1->radius(i) + body2->radius.segment(offset2, size2)).square()).any())
+					{
+						return true;
+					}
+				}
+				
+				return false;
+			}
+			
+			bool
+			Scene::areColliding(::rl::sg::Shape* first, ::rl::sg::Shape* second)
+			{
+				Shape* shape1 = static_cast<Shape*>(first);
+				Shape* shape2 = static_cast<Shape*>(second);
+				Body* body1 = static_cast<Body*>(shape1->getBody());
+				Body* body2 = static_cast<Body*>(shape2->getBody());
+				
+				if (!this->areColliding(body1, shape1->offset, shape1->getNumCapsules(), body2, shape2->offset, shape2->getNumCapsules()))
+				{
+					return false;
+				}
+				
+				if (nullptr != this->exact && nullptr != body1->exact && nullptr != body2->exact)
+				{
+					::std::size_t i1 = ::std::find(body1->begin(), body1->end(), first) - body1->begin();
+					::std::size_t i2 = ::std::find(body2->begin(), body2->end(), second) - body2->begin();
+					return this->exact->areColliding(body1->exact->getShape(i1), body2->exact->getShape(i2));
+				}
+				
+				return true;
+			}
+			
+			void
+			Scene::closest(const ::rl::math::Vector3& from, const ::rl::math::Vector3& direction, const Body* body, const ::std::size_t& offset, const ::std::size_t& size)
+			{
+				// closest points of segments, Ericson, Real-Time Collision Detection, 2005, section 5.1.9
+				
+				this->scratch.reserve(size);
+				
+				::Eigen::Ref<const ::rl::math::ArrayX> dx = body->direction.col(0).segment(offset, size);
+				::Eigen::Ref<const ::rl::math::ArrayX> dy = body->direction.col(1).segment(offset, size);
+				::Eigen::Ref<const ::rl::math::ArrayX> dz = body->direction.col(2).segment(offset, size);
+				
+				::Eigen::Ref<::rl::math::ArrayX> b = this->scratch.b.head(size);
+				::Eigen::Ref<::rl::math::ArrayX> c = this->scratch.c.head(size);
+				::Eigen::Ref<::rl::math::ArrayX> denominator = this->scratch.denominator.head(size);
+				::Eigen::Ref<::rl::math::ArrayX> distance2 = this->scratch.distance2.head(size);
+				::Eigen::Ref<::rl::math::ArrayX> e = this->scratch.e.head(size);
+				::Eigen::Ref<::rl::math::ArrayX> f = this->scratch.f.head(size);
+				::Eigen::Ref<::rl::math::ArrayX> rx = this->scratch.rx.head(size);
+				::Eigen::Ref<::rl::math::ArrayX> ry = this->scratch.ry.head(size);
+				::Eigen::Ref<::rl::math::ArrayX> rz = this->scratch.rz.head(size);
+				::Eigen::Ref<::rl::math::ArrayX> s = this->scratch.s.head(size);
+				::Eigen::Ref<::rl::math::ArrayX> t = this->scratch.t.head(size);
+				
+				rx = from.x() - body->from.col(0).segment(offset, size);
+				ry = from.y() - body->from.col(1).segment(offset, size);
+				rz = from.z() - body->from.col(2).segment(offset, size);
+				
+				::rl::math::Real a = direction.squaredNorm();
+				b = direction.x() * dx + direction.y() * dy + direction.z() * dz;
+				c = direction.x() * rx + direction.y() * ry + direction.z() * rz;
+				e = dx.square() + dy.square() + dz.square();
+				f = dx * rx + dy * ry + dz * rz;
+				
+				::rl::math::Real epsilon = ::std::numeric_limits<::rl::math::Real>::epsilon();
+				
+				if (a > epsilon)
+				{
+					denominator = a * e - b.square();
+					s = (denominator > epsilon * a * e).select(((b * f - c * e) / denominator).max(0).min(1), 0);
+					t = (b * s + f) / e;
+					s = (t < 0).select((-c / a).max(0).min(1), (t > 1).select(((b - c) / a).max(0).min(1), s));
+					t = (e > epsilon).select(t.max(0).min(1), 0);
+					s = (e > epsilon).select(s, (-c / a).max(0).min(1));
+				}
+				else
+				{
+					s.setZero();
+					t = (e > epsilon).select((f / e).max(0).min(1), 0);
+				}
+				
+				distance2 = (rx + direction.x() * s - dx * t).square() + (ry + direction.y() * s - dy * t).square() + (rz + direction.z() * s - dz * t).square();
+			}
+			
+			::rl::sg::Model*
+			Scene::create()
+			{
+				return new Model(this);
+			}
+			
+			::rl::math::Real
+			Scene::distance(::rl::sg::Body* first, ::rl::sg::Body* second, ::rl::math::Vector3& point1, ::rl::math::Vector3& point2)
+			{
+				Body* body1 = static_cast<Body*>(first);
+				Body* body2 = static_cast<Body*>(second);
+				
+				return this->distance(body1, 0, body1->radius.size(), body2, 0, body2->radius.size(), point1, point2);
+			}
+			
+			::rl::math::Real
+			Scene::distance(const Body* body1, const ::std::size_t& offset1, const ::std::size_t& size1, const Body* body2, const ::std::size_t& offset2, const ::std::size_t& size2, ::rl::math::Vector3& point1, ::rl::math::Vector3& point2)
+			{
+				::rl::math::Real distance = ::std::numeric_limits<::rl::math::Real>::infinity();
+				
+				if (0 == size1 || 0 == size2)
+				{
+					return distance;
+				}
+				
+				::std::size_t i1 = offset1;
+				::std::size_t i2 = offset2;
+				::rl::math::Real s1 = 0;
+				::rl::math::Real t2 = 0;
+				
+				for (::std::size_t i = offset1; i < offset1 + size1; ++i)
+				{
+					this->closest(body1->from.row(i).transpose().matrix(), body1->direction.row(i).transpose().matrix(), body2, offset2, size2);
+					
+					::std::ptrdiff_t j;
+					::rl::math::Real d = (this->scratch.distance2.head(size2).sqrt() - body2->radius.segment(offset2, size2)).minCoeff(&j) - body1->radius(i);
+					
+					if (d < distance)
+					{
+						distance = d;
+						i1 = i;
+						i2 = offset2 + j;
+						s1 = this->scratch.s(j);
+						t2 = this->scratch.t(j);
+					}
+				}
+				
+				if (::std::numeric_limits<::rl::math::Real>::infinity() == distance)
+				{
+					return distance;
+				}
+				
+				::rl::math::Vector3 center1 = (body1->from.row(i1) + s1 * body1->direction.row(i1)).transpose().matrix();
+				::rl::math::Vector3 center2 = (body2->from.row(i2) + t2 * body2->direction.row(i2)).transpose().matrix();
+				::rl::math::Vector3 normal = center2 - center1;
+				
+				if (normal.norm() > ::std::numeric_limits<::rl::math::Real>::epsilon())
+				{
+					normal.normalize();
+				}
+				
+				point1 = center1 + body1->radius(i1) * normal;
+				point2 = center2 - body2->radius(i2) * normal;
+				
+				return ::std::max(static_cast<::rl::math::Real>(0), distance);
+			}
+			
+			::rl::math::Real
+			Scene::distance(::rl::sg::Shape* first, ::rl::sg::Shape* second, ::rl::math::Vector3& point1, ::rl::math::Vector3& point2)
+			{
+				Shape* shape1 = static_cast<Shape*>(first);
+				Shape* shape2 = static_cast<Shape*>(second);
+				
+				return this->distance(
+					static_cast<Body*>(shape1->getBody()),
+					shape1->offset,
+					shape1->getNumCapsules(),
+					static_cast<Body*>(shape2->getBody()),
+					shape2->offset,
+					shape2->getNumCapsules(),
+					point1,
+					point2
+				);
+			}
+			
+			::rl::math::Real
+			Scene::distance(::rl::sg::Shape* shape, const ::rl::math::Vector3& point, ::rl::math::Vector3& point1, ::rl::math::Vector3& point2)
+			{
+				Shape* shape1 = static_cast<Shape*>(shape);
+				Body* body1 = static_cast<Body*>(shape1->getBody());
+				
+				if (0 == shape1->getNumCapsules())
+				{
+					return ::std::numeric_limits<::rl::math::Real>::infinity();
+				}
+				
+				this->closest(point, ::rl::math::Vector3::Zero(), body1, shape1->offset, shape1->getNumCapsules());
+				
+				::std::ptrdiff_t j;
+				::rl::math::Real distance = (this->scratch.distance2.head(shape1->getNumCapsules()).sqrt() - body1->radius.segment(shape1->offset, shape1->getNumCapsules())).minCoeff(&j);
+				
+				::rl::math::Vector3 center = (body1->from.row(shape1->offset + j) + this->scratch.t(j) * body1->direction.row(shape1->offset + j)).transpose().matrix();
+				::rl::math::Vector3 normal = point - center;
+				
+				if (normal.norm() > ::std::numeric_limits<::rl::math::Real>::epsilon())
+				{
+					normal.normalize();
+				}
+				
+				point1 = center + body1->radius(shape1->offset + j) * normal;
+				point2 = point;
+				
+				return ::std::max(static_cast<::rl::math::Real>(0), distance);
+			}
+			
+			::rl::sg::SimpleScene*
+			Scene::getExact() const
+			{
+				return this->exact;
+			}
+			
+			bool
+			Scene::isScalingSupported() const
+			{
+				return false;
+			}
+			
+			void
+			Scene::setExact(::rl::sg::SimpleScene* exact)
+			{
+				if (nullptr != exact)
+				{
+					if (exact->getNumModels() != this->getNumModels())
+					{
+						throw Exception("rl::sg::ssv::Scene::setExact() - number of models differs");
+					}
+					
+					for (::std::size_t i = 0; i < this->getNumModels(); ++i)
+					{
+						if (exact->getModel(i)->getNumBodies() != this->getModel(i)->getNumBodies())
+						{
+							throw Exception("rl::sg::ssv::Scene::setExact() - number of bodies differs");
+						}
+					}
+				}
+				
+				this->exact = exact;
+				
+				for (::std::size_t i = 0; i < this->getNumModels(); ++i)
+				{
+					for (::std::size_t j = 0; j < this->getModel(i)->getNumBodies(); ++j)
+					{
+						Body* body = static_cast<Body*>(this->getModel(i)->getBody(j));
+						body->exact = nullptr != exact ? exact->getModel(i)->getBody(j) : nullptr;
+						
+						if (nullptr != body->exact)
+						{
+							body->exact->setFrame(body->frame);
+						}
+					}
+				}
+			}
+			
+			Scene::Scratch::Scratch() :
+				b(),
+				c(),
+				denominator(),
+				distance2(),
+				e(),
+				f(),
+				rx(),
+				ry(),
+				rz(),
+				s(),
+				t()
+			{
+			}
+			
+			void
+			Scene::Scratch::reserve(const ::std::size_t& size)
+			{
+				if (this->s.size() < static_cast<::Eigen::Index>(size))
+				{
+					this->b.resize(size);
+					this->c.resize(size);
+					this->denominator.resize(size);
+					this->distance2.resize(size);
+					this->e.resize(size);
+					this->f.resize(size);
+					this->rx.resize(size);
+					this->ry.resize(size);
+					this->rz.resize(size);
+					this->s.resize(size);
+					this->t.resize(size);
+				}
+			}
+		}
+	}
+}
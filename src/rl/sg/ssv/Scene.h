@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_SG_SSV_SCENE_H
+#define RL_SG_SSV_SCENE_H
+
+#include <rl/math/Array.h>
+
+#include "../DistanceScene.h"
+#include "../SimpleScene.h"
+
+namespace rl
+{
+	namespace sg
+	{
+		/**
+		 * Swept sphere volumes.
+		 *
+		 * Built-in backend without external dependencies that encloses every
+		 * shape in a small set of spheres and capsules. Collision checks are
+		 * conservative and distances are lower bounds of the exact values, so
+		 * the scene can serve as a fast first-pass filter for planning.
+		 *
+		 * An exact scene loaded from the same file can be attached with
+		 * setExact(), to which collision checks between bodies or shapes fall
+		 * back whenever their capsules overlap.
+		 */
+		namespace ssv
+		{
+			class Body;
+			
+			class RL_SG_EXPORT Scene : public ::rl::sg::DistanceScene, public ::rl::sg::SimpleScene
+			{
+			public:
+				Scene();
+				
+				virtual ~Scene();
+				
+				using ::rl::sg::SimpleScene::areColliding;
+				
+				bool areColliding(::rl::sg::Body* first, ::rl::sg::Body* second);
+				
+				bool areColliding(::rl::sg::Shape* first, ::rl::sg::Shape* second);
+				
+				::rl::sg::Model* create();
+				
+				using ::rl::sg::DistanceScene::distance;
+				
+				::rl::math::Real distance(::rl::sg::Body* first, ::rl::sg::Body* second, ::rl::math::Vector3& point1, ::rl::math::Vector3& point2);
+				
+				::rl::math::Real distance(::rl::sg::Shape* first, ::rl::sg::Shape* second, ::rl::math::Vector3& point1, ::rl::math::Vector3& point2);
+				
+				::rl::math::Real distance(::rl::sg::Shape* shape, const ::rl::math::Vector3& point, ::rl::math::Vector3& point1, ::rl::math::Vector3& point2);
+				
+				::rl::sg::SimpleScene* getExact() const;
+				
+				bool isScalingSupported() const;
+				
+				/**
+				 * Attach an exact scene loaded from the same file.
+				 *
+				 * Bodies are matched by their indices, the frames of all bodies
+				 * are forwarded to their counterparts from then on.
+				 */
+				void setExact(::rl::sg::SimpleScene* exact);
+				
+				/**
+				 * Maximum number of times a non-convex triangle mesh is split in half.
+				 *
+				 * Shapes loaded afterwards are enclosed by up to 2^subdivisions
+				 * capsules.
+				 */
+				::std::size_t subdivisions;
+				
+			protected:
+				
+			private:
+				/**
+				 * Preallocated arrays for closest(), grown to the largest number of
+				 * capsules queried so far and accessed through their heads.
+				 */
+				struct Scratch
+				{
+					Scratch();
+					
+					void reserve(const ::std::size_t& size);
+					
+					::rl::math::ArrayX b;
+					
+					::rl::math::ArrayX c;
+					
+					::rl::math::ArrayX denominator;
+					
+					::rl::math::ArrayX distance2;
+					
+					::rl::math::ArrayX e;
+					
+					::rl::math::ArrayX f;
+					
+					::rl::math::ArrayX rx;
+					
+					::rl::math::ArrayX ry;
+					
+					::rl::math::ArrayX rz;
+					
+					::rl::math::ArrayX s;
+					
+					::rl::math::ArrayX t;
+				};
+				
+				bool areColliding(const Body* body1, const ::std::size_t& offset1, const ::std::size_t& size1, const Body* body2, const ::std::size_t& offset2, const ::std::size_t& size2);
+				
+				/**
+				 * Closest points of a segment and size capsule segments of body.
+				 *
+				 * Results are written to the first size elements of scratch.s,
+				 * scratch.t, and scratch.distance2.
+				 */
+				void closest(const ::rl::math::Vector3& from, const ::rl::math::Vector3& direction, const Body* body, const ::std::size_t& offset, const ::std::size_t& size);
+				
+				::rl::math::Real distance(const Body* body1, const ::std::size_t& offset1, const ::std::size_t& size1, const Body* body2, const ::std::size_t& offset2, const ::std::size_t& size2, ::rl::math::Vector3& point1, ::rl::math::Vector3& point2);
+				
+				::rl::sg::SimpleScene* exact;
+				
+				Scratch scratch;
+			};
+		}
+	}
+}
+
+#endif // RL_SG_SSV_SCENE_H
@@ -0,0 +1,289 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <limits>
+#include <Eigen/Eigenvalues>
+#include <Inventor/SoPrimitiveVertex.h>
+#include <Inventor/VRMLnodes/SoVRMLBox.h>
+#include <Inventor/VRMLnodes/SoVRMLCone.h>
+#include <Inventor/VRMLnodes/SoVRMLCylinder.h>
+#include <Inventor/VRMLnodes/SoVRMLGeometry.h>
+#include <Inventor/VRMLnodes/SoVRMLIndexedFaceSet.h>
+#include <Inventor/VRMLnodes/SoVRMLSphere.h>
+#include <rl/math/Constants.h>
+
+#include "../Exception.h"
+#include "Body.h"
+#include "Model.h"
+#include "Scene.h"
+#include "Shape.h"
+
+namespace rl
+{
+	namespace sg
+	{
+		namespace ssv
+		{
+			Shape::Shape(::SoVRMLShape* shape, Body* body) :
+				::rl::sg::Shape(body),
+				direction(::rl::math::Matrix::Zero(3, 1)),
+				from(::rl::math::Matrix::Zero(3, 1)),
+				offset(0),
+				radius(::rl::math::ArrayX::Zero(1)),
+				transform(::rl::math::Transform::Identity())
+			{
+				::SoVRMLGeometry* geometry = static_cast<::SoVRMLGeometry*>(shape->geometry.getValue());
+				
+				if (geometry->isOfType(::SoVRMLBox::getClassTypeId()))
+				{
+					::SoVRMLBox* box = static_cast<::SoVRMLBox*>(geometry);
+					::rl::math::Vector3 size(box->size.getValue()[0], box->size.getValue()[1], box->size.getValue()[2]);
+					::std::ptrdiff_t axis;
+					size.maxCoeff(&axis);
+					this->direction(axis, 0) = size(axis);
+					this->from(axis, 0) = -size(axis) / 2;
+					this->radius(0) = ::std::sqrt(::std::max(static_cast<::rl::math::Real>(0), size.squaredNorm() - size(axis) * size(axis))) / 2;
+				}
+				else if (geometry->isOfType(::SoVRMLCone::getClassTypeId()) || geometry->isOfType(::SoVRMLCylinder::getClassTypeId()))
+				{
+					::rl::math::Real height;
+					::rl::math::Real bottomRadius;
+					
+					if (geometry->isOfType(::SoVRMLCone::getClassTypeId()))
+					{
+						height = static_cast<::SoVRMLCone*>(geometry)->height.getValue();
+						bottomRadius = static_cast<::SoVRMLCone*>(geometry)->bottomRadius.getValue();
+					}
+					else
+					{
+						height = static_cast<::SoVRMLCylinder*>(geometry)->height.getValue();
+						bottomRadius = static_cast<::SoVRMLCylinder*>(geometry)->radius.getValue();
+					}
+					
+					// capsule along the axis or enclosing sphere, whichever is smaller
+					
+					if (bottomRadius < height)
+					{
+						this->direction(1, 0) = height;
+						this->from(1, 0) = -height / 2;
+						this->radius(0) = bottomRadius;
+					}
+					else
+					{
+						this->radius(0) = ::std::sqrt(bottomRadius * bottomRadius + height * height / 4);
+					}
+				}
+				else if (geometry->isOfType(::SoVRMLSphere::getClassTypeId()))
+				{
+					this->radius(0) = static_cast<::SoVRMLSphere*>(geometry)->radius.getValue();
+				}
+				else
+				{
+					::std::vector<::rl::math::Matrix33> triangles;
+					
+					::SoCallbackAction callbackAction;
+					callbackAction.addTriangleCallback(geometry->getTypeId(), Shape::triangleCallback, &triangles);
+					callbackAction.apply(geometry);
+					
+					if (triangles.empty())
+					{
+						throw Exception("rl::sg::ssv::Shape() - geometry not supported");
+					}
+					
+					::std::vector<::rl::math::Vector3> from;
+					::std::vector<::rl::math::Vector3> direction;
+					::std::vector<::rl::math::Real> radius;
+					
+					// a single capsule encloses the convex hull, split capsules only enclose the surface
+					
+					::std::size_t subdivisions = dynamic_cast<Scene*>(body->getModel()->getScene())->subdivisions;
+					
+					if (geometry->isOfType(::SoVRMLIndexedFaceSet::getClassTypeId()) && static_cast<::SoVRMLIndexedFaceSet*>(geometry)->convex.getValue())
+					{
+						subdivisions = 0;
+					}
+					
+					this->fit(triangles.begin(), triangles.end(), subdivisions, from, direction, radius);
+					
+					this->direction.resize(3, direction.size());
+					this->from.resize(3, from.size());
+					this->radius.resize(radius.size());
+					
+					for (::std::size_t i = 0; i < radius.size(); ++i)
+					{
+						this->direction.col(i) = direction[i];
+						this->from.col(i) = from[i];
+						this->radius(i) = radius[i];
+					}
+				}
+				
+				this->getBody()->add(this);
+			}
+			
+			Shape::~Shape()
+			{
+				this->getBody()->remove(this);
+			}
+			
+			::rl::math::Real
+			Shape::fit(::std::vector<::rl::math::Matrix33>::iterator first, ::std::vector<::rl::math::Matrix33>::iterator last, const ::std::size_t& subdivisions, ::std::vector<::rl::math::Vector3>& from, ::std::vector<::rl::math::Vector3>& direction, ::std::vector<::rl::math::Real>& radius) const
+			{
+				// principal axis of all vertices
+				
+				::rl::math::Vector3 mean = ::rl::math::Vector3::Zero();
+				
+				for (::std::vector<::rl::math::Matrix33>::iterator i = first; i != last; ++i)
+				{
+					mean += i->rowwise().sum();
+				}
+				
+				mean /= static_cast<::rl::math::Real>(3 * (last - first));
+				
+				::rl::math::Matrix33 covariance = ::rl::math::Matrix33::Zero();
+				
+				for (::std::vector<::rl::math::Matrix33>::iterator i = first; i != last; ++i)
+				{
+					for (::std::size_t j = 0; j < 3; ++j)
+					{
+						covariance += (i->col(j) - mean) * (i->col(j) - mean).transpose();
+					}
+				}
+				
+				::Eigen::SelfAdjointEigenSolver<::rl::math::Matrix33> solver(covariance);
+				::rl::math::Vector3 axis = solver.eigenvectors().col(2);
+				
+				// smallest radius enclosing all vertices around the axis
+				
+				::rl::math::Real radius2 = 0;
+				
+				for (::std::vector<::rl::math::Matrix33>::iterator i = first; i != last; ++i)
+				{
+					for (::std::size_t j = 0; j < 3; ++j)
+					{
+						::rl::math::Real s = axis.dot(i->col(j) - mean);
+						radius2 = ::std::max(radius2, (i->col(j) - mean).squaredNorm() - s * s);
+					}
+				}
+				
+				// shortest segment with every vertex inside one of the spheres along it
+				
+				::rl::math::Real lower = ::std::numeric_limits<::rl::math::Real>::infinity();
+				::rl::math::Real upper = -::std::numeric_limits<::rl::math::Real>::infinity();
+				
+				for (::std::vector<::rl::math::Matrix33>::iterator i = first; i != last; ++i)
+				{
+					for (::std::size_t j = 0; j < 3; ++j)
+					{
+						::rl::math::Real s = axis.dot(i->col(j) - mean);
+						::rl::math::Real h = ::std::sqrt(::std::max(static_cast<::rl::math::Real>(0), radius2 - ((i->col(j) - mean).squaredNorm() - s * s)));
+						lower = ::std::min(lower, s + h);
+						upper = ::std::max(upper, s - h);
+					}
+				}
+				
+				if (lower > upper)
+				{
+					::std::swap(lower, upper);
+				}
+				
+				::rl::math::Real volume = ::rl::math::constants::pi * radius2 * (upper - lower + 4 * ::std::sqrt(radius2) / 3);
+				
+				// split at the median triangle along the axis if the halves enclose less volume
+				
+				if (subdivisions > 0 && last - first > 1)
+				{
+					::std::vector<::rl::math::Matrix33>::iterator middle = first + (last - first) / 2;
+					
+					::std::nth_element(
+						first,
+						middle,
+						last,
+						[&axis](const ::rl::math::Matrix33& a, const ::rl::math::Matrix33& b)
+						{
+							return axis.dot(a.rowwise().sum()) < axis.dot(b.rowwise().sum());
+						}
+					);
+					
+					::std::vector<::rl::math::Vector3> childFrom;
+					::std::vector<::rl::math::Vector3> childDirection;
+					::std::vector<::rl::math::Real> childRadius;
+					
+					::rl::math::Real childVolume = this->fit(first, middle, subdivisions - 1, childFrom, childDirection, childRadius);
+					childVolume += this->fit(middle, last, subdivisions - 1, childFrom, childDirection, childRadius);
+					
+					if (childVolume < volume)
+					{
+						from.insert(from.end(), childFrom.begin(), childFrom.end());
+						direction.insert(direction.end(), childDirection.begin(), childDirection.end());
+						radius.insert(radius.end(), childRadius.begin(), childRadius.end());
+						return childVolume;
+					}
+				}
+				
+				from.push_back(mean + lower * axis);
+				direction.push_back((upper - lower) * axis);
+				radius.push_back(::std::sqrt(radius2));
+				
+				return volume;
+			}
+			
+			::std::size_t
+			Shape::getNumCapsules() const
+			{
+				return this->radius.size();
+			}
+			
+			::rl::math::Transform
+			Shape::getTransform() const
+			{
+				return this->transform;
+			}
+			
+			void
+			Shape::setTransform(const ::rl::math::Transform& transform)
+			{
+				this->transform = transform;
+				
+				static_cast<Body*>(this->getBody())->update();
+			}
+			
+			void
+			Shape::triangleCallback(void* userData, ::SoCallbackAction* action, const ::SoPrimitiveVertex* v1, const ::SoPrimitiveVertex* v2, const ::SoPrimitiveVertex* v3)
+			{
+				::std::vector<::rl::math::Matrix33>* triangles = static_cast<::std::vector<::rl::math::Matrix33>*>(userData);
+				
+				::rl::math::Matrix33 triangle;
+				triangle <<
+					v1->getPoint()[0], v2->getPoint()[0], v3->getPoint()[0],
+					v1->getPoint()[1], v2->getPoint()[1], v3->getPoint()[1],
+					v1->getPoint()[2], v2->getPoint()[2], v3->getPoint()[2];
+				
+				triangles->push_back(triangle);
+			}
+		}
+	}
+}
@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_SG_SSV_SHAPE_H
+#define RL_SG_SSV_SHAPE_H
+
+#include <vector>
+#include <Inventor/actions/SoCallbackAction.h>
+#include <Inventor/VRMLnodes/SoVRMLShape.h>
+#include <rl/math/Array.h>
+#include <rl/math/Matrix.h>
+
+#include "../Shape.h"
+
+namespace rl
+{
+	namespace sg
+	{
+		namespace ssv
+		{
+			class Body;
+			
+			/**
+			 * Shape approximated by a set of capsules.
+			 *
+			 * Spheres are represented exactly. Boxes, cones, and cylinders are
+			 * enclosed in a single capsule along their longest axis. Convex
+			 * triangle meshes are enclosed in a single capsule along their
+			 * principal axis. The surface of non-convex meshes is enclosed in
+			 * capsules that are split at the median triangle as long as this
+			 * reduces the enclosed volume.
+			 */
+			class RL_SG_EXPORT Shape : public ::rl::sg::Shape
+			{
+			public:
+				EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+				
+				Shape(::SoVRMLShape* shape, Body* body);
+				
+				virtual ~Shape();
+				
+				::std::size_t getNumCapsules() const;
+				
+				using ::rl::sg::Shape::getTransform;
+				
+				::rl::math::Transform getTransform() const;
+				
+				void setTransform(const ::rl::math::Transform& transform);
+				
+				/** Segment directions in shape coordinates, one column per capsule. */
+				::rl::math::Matrix direction;
+				
+				/** Segment start points in shape coordinates, one column per capsule. */
+				::rl::math::Matrix from;
+				
+				/** Index of the first capsule in the arrays of the body. */
+				::std::size_t offset;
+				
+				/** Capsule radii. */
+				::rl::math::ArrayX radius;
+				
+			protected:
+				
+			private:
+				::rl::math::Real fit(::std::vector<::rl::math::Matrix33>::iterator first, ::std::vector<::rl::math::Matrix33>::iterator last, const ::std::size_t& subdivisions, ::std::vector<::rl::math::Vector3>& from, ::std::vector<::rl::math::Vector3>& direction, ::std::vector<::rl::math::Real>& radius) const;
+				
+				static void triangleCallback(void* userData, ::SoCallbackAction* action, const ::SoPrimitiveVertex* v1, const ::SoPrimitiveVertex* v2, const ::SoPrimitiveVertex* v3);
+				
+				::rl::math::Transform transform;
+			};
+		}
+	}
+}
+
+#endif // RL_SG_SSV_SHAPE_H
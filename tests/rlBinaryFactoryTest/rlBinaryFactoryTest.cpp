@@ -0,0 +1,309 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <rl/sg/BinaryFactory.h>
+#include <rl/sg/Body.h>
+#include <rl/sg/Model.h>
+#include <rl/sg/Shape.h>
+#include <rl/sg/XmlFactory.h>
+#include <rl/sg/so/Scene.h>
+
+#include "../createScene.h"
+
+bool
+equals(rl::sg::Scene& scene1, rl::sg::Scene& scene2)
+{
+	if (scene1.getNumModels() != scene2.getNumModels())
+	{
+		std::cerr << "rlBinaryFactoryTest: Number of models differs." << std::endl;
+		return false;
+	}
+	
+	for (std::size_t i = 0; i < scene1.getNumModels(); ++i)
+	{
+		rl::sg::Model* model1 = scene1.getModel(i);
+		rl::sg::Model* model2 = scene2.getModel(i);
+		
+		if (model1->getName() != model2->getName() || model1->getNumBodies() != model2->getNumBodies())
+		{
+			std::cerr << "rlBinaryFactoryTest: Model " << i << " differs." << std::endl;
+			return false;
+		}
+		
+		for (std::size_t j = 0; j < model1->getNumBodies(); ++j)
+		{
+			rl::sg::Body* body1 = model1->getBody(j);
+			rl::sg::Body* body2 = model2->getBody(j);
+			
+			if (
+				body1->getName() != body2->getName() ||
+				!body1->getFrame().matrix().isApprox(body2->getFrame().matrix()) ||
+				!body1->center.isApprox(body2->center) ||
+				!body1->min.isApprox(body2->min) ||
+				!body1->max.isApprox(body2->max) ||
+				body1->points.size() != body2->points.size() ||
+				body1->getNumShapes() != body2->getNumShapes()
+			)
+			{
+				std::cerr << "rlBinaryFactoryTest: Body " << j << " of model " << i << " differs." << std::endl;
+				return false;
+			}
+			
+			for (std::size_t k = 0; k < body1->points.size(); ++k)
+			{
+				if (!body1->points[k].isApprox(body2->points[k]))
+				{
+					std::cerr << "rlBinaryFactoryTest: Point " << k << " of body " << j << " of model " << i << " differs." << std::endl;
+					return false;
+				}
+			}
+			
+			for (std::size_t k = 0; k < body1->getNumShapes(); ++k)
+			{
+				rl::sg::Shape* shape1 = body1->getShape(k);
+				rl::sg::Shape* shape2 = body2->getShape(k);
+				
+				if (shape1->getName() != shape2->getName() || !shape1->getTransform().matrix().isApprox(shape2->getTransform().matrix()))
+				{
+					std::cerr << "rlBinaryFactoryTest: Shape " << k << " of body " << j << " of model " << i << " differs." << std::endl;
+					return false;
+				}
+			}
+		}
+	}
+	
+	return true;
+}
+
+std::string
+read(const std::string& filename)
+{
+	std::ifstream file(filename.c_str(), std::ios::binary);
+	
+	if (!file)
+	{
+		throw std::runtime_error("Could not read " + filename);
+	}
+	
+	return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void
+write(const std::string& filename, const std::string& contents)
+{
+	std::ofstream file(filename.c_str(), std::ios::binary);
+	file << contents;
+	
+	if (!file)
+	{
+		throw std::runtime_error("Could not write " + filename);
+	}
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: rlBinaryFactoryTest SCENEFILE" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		// round trip of given scene
+		
+		rl::sg::BinaryFactory binaryFactory;
+		binaryFactory.save(argv[1], "rlBinaryFactoryTest.cache");
+		
+		if (!rl::sg::BinaryFactory::isCurrent("rlBinaryFactoryTest.cache"))
+		{
+			std::cerr << "rlBinaryFactoryTest: Saved file is not current." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		rl::sg::so::Scene binaryScene;
+		binaryFactory.load("rlBinaryFactoryTest.cache", &binaryScene, true, true);
+		
+		rl::sg::so::Scene xmlScene;
+		rl::sg::XmlFactory xmlFactory;
+		xmlFactory.load(argv[1], &xmlScene, true, true);
+		
+		if (!equals(xmlScene, binaryScene))
+		{
+			return EXIT_FAILURE;
+		}
+		
+		// modified file included via VRML Inline node
+		
+		write(
+			"rlBinaryFactoryTest.xml",
+			"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+			"<rlsg>\n"
+			"\t<scene href=\"rlBinaryFactoryTest.wrl\">\n"
+			"\t\t<model name=\"model\">\n"
+			"\t\t\t<body name=\"body\"/>\n"
+			"\t\t</model>\n"
+			"\t</scene>\n"
+			"</rlsg>\n"
+		);
+		
+		write(
+			"rlBinaryFactoryTest.wrl",
+			"#VRML V2.0 utf8\n"
+			"DEF model Transform {\n"
+			"\tchildren [\n"
+			"\t\tDEF body Transform {\n"
+			"\t\t\tchildren [\n"
+			"\t\t\t\tInline {\n"
+			"\t\t\t\t\turl \"rlBinaryFactoryTestInline.wrl\"\n"
+			"\t\t\t\t}\n"
+			"\t\t\t]\n"
+			"\t\t}\n"
+			"\t]\n"
+			"}\n"
+		);
+		
+		write("rlBinaryFactoryTestInline.wrl", "#VRML V2.0 utf8\nShape {\n\tgeometry Box {\n\t\tsize 1 1 1\n\t}\n}\n");
+		
+		binaryFactory.save("rlBinaryFactoryTest.xml", "rlBinaryFactoryTest.xml.cache");
+		
+		if (!rl::sg::BinaryFactory::isCurrent("rlBinaryFactoryTest.xml.cache"))
+		{
+			std::cerr << "rlBinaryFactoryTest: Saved file is not current." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		rl::sg::so::Scene inlineScene;
+		binaryFactory.load("rlBinaryFactoryTest.xml.cache", &inlineScene, true, false);
+		
+		if (1 != inlineScene.getNumModels() || 1 != inlineScene.getModel(0)->getNumBodies() || 1 != inlineScene.getModel(0)->getBody(0)->getNumShapes())
+		{
+			std::cerr << "rlBinaryFactoryTest: Shape of inline file missing." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		// size differs, so that the change is detected within the same second
+		write("rlBinaryFactoryTestInline.wrl", "#VRML V2.0 utf8\nShape {\n\tgeometry Box {\n\t\tsize 2.5 2.5 2.5\n\t}\n}\n");
+		
+		if (rl::sg::BinaryFactory::isCurrent("rlBinaryFactoryTest.xml.cache"))
+		{
+			std::cerr << "rlBinaryFactoryTest: Modified inline file not detected." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		// unreadable files
+		
+		write("rlBinaryFactoryTestEmpty.cache", "");
+		
+		if (rl::sg::BinaryFactory::isCurrent("rlBinaryFactoryTestEmpty.cache"))
+		{
+			std::cerr << "rlBinaryFactoryTest: Empty file is current." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		std::string contents = read("rlBinaryFactoryTest.cache");
+		write("rlBinaryFactoryTestTruncated.cache", contents.substr(0, contents.size() / 2));
+		
+		if (rl::sg::BinaryFactory::isCurrent("rlBinaryFactoryTestTruncated.cache"))
+		{
+			std::cerr << "rlBinaryFactoryTest: Truncated file is current." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		// cache picked up by XmlFactory, body of description itself has no shapes
+		
+		const char* engines[] = {"bullet", "fcl", "ode", "pqp", "solid", "ssv"};
+		std::string engine;
+		
+		for (std::size_t i = 0; i < sizeof(engines) / sizeof(engines[0]) && engine.empty(); ++i)
+		{
+			if (nullptr != createScene(engines[i]))
+			{
+				engine = engines[i];
+			}
+		}
+		
+		if (engine.empty())
+		{
+			std::cout << "rlBinaryFactoryTest: No collision engine, XmlFactory cache not tested." << std::endl;
+		}
+		else
+		{
+			write(
+				"rlBinaryFactoryTestCached.xml",
+				"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+				"<rlsg>\n"
+				"\t<scene href=\"rlBinaryFactoryTestCached.wrl\">\n"
+				"\t\t<model name=\"model\">\n"
+				"\t\t\t<body name=\"body\"/>\n"
+				"\t\t</model>\n"
+				"\t</scene>\n"
+				"</rlsg>\n"
+			);
+			
+			write("rlBinaryFactoryTestCached.wrl", "#VRML V2.0 utf8\nDEF model Transform {\n\tchildren [\n\t\tDEF body Transform {\n\t\t}\n\t]\n}\n");
+			
+			binaryFactory.save("rlBinaryFactoryTest.xml", "rlBinaryFactoryTestCached.xml.cache");
+			
+			std::shared_ptr<rl::sg::Scene> currentScene = createScene(engine);
+			xmlFactory.load("rlBinaryFactoryTestCached.xml", currentScene.get());
+			
+			if (1 != currentScene->getNumModels() || 1 != currentScene->getModel(0)->getNumBodies() || 1 != currentScene->getModel(0)->getBody(0)->getNumShapes())
+			{
+				std::cerr << "rlBinaryFactoryTest: Current cache not used by XmlFactory." << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			write("rlBinaryFactoryTestInline.wrl", "#VRML V2.0 utf8\nShape {\n\tgeometry Box {\n\t\tsize 4 4 4\n\t}\n}\n");
+			
+			std::shared_ptr<rl::sg::Scene> staleScene = createScene(engine);
+			xmlFactory.load("rlBinaryFactoryTestCached.xml", staleScene.get());
+			
+			if (1 != staleScene->getNumModels() || 1 != staleScene->getModel(0)->getNumBodies() || 0 != staleScene->getModel(0)->getBody(0)->getNumShapes())
+			{
+				std::cerr << "rlBinaryFactoryTest: Stale cache used by XmlFactory." << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "rlBinaryFactoryTest: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	std::cout << "rlBinaryFactoryTest: Binary file matches XML scene." << std::endl;
+	
+	return EXIT_SUCCESS;
+}
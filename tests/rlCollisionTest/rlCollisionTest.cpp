@@ -28,6 +28,7 @@
 #include <memory>
 #include <random>
 #include <stdexcept>
+#include <vector>
 #include <boost/lexical_cast.hpp>
 
 #include <rl/math/Constants.h>
@@ -161,6 +162,19 @@ main(int argc, char** argv)
 	
 	std::cout << "Loading done." << std::endl;
 	
+	std::vector<std::vector<rl::math::Transform>> frames(scenes.size());
+	
+	for (std::size_t i = 0; i < scenes.size(); ++i)
+	{
+		for (std::size_t m = 1; m < scenes[i]->getNumModels(); ++m)
+		{
+			for (std::size_t b = 0; b < scenes[i]->getModel(m)->getNumBodies(); ++b)
+			{
+				frames[i].push_back(scenes[i]->getModel(m)->getBody(b)->getFrame());
+			}
+		}
+	}
+	
 	for (std::size_t i = 0; i < scenes.size(); ++i)
 	{
 		std::cout << "Testing SimpleScene::isColliding() in " << sceneNames[i] << ": ";
@@ -169,6 +183,7 @@ main(int argc, char** argv)
 	
 	std::mt19937 randomGenerator(0);
 	std::uniform_real_distribution<rl::math::Real> randomDistribution(-180 * rl::math::constants::deg2rad, 180 * rl::math::constants::deg2rad);
+	std::uniform_real_distribution<rl::math::Real> offsetDistribution(-0.25, 0.25);
 		
 	std::size_t j;
 	for (j = 0; j < 10; ++j)
@@ -183,15 +198,47 @@ main(int argc, char** argv)
 		kinematics->setPosition(q);
 		kinematics->forwardPosition();
 		
+		// move the other models as well, broadphase entries of all moved bodies must be refreshed
+		rl::math::Transform offset = rl::math::Transform::Identity();
+		
+		for (std::size_t i = 0; i < 3; ++i)
+		{
+			offset.translation()(i) = offsetDistribution(randomGenerator);
+		}
+		
 		rl::math::Vector results(scenes.size());
 		
 		for (std::size_t i = 0; i < scenes.size(); ++i)
 		{
+			for (std::size_t m = 1, k = 0; m < scenes[i]->getNumModels(); ++m)
+			{
+				for (std::size_t b = 0; b < scenes[i]->getModel(m)->getNumBodies(); ++b, ++k)
+				{
+					scenes[i]->getModel(m)->getBody(b)->setFrame(offset * frames[i][k]);
+				}
+			}
+			
 			for (std::size_t b = 0; b < kinematics->getBodies(); ++b)
 			{
 				scenes[i]->getModel(0)->getBody(b)->setFrame(kinematics->getBodyFrame(b));
 			}
 			results[i] = collides(scenes[i], kinematics.get());
+			
+			std::size_t body;
+			
+			bool colliding = scenes[i]->isColliding(
+				scenes[i]->getModel(0),
+				[&kinematics](const std::size_t& k) { return kinematics->isColliding(k); },
+				[&kinematics](const std::size_t& k, const std::size_t& l) { return kinematics->areColliding(k, l); },
+				body
+			);
+			
+			if (colliding != static_cast<bool>(results[i]))
+			{
+				std::cerr << "Error: Counterexample " << j << ": SimpleScene::isColliding(model) in " << sceneNames[i] << "=" << colliding;
+				std::cerr << " differs from pairwise queries, joint angle [rad] " << q.transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
 		}
 		
 		if ((results.array() == false).any() && (results.array() == true).any())
@@ -0,0 +1,206 @@
+//
+// Copyright (c) 2009, Andre Gaschler
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <rl/math/Constants.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/XmlFactory.h>
+#include <rl/sg/Body.h>
+#include <rl/sg/DistanceScene.h>
+#include <rl/sg/Model.h>
+#include <rl/sg/XmlFactory.h>
+#include <rl/sg/ssv/Scene.h>
+
+#ifdef RL_SG_BULLET
+#include <rl/sg/bullet/Scene.h>
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+#include <rl/sg/fcl/Scene.h>
+#endif // RL_SG_FCL
+#ifdef RL_SG_PQP
+#include <rl/sg/pqp/Scene.h>
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+#include <rl/sg/solid/Scene.h>
+#endif // RL_SG_SOLID
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		std::cout << "Usage: rlSsvCollisionTest SCENEFILE KINEMATICSFILE" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	rl::mdl::XmlFactory modelFactory;
+	std::shared_ptr<rl::mdl::Kinematic> kinematics = std::dynamic_pointer_cast<rl::mdl::Kinematic>(modelFactory.create(argv[2]));
+	
+	std::vector<std::shared_ptr<rl::sg::SimpleScene>> scenes;
+	std::vector<std::string> sceneNames;
+	
+#ifdef RL_SG_BULLET
+	scenes.push_back(std::make_shared<rl::sg::bullet::Scene>());
+	sceneNames.push_back("bullet");
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+	scenes.push_back(std::make_shared<rl::sg::fcl::Scene>());
+	sceneNames.push_back("fcl");
+#endif // RL_SG_FCL
+#ifdef RL_SG_PQP
+	scenes.push_back(std::make_shared<rl::sg::pqp::Scene>());
+	sceneNames.push_back("pqp");
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+	scenes.push_back(std::make_shared<rl::sg::solid::Scene>());
+	sceneNames.push_back("solid");
+#endif // RL_SG_SOLID
+	
+	rl::sg::XmlFactory sceneFactory;
+	
+	rl::sg::ssv::Scene ssv;
+	sceneFactory.load(argv[1], &ssv);
+	
+	for (std::size_t i = 0; i < scenes.size(); ++i)
+	{
+		sceneFactory.load(argv[1], scenes[i].get());
+	}
+	
+	std::mt19937 randomGenerator(0);
+	std::uniform_real_distribution<rl::math::Real> randomDistribution(-180 * rl::math::constants::deg2rad, 180 * rl::math::constants::deg2rad);
+	
+	rl::sg::Model* model = ssv.getModel(0);
+	
+	rl::sg::Model* emptyModel = ssv.create();
+	rl::sg::Body* empty = emptyModel->create();
+	
+	for (std::size_t k = 0; k < model->getNumBodies(); ++k)
+	{
+		rl::math::Vector3 point1;
+		rl::math::Vector3 point2;
+		
+		if (ssv.areColliding(model->getBody(k), empty) || ssv.areColliding(empty, model->getBody(k)))
+		{
+			std::cerr << "Error: Body " << k << " collides with body without shapes" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (std::numeric_limits<rl::math::Real>::infinity() != ssv.distance(model->getBody(k), empty, point1, point2) || std::numeric_limits<rl::math::Real>::infinity() != ssv.distance(empty, model->getBody(k), point1, point2))
+		{
+			std::cerr << "Error: Distance of body " << k << " to body without shapes is finite" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	
+	rl::math::Vector3 point1;
+	rl::math::Vector3 point2;
+	
+	if (std::numeric_limits<rl::math::Real>::infinity() != ssv.distance(empty, rl::math::Vector3::Zero(), point1, point2))
+	{
+		std::cerr << "Error: Distance of point to body without shapes is finite" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	delete emptyModel;
+	
+	for (std::size_t i = 0; i < scenes.size(); ++i)
+	{
+		rl::sg::Model* exactModel = scenes[i]->getModel(0);
+		
+		for (std::size_t j = 0; j < 100; ++j)
+		{
+			rl::math::Vector q(kinematics->getDof());
+			
+			for (std::size_t k = 0; k < kinematics->getDof(); ++k)
+			{
+				q(k) = randomDistribution(randomGenerator);
+			}
+			
+			kinematics->setPosition(q);
+			kinematics->forwardPosition();
+			
+			for (std::size_t k = 0; k < kinematics->getBodies(); ++k)
+			{
+				model->getBody(k)->setFrame(kinematics->getBodyFrame(k));
+				exactModel->getBody(k)->setFrame(kinematics->getBodyFrame(k));
+			}
+			
+			for (std::size_t k = 0; k < model->getNumBodies(); ++k)
+			{
+				for (std::size_t l = 1; l < ssv.getNumModels(); ++l)
+				{
+					for (std::size_t m = 0; m < ssv.getModel(l)->getNumBodies(); ++m)
+					{
+						rl::sg::Body* body1 = model->getBody(k);
+						rl::sg::Body* body2 = ssv.getModel(l)->getBody(m);
+						rl::sg::Body* exactBody1 = exactModel->getBody(k);
+						rl::sg::Body* exactBody2 = scenes[i]->getModel(l)->getBody(m);
+						
+						if (scenes[i]->areColliding(exactBody1, exactBody2) && !ssv.areColliding(body1, body2))
+						{
+							std::cerr << "Error: Body " << k << " collides with body " << m << " of model " << l << " in " << sceneNames[i] << " but not in ssv, joint angle [rad] " << q.transpose() << std::endl;
+							return EXIT_FAILURE;
+						}
+						
+						if (rl::sg::DistanceScene* distanceScene = dynamic_cast<rl::sg::DistanceScene*>(scenes[i].get()))
+						{
+							rl::math::Vector3 point1;
+							rl::math::Vector3 point2;
+							rl::math::Real distance = distanceScene->distance(exactBody1, exactBody2, point1, point2);
+							rl::math::Real bound = ssv.distance(body1, body2, point1, point2);
+							
+							if (bound > distance + static_cast<rl::math::Real>(1.0e-4))
+							{
+								std::cerr << "Error: Distance " << bound << " in ssv exceeds distance " << distance << " in " << sceneNames[i] << ", joint angle [rad] " << q.transpose() << std::endl;
+								return EXIT_FAILURE;
+							}
+						}
+						
+						ssv.setExact(scenes[i].get());
+						bool colliding = ssv.areColliding(body1, body2);
+						ssv.setExact(nullptr);
+						
+						if (colliding != scenes[i]->areColliding(exactBody1, exactBody2))
+						{
+							std::cerr << "Error: Collision with fallback to " << sceneNames[i] << " differs, joint angle [rad] " << q.transpose() << std::endl;
+							return EXIT_FAILURE;
+						}
+					}
+				}
+			}
+		}
+		
+		std::cout << "Tested 100 random poses, ssv is conservative with respect to " << sceneNames[i] << "." << std::endl;
+	}
+	
+	return EXIT_SUCCESS;
+}
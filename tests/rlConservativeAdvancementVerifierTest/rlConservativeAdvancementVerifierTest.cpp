@@ -0,0 +1,163 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <rl/math/Constants.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/XmlFactory.h>
+#include <rl/plan/ConservativeAdvancementVerifier.h>
+#include <rl/plan/SequentialVerifier.h>
+#include <rl/plan/SimpleModel.h>
+#include <rl/plan/UniformSampler.h>
+#include <rl/sg/Model.h>
+#include <rl/sg/XmlFactory.h>
+
+#include "../createScene.h"
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 4)
+	{
+		std::cout << "Usage: rlConservativeAdvancementVerifierTest ENGINE SCENEFILE KINEMATICSFILE" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::shared_ptr<rl::sg::Scene> scene = createScene(argv[1]);
+		
+		rl::sg::XmlFactory factory1;
+		factory1.load(argv[2], scene.get(), true, false);
+		
+		rl::mdl::XmlFactory factory2;
+		std::shared_ptr<rl::mdl::Kinematic> kinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory2.create(argv[3]));
+		
+		kinematic->world() = rl::math::AngleAxis(90 * rl::math::constants::deg2rad, rl::math::Vector3::UnitZ());
+		
+		rl::plan::SimpleModel model;
+		model.mdl = kinematic.get();
+		model.model = scene->getModel(0);
+		model.scene = scene.get();
+		
+		rl::plan::UniformSampler sampler;
+		sampler.seed(0);
+		sampler.setModel(&model);
+		
+		rl::plan::ConservativeAdvancementVerifier conservativeAdvancementVerifier;
+		conservativeAdvancementVerifier.setModel(&model);
+		
+		rl::plan::SequentialVerifier sequentialVerifier;
+		sequentialVerifier.setDelta(static_cast<rl::math::Real>(0.1) * rl::math::constants::deg2rad);
+		sequentialVerifier.setModel(&model);
+		
+		std::size_t blockedEdges = 0;
+		std::size_t freeEdges = 0;
+		std::size_t conservativeEdges = 0;
+		std::size_t queries = 0;
+		std::size_t steps = 0;
+		
+		rl::math::Vector v(kinematic->getDofPosition());
+		
+		for (std::size_t i = 0; i < 100; ++i)
+		{
+			rl::math::Vector u = sampler.generateCollisionFree();
+			model.interpolate(u, sampler.generateCollisionFree(), static_cast<rl::math::Real>(0.25), v);
+			
+			if (model.isColliding(v))
+			{
+				continue;
+			}
+			
+			rl::math::Real d = model.distance(u, v);
+			bool colliding = conservativeAdvancementVerifier.isColliding(u, v, d);
+			
+			if (sequentialVerifier.isColliding(u, v, d))
+			{
+				if (!colliding)
+				{
+					std::cerr << "rlConservativeAdvancementVerifierTest: Blocked edge not detected." << std::endl;
+					std::cerr << "u = " << u.transpose() << std::endl;
+					std::cerr << "v = " << v.transpose() << std::endl;
+					return EXIT_FAILURE;
+				}
+				
+				++blockedEdges;
+			}
+			else if (colliding)
+			{
+				// closer than epsilon or colliding between the sequential steps
+				++conservativeEdges;
+			}
+			else
+			{
+				if (conservativeAdvancementVerifier.getQueries() < 1)
+				{
+					std::cerr << "rlConservativeAdvancementVerifierTest: Free edge accepted without queries." << std::endl;
+					return EXIT_FAILURE;
+				}
+				
+				queries += conservativeAdvancementVerifier.getQueries();
+				steps += sequentialVerifier.getSteps(d) - 1;
+				++freeEdges;
+			}
+		}
+		
+		std::cout << "free " << freeEdges << " blocked " << blockedEdges << " conservative " << conservativeEdges << std::endl;
+		std::cout << "queries " << queries << " sequential steps " << steps << " on free edges" << std::endl;
+		
+		if (0 == freeEdges || 0 == blockedEdges)
+		{
+			std::cerr << "rlConservativeAdvancementVerifierTest: Expected both free and blocked edges." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (conservativeEdges > (freeEdges + blockedEdges) / 10)
+		{
+			std::cerr << "rlConservativeAdvancementVerifierTest: Too many free edges reported as colliding." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (queries >= steps)
+		{
+			std::cerr << "rlConservativeAdvancementVerifierTest: Free edges required " << queries << " queries, sequential verifier requires " << steps << "." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	std::cout << "rlConservativeAdvancementVerifierTest: Done." << std::endl;
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <rl/plan/DistanceField.h>
+#include <rl/plan/DistanceModel.h>
+#include <rl/sg/DistanceScene.h>
+#include <rl/sg/XmlFactory.h>
+
+#include "../createScene.h"
+
+bool
+isRejected(const std::string& source, const std::string& filename, const std::size_t& offset, const void* value, const std::size_t& size)
+{
+	std::ifstream in(source.c_str(), std::ios::binary);
+	std::vector<char> buffer((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	std::copy(static_cast<const char*>(value), static_cast<const char*>(value) + size, buffer.begin() + offset);
+	
+	std::ofstream out(filename.c_str(), std::ios::binary);
+	out.write(buffer.data(), buffer.size());
+	out.close();
+	
+	rl::plan::DistanceField field;
+	
+	try
+	{
+		field.load(filename);
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << "rejected: " << e.what() << std::endl;
+		return true;
+	}
+	
+	return false;
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 4)
+	{
+		std::cout << "Usage: rlDistanceFieldTest ENGINE SCENEFILE RESOLUTION" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::shared_ptr<rl::sg::Scene> scene = createScene(argv[1]);
+		
+		if (nullptr == dynamic_cast<rl::sg::DistanceScene*>(scene.get()))
+		{
+			std::cerr << "rlDistanceFieldTest: Engine " << argv[1] << " does not support distance queries." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		rl::sg::XmlFactory factory;
+		factory.load(argv[2], scene.get());
+		
+		rl::plan::DistanceModel model;
+		model.model = scene->getModel(0);
+		model.scene = scene.get();
+		
+		rl::math::AlignedBox3 boundingBox(rl::math::Vector3(-1, -1, 0), rl::math::Vector3(1, 1, 1.5));
+		rl::math::Real resolution = std::stod(argv[3]);
+		
+		rl::plan::DistanceField field;
+		field.build(std::vector<rl::plan::DistanceModel*>(1, &model), boundingBox, resolution);
+		
+		std::string filename = std::string(argv[1]) + ".rldf";
+		field.save(filename);
+		
+		rl::plan::DistanceField loaded;
+		loaded.load(filename);
+		
+		if (loaded.getSize() != field.getSize() ||
+			loaded.getResolution() != field.getResolution() ||
+			!loaded.getBoundingBox().isApprox(field.getBoundingBox()))
+		{
+			std::cerr << "rlDistanceFieldTest: Loaded field differs in size, resolution, or bounding box." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		std::mt19937 engine(0);
+		std::uniform_real_distribution<rl::math::Real> uniform(0, 1);
+		
+		for (std::size_t i = 0; i < 1000; ++i)
+		{
+			rl::math::Vector3 point = boundingBox.min() + boundingBox.sizes().cwiseProduct(rl::math::Vector3(uniform(engine), uniform(engine), uniform(engine)));
+			
+			if (loaded.distance(point) != field.distance(point))
+			{
+				std::cerr << "rlDistanceFieldTest: Loaded distance " << loaded.distance(point) << " differs from " << field.distance(point) << " at " << point.transpose() << "." << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			model.field = &loaded;
+			rl::math::Real distance = model.distance(point);
+			model.field = nullptr;
+			rl::math::Real exactDistance = model.exactDistance(point);
+			
+			if (distance > exactDistance)
+			{
+				std::cerr << "rlDistanceFieldTest: Distance " << distance << " exceeds exact distance " << exactDistance << " at " << point.transpose() << "." << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		
+		// header offsets of resolution and size
+		
+		double zero = 0;
+		std::uint64_t size[3] = { 1, 1 << 20, std::uint64_t(1) << 62 };
+		
+		if (!isRejected(filename, filename + ".resolution", 56, &zero, sizeof(zero)) ||
+			!isRejected(filename, filename + ".size", 8, size, sizeof(size)))
+		{
+			std::cerr << "rlDistanceFieldTest: Invalid header was not rejected." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		std::remove(filename.c_str());
+		std::remove((filename + ".resolution").c_str());
+		std::remove((filename + ".size").c_str());
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	std::cout << "rlDistanceFieldTest: Done." << std::endl;
+	
+	return EXIT_SUCCESS;
+}
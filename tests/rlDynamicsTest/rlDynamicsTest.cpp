@@ -24,11 +24,19 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <random>
 #include <stdexcept>
+#include <thread>
+#include <vector>
+#include <rl/mdl/Data.h>
+#include <rl/mdl/DormandPrinceIntegrator.h>
 #include <rl/mdl/Dynamic.h>
+#include <rl/mdl/Exception.h>
+#include <rl/mdl/RungeKuttaNystromIntegrator.h>
 #include <rl/mdl/XmlFactory.h>
 
 int
@@ -66,6 +74,8 @@ main(int argc, char** argv)
 				qdd.setRandom();
 			}
 			
+			dynamic->normalize(q);
+			
 			// forward velocity (recursive)
 			
 			dynamic->setPosition(q);
@@ -162,6 +172,28 @@ main(int argc, char** argv)
 				return EXIT_FAILURE;
 			}
 			
+			// mass matrix (composite-rigid-body algorithm)
+			
+			dynamic->setPosition(q);
+			dynamic->calculateMassMatrix(true);
+			
+			rl::math::Matrix MCrba = dynamic->getMassMatrix();
+			
+			// mass matrix (inverse dynamics)
+			
+			dynamic->setPosition(q);
+			dynamic->calculateMassMatrix(false);
+			
+			rl::math::Matrix MInverseDynamics = dynamic->getMassMatrix();
+			
+			if (!MCrba.isApprox(MInverseDynamics))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "M (composite-rigid-body) = " << std::endl << MCrba << std::endl;
+				std::cerr << "M (inverse dynamics) = " << std::endl << MInverseDynamics << std::endl;
+				return EXIT_FAILURE;
+			}
+			
 			// forward dynamics (recursive)
 			
 			dynamic->setPosition(q);
@@ -182,6 +214,28 @@ main(int argc, char** argv)
 				return EXIT_FAILURE;
 			}
 			
+			// mass matrix inverse (composite-rigid-body algorithm)
+			
+			dynamic->setPosition(q);
+			dynamic->calculateMassMatrixInverse(true);
+			
+			rl::math::Matrix invMCrba = dynamic->getMassMatrixInverse();
+			
+			// mass matrix inverse (forward dynamics)
+			
+			dynamic->setPosition(q);
+			dynamic->calculateMassMatrixInverse(false);
+			
+			rl::math::Matrix invMForwardDynamics = dynamic->getMassMatrixInverse();
+			
+			if (!invMCrba.isApprox(invMForwardDynamics))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "M^-1 (composite-rigid-body) = " << std::endl << invMCrba << std::endl;
+				std::cerr << "M^-1 (forward dynamics) = " << std::endl << invMForwardDynamics << std::endl;
+				return EXIT_FAILURE;
+			}
+			
 			// forward dynamics (matrices)
 			
 			dynamic->setPosition(q);
@@ -206,6 +260,339 @@ main(int argc, char** argv)
 				return EXIT_FAILURE;
 			}
 		}
+		
+		// batch evaluation
+		
+		rl::math::Matrix qBatch(atoi(argv[2]), dynamic->getDofPosition());
+		rl::math::Matrix qdBatch = rl::math::Matrix::Random(qBatch.rows(), dynamic->getDof());
+		rl::math::Matrix qddBatch = rl::math::Matrix::Random(qBatch.rows(), dynamic->getDof());
+		
+		for (std::ptrdiff_t i = 0; i < qBatch.rows(); ++i)
+		{
+			q.setRandom();
+			dynamic->normalize(q);
+			qBatch.row(i) = q.transpose();
+		}
+		
+		rl::math::Matrix xBatch(qBatch.rows(), 12 * dynamic->getOperationalDof());
+		dynamic->calculateBatchOperationalPosition(qBatch, xBatch);
+		rl::math::Matrix JBatch(qBatch.rows(), 6 * dynamic->getOperationalDof() * dynamic->getDof());
+		dynamic->calculateBatchJacobian(qBatch, JBatch, false);
+		rl::mdl::Data batchData(*dynamic);
+		rl::math::Matrix JBatchWorld(qBatch.rows(), 6 * dynamic->getOperationalDof() * dynamic->getDof());
+		dynamic->calculateBatchJacobian(batchData, qBatch, JBatchWorld, true);
+		rl::math::Matrix GBatch(qBatch.rows(), dynamic->getDof());
+		dynamic->calculateBatchGravity(qBatch, GBatch);
+		rl::math::Matrix tauBatch(qBatch.rows(), dynamic->getDof());
+		dynamic->calculateBatchInverseDynamics(qBatch, qdBatch, qddBatch, tauBatch);
+		
+		for (std::ptrdiff_t i = 0; i < qBatch.rows(); ++i)
+		{
+			q = qBatch.row(i).transpose();
+			qd = qdBatch.row(i).transpose();
+			qdd = qddBatch.row(i).transpose();
+			
+			dynamic->setPosition(q);
+			dynamic->forwardPosition();
+			
+			for (std::size_t j = 0; j < dynamic->getOperationalDof(); ++j)
+			{
+				Eigen::Matrix<rl::math::Real, 3, 4> x;
+				
+				for (std::size_t k = 0; k < 4; ++k)
+				{
+					x.col(k) = xBatch.block(i, 12 * j + 3 * k, 1, 3).transpose();
+				}
+				
+				if (!x.isApprox(dynamic->getOperationalPosition(j).affine()))
+				{
+					std::cerr << "q = " << q.transpose() << std::endl;
+					std::cerr << "x (batch) = " << xBatch.row(i) << std::endl;
+					std::cerr << "x = " << std::endl << dynamic->getOperationalPosition(j).matrix() << std::endl;
+					return EXIT_FAILURE;
+				}
+			}
+			
+			dynamic->calculateJacobian(false);
+			
+			if (!JBatch.row(i).isApprox(Eigen::Map<const rl::math::Vector>(dynamic->getJacobian().data(), dynamic->getJacobian().size()).transpose()))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "J (batch) = " << JBatch.row(i) << std::endl;
+				std::cerr << "J = " << std::endl << dynamic->getJacobian() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			dynamic->calculateJacobian(true);
+			
+			if (!JBatchWorld.row(i).isApprox(Eigen::Map<const rl::math::Vector>(dynamic->getJacobian().data(), dynamic->getJacobian().size()).transpose()))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "J (batch) = " << JBatchWorld.row(i) << std::endl;
+				std::cerr << "J = " << std::endl << dynamic->getJacobian() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			dynamic->setPosition(q);
+			dynamic->calculateGravity();
+			
+			if (GBatch.row(i) != dynamic->getGravity().transpose())
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "G (batch) = " << GBatch.row(i) << std::endl;
+				std::cerr << "G = " << dynamic->getGravity().transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			dynamic->setPosition(q);
+			dynamic->setVelocity(qd);
+			dynamic->setAcceleration(qdd);
+			dynamic->inverseDynamics();
+			
+			if (tauBatch.row(i) != dynamic->getTorque().transpose())
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "tau (batch) = " << tauBatch.row(i) << std::endl;
+				std::cerr << "tau = " << dynamic->getTorque().transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		
+		// workspace evaluation
+		
+		std::vector<rl::mdl::Data> datas(std::max<std::size_t>(std::thread::hardware_concurrency(), 2), rl::mdl::Data(*dynamic));
+		rl::math::Matrix tauThreads(qBatch.rows(), dynamic->getDof());
+		std::vector<std::thread> threads;
+		
+		for (std::size_t j = 0; j < datas.size(); ++j)
+		{
+			threads.push_back(std::thread([&, j]() {
+				for (std::ptrdiff_t i = j; i < qBatch.rows(); i += datas.size())
+				{
+					datas[j].q = qBatch.row(i).transpose();
+					datas[j].qd = qdBatch.row(i).transpose();
+					datas[j].qdd = qddBatch.row(i).transpose();
+					dynamic->inverseDynamics(datas[j]);
+					tauThreads.row(i) = datas[j].tau.transpose();
+				}
+			}));
+		}
+		
+		for (std::size_t j = 0; j < threads.size(); ++j)
+		{
+			threads[j].join();
+		}
+		
+		if (!tauThreads.isApprox(tauBatch))
+		{
+			std::cerr << "tau (threads) = " << std::endl << tauThreads << std::endl;
+			std::cerr << "tau (batch) = " << std::endl << tauBatch << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		rl::mdl::Data data(*dynamic);
+		
+		for (std::ptrdiff_t i = 0; i < qBatch.rows(); ++i)
+		{
+			data.q = q = qBatch.row(i).transpose();
+			data.qd = qd = qdBatch.row(i).transpose();
+			data.qdd = qdd = qddBatch.row(i).transpose();
+			
+			dynamic->calculateJacobian(data, false);
+			dynamic->calculateJacobianDerivative(data, false);
+			dynamic->setPosition(q);
+			dynamic->calculateJacobian(false);
+			dynamic->setVelocity(qd);
+			dynamic->calculateJacobianDerivative(false);
+			
+			if (!data.J.isApprox(dynamic->getJacobian()) || !data.Jdqd.isApprox(dynamic->getJacobianDerivative()))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "J (workspace) = " << std::endl << data.J << std::endl;
+				std::cerr << "J = " << std::endl << dynamic->getJacobian() << std::endl;
+				std::cerr << "Jd * qd (workspace) = " << data.Jdqd.transpose() << std::endl;
+				std::cerr << "Jd * qd = " << dynamic->getJacobianDerivative().transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			dynamic->forwardVelocity(data);
+			dynamic->forwardAcceleration(data);
+			dynamic->setAcceleration(qdd);
+			dynamic->forwardVelocity();
+			dynamic->forwardAcceleration();
+			
+			for (std::size_t j = 0; j < dynamic->getOperationalDof(); ++j)
+			{
+				if (!dynamic->getOperationalPosition(data, j).isApprox(dynamic->getOperationalPosition(j)) ||
+					!dynamic->getOperationalVelocity(data, j).matrix().isApprox(dynamic->getOperationalVelocity(j).matrix()) ||
+					!dynamic->getOperationalAcceleration(data, j).matrix().isApprox(dynamic->getOperationalAcceleration(j).matrix()))
+				{
+					std::cerr << "q = " << q.transpose() << std::endl;
+					std::cerr << "xdd (workspace) = " << dynamic->getOperationalAcceleration(data, j).matrix().transpose() << std::endl;
+					std::cerr << "xdd = " << dynamic->getOperationalAcceleration(j).matrix().transpose() << std::endl;
+					return EXIT_FAILURE;
+				}
+			}
+			
+			dynamic->calculateMassMatrix(data);
+			dynamic->calculateMassMatrixInverse(data);
+			dynamic->calculateCentrifugalCoriolis(data);
+			dynamic->calculateGravity(data);
+			dynamic->setPosition(q);
+			dynamic->calculateMassMatrix();
+			dynamic->calculateMassMatrixInverse();
+			dynamic->setVelocity(qd);
+			dynamic->calculateCentrifugalCoriolis();
+			dynamic->calculateGravity();
+			
+			if (!data.M.isApprox(dynamic->getMassMatrix()) || !data.invM.isApprox(dynamic->getMassMatrixInverse()) || !data.V.isApprox(dynamic->getCentrifugalCoriolis()) || !data.G.isApprox(dynamic->getGravity()))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "qd = " << qd.transpose() << std::endl;
+				std::cerr << "M (workspace) = " << std::endl << data.M << std::endl;
+				std::cerr << "M = " << std::endl << dynamic->getMassMatrix() << std::endl;
+				std::cerr << "V (workspace) = " << data.V.transpose() << std::endl;
+				std::cerr << "V = " << dynamic->getCentrifugalCoriolis().transpose() << std::endl;
+				std::cerr << "G (workspace) = " << data.G.transpose() << std::endl;
+				std::cerr << "G = " << dynamic->getGravity().transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			data.tau = tauBatch.row(i).transpose();
+			dynamic->forwardDynamics(data);
+			
+			if (!data.qdd.isApprox(qdd))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "qd = " << qd.transpose() << std::endl;
+				std::cerr << "qdd = " << qdd.transpose() << std::endl;
+				std::cerr << "qdd (workspace) = " << data.qdd.transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		
+		// adaptive integration
+		
+		if (dynamic->getDofPosition() == dynamic->getDof())
+		{
+			rl::math::Real dt = static_cast<rl::math::Real>(1.0e-3);
+			rl::math::Vector tau = rl::math::Vector::Zero(dynamic->getDof());
+			
+			dynamic->setPosition(q);
+			dynamic->setVelocity(qd);
+			dynamic->setTorque(tau);
+			
+			rl::mdl::RungeKuttaNystromIntegrator rungeKuttaNystrom(dynamic.get());
+			
+			for (std::size_t i = 0; i < 100; ++i)
+			{
+				rungeKuttaNystrom.integrate(dt);
+			}
+			
+			rl::math::Vector qRungeKuttaNystrom = dynamic->getPosition();
+			rl::math::Vector qdRungeKuttaNystrom = dynamic->getVelocity();
+			
+			dynamic->setPosition(q);
+			dynamic->setVelocity(qd);
+			dynamic->setTorque(tau);
+			
+			rl::mdl::DormandPrinceIntegrator dormandPrince(dynamic.get());
+			dormandPrince.setAbsoluteTolerance(static_cast<rl::math::Real>(1.0e-10));
+			dormandPrince.setRelativeTolerance(static_cast<rl::math::Real>(1.0e-10));
+			
+			for (std::size_t i = 0; i < 100; ++i)
+			{
+				dormandPrince.integrate(dt);
+			}
+			
+			if ((dynamic->getPosition() - qRungeKuttaNystrom).cwiseAbs().maxCoeff() > static_cast<rl::math::Real>(1.0e-6) ||
+				(dynamic->getVelocity() - qdRungeKuttaNystrom).cwiseAbs().maxCoeff() > static_cast<rl::math::Real>(1.0e-6))
+			{
+				std::cerr << "q (Runge-Kutta-Nystrom) = " << qRungeKuttaNystrom.transpose() << std::endl;
+				std::cerr << "q (Dormand-Prince) = " << dynamic->getPosition().transpose() << std::endl;
+				std::cerr << "qd (Runge-Kutta-Nystrom) = " << qdRungeKuttaNystrom.transpose() << std::endl;
+				std::cerr << "qd (Dormand-Prince) = " << dynamic->getVelocity().transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			// dense output at both ends of a single accepted step
+			
+			dynamic->setPosition(q);
+			dynamic->setVelocity(qd);
+			dynamic->setTorque(tau);
+			
+			rl::mdl::DormandPrinceIntegrator singleStep(dynamic.get());
+			singleStep.setAbsoluteTolerance(static_cast<rl::math::Real>(1.0e-3));
+			singleStep.setRelativeTolerance(static_cast<rl::math::Real>(1.0e-3));
+			singleStep.setStepSize(dt);
+			singleStep.integrate(dt);
+			
+			rl::math::Vector q0;
+			rl::math::Vector qd0;
+			singleStep.interpolate(0, q0, qd0);
+			rl::math::Vector q1;
+			rl::math::Vector qd1;
+			singleStep.interpolate(1, q1, qd1);
+			
+			if (1 != singleStep.getSteps() ||
+				(q0 - q).cwiseAbs().maxCoeff() > static_cast<rl::math::Real>(1.0e-12) ||
+				(qd0 - qd).cwiseAbs().maxCoeff() > static_cast<rl::math::Real>(1.0e-12) ||
+				(q1 - dynamic->getPosition()).cwiseAbs().maxCoeff() > static_cast<rl::math::Real>(1.0e-12) ||
+				(qd1 - dynamic->getVelocity()).cwiseAbs().maxCoeff() > static_cast<rl::math::Real>(1.0e-12))
+			{
+				std::cerr << "steps = " << singleStep.getSteps() << std::endl;
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "q (interpolate 0) = " << q0.transpose() << std::endl;
+				std::cerr << "q (integrate) = " << dynamic->getPosition().transpose() << std::endl;
+				std::cerr << "q (interpolate 1) = " << q1.transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			// step rejection with tight tolerances
+			
+			dynamic->setPosition(q);
+			dynamic->setVelocity(qd);
+			dynamic->setTorque(tau);
+			
+			rl::mdl::DormandPrinceIntegrator tight(dynamic.get());
+			tight.setAbsoluteTolerance(static_cast<rl::math::Real>(1.0e-12));
+			tight.setRelativeTolerance(static_cast<rl::math::Real>(1.0e-12));
+			tight.setStepSize(static_cast<rl::math::Real>(0.1));
+			tight.integrate(static_cast<rl::math::Real>(0.1));
+			
+			if (0 == tight.getRejections() || tight.getSteps() < 2)
+			{
+				std::cerr << "rejections = " << tight.getRejections() << std::endl;
+				std::cerr << "steps = " << tight.getSteps() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			// non-finite error rejected until minimum step size
+			
+			dynamic->setPosition(q);
+			dynamic->setVelocity(qd);
+			dynamic->setTorque(rl::math::Vector::Constant(tau.size(), std::numeric_limits<rl::math::Real>::quiet_NaN()));
+			
+			rl::mdl::DormandPrinceIntegrator diverging(dynamic.get());
+			diverging.setStepSize(static_cast<rl::math::Real>(0.1));
+			
+			try
+			{
+				diverging.integrate(static_cast<rl::math::Real>(0.1));
+				std::cerr << "Dormand-Prince accepted non-finite error" << std::endl;
+				return EXIT_FAILURE;
+			}
+			catch (const rl::mdl::Exception&)
+			{
+			}
+			
+			if (0 != diverging.getSteps() || 0 == diverging.getRejections() || !q.isApprox(dynamic->getPosition()))
+			{
+				std::cerr << "rejections = " << diverging.getRejections() << std::endl;
+				std::cerr << "steps = " << diverging.getSteps() << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
 	}
 	catch (const std::exception& e)
 	{
@@ -0,0 +1,288 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <rl/hal/Coach.h>
+#include <rl/hal/CoachFrame.h>
+#include <rl/hal/Socket.h>
+
+// single connection server that stores joint positions and answers position requests,
+// optionally without binary framing like servers predating it
+class Server
+{
+public:
+	Server(const unsigned short int& port, const bool& binary) :
+		binary(binary),
+		framed(false),
+		position(),
+		socket(rl::hal::Socket::Tcp(rl::hal::Socket::Address::Ipv4("localhost", port)))
+	{
+		this->socket.open();
+		this->socket.bind();
+		this->socket.listen();
+	}
+	
+	void handle(const rl::hal::CoachFrame::Message& message, std::vector<rl::hal::CoachFrame::Message>& replies)
+	{
+		if (2 == message.cmd)
+		{
+			this->position = message.values;
+		}
+		else if (6 == message.cmd)
+		{
+			rl::hal::CoachFrame::Message reply = {message.cmd, message.i, this->position};
+			replies.push_back(reply);
+		}
+	}
+	
+	void run()
+	{
+		rl::hal::Socket connection = this->socket.accept();
+		std::vector<std::uint8_t> buffer;
+		
+		for (;;)
+		{
+			std::uint8_t chunk[1024];
+			std::size_t count = connection.recv(chunk, sizeof(chunk));
+			
+			if (0 == count)
+			{
+				break;
+			}
+			
+			buffer.insert(buffer.end(), chunk, chunk + count);
+			
+			for (std::vector<std::uint8_t>::iterator newline = std::find(buffer.begin(), buffer.end(), '\n'); !this->framed && buffer.end() != newline; newline = std::find(buffer.begin(), buffer.end(), '\n'))
+			{
+				std::istringstream line(std::string(buffer.begin(), newline));
+				buffer.erase(buffer.begin(), newline + 1);
+				
+				std::size_t cmd = 0;
+				line >> cmd;
+				std::size_t i = 0;
+				line >> i;
+				
+				if (2 == cmd)
+				{
+					std::vector<rl::math::Real> values;
+					
+					for (rl::math::Real value; line >> value;)
+					{
+						values.push_back(value);
+					}
+					
+					this->position = rl::math::Vector::Map(values.data(), values.size());
+				}
+				else if (6 == cmd)
+				{
+					std::ostringstream reply;
+					reply << cmd << " " << i;
+					
+					for (std::ptrdiff_t j = 0; j < this->position.size(); ++j)
+					{
+						reply << " " << this->position(j);
+					}
+					
+					reply << std::endl;
+					connection.send(reply.str().c_str(), reply.str().length());
+				}
+				else if (7 == cmd && this->binary)
+				{
+					connection.send("7 1\n", 4);
+					this->framed = true;
+				}
+			}
+			
+			if (this->framed)
+			{
+				std::vector<std::uint8_t> replies;
+				
+				std::size_t consumed = rl::hal::CoachFrame::process(
+					buffer.data(),
+					buffer.size(),
+					[this](const rl::hal::CoachFrame::Message& message, std::vector<rl::hal::CoachFrame::Message>& replies)
+					{
+						this->handle(message, replies);
+					},
+					replies
+				);
+				
+				buffer.erase(buffer.begin(), buffer.begin() + consumed);
+				
+				if (!replies.empty())
+				{
+					connection.send(replies.data(), replies.size());
+				}
+			}
+		}
+		
+		connection.close();
+		this->socket.close();
+	}
+	
+	bool binary;
+	
+	bool framed;
+	
+	rl::math::Vector position;
+	
+	rl::hal::Socket socket;
+};
+
+void
+roundTrip(const unsigned short int& port, const bool& binary, rl::math::Vector& q, bool& framed)
+{
+	Server server(port, binary);
+	std::thread thread(&Server::run, &server);
+	
+	rl::hal::Coach coach(q.size(), std::chrono::milliseconds(1), 0, "localhost", port);
+	coach.setProtocol(rl::hal::Coach::Protocol::binary);
+	coach.open();
+	coach.start();
+	coach.setJointPosition(q);
+	coach.step();
+	q = coach.getJointPosition();
+	coach.stop();
+	coach.close();
+	
+	thread.join();
+	framed = server.framed;
+}
+
+int
+main(int argc, char** argv)
+{
+	try
+	{
+		// little-endian framing
+		
+		rl::math::Vector values(1);
+		values << 1.5;
+		
+		std::vector<rl::hal::CoachFrame::Message> messages;
+		rl::hal::CoachFrame::Message message = {2, 1, values};
+		messages.push_back(message);
+		
+		std::vector<std::uint8_t> frame;
+		rl::hal::CoachFrame::encode(messages, frame);
+		
+		const std::uint8_t expected[] = {
+			16, 0, 0, 0,
+			2, 0,
+			1, 0,
+			1, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0xF8, 0x3F
+		};
+		
+		if (frame != std::vector<std::uint8_t>(expected, expected + sizeof(expected)))
+		{
+			std::cerr << "rlHalCoachTest: Frame is not little-endian with size prefix." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (0 != rl::hal::CoachFrame::decode(frame.data(), frame.size() - 1, messages))
+		{
+			std::cerr << "rlHalCoachTest: Incomplete frame decoded." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (frame.size() != rl::hal::CoachFrame::decode(frame.data(), frame.size(), messages) || 1 != messages.size() || 2 != messages[0].cmd || 1 != messages[0].i || values != messages[0].values)
+		{
+			std::cerr << "rlHalCoachTest: Decoded frame differs." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		std::vector<std::uint8_t> frames(frame);
+		frames.insert(frames.end(), frame.begin(), frame.end());
+		frames.insert(frames.end(), frame.begin(), frame.end() - 1);
+		std::size_t handled = 0;
+		std::vector<std::uint8_t> replies;
+		
+		std::size_t consumed = rl::hal::CoachFrame::process(
+			frames.data(),
+			frames.size(),
+			[&handled](const rl::hal::CoachFrame::Message& message, std::vector<rl::hal::CoachFrame::Message>& replies)
+			{
+				++handled;
+			},
+			replies
+		);
+		
+		if (2 * frame.size() != consumed || 2 != handled || 8 != replies.size())
+		{
+			std::cerr << "rlHalCoachTest: Complete frames not processed separately." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		// negotiation of binary framing, doubles round-trip without loss
+		
+		rl::math::Vector q(3);
+		q << 0.1234567890123, -1.0 / 3.0, 2.5e-9;
+		rl::math::Vector qBinary = q;
+		bool framed = false;
+		
+		roundTrip(11236, true, qBinary, framed);
+		
+		if (!framed || q != qBinary)
+		{
+			std::cerr << "rlHalCoachTest: Binary framing not negotiated or position differs." << std::endl;
+			std::cerr << "q = " << q.transpose() << std::endl;
+			std::cerr << "q (binary) = " << qBinary.transpose() << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		// text fallback with server ignoring the request
+		
+		rl::math::Vector qText = q;
+		
+		roundTrip(11237, false, qText, framed);
+		
+		if (framed || !q.isApprox(qText, 1.0e-5))
+		{
+			std::cerr << "rlHalCoachTest: Text fallback failed." << std::endl;
+			std::cerr << "q = " << q.transpose() << std::endl;
+			std::cerr << "q (text) = " << qText.transpose() << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "rlHalCoachTest: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	std::cout << "rlHalCoachTest: Binary and text protocol round-trip." << std::endl;
+	
+	return EXIT_SUCCESS;
+}
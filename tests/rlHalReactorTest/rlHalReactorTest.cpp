@@ -0,0 +1,249 @@
+//
+// Copyright (c) 2013, Andre Gaschler, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <rl/hal/ComException.h>
+#include <rl/hal/DeviceException.h>
+#include <rl/hal/Reactor.h>
+
+class TestDevice : public rl::hal::ReactiveDevice
+{
+public:
+	TestDevice(const int& fd) :
+		rl::hal::Device(),
+		ReactiveDevice(),
+		fd(fd),
+		payloads(),
+		timestamps()
+	{
+	}
+	
+	void close()
+	{
+	}
+	
+	int getDescriptor() const
+	{
+		return this->fd;
+	}
+	
+	void open()
+	{
+	}
+	
+	void start()
+	{
+	}
+	
+	void stop()
+	{
+	}
+	
+	int fd;
+	
+	std::vector<std::string> payloads;
+	
+	std::vector<std::chrono::steady_clock::time_point> timestamps;
+	
+protected:
+	// one length byte followed by the payload
+	std::size_t frame(const std::uint8_t* buf, const std::size_t& count) const
+	{
+		if (count < 1 || count < 1 + static_cast<std::size_t>(buf[0]))
+		{
+			return 0;
+		}
+		
+		return 1 + buf[0];
+	}
+	
+	void receive(const std::uint8_t* buf, const std::size_t& count)
+	{
+		if ('!' == buf[1])
+		{
+			throw rl::hal::DeviceException("Invalid frame");
+		}
+		
+		this->payloads.push_back(std::string(buf + 1, buf + count));
+		this->timestamps.push_back(this->getTimestamp());
+	}
+};
+
+void
+send(const int& fd, const std::string& data)
+{
+	if (static_cast<ssize_t>(data.size()) != ::write(fd, data.data(), data.size()))
+	{
+		std::cerr << "Error writing to socket" << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+}
+
+int
+main(int argc, char** argv)
+{
+	int sv1[2];
+	int sv2[2];
+	
+	if (-1 == ::socketpair(AF_UNIX, SOCK_STREAM, 0, sv1) || -1 == ::socketpair(AF_UNIX, SOCK_STREAM, 0, sv2))
+	{
+		std::cerr << "Error creating socket pairs" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	TestDevice device1(sv1[0]);
+	TestDevice device2(sv2[0]);
+	
+	rl::hal::Reactor reactor;
+	reactor.add(&device1);
+	reactor.add(&device2);
+	
+	if (!device1.isReactive() || !device2.isReactive())
+	{
+		std::cerr << "Added device not reactive" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	std::chrono::steady_clock::time_point before = std::chrono::steady_clock::now();
+	send(sv1[1], std::string("\x03" "ab", 3));
+	
+	if (0 != reactor.poll(std::chrono::seconds(1)) || !device1.payloads.empty())
+	{
+		std::cerr << "Partial frame dispatched" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	send(sv1[1], "c");
+	
+	if (1 != reactor.poll(std::chrono::seconds(1)) || 1 != device1.payloads.size() || "abc" != device1.payloads[0])
+	{
+		std::cerr << "Partial frame not reassembled" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	std::chrono::steady_clock::time_point after = std::chrono::steady_clock::now();
+	
+	if (device1.timestamps[0] < before || device1.timestamps[0] > after)
+	{
+		std::cerr << "Arrival timestamp outside of poll" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	send(sv1[1], std::string("\x01" "d" "\x02" "ef" "\x01", 6));
+	
+	if (2 != reactor.poll(std::chrono::seconds(1)) || 3 != device1.payloads.size() || "d" != device1.payloads[1] || "ef" != device1.payloads[2])
+	{
+		std::cerr << "Frames of one read not dispatched" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	if (device1.timestamps[1] != device1.timestamps[2] || device1.timestamps[1] < after)
+	{
+		std::cerr << "Frames of one read with different timestamps" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	send(sv1[1], "g");
+	
+	if (1 != reactor.poll(std::chrono::seconds(1)) || 4 != device1.payloads.size() || "g" != device1.payloads[3])
+	{
+		std::cerr << "Remaining frame not reassembled" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	send(sv2[1], std::string("\x01" "!", 2));
+	send(sv1[1], std::string("\x01" "h", 2));
+	reactor.poll(std::chrono::seconds(1));
+	
+	if (device2.isReactive() || nullptr == device2.getException())
+	{
+		std::cerr << "Device with invalid frame not removed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::rethrow_exception(device2.getException());
+	}
+	catch (const rl::hal::DeviceException&)
+	{
+	}
+	
+	if (!device1.isReactive())
+	{
+		std::cerr << "Device removed because of another device" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	while (device1.payloads.size() < 5)
+	{
+		if (0 == reactor.poll(std::chrono::seconds(1)))
+		{
+			std::cerr << "Frame of remaining device not dispatched" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	
+	std::thread thread(&rl::hal::Reactor::run, &reactor);
+	
+	::close(sv1[1]);
+	
+	for (std::size_t i = 0; i < 1000 && device1.isReactive(); ++i)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	
+	reactor.stop();
+	thread.join();
+	
+	if (device1.isReactive() || nullptr == device1.getException())
+	{
+		std::cerr << "Device not removed on end of file" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::rethrow_exception(device1.getException());
+	}
+	catch (const rl::hal::ComException&)
+	{
+	}
+	
+	::close(sv1[0]);
+	::close(sv2[0]);
+	::close(sv2[1]);
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2013, Andre Gaschler, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <rl/hal/TripleBuffer.h>
+
+int
+main(int argc, char** argv)
+{
+	{
+		rl::hal::TripleBuffer<int> buffer(-1);
+		
+		if (-1 != buffer.load())
+		{
+			std::cerr << "Initial value " << buffer.load() << " != -1" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		buffer.store(1);
+		buffer.store(2);
+		
+		if (2 != buffer.load())
+		{
+			std::cerr << "Latest value " << buffer.load() << " != 2" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		buffer.getBack() = 3;
+		
+		if (2 != buffer.load())
+		{
+			std::cerr << "Unpublished value visible" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		buffer.publish();
+		
+		if (2 != buffer.getFront())
+		{
+			std::cerr << "Front buffer changed without update" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (!buffer.update() || buffer.update())
+		{
+			std::cerr << "Update does not report published values" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (3 != buffer.getFront() || 3 != buffer.load())
+		{
+			std::cerr << "Published value " << buffer.getFront() << " != 3" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	
+	{
+		typedef std::array<std::uint64_t, 64> State;
+		
+		const std::uint64_t count = 200000;
+		
+		rl::hal::TripleBuffer<State> buffer(State{});
+		
+		std::thread writer([&buffer, count]() {
+			for (std::uint64_t i = 1; i <= count; ++i)
+			{
+				State& state = buffer.getBack();
+				
+				for (std::size_t j = 0; j < state.size(); ++j)
+				{
+					state[j] = i;
+				}
+				
+				buffer.publish();
+			}
+		});
+		
+		std::uint64_t last = 0;
+		
+		while (last < count)
+		{
+			const State& state = buffer.load();
+			
+			for (std::size_t j = 1; j < state.size(); ++j)
+			{
+				if (state[j] != state[0])
+				{
+					std::cerr << "Torn snapshot " << state[0] << " != " << state[j] << std::endl;
+					writer.join();
+					return EXIT_FAILURE;
+				}
+			}
+			
+			if (state[0] < last)
+			{
+				std::cerr << "Snapshot " << state[0] << " older than " << last << std::endl;
+				writer.join();
+				return EXIT_FAILURE;
+			}
+			
+			if (buffer.getTimestamp() > std::chrono::steady_clock::now())
+			{
+				std::cerr << "Timestamp in the future" << std::endl;
+				writer.join();
+				return EXIT_FAILURE;
+			}
+			
+			last = state[0];
+		}
+		
+		writer.join();
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -69,6 +69,19 @@ main(int argc, char** argv)
 		jacobianTranspose->setMethod(rl::mdl::JacobianInverseKinematics::Method::transpose);
 		ik.push_back(std::make_pair(jacobianTranspose, "rl::mdl::JacobianInverseKinematics::Method::transpose"));
 		
+		std::shared_ptr<rl::mdl::JacobianInverseKinematics> jacobianWorkers = std::make_shared<rl::mdl::JacobianInverseKinematics>(kinematics.get());
+		jacobianWorkers->seed(0);
+		jacobianWorkers->setMethod(rl::mdl::JacobianInverseKinematics::Method::svd);
+		jacobianWorkers->setWorkers(4);
+		ik.push_back(std::make_pair(jacobianWorkers, "rl::mdl::JacobianInverseKinematics::Method::svd with 4 workers"));
+		
+		std::shared_ptr<rl::mdl::JacobianInverseKinematics> jacobianSolutions = std::make_shared<rl::mdl::JacobianInverseKinematics>(kinematics.get());
+		jacobianSolutions->seed(0);
+		jacobianSolutions->setMethod(rl::mdl::JacobianInverseKinematics::Method::svd);
+		jacobianSolutions->setSolutions(3);
+		jacobianSolutions->setWorkers(2);
+		ik.push_back(std::make_pair(jacobianSolutions, "rl::mdl::JacobianInverseKinematics::Method::svd with best of 3 solutions"));
+		
 #ifdef RL_MDL_NLOPT
 		std::shared_ptr<rl::mdl::NloptInverseKinematics> nlopt = std::make_shared<rl::mdl::NloptInverseKinematics>(kinematics.get());
 		nlopt->seed(0);
@@ -89,6 +89,37 @@ main(int argc, char** argv)
 			return EXIT_FAILURE;
 		}
 		
+		// Compute Jacobian derivative with central differences along qd
+		rl::math::Vector qd(dof);
+		
+		for (std::size_t i = 0; i < dof; ++i)
+		{
+			qd(i) = static_cast<rl::math::Real>(std::rand()) / static_cast<rl::math::Real>(RAND_MAX) - 0.5;
+		}
+		
+		kinematics->setPosition(q);
+		kinematics->setVelocity(qd);
+		kinematics->calculateJacobianDerivative();
+		rl::math::Vector jacobianDerivativeAlgebraic = kinematics->getJacobianDerivative();
+		
+		kinematics->setPosition(q + qd * big_eps);
+		kinematics->calculateJacobian();
+		rl::math::Matrix jacobianPlus = kinematics->getJacobian();
+		kinematics->setPosition(q - qd * big_eps);
+		kinematics->calculateJacobian();
+		rl::math::Matrix jacobianMinus = kinematics->getJacobian();
+		rl::math::Vector jacobianDerivativeNumeric = (jacobianPlus - jacobianMinus) / 2 / big_eps * qd;
+		
+		if ((jacobianDerivativeAlgebraic - jacobianDerivativeNumeric).norm() > big_eps)
+		{
+			std::cerr << "jacobianDerivativeNumeric differs from jacobianDerivativeAlgebraic, one of them must be wrong." << std::endl;
+			std::cerr << " q [rad]: " << q.transpose() << std::endl;
+			std::cerr << " qd [rad/s]: " << qd.transpose() << std::endl;
+			std::cerr << " jacobianDerivativeAlgebraic: " << jacobianDerivativeAlgebraic.transpose() << std::endl;
+			std::cerr << " jacobianDerivativeNumeric: " << jacobianDerivativeNumeric.transpose() << std::endl;
+			
+			return EXIT_FAILURE;
+		}
 	}
 	
 	return EXIT_SUCCESS;
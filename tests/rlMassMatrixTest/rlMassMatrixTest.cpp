@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/XmlFactory.h>
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		std::cout << "Usage: rlMassMatrixTest MODELFILE LOOP" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		rl::mdl::XmlFactory factory;
+		std::shared_ptr<rl::mdl::Dynamic> dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(argv[1]));
+		
+		std::size_t loop = atoi(argv[2]);
+		
+		std::vector<rl::math::Vector> q(loop);
+		
+		for (std::size_t i = 0; i < loop; ++i)
+		{
+			q[i] = dynamic->generatePositionUniform();
+		}
+		
+		rl::math::Matrix M(dynamic->getDof(), dynamic->getDof());
+		std::vector<rl::math::Matrix> MCrba(loop);
+		std::vector<rl::math::Matrix> MInverseDynamics(loop);
+		
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < loop; ++i)
+		{
+			dynamic->setPosition(q[i]);
+			dynamic->calculateMassMatrix(M, true);
+			MCrba[i] = M;
+		}
+		
+		std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+		
+		std::cout << "mass matrix (composite-rigid-body) time " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000 / loop << " ms" << std::endl;
+		
+		start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < loop; ++i)
+		{
+			dynamic->setPosition(q[i]);
+			dynamic->calculateMassMatrix(M, false);
+			MInverseDynamics[i] = M;
+		}
+		
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "mass matrix (inverse dynamics) time " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000 / loop << " ms" << std::endl;
+		
+		rl::math::Matrix invM(dynamic->getDof(), dynamic->getDof());
+		std::vector<rl::math::Matrix> invMCrba(loop);
+		std::vector<rl::math::Matrix> invMForwardDynamics(loop);
+		
+		start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < loop; ++i)
+		{
+			dynamic->setPosition(q[i]);
+			dynamic->calculateMassMatrixInverse(invM, true);
+			invMCrba[i] = invM;
+		}
+		
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "mass matrix inverse (composite-rigid-body) time " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000 / loop << " ms" << std::endl;
+		
+		start = std::chrono::steady_clock::now();
+		
+		for (std::size_t i = 0; i < loop; ++i)
+		{
+			dynamic->setPosition(q[i]);
+			dynamic->calculateMassMatrixInverse(invM, false);
+			invMForwardDynamics[i] = invM;
+		}
+		
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "mass matrix inverse (forward dynamics) time " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000 / loop << " ms" << std::endl;
+		
+		for (std::size_t i = 0; i < loop; ++i)
+		{
+			if (!MCrba[i].isApprox(MInverseDynamics[i]))
+			{
+				std::cerr << "rlMassMatrixTest: composite-rigid-body != inverse dynamics" << std::endl;
+				std::cerr << "q = " << q[i].transpose() << std::endl;
+				std::cerr << "M (composite-rigid-body) = " << std::endl << MCrba[i] << std::endl;
+				std::cerr << "M (inverse dynamics) = " << std::endl << MInverseDynamics[i] << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			if (!invMCrba[i].isApprox(invMForwardDynamics[i]))
+			{
+				std::cerr << "rlMassMatrixTest: composite-rigid-body != forward dynamics" << std::endl;
+				std::cerr << "q = " << q[i].transpose() << std::endl;
+				std::cerr << "M^-1 (composite-rigid-body) = " << std::endl << invMCrba[i] << std::endl;
+				std::cerr << "M^-1 (forward dynamics) = " << std::endl << invMForwardDynamics[i] << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
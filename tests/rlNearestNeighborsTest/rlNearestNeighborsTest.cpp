@@ -1,6 +1,7 @@
 #include <chrono>
 #include <iostream>
 #include <vector>
+#include <rl/math/FlatKdtreeNearestNeighbors.h>
 #include <rl/math/GnatNearestNeighbors.h>
 #include <rl/math/KdtreeBoundingBoxNearestNeighbors.h>
 #include <rl/math/KdtreeNearestNeighbors.h>
@@ -12,9 +13,12 @@
 #include "iterator.h"
 
 #define DIM 6
+#define DIMS { 10, 14 }
 #define K 30
 #define N 100000
+#define N2 5000
 #define QUERIES 100
+#define QUERIES2 25
 
 template<typename NearestNeighbors>
 std::vector<std::vector<typename NearestNeighbors::Neighbor>>
@@ -97,6 +101,9 @@ test(const std::vector<rl::math::Vector>& points, const std::vector<rl::math::Ve
 	std::cout << "** LinearNearestNeighbors<MetricSquared> **************************************" << std::endl;
 	std::vector<std::vector<rl::math::LinearNearestNeighbors<MetricSquared>::Neighbor>> linear2 = test<rl::math::LinearNearestNeighbors<MetricSquared>>(points, queries, iterative, true);
 	
+	std::cout << "** FlatKdtreeNearestNeighbors<MetricSquared> **********************************" << std::endl;
+	std::vector<std::vector<rl::math::FlatKdtreeNearestNeighbors<MetricSquared>::Neighbor>> flatKdtree = test<rl::math::FlatKdtreeNearestNeighbors<MetricSquared>>(points, queries, iterative, true);
+	
 	std::cout << "** GnatNearestNeighbors<Metric> ***********************************************" << std::endl;
 	std::vector<std::vector<rl::math::GnatNearestNeighbors<Metric>::Neighbor>> gnat = test<rl::math::GnatNearestNeighbors<Metric>>(points, queries, iterative, false);
 	
@@ -119,6 +126,15 @@ test(const std::vector<rl::math::Vector>& points, const std::vector<rl::math::Ve
 				exit(EXIT_FAILURE);
 			}
 			
+			if (!Eigen::internal::isApprox(linear[i][j].first, std::sqrt(flatKdtree[i][j].first)) ||
+				!linear[i][j].second->isApprox(*flatKdtree[i][j].second))
+			{
+				std::cerr << "rlNearestNeighborsTest: LinearNearestNeighbors<Metric> != FlatKdtreeNearestNeighbors<MetricSquared>" << std::endl;
+				std::cerr << "[" << i << "][" << j << "] " << linear[i][j].first << " LinearNearestNeighbors<Metric>: " << linear[i][j].second->transpose() << std::endl;
+				std::cerr << "[" << i << "][" << j << "] " << std::sqrt(flatKdtree[i][j].first) << " FlatKdtreeNearestNeighbors<MetricSquared>: " << flatKdtree[i][j].second->transpose() << std::endl;
+				exit(EXIT_FAILURE);
+			}
+			
 			if (!Eigen::internal::isApprox(linear[i][j].first, gnat[i][j].first) ||
 				!linear[i][j].second->isApprox(*gnat[i][j].second))
 			{
@@ -202,5 +218,29 @@ main(int argc, char** argv)
 	std::cout << std::endl << "-------------------------------------------------------------------------------" << std::endl << std::endl;
 	test(points, queries, true);
 	
+	for (std::size_t dim : DIMS)
+	{
+		points.clear();
+		points.reserve(N2);
+		
+		for (std::size_t i = 0; i < N2; ++i)
+		{
+			points.push_back(rl::math::Vector::Random(dim));
+		}
+		
+		std::cout << std::endl << "===============================================================================" << std::endl << std::endl;
+		
+		queries.clear();
+		
+		for (std::size_t i = 0; i < QUERIES2; ++i)
+		{
+			queries.push_back(rl::math::Vector::Random(dim));
+		}
+		
+		test(points, queries, false);
+		std::cout << std::endl << "-------------------------------------------------------------------------------" << std::endl << std::endl;
+		test(points, queries, true);
+	}
+	
 	return EXIT_SUCCESS;
 }
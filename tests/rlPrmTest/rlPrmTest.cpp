@@ -24,9 +24,14 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <set>
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 #include <boost/lexical_cast.hpp>
 #include <rl/math/Constants.h>
 #include <rl/mdl/Kinematic.h>
@@ -40,65 +45,100 @@
 #include <rl/sg/Model.h>
 #include <rl/sg/XmlFactory.h>
 
-#ifdef RL_SG_BULLET
-#include <rl/sg/bullet/Scene.h>
-#endif // RL_SG_BULLET
-#ifdef RL_SG_FCL
-#include <rl/sg/fcl/Scene.h>
-#endif // RL_SG_FCL
-#ifdef RL_SG_ODE
-#include <rl/sg/ode/Scene.h>
-#endif // RL_SG_ODE
-#ifdef RL_SG_PQP
-#include <rl/sg/pqp/Scene.h>
-#endif // RL_SG_PQP
-#ifdef RL_SG_SOLID
-#include <rl/sg/solid/Scene.h>
-#endif // RL_SG_SOLID
+#include "../createScene.h"
 
-int
-main(int argc, char** argv)
+/**
+ * Sampler returning every stride-th configuration of a list, starting at offset.
+ */
+class ListSampler : public rl::plan::Sampler
 {
-	if (argc < 14)
+public:
+	ListSampler(const std::vector<rl::math::Vector>& samples, const std::size_t& offset, const std::size_t& stride) :
+		Sampler(),
+		next(offset),
+		samples(samples),
+		stride(stride)
 	{
-		std::cout << "Usage: rlPrmTest ENGINE SCENEFILE KINEMATICSFILE EXPECTED_NUM_VERTICES_MAX EXPECTED_NUM_EDGES_MAX X Y Z A B C START1 ... STARTn GOAL1 ... GOALn" << std::endl;
-		return EXIT_FAILURE;
 	}
 	
-	try
+	rl::math::Vector generate()
+	{
+		rl::math::Vector q = this->samples[this->next % this->samples.size()];
+		this->next += this->stride;
+		return q;
+	}
+	
+private:
+	std::size_t next;
+	
+	const std::vector<rl::math::Vector>& samples;
+	
+	std::size_t stride;
+};
+
+/**
+ * Planner exposing its roadmap by vertex indices.
+ */
+class RoadmapPrm : public rl::plan::Prm
+{
+public:
+	std::vector<std::size_t> getComponents()
 	{
-		std::shared_ptr<rl::sg::Scene> scene;
+		std::vector<std::size_t> components(this->getNumVertices(), this->getNumVertices());
 		
-#ifdef RL_SG_BULLET
-		if ("bullet" == std::string(argv[1]))
+		for (VertexIteratorPair i = boost::vertices(this->graph); i.first != i.second; ++i.first)
 		{
-			scene = std::make_shared<rl::sg::bullet::Scene>();
+			std::size_t& component = components[this->graph[this->ds.find_set(*i.first)].index];
+			component = std::min(component, this->graph[*i.first].index);
 		}
-#endif // RL_SG_BULLET
-#ifdef RL_SG_FCL
-		if ("fcl" == std::string(argv[1]))
-		{
-			scene = std::make_shared<rl::sg::fcl::Scene>();
-		}
-#endif // RL_SG_FCL
-#ifdef RL_SG_ODE
-		if ("ode" == std::string(argv[1]))
+		
+		for (VertexIteratorPair i = boost::vertices(this->graph); i.first != i.second; ++i.first)
 		{
-			scene = std::make_shared<rl::sg::ode::Scene>();
+			components[this->graph[*i.first].index] = components[this->graph[this->ds.find_set(*i.first)].index];
 		}
-#endif // RL_SG_ODE
-#ifdef RL_SG_PQP
-		if ("pqp" == std::string(argv[1]))
+		
+		return components;
+	}
+	
+	std::set<std::pair<std::size_t, std::size_t>> getEdges() const
+	{
+		std::set<std::pair<std::size_t, std::size_t>> edges;
+		
+		for (EdgeIteratorPair i = boost::edges(this->graph); i.first != i.second; ++i.first)
 		{
-			scene = std::make_shared<rl::sg::pqp::Scene>();
+			std::size_t u = this->graph[boost::source(*i.first, this->graph)].index;
+			std::size_t v = this->graph[boost::target(*i.first, this->graph)].index;
+			edges.insert(std::make_pair(std::min(u, v), std::max(u, v)));
 		}
-#endif // RL_SG_PQP
-#ifdef RL_SG_SOLID
-		if ("solid" == std::string(argv[1]))
+		
+		return edges;
+	}
+	
+	std::vector<rl::math::Vector> getVertices() const
+	{
+		std::vector<rl::math::Vector> vertices(this->getNumVertices());
+		
+		for (VertexIteratorPair i = boost::vertices(this->graph); i.first != i.second; ++i.first)
 		{
-			scene = std::make_shared<rl::sg::solid::Scene>();
+			vertices[this->graph[*i.first].index] = *this->graph[*i.first].q;
 		}
-#endif // RL_SG_SOLID
+		
+		return vertices;
+	}
+};
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 14)
+	{
+		std::cout << "Usage: rlPrmTest ENGINE SCENEFILE KINEMATICSFILE EXPECTED_NUM_VERTICES_MAX EXPECTED_NUM_EDGES_MAX X Y Z A B C START1 ... STARTn GOAL1 ... GOALn" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::shared_ptr<rl::sg::Scene> scene = createScene(argv[1]);
 		
 		rl::sg::XmlFactory factory1;
 		factory1.load(argv[2], scene.get());
@@ -190,21 +230,170 @@ main(int argc, char** argv)
 		
 		std::cout << "NumVertices: " << planner.getNumVertices() << "  NumEdges: " << planner.getNumEdges() << std::endl;
 		
-		if (solved)
+		if (!solved)
+		{
+			return EXIT_FAILURE;
+		}
+		
+		if (boost::lexical_cast<std::size_t>(argv[4]) < planner.getNumVertices() ||
+			boost::lexical_cast<std::size_t>(argv[5]) < planner.getNumEdges())
 		{
-			if (boost::lexical_cast<std::size_t>(argv[4]) >= planner.getNumVertices() &&
-				boost::lexical_cast<std::size_t>(argv[5]) >= planner.getNumEdges())
+			std::cerr << "NumVertices and NumEdges are more than expected for this test case.";
+			return EXIT_FAILURE;
+		}
+		
+		std::shared_ptr<rl::sg::Scene> workerScene = createScene(argv[1]);
+		factory1.load(argv[2], workerScene.get());
+		
+		std::shared_ptr<rl::mdl::Kinematic> workerKinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory2.create(argv[3]));
+		workerKinematic->world() = world;
+		
+		rl::plan::SimpleModel workerModel;
+		workerModel.mdl = workerKinematic.get();
+		workerModel.model = workerScene->getModel(0);
+		workerModel.scene = workerScene.get();
+		
+		rl::plan::UniformSampler workerSampler;
+		rl::plan::RecursiveVerifier workerVerifier;
+		
+		workerSampler.seed(1);
+		workerSampler.setModel(&workerModel);
+		
+		workerVerifier.setDelta(1 * rl::math::constants::deg2rad);
+		workerVerifier.setModel(&workerModel);
+		
+		rl::plan::KdtreeNearestNeighbors concurrentNearestNeighbors(&model);
+		rl::plan::Prm concurrentPlanner;
+		
+		sampler.seed(0);
+		
+		concurrentPlanner.setModel(&model);
+		concurrentPlanner.setNearestNeighbors(&concurrentNearestNeighbors);
+		concurrentPlanner.setSampler(&sampler);
+		concurrentPlanner.setVerifier(&verifier);
+		concurrentPlanner.addWorker(&workerSampler, &workerVerifier);
+		concurrentPlanner.setStart(&start);
+		concurrentPlanner.setGoal(&goal);
+		concurrentPlanner.setDuration(std::chrono::seconds(20));
+		
+		std::cout << "solve() with worker ... " << std::endl;
+		startTime = std::chrono::steady_clock::now();
+		solved = concurrentPlanner.solve();
+		stopTime = std::chrono::steady_clock::now();
+		std::cout << "solve() with worker " << (solved ? "true" : "false") << " " << std::chrono::duration_cast<std::chrono::duration<double>>(stopTime - startTime).count() * 1000 << " ms" << std::endl;
+		
+		std::cout << "NumVertices: " << concurrentPlanner.getNumVertices() << "  NumEdges: " << concurrentPlanner.getNumEdges() << std::endl;
+		
+		if (!solved)
+		{
+			return EXIT_FAILURE;
+		}
+		
+		// same samples constructed sequentially and concurrently
+		
+		std::vector<rl::math::Vector> samples;
+		rl::plan::UniformSampler listSampler;
+		listSampler.seed(2);
+		listSampler.setModel(&model);
+		
+		for (std::size_t i = 0; i < 64; ++i)
+		{
+			samples.push_back(listSampler.generateCollisionFree());
+		}
+		
+		ListSampler sequentialSampler(samples, 0, 1);
+		sequentialSampler.setModel(&model);
+		rl::plan::KdtreeNearestNeighbors sequentialNearestNeighbors(&model);
+		RoadmapPrm sequentialRoadmap;
+		sequentialRoadmap.setModel(&model);
+		sequentialRoadmap.setNearestNeighbors(&sequentialNearestNeighbors);
+		sequentialRoadmap.setSampler(&sequentialSampler);
+		sequentialRoadmap.setVerifier(&verifier);
+		sequentialRoadmap.construct(samples.size());
+		
+		ListSampler concurrentSampler(samples, 0, 2);
+		concurrentSampler.setModel(&model);
+		ListSampler workerListSampler(samples, 1, 2);
+		workerListSampler.setModel(&workerModel);
+		rl::plan::KdtreeNearestNeighbors concurrentRoadmapNearestNeighbors(&model);
+		RoadmapPrm concurrentRoadmap;
+		concurrentRoadmap.setModel(&model);
+		concurrentRoadmap.setNearestNeighbors(&concurrentRoadmapNearestNeighbors);
+		concurrentRoadmap.setSampler(&concurrentSampler);
+		concurrentRoadmap.setVerifier(&verifier);
+		concurrentRoadmap.addWorker(&workerListSampler, &workerVerifier);
+		concurrentRoadmap.construct(samples.size());
+		
+		std::cout << "Roadmap sequential NumEdges: " << sequentialRoadmap.getNumEdges() << "  concurrent NumEdges: " << concurrentRoadmap.getNumEdges() << std::endl;
+		
+		if (concurrentRoadmap.getVertices() != sequentialRoadmap.getVertices() ||
+			concurrentRoadmap.getEdges() != sequentialRoadmap.getEdges() ||
+			concurrentRoadmap.getComponents() != sequentialRoadmap.getComponents())
+		{
+			std::cerr << "Concurrent roadmap differs from sequential roadmap." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		std::vector<rl::math::Vector> vertices = concurrentRoadmap.getVertices();
+		std::set<std::pair<std::size_t, std::size_t>> edges = concurrentRoadmap.getEdges();
+		
+		for (std::set<std::pair<std::size_t, std::size_t>>::iterator i = edges.begin(); i != edges.end(); ++i)
+		{
+			if (verifier.isColliding(vertices[i->first], vertices[i->second], model.distance(vertices[i->first], vertices[i->second])))
 			{
-				return EXIT_SUCCESS;
+				std::cerr << "Concurrent roadmap edge is colliding." << std::endl;
+				return EXIT_FAILURE;
 			}
-			else
+		}
+		
+		rl::plan::KdtreeNearestNeighbors lazyNearestNeighbors(&model);
+		rl::plan::Prm lazyPlanner;
+		
+		sampler.seed(0);
+		
+		lazyPlanner.setLazy(true);
+		lazyPlanner.setModel(&model);
+		lazyPlanner.setNearestNeighbors(&lazyNearestNeighbors);
+		lazyPlanner.setSampler(&sampler);
+		lazyPlanner.setVerifier(&verifier);
+		lazyPlanner.setStart(&start);
+		lazyPlanner.setGoal(&goal);
+		lazyPlanner.setDuration(std::chrono::seconds(20));
+		
+		std::cout << "solve() lazy ... " << std::endl;
+		startTime = std::chrono::steady_clock::now();
+		solved = lazyPlanner.solve();
+		stopTime = std::chrono::steady_clock::now();
+		std::cout << "solve() lazy " << (solved ? "true" : "false") << " " << std::chrono::duration_cast<std::chrono::duration<double>>(stopTime - startTime).count() * 1000 << " ms" << std::endl;
+		
+		std::cout << "NumVertices: " << lazyPlanner.getNumVertices() << "  NumEdges: " << lazyPlanner.getNumEdges() << std::endl;
+		
+		if (!solved)
+		{
+			return EXIT_FAILURE;
+		}
+		
+		rl::plan::VectorList path = lazyPlanner.getPath();
+		
+		if (path.empty() || !path.front().isApprox(start) || !path.back().isApprox(goal))
+		{
+			std::cerr << "Lazy path does not connect start and goal." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		for (rl::plan::VectorList::iterator i = path.begin(), j = ++path.begin(); j != path.end(); ++i, ++j)
+		{
+			model.setPosition(*j);
+			model.updateFrames();
+			
+			if (model.isColliding() || verifier.isColliding(*i, *j, model.distance(*i, *j)))
 			{
-				std::cerr << "NumVertices and NumEdges are more than expected for this test case.";
+				std::cerr << "Lazy path is colliding." << std::endl;
 				return EXIT_FAILURE;
 			}
 		}
 		
-		return EXIT_FAILURE;
+		return EXIT_SUCCESS;
 	}
 	catch (const std::exception& e)
 	{
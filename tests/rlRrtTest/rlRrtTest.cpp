@@ -0,0 +1,187 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <rl/math/Constants.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/XmlFactory.h>
+#include <rl/plan/AddRrtConCon.h>
+#include <rl/plan/KdtreeNearestNeighbors.h>
+#include <rl/plan/RrtConCon.h>
+#include <rl/plan/RrtDual.h>
+#include <rl/plan/RrtExtCon.h>
+#include <rl/plan/RrtExtExt.h>
+#include <rl/plan/SimpleModel.h>
+#include <rl/plan/UniformSampler.h>
+#include <rl/sg/Model.h>
+#include <rl/sg/XmlFactory.h>
+
+#include "../createScene.h"
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 10)
+	{
+		std::cout << "Usage: rlRrtTest ENGINE SCENEFILE KINEMATICSFILE X Y Z A B C START1 ... STARTn GOAL1 ... GOALn" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::shared_ptr<rl::sg::Scene> scene = createScene(argv[1]);
+		
+		if (nullptr == scene)
+		{
+			throw std::runtime_error("Engine '" + std::string(argv[1]) + "' not supported");
+		}
+		
+		rl::sg::XmlFactory factory1;
+		factory1.load(argv[2], scene.get());
+		
+		rl::mdl::XmlFactory factory2;
+		std::shared_ptr<rl::mdl::Kinematic> kinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory2.create(argv[3]));
+		
+		rl::math::Transform world = rl::math::Transform::Identity();
+		
+		world = rl::math::AngleAxis(
+			boost::lexical_cast<rl::math::Real>(argv[9]) * rl::math::constants::deg2rad,
+			rl::math::Vector3::UnitZ()
+		) * rl::math::AngleAxis(
+			boost::lexical_cast<rl::math::Real>(argv[8]) * rl::math::constants::deg2rad,
+			rl::math::Vector3::UnitY()
+		) * rl::math::AngleAxis(
+			boost::lexical_cast<rl::math::Real>(argv[7]) * rl::math::constants::deg2rad,
+			rl::math::Vector3::UnitX()
+		);
+		
+		world.translation().x() = boost::lexical_cast<rl::math::Real>(argv[4]);
+		world.translation().y() = boost::lexical_cast<rl::math::Real>(argv[5]);
+		world.translation().z() = boost::lexical_cast<rl::math::Real>(argv[6]);
+		
+		kinematic->world() = world;
+		
+		rl::plan::SimpleModel model;
+		model.mdl = kinematic.get();
+		model.model = scene->getModel(0);
+		model.scene = scene.get();
+		
+		if (static_cast<std::size_t>(argc) < 10 + 2 * kinematic->getDofPosition())
+		{
+			throw std::runtime_error("Start and goal configurations incomplete");
+		}
+		
+		rl::math::Vector start(kinematic->getDofPosition());
+		rl::math::Vector goal(kinematic->getDofPosition());
+		
+		for (std::ptrdiff_t i = 0; i < start.size(); ++i)
+		{
+			start(i) = boost::lexical_cast<rl::math::Real>(argv[i + 10]) * rl::math::constants::deg2rad;
+			goal(i) = boost::lexical_cast<rl::math::Real>(argv[start.size() + i + 10]) * rl::math::constants::deg2rad;
+		}
+		
+		std::vector<std::shared_ptr<rl::plan::Rrt>> planners;
+		planners.push_back(std::make_shared<rl::plan::AddRrtConCon>());
+		planners.push_back(std::make_shared<rl::plan::RrtConCon>());
+		planners.push_back(std::make_shared<rl::plan::RrtDual>());
+		planners.push_back(std::make_shared<rl::plan::RrtExtCon>());
+		planners.push_back(std::make_shared<rl::plan::RrtExtExt>());
+		
+		for (std::size_t i = 0; i < planners.size(); ++i)
+		{
+			rl::plan::KdtreeNearestNeighbors nearestNeighbors0(&model);
+			rl::plan::KdtreeNearestNeighbors nearestNeighbors1(&model);
+			rl::plan::UniformSampler sampler;
+			
+			sampler.seed(0);
+			sampler.setModel(&model);
+			
+			planners[i]->setDelta(1 * rl::math::constants::deg2rad);
+			planners[i]->setDuration(std::chrono::seconds(20));
+			planners[i]->setGoal(&goal);
+			planners[i]->setModel(&model);
+			planners[i]->setNearestNeighbors(&nearestNeighbors0, 0);
+			planners[i]->setNearestNeighbors(&nearestNeighbors1, 1);
+			planners[i]->setSampler(&sampler);
+			planners[i]->setStart(&start);
+			
+			// solve twice to reuse the storage of the trees after reset()
+			
+			for (std::size_t j = 0; j < 2; ++j)
+			{
+				planners[i]->reset();
+				
+				if (!planners[i]->solve())
+				{
+					std::cerr << planners[i]->getName() << " did not solve run " << j << std::endl;
+					return EXIT_FAILURE;
+				}
+				
+				rl::plan::VectorList path = planners[i]->getPath();
+				
+				if (path.empty() || model.distance(path.front(), start) > planners[i]->getEpsilon() || model.distance(path.back(), goal) > planners[i]->getEpsilon())
+				{
+					std::cerr << planners[i]->getName() << " path does not connect start and goal" << std::endl;
+					return EXIT_FAILURE;
+				}
+				
+				rl::plan::VectorList::iterator k = path.begin();
+				rl::plan::VectorList::iterator l = ++path.begin();
+				
+				for (; path.end() != l; ++k, ++l)
+				{
+					if (model.distance(*k, *l) > planners[i]->getDelta() + planners[i]->getEpsilon())
+					{
+						std::cerr << planners[i]->getName() << " path contains step larger than delta" << std::endl;
+						return EXIT_FAILURE;
+					}
+					
+					if (model.isColliding(*l))
+					{
+						std::cerr << planners[i]->getName() << " path contains colliding configuration " << l->transpose() << std::endl;
+						return EXIT_FAILURE;
+					}
+				}
+				
+				std::cout << planners[i]->getName() << " run " << j << ": " << planners[i]->getNumVertices() << " vertices, " << path.size() << " configurations in path" << std::endl;
+			}
+		}
+		
+		return EXIT_SUCCESS;
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+}
@@ -24,8 +24,12 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <array>
 #include <iostream>
+#include <vector>
+#include <rl/math/FixedDegreePolynomial.h>
 #include <rl/math/Polynomial.h>
+#include <rl/math/Vector.h>
 
 int
 main(int argc, char** argv)
@@ -120,6 +124,72 @@ main(int argc, char** argv)
 		}
 	}
 	
+	{
+		rl::math::Polynomial<rl::math::Real> p = rl::math::Polynomial<rl::math::Real>::SepticFirstSecondThird(y0, y1, yd0, yd1, ydd0, ydd1, yddd0, yddd1, x1);
+		std::vector<rl::math::Real> y(10);
+		
+		for (rl::math::Real x = 0; x <= x1; x += x1 / 7)
+		{
+			p.evaluate(x, y);
+			
+			for (std::size_t i = 0; i < y.size(); ++i)
+			{
+				if (std::abs(y[i] - p(x, i)) > eps * std::max<rl::math::Real>(1, std::abs(y[i])))
+				{
+					std::cerr << "rlPolynomialTest: evaluate" << std::endl;
+					return EXIT_FAILURE;
+				}
+			}
+		}
+	}
+	
+	{
+		rl::math::Vector3 v0(y0, -y0, 0), v1(y1, -y1, 1), vd0(yd0, -yd0, 2), vd1(yd1, -yd1, 3), vdd0(ydd0, -ydd0, 4), vdd1(ydd1, -ydd1, 5), vddd0(yddd0, -yddd0, 6), vddd1(yddd1, -yddd1, 7);
+		
+		rl::math::FixedDegreePolynomial<rl::math::Vector3, 3> p3 = rl::math::FixedDegreePolynomial<rl::math::Vector3, 3>::CubicFirst(v0, v1, vd0, vd1, x1);
+		rl::math::FixedDegreePolynomial<rl::math::Vector3, 5> p5 = rl::math::FixedDegreePolynomial<rl::math::Vector3, 5>::QuinticFirstSecond(v0, v1, vd0, vd1, vdd0, vdd1, x1);
+		rl::math::FixedDegreePolynomial<rl::math::Vector3, 7> p7 = rl::math::FixedDegreePolynomial<rl::math::Vector3, 7>::SepticFirstSecondThird(v0, v1, vd0, vd1, vdd0, vdd1, vddd0, vddd1, x1);
+		rl::math::Polynomial<rl::math::Vector3> q7 = rl::math::Polynomial<rl::math::Vector3>::SepticFirstSecondThird(v0, v1, vd0, vd1, vdd0, vdd1, vddd0, vddd1, x1);
+		
+		std::array<rl::math::Vector3, 4> y;
+		
+		p3.evaluate(0, y);
+		
+		if (!y[0].isApprox(v0, eps) || !y[1].isApprox(vd0, eps) || !p3(x1).isApprox(v1, eps) || !p3(x1, 1).isApprox(vd1, eps))
+		{
+			std::cerr << "rlPolynomialTest: FixedDegreePolynomial CubicFirst" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		p5.evaluate(x1, y);
+		
+		if (!y[0].isApprox(v1, eps) || !y[1].isApprox(vd1, eps) || !y[2].isApprox(vdd1, eps) || !p5(0, 2).isApprox(vdd0, eps))
+		{
+			std::cerr << "rlPolynomialTest: FixedDegreePolynomial QuinticFirstSecond" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		p7.evaluate(x1, y);
+		
+		if (!y[0].isApprox(v1, eps) || !y[1].isApprox(vd1, eps) || !y[2].isApprox(vdd1, eps) || !y[3].isApprox(vddd1, eps))
+		{
+			std::cerr << "rlPolynomialTest: FixedDegreePolynomial SepticFirstSecondThird" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		for (rl::math::Real x = 0; x <= x1; x += x1 / 7)
+		{
+			for (std::size_t i = 0; i < 9; ++i)
+			{
+				if (p7(x, i) != q7(x, i) || p7.polynomial()(x, i) != q7(x, i))
+				{
+					std::cerr << "rlPolynomialTest: FixedDegreePolynomial != Polynomial" << std::endl;
+					return EXIT_FAILURE;
+				}
+			}
+		}
+	}
+	
 	std::cout << "rlPolynomialTest is ok." << std::endl;
 	return EXIT_SUCCESS;
 }
@@ -24,6 +24,8 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <rl/math/Array.h>
 #include <rl/math/Spline.h>
@@ -147,6 +149,83 @@ main(int argc, char** argv)
 		}
 	}
 	
+	{
+		// Segment lookup
+		::std::vector<rl::math::Real> x;
+		::std::vector<rl::math::ArrayX> y;
+		
+		for (::std::size_t i = 0; i < 1000; ++i)
+		{
+			x.push_back(0.5 * i + 0.25 * ::std::sin(static_cast<rl::math::Real>(i)));
+			y.push_back(rl::math::ArrayX::Random(3));
+		}
+		
+		rl::math::Spline<rl::math::ArrayX> s = rl::math::Spline<rl::math::ArrayX>::CubicNatural(x, y);
+		
+		::std::vector<rl::math::Real> t;
+		
+		for (::std::size_t i = 0; i < s.size(); ++i)
+		{
+			t.push_back(x[i]);
+			t.push_back(x[i] + 0.3 * (x[i + 1] - x[i]));
+		}
+		
+		t.push_back(s.lower() - 1.0e-9);
+		t.push_back(s.upper());
+		t.push_back(s.upper() + 1.0e-9);
+		::std::sort(t.begin(), t.end());
+		
+		::std::vector<rl::math::Real> t2(t.rbegin(), t.rend());
+		
+		for (::std::size_t derivative = 0; derivative < 3; ++derivative)
+		{
+			::std::vector<rl::math::ArrayX> y1;
+			s.evaluate(t, y1, derivative);
+			
+			::std::vector<rl::math::ArrayX> y2;
+			s.evaluate(t2, y2, derivative);
+			
+			rl::math::Spline<rl::math::ArrayX>::Cursor cursor = s.cursor();
+			
+			for (::std::size_t i = 0; i < t.size(); ++i)
+			{
+				rl::math::Real x0 = s.lower();
+				::std::size_t j = 0;
+				
+				for (; t[i] > x0 + s[j].duration() && j + 1 < s.size(); ++j)
+				{
+					x0 += s[j].duration();
+				}
+				
+				rl::math::ArrayX expected = s[j](t[i] - x0, derivative);
+				
+				if (s.segment(t[i]) != j)
+				{
+					std::cerr << "Spline::segment(" << t[i] << ") returned " << s.segment(t[i]) << " instead of " << j << "." << std::endl;
+					return EXIT_FAILURE;
+				}
+				
+				if ((s(t[i], derivative) != expected).any())
+				{
+					std::cerr << "Spline::operator() differs from sequential lookup at " << t[i] << "." << std::endl;
+					return EXIT_FAILURE;
+				}
+				
+				if ((cursor(t[i], derivative) != expected).any())
+				{
+					std::cerr << "Spline::Cursor differs from sequential lookup at " << t[i] << "." << std::endl;
+					return EXIT_FAILURE;
+				}
+				
+				if ((y1[i] != expected).any() || (y2[t.size() - 1 - i] != expected).any())
+				{
+					std::cerr << "Spline::evaluate differs from sequential lookup at " << t[i] << "." << std::endl;
+					return EXIT_FAILURE;
+				}
+			}
+		}
+	}
+	
 	std::cout << "rlSplineTest: Done." << std::endl;
 	return EXIT_SUCCESS;
 }
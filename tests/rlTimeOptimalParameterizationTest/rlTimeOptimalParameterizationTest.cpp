@@ -0,0 +1,228 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/TimeOptimalParameterization.h>
+#include <rl/mdl/XmlFactory.h>
+
+bool
+check(rl::mdl::Dynamic* dynamic, const rl::math::Spline<rl::math::Vector>& path, const rl::math::Spline<rl::math::Vector>& trajectory, const rl::math::Vector& speed, const rl::math::Vector& acceleration, const rl::math::Vector& torque, rl::math::Vector& maximum)
+{
+	rl::math::Real epsilon = 1.0e-6;
+	
+	if (!trajectory(trajectory.lower()).isApprox(path(path.lower()), epsilon) ||
+		!trajectory(trajectory.upper()).isApprox(path(path.upper()), epsilon))
+	{
+		std::cerr << "Trajectory does not connect start and goal of path." << std::endl;
+		return false;
+	}
+	
+	if (trajectory(trajectory.lower(), 1).norm() > epsilon ||
+		trajectory(trajectory.upper(), 1).norm() > epsilon)
+	{
+		std::cerr << "Trajectory does not start and end at rest." << std::endl;
+		return false;
+	}
+	
+	for (std::size_t i = 1; i < trajectory.size(); ++i)
+	{
+		for (std::size_t j = 0; j < 2; ++j)
+		{
+			if (!trajectory[i - 1](trajectory[i - 1].upper(), j).isApprox(trajectory[i](0, j), epsilon) &&
+				(trajectory[i - 1](trajectory[i - 1].upper(), j) - trajectory[i](0, j)).norm() > epsilon)
+			{
+				std::cerr << "Trajectory is not continuous at polynomial " << i << " in derivative " << j << "." << std::endl;
+				return false;
+			}
+		}
+	}
+	
+	maximum = rl::math::Vector::Zero(dynamic->getDof());
+	
+	for (rl::math::Real t = trajectory.lower(); t < trajectory.upper(); t += 0.001)
+	{
+		rl::math::Vector q = trajectory(t);
+		rl::math::Vector qd = trajectory(t, 1);
+		rl::math::Vector qdd = trajectory(t, 2);
+		
+		if ((qd.cwiseAbs().array() > speed.array() * 1.02 + epsilon).any())
+		{
+			std::cerr << "Velocity " << qd.transpose() << " at " << t << " exceeds limits " << speed.transpose() << "." << std::endl;
+			return false;
+		}
+		
+		if ((qdd.cwiseAbs().array() > acceleration.array() * 1.02 + epsilon).any())
+		{
+			std::cerr << "Acceleration " << qdd.transpose() << " at " << t << " exceeds limits " << acceleration.transpose() << "." << std::endl;
+			return false;
+		}
+		
+		dynamic->setPosition(q);
+		dynamic->setVelocity(qd);
+		dynamic->setAcceleration(qdd);
+		dynamic->inverseDynamics();
+		maximum = maximum.cwiseMax(dynamic->getTorque().cwiseAbs());
+		
+		if (torque.size() > 0 && (dynamic->getTorque().cwiseAbs().array() > torque.array() * 1.05 + epsilon).any())
+		{
+			std::cerr << "Torque " << dynamic->getTorque().transpose() << " at " << t << " exceeds limits " << torque.transpose() << "." << std::endl;
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: rlTimeOptimalParameterizationTest MODELFILE" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		rl::mdl::XmlFactory factory;
+		std::shared_ptr<rl::mdl::Dynamic> dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(argv[1]));
+		dynamic->seed(0);
+		
+		std::vector<rl::math::Vector> waypoints;
+		waypoints.push_back(rl::math::Vector::Zero(dynamic->getDofPosition()));
+		
+		for (std::size_t i = 0; i < 3; ++i)
+		{
+			waypoints.push_back(dynamic->generatePositionUniform() / 2);
+		}
+		
+		rl::math::Vector acceleration = 2 * dynamic->getSpeed();
+		
+		for (rl::math::Real blend : { 0.0, 0.2 })
+		{
+			rl::math::Spline<rl::math::Vector> path = rl::mdl::TimeOptimalParameterization::Path(waypoints.begin(), waypoints.end(), blend);
+			
+			rl::mdl::TimeOptimalParameterization parameterization(dynamic.get());
+			parameterization.setAcceleration(acceleration);
+			
+			rl::math::Spline<rl::math::Vector> trajectory = parameterization.parameterize(path);
+			rl::math::Vector maximum;
+			
+			if (!check(dynamic.get(), path, trajectory, parameterization.getSpeed(), acceleration, rl::math::Vector(), maximum))
+			{
+				std::cerr << "rlTimeOptimalParameterizationTest: Kinematic limits violated with blend " << blend << "." << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			std::cout << "blend " << blend << " duration " << trajectory.duration() << " s with " << trajectory.size() << " polynomials, maximum torque " << maximum.transpose() << std::endl;
+			
+			rl::math::Matrix q(waypoints.size(), dynamic->getDofPosition());
+			
+			for (std::size_t i = 0; i < waypoints.size(); ++i)
+			{
+				q.row(i) = waypoints[i].transpose();
+			}
+			
+			rl::math::Matrix gravity(waypoints.size(), dynamic->getDof());
+			dynamic->calculateBatchGravity(q, gravity);
+			rl::math::Vector torque = (0.7 * maximum).cwiseMax(1.5 * gravity.cwiseAbs().colwise().maxCoeff().transpose() + rl::math::Vector::Ones(dynamic->getDof()));
+			
+			parameterization.setTorque(torque);
+			
+			rl::math::Spline<rl::math::Vector> trajectory2 = parameterization.parameterize(path);
+			
+			if (!check(dynamic.get(), path, trajectory2, parameterization.getSpeed(), acceleration, torque, maximum))
+			{
+				std::cerr << "rlTimeOptimalParameterizationTest: Dynamic limits violated with blend " << blend << "." << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			std::cout << "blend " << blend << " duration " << trajectory2.duration() << " s with torque limits " << torque.transpose() << std::endl;
+			
+			if (trajectory2.duration() < trajectory.duration() * (1 - 1.0e-6))
+			{
+				std::cerr << "rlTimeOptimalParameterizationTest: Torque limits shortened trajectory." << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		
+		// short segment between two corners
+		
+		rl::math::Vector a = dynamic->generatePositionUniform() / 4;
+		
+		std::vector<rl::math::Vector> corners;
+		corners.push_back(rl::math::Vector::Zero(dynamic->getDofPosition()));
+		corners.push_back(a);
+		corners.push_back(a + 1.0e-3 * rl::math::Vector::Unit(dynamic->getDofPosition(), 0));
+		corners.push_back(2 * a);
+		
+		rl::math::Spline<rl::math::Vector> path = rl::mdl::TimeOptimalParameterization::Path(corners.begin(), corners.end(), 0);
+		
+		rl::mdl::TimeOptimalParameterization parameterization(dynamic.get());
+		parameterization.setAcceleration(acceleration);
+		
+		rl::math::Spline<rl::math::Vector> trajectory = parameterization.parameterize(path);
+		rl::math::Vector maximum;
+		
+		if (!check(dynamic.get(), path, trajectory, parameterization.getSpeed(), acceleration, rl::math::Vector(), maximum))
+		{
+			std::cerr << "rlTimeOptimalParameterizationTest: Kinematic limits violated with short segment." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		std::cout << "short segment duration " << trajectory.duration() << " s with " << trajectory.size() << " polynomials" << std::endl;
+		
+		// zero-length path
+		
+		rl::math::Polynomial<rl::math::Vector> point(0);
+		point.coefficient(0) = a;
+		
+		rl::math::Spline<rl::math::Vector> zeroPath;
+		zeroPath.push_back(point);
+		
+		rl::math::Spline<rl::math::Vector> zeroTrajectory = parameterization.parameterize(zeroPath);
+		
+		if (0 != zeroTrajectory.duration() || !zeroTrajectory(0).isApprox(a) || 0 != zeroTrajectory(0, 1).norm())
+		{
+			std::cerr << "rlTimeOptimalParameterizationTest: Zero-length path not at rest at its position." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	std::cout << "rlTimeOptimalParameterizationTest: Done." << std::endl;
+	
+	return EXIT_SUCCESS;
+}
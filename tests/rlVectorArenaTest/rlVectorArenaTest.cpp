@@ -0,0 +1,123 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <rl/plan/VectorArena.h>
+
+int
+main(int argc, char** argv)
+{
+	rl::plan::VectorArena arena(3, 4);
+	std::vector<const rl::math::Real*> pointers;
+	
+	for (std::size_t i = 0; i < 100; ++i)
+	{
+		rl::math::Vector q(3);
+		q << i, 2 * i, 3 * i;
+		
+		if (i != arena.push_back(q))
+		{
+			std::cerr << "Index of configuration " << i << " not consecutive" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		pointers.push_back(arena.data(i));
+	}
+	
+	if (100 != arena.size())
+	{
+		std::cerr << "Size " << arena.size() << " != 100" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	for (std::size_t i = 0; i < arena.size(); ++i)
+	{
+		if (pointers[i] != arena.data(i))
+		{
+			std::cerr << "Configuration " << i << " moved while growing" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (i != pointers[i][0] || 2 * i != pointers[i][1] || 3 * i != pointers[i][2])
+		{
+			std::cerr << "Configuration " << i << " changed while growing: " << arena[i].transpose() << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	
+	rl::plan::VectorArena copy(arena);
+	
+	if (copy.size() != arena.size() || copy.data(0) == arena.data(0) || copy[99] != arena[99])
+	{
+		std::cerr << "Copy differs from original" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	arena.clear();
+	
+	if (!arena.empty())
+	{
+		std::cerr << "Arena not empty after clear" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	for (std::size_t i = 0; i < 100; ++i)
+	{
+		arena.push_back(rl::math::Vector::Constant(3, -static_cast<rl::math::Real>(i)));
+		
+		if (pointers[i] != arena.data(i))
+		{
+			std::cerr << "Storage of configuration " << i << " not reused after clear" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	
+	if (99 != copy[99][0])
+	{
+		std::cerr << "Copy shares storage with original" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	arena.setStride(6);
+	
+	if (!arena.empty() || 6 != arena.getStride())
+	{
+		std::cerr << "Arena not empty after changing stride" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	arena.push_back(rl::math::Vector::Ones(6));
+	
+	if (6 != arena[0].size() || 6 != arena[0].sum())
+	{
+		std::cerr << "Configuration with new stride incorrect" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}